@@ -28,6 +28,7 @@
 %import "spectrum.i"
 %import "tessellation.i"
 %import "timekeeper.i"
+%include "doublevaluesarraytypemap.i"
 %include "integervaluesarraytypemap.i"
 
 %extend OpenCMISS::Zinc::Context {
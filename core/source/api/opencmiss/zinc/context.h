@@ -220,6 +220,93 @@ ZINC_API const char* cmzn_context_get_revision(cmzn_context_id context);
  */
 ZINC_API char *cmzn_context_get_version_string(cmzn_context_id context);
 
+/**
+ * Query whether this Zinc library was built with instrumentation, i.e. with
+ * the ZINC_BUILD_INSTRUMENTATION option. Without it no statistics are gathered
+ * and the statistics functions below return CMZN_ERROR_NOT_IMPLEMENTED.
+ *
+ * @param context  Handle to the context.
+ * @return  Boolean true if statistics are gathered, otherwise false.
+ */
+ZINC_API bool cmzn_context_is_instrumented(cmzn_context_id context);
+
+/**
+ * Get the value of a statistic gathered since the library was loaded or
+ * statistics were last reset. Statistics are currently gathered over all
+ * contexts in the process.
+ *
+ * @param context  Handle to the context.
+ * @param statistic_type  The statistic to get.
+ * @param value_out  Address to return the value of the statistic.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_NOT_IMPLEMENTED if not
+ * built with instrumentation, or any other value on failure.
+ */
+ZINC_API int cmzn_context_get_statistic(cmzn_context_id context,
+	enum cmzn_context_statistic_type statistic_type, double *value_out);
+
+/**
+ * Reset all statistics to zero, including those for individual fields and
+ * graphics in the regions of this context.
+ *
+ * @param context  Handle to the context.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_NOT_IMPLEMENTED if not
+ * built with instrumentation, or any other value on failure.
+ */
+ZINC_API int cmzn_context_reset_statistics(cmzn_context_id context);
+
+/**
+ * Get a JSON description of all statistics, with evaluation counts of each
+ * field and build counts and times of each graphics in regions of this
+ * context, omitting fields and graphics with zero counts.
+ *
+ * @param context  Handle to the context.
+ * @return  On success allocated string containing the JSON description,
+ * otherwise 0 including if not built with instrumentation. Up to caller to
+ * free using cmzn_deallocate().
+ */
+ZINC_API char *cmzn_context_get_statistics_description(cmzn_context_id context);
+
+/**
+ * Write the JSON description of all statistics as an information message to
+ * the logger.
+ * @see cmzn_context_get_statistics_description
+ *
+ * @param context  Handle to the context.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_NOT_IMPLEMENTED if not
+ * built with instrumentation, or any other value on failure.
+ */
+ZINC_API int cmzn_context_log_statistics(cmzn_context_id context);
+
+/**
+ * Begin recording a timeline of spans for phases of region change
+ * notification, field change propagation, graphics building, rendering, region
+ * and scene I/O and optimisation, nested by call structure. Spans are held in
+ * memory until the trace is ended. Only available if built with
+ * instrumentation; only one trace may be recorded at a time.
+ * @see cmzn_context_is_instrumented
+ *
+ * @param context  Handle to the context.
+ * @param file_name  Name of file to write the trace to on ending it.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_IN_USE if a trace is already
+ * being recorded, CMZN_ERROR_NOT_IMPLEMENTED if not built with
+ * instrumentation, or any other value on failure.
+ */
+ZINC_API int cmzn_context_begin_trace(cmzn_context_id context,
+	const char *file_name);
+
+/**
+ * End recording the trace and write it to the file name given when it was
+ * begun, in Chrome trace event JSON format for viewing in Perfetto or
+ * chrome://tracing.
+ *
+ * @param context  Handle to the context.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_NOT_FOUND if no trace is
+ * being recorded, CMZN_ERROR_NOT_IMPLEMENTED if not built with
+ * instrumentation, or any other value on failure including failing to write
+ * the file.
+ */
+ZINC_API int cmzn_context_end_trace(cmzn_context_id context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -106,6 +106,59 @@ public:
 		return cmzn_context_get_version_string(id);
 	}
 
+	enum StatisticType
+	{
+		STATISTIC_TYPE_INVALID = CMZN_CONTEXT_STATISTIC_TYPE_INVALID,
+		STATISTIC_TYPE_FIELD_EVALUATIONS = CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATIONS,
+		STATISTIC_TYPE_FIELD_EVALUATION_CACHE_HITS = CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATION_CACHE_HITS,
+		STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_HITS = CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_HITS,
+		STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_MISSES = CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_MISSES,
+		STATISTIC_TYPE_FIND_XI_SEARCHES = CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_SEARCHES,
+		STATISTIC_TYPE_FIND_XI_ITERATIONS = CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_ITERATIONS,
+		STATISTIC_TYPE_GRAPHICS_BUILDS = CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILDS,
+		STATISTIC_TYPE_GRAPHICS_BUILD_TIME = CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILD_TIME,
+		STATISTIC_TYPE_STREAM_READ_BYTES = CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_BYTES,
+		STATISTIC_TYPE_STREAM_READ_TIME = CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_TIME,
+		STATISTIC_TYPE_STREAM_WRITE_BYTES = CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_BYTES,
+		STATISTIC_TYPE_STREAM_WRITE_TIME = CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_TIME
+	};
+
+	bool isInstrumented()
+	{
+		return cmzn_context_is_instrumented(id);
+	}
+
+	int getStatistic(StatisticType statisticType, double *valueOut)
+	{
+		return cmzn_context_get_statistic(id,
+			static_cast<cmzn_context_statistic_type>(statisticType), valueOut);
+	}
+
+	int resetStatistics()
+	{
+		return cmzn_context_reset_statistics(id);
+	}
+
+	char *getStatisticsDescription()
+	{
+		return cmzn_context_get_statistics_description(id);
+	}
+
+	int logStatistics()
+	{
+		return cmzn_context_log_statistics(id);
+	}
+
+	int beginTrace(const char *fileName)
+	{
+		return cmzn_context_begin_trace(id, fileName);
+	}
+
+	int endTrace()
+	{
+		return cmzn_context_end_trace(id);
+	}
+
 	inline Region createRegion();
 
 	inline Region getDefaultRegion();
@@ -26,7 +26,9 @@ class FieldEdgeDiscontinuity;
 class FieldEigenvalues;
 class FieldElementGroup;
 class FieldFindMeshLocation;
+class FieldFindNearestNode;
 class FieldFiniteElement;
+class FieldGradient;
 class FieldGroup;
 class FieldImage;
 class FieldImagefilterBinaryThreshold;
@@ -260,7 +262,9 @@ public:
 	inline FieldEigenvalues castEigenvalues();
 	inline FieldElementGroup castElementGroup();
 	inline FieldFindMeshLocation castFindMeshLocation();
+	inline FieldFindNearestNode castFindNearestNode();
 	inline FieldFiniteElement castFiniteElement();
+	inline FieldGradient castGradient();
 	inline FieldGroup castGroup();
 	inline FieldImage castImage();
 	inline FieldImagefilterBinaryThreshold castImagefilterBinaryThreshold();
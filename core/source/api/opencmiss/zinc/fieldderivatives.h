@@ -11,6 +11,7 @@
 #ifndef CMZN_FIELDDERIVATIVES_H__
 #define CMZN_FIELDDERIVATIVES_H__
 
+#include "types/fieldderivativesid.h"
 #include "types/fieldid.h"
 #include "types/fieldmoduleid.h"
 
@@ -79,7 +80,9 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_divergence(
  * scalar source_field, and the deformation gradient if a deformed coordinate
  * field is passed as the source_field.
  * The gradient can also be calculated at nodes, albeit approximately using a
- * finite difference approach by perturbing the coordinate field.
+ * finite difference approach by perturbing the coordinate field, or by
+ * averaging the gradients in adjacent elements.
+ * @see cmzn_field_gradient_set_node_mode
  *
  * @param field_module  Region field module which will own new field.
  * @param source_field  Field to calculate gradients for.
@@ -91,6 +94,82 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_gradient(
 	cmzn_fieldmodule_id field_module,
 	cmzn_field_id source_field, cmzn_field_id coordinate_field);
 
+/**
+ * If the field is a gradient type field, return the derived field handle.
+ *
+ * @param field  The field to be cast.
+ * @return  Handle to derived gradient field, or NULL/invalid handle if wrong
+ * type or failed.
+ */
+ZINC_API cmzn_field_gradient_id cmzn_field_cast_gradient(cmzn_field_id field);
+
+/**
+ * Cast gradient field back to its base field and return the field.
+ * IMPORTANT NOTE: Returned field does not have incremented reference count and
+ * must not be destroyed. Use cmzn_field_access() to add a reference if
+ * maintaining returned handle beyond the lifetime of the derived field.
+ * Use this function to call base-class API, e.g.:
+ * cmzn_field_set_name(cmzn_field_derived_base_cast(derived_field), "bob");
+ *
+ * @param gradient_field  Handle to the gradient field to cast.
+ * @return  Non-accessed handle to the base field or NULL if failed.
+ */
+ZINC_C_INLINE cmzn_field_id cmzn_field_gradient_base_cast(
+	cmzn_field_gradient_id gradient_field)
+{
+	return (cmzn_field_id)(gradient_field);
+}
+
+/**
+ * Destroys handle to the gradient field (and sets it to NULL).
+ * Internally this decrements the reference count.
+ *
+ * @param gradient_field_address  Address of handle to the field to destroy.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_field_gradient_destroy(cmzn_field_gradient_id *gradient_field_address);
+
+/**
+ * Convert a short name into an enum if the name matches any of the members in
+ * the enum.
+ *
+ * @param string  string of the short enumerator name
+ * @return  the correct enum type if a match is found.
+ */
+ZINC_API enum cmzn_field_gradient_node_mode
+	cmzn_field_gradient_node_mode_enum_from_string(const char *string);
+
+/**
+ * Return an allocated short name of the enum type from the provided enum.
+ * User must call cmzn_deallocate to destroy the successfully returned string.
+ *
+ * @param mode  enum to be converted into string
+ * @return  an allocated string which stored the short name of the enum.
+ */
+ZINC_API char *cmzn_field_gradient_node_mode_enum_to_string(
+	enum cmzn_field_gradient_node_mode mode);
+
+/**
+ * Get how the gradient field is evaluated at nodes.
+ *
+ * @param gradient_field  The gradient field to query.
+ * @return  The node mode, or CMZN_FIELD_GRADIENT_NODE_MODE_INVALID if bad
+ * argument.
+ */
+ZINC_API enum cmzn_field_gradient_node_mode cmzn_field_gradient_get_node_mode(
+	cmzn_field_gradient_id gradient_field);
+
+/**
+ * Set how the gradient field is evaluated at nodes.
+ * @see cmzn_field_gradient_node_mode
+ *
+ * @param gradient_field  The gradient field to modify.
+ * @param node_mode  The node mode to set.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_gradient_set_node_mode(cmzn_field_gradient_id gradient_field,
+	enum cmzn_field_gradient_node_mode node_mode);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,17 +69,40 @@ public:
 class FieldGradient : public Field
 {
 private:
-	// takes ownership of C handle, responsibility for destroying it
-	explicit FieldGradient(cmzn_field_id field_id) : Field(field_id)
-	{	}
 
-	friend FieldGradient Fieldmodule::createFieldGradient(const Field& sourceField, const Field& coordinateField);
+	inline cmzn_field_gradient_id getDerivedId()
+	{
+		return reinterpret_cast<cmzn_field_gradient_id>(id);
+	}
 
 public:
 
 	FieldGradient() : Field(0)
 	{	}
 
+	// takes ownership of C handle, responsibility for destroying it
+	explicit FieldGradient(cmzn_field_gradient_id field_gradient_id) :
+		Field(reinterpret_cast<cmzn_field_id>(field_gradient_id))
+	{	}
+
+	enum NodeMode
+	{
+		NODE_MODE_INVALID = CMZN_FIELD_GRADIENT_NODE_MODE_INVALID,
+		NODE_MODE_FINITE_DIFFERENCE = CMZN_FIELD_GRADIENT_NODE_MODE_FINITE_DIFFERENCE,
+		NODE_MODE_ELEMENT_AVERAGE = CMZN_FIELD_GRADIENT_NODE_MODE_ELEMENT_AVERAGE
+	};
+
+	NodeMode getNodeMode()
+	{
+		return static_cast<NodeMode>(cmzn_field_gradient_get_node_mode(getDerivedId()));
+	}
+
+	int setNodeMode(NodeMode nodeMode)
+	{
+		return cmzn_field_gradient_set_node_mode(getDerivedId(),
+			static_cast<cmzn_field_gradient_node_mode>(nodeMode));
+	}
+
 };
 
 inline FieldDerivative Fieldmodule::createFieldDerivative(const Field& sourceField, int xi_index)
@@ -99,8 +122,13 @@ inline FieldDivergence Fieldmodule::createFieldDivergence(const Field& vectorFie
 
 inline FieldGradient Fieldmodule::createFieldGradient(const Field& sourceField, const Field& coordinateField)
 {
-	return FieldGradient(cmzn_fieldmodule_create_field_gradient(id, sourceField.getId(),
-		coordinateField.getId()));
+	return FieldGradient(reinterpret_cast<cmzn_field_gradient_id>(
+		cmzn_fieldmodule_create_field_gradient(id, sourceField.getId(), coordinateField.getId())));
+}
+
+inline FieldGradient Field::castGradient()
+{
+	return FieldGradient(cmzn_field_cast_gradient(id));
 }
 
 }  // namespace Zinc
@@ -50,6 +50,64 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_fibre_axes(
 	cmzn_fieldmodule_id field_module,
 	cmzn_field_id fibre_field, cmzn_field_id coordinate_field);
 
+/**
+ * Creates a field returning the 9-component (3 x 3 matrix) deformation
+ * gradient F = dx/dX of the deformed coordinates x with respect to the
+ * undeformed coordinates X, with both expressed in the fibre axes of the
+ * undeformed coordinates (as for the fibre axes field). Only defined at element
+ * locations on or in 3-D elements.
+ * The right Cauchy-Green deformation tensor, Green-Lagrange strain and
+ * principal strains are calculated and cached in the same pass, and are
+ * returned by fields created from this field with the functions below, so
+ * evaluating any of these at a location evaluates coordinates and fibre axes
+ * only once. Derivatives are not available.
+ *
+ * @param field_module  Region field module which will own new field.
+ * @param deformed_coordinate_field  The deformed coordinate field with at most
+ * 3 components.
+ * @param undeformed_coordinate_field  The undeformed coordinate field with at
+ * most 3 components.
+ * @param fibre_field  The fibre field with at most 3 components.
+ * @return  Handle to new 9-component field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_fibre_deformation_gradient(
+	cmzn_fieldmodule_id field_module, cmzn_field_id deformed_coordinate_field,
+	cmzn_field_id undeformed_coordinate_field, cmzn_field_id fibre_field);
+
+/**
+ * Creates a field returning the 9-component right Cauchy-Green deformation
+ * tensor C = F^T F in fibre axes, cached with the fibre deformation gradient.
+ *
+ * @param field_module  Region field module which will own new field.
+ * @param fibre_deformation_gradient_field  A fibre deformation gradient field.
+ * @return  Handle to new 9-component field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_fibre_right_cauchy_green_deformation(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field);
+
+/**
+ * Creates a field returning the 9-component Green-Lagrange strain tensor
+ * E = (C - I)/2 in fibre axes, cached with the fibre deformation gradient.
+ *
+ * @param field_module  Region field module which will own new field.
+ * @param fibre_deformation_gradient_field  A fibre deformation gradient field.
+ * @return  Handle to new 9-component field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_fibre_green_lagrange_strain(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field);
+
+/**
+ * Creates a field returning the 3 principal strains, the eigenvalues of the
+ * Green-Lagrange strain tensor from largest to smallest, cached with the fibre
+ * deformation gradient.
+ *
+ * @param field_module  Region field module which will own new field.
+ * @param fibre_deformation_gradient_field  A fibre deformation gradient field.
+ * @return  Handle to new 3-component field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_fibre_principal_strains(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field);
+
 #ifdef __cplusplus
 }
 #endif
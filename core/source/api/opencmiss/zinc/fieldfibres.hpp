@@ -34,12 +34,80 @@ public:
 
 };
 
+class FieldFibreDeformationGradient : public Field
+{
+private:
+	// takes ownership of C handle, and responsibility for destroying it
+	explicit FieldFibreDeformationGradient(cmzn_field_id field_id) : Field(field_id)
+	{ }
+
+	friend FieldFibreDeformationGradient Fieldmodule::createFieldFibreDeformationGradient(
+		const Field& deformedCoordinateField, const Field& undeformedCoordinateField,
+		const Field& fibreField);
+
+public:
+
+	FieldFibreDeformationGradient() : Field(0)
+	{	}
+
+};
+
+class FieldFibreStrain : public Field
+{
+private:
+	// takes ownership of C handle, and responsibility for destroying it
+	explicit FieldFibreStrain(cmzn_field_id field_id) : Field(field_id)
+	{ }
+
+	friend FieldFibreStrain Fieldmodule::createFieldFibreRightCauchyGreenDeformation(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+	friend FieldFibreStrain Fieldmodule::createFieldFibreGreenLagrangeStrain(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+	friend FieldFibreStrain Fieldmodule::createFieldFibrePrincipalStrains(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+
+public:
+
+	FieldFibreStrain() : Field(0)
+	{	}
+
+};
+
 inline FieldFibreAxes Fieldmodule::createFieldFibreAxes(const Field& fibreField, const Field& coordinateField)
 {
 	return FieldFibreAxes(cmzn_fieldmodule_create_field_fibre_axes(id,
 		fibreField.getId(), coordinateField.getId()));
 }
 
+inline FieldFibreDeformationGradient Fieldmodule::createFieldFibreDeformationGradient(
+	const Field& deformedCoordinateField, const Field& undeformedCoordinateField,
+	const Field& fibreField)
+{
+	return FieldFibreDeformationGradient(cmzn_fieldmodule_create_field_fibre_deformation_gradient(id,
+		deformedCoordinateField.getId(), undeformedCoordinateField.getId(), fibreField.getId()));
+}
+
+inline FieldFibreStrain Fieldmodule::createFieldFibreRightCauchyGreenDeformation(
+	const FieldFibreDeformationGradient& fibreDeformationGradientField)
+{
+	return FieldFibreStrain(cmzn_fieldmodule_create_field_fibre_right_cauchy_green_deformation(id,
+		fibreDeformationGradientField.getId()));
+}
+
+inline FieldFibreStrain Fieldmodule::createFieldFibreGreenLagrangeStrain(
+	const FieldFibreDeformationGradient& fibreDeformationGradientField)
+{
+	return FieldFibreStrain(cmzn_fieldmodule_create_field_fibre_green_lagrange_strain(id,
+		fibreDeformationGradientField.getId()));
+}
+
+inline FieldFibreStrain Fieldmodule::createFieldFibrePrincipalStrains(
+	const FieldFibreDeformationGradient& fibreDeformationGradientField)
+{
+	return FieldFibreStrain(cmzn_fieldmodule_create_field_fibre_principal_strains(id,
+		fibreDeformationGradientField.getId()));
+}
+
 }  // namespace Zinc
 }
 
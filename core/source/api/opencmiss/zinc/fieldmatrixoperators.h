@@ -23,11 +23,11 @@ extern "C" {
 
 /**
  * Creates a field returning the scalar real determinant of a square matrix
- * source field. Only supports up to 3x3 matrix.
+ * source field. Only supports up to 4x4 matrix.
  *
  * @param field_module  Region field module which will own new field.
- * @param source_field  Field supplying square matrix up to 3x3. May only have
- * 1, 4 or 9 components.
+ * @param source_field  Field supplying square matrix up to 4x4. May only have
+ * 1, 4, 9 or 16 components.
  * @return  Handle to new field, or NULL/invalid handle on failure.
  */
 ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_determinant(
@@ -186,6 +186,33 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_mesh_integral_squares(
 	cmzn_fieldmodule_id field_module, cmzn_field_id integrand_field,
 	cmzn_field_id coordinate_field, cmzn_mesh_id mesh);
 
+/**
+ * Creates a field which integrates the integrand along paths through the mesh
+ * from the xi = 0 corner of the seed element, crossing faces of 2-D and 3-D
+ * elements and nodes of 1-D elements. Each element is reached along its
+ * shortest path, measured by the change in integrated values, and only
+ * elements whose paths pass through changed nodes or elements are
+ * recalculated after edits. Adding or removing elements recalculates all.
+ * Evaluated at element locations, and at nodes of line elements.
+ *
+ * @param field_module  Region field module which will own the new field.
+ * @param integrand_field  Scalar field to integrate.
+ * @param coordinate_field  Field supplying coordinates. Its derivatives with
+ * respect to xi give the arc length differentials.
+ * @param mesh  The mesh to integrate over, containing the seed element.
+ * @param seed_element  Element integrated from, with zero value at its xi = 0
+ * corner.
+ * @param magnitude_coordinates  If true, the field has a single component
+ * integrated with respect to the magnitude of the coordinate field
+ * derivatives. If false, it has the same number of components as the
+ * coordinate field, each integrated with respect to that coordinate.
+ * @return  Handle to new field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_integration(
+	cmzn_fieldmodule_id field_module, cmzn_field_id integrand_field,
+	cmzn_field_id coordinate_field, cmzn_mesh_id mesh,
+	cmzn_element_id seed_element, bool magnitude_coordinates);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,6 +87,23 @@ public:
 };
 
 
+class FieldIntegration : public Field
+{
+private:
+	// takes ownership of C handle, responsibility for destroying it
+	explicit FieldIntegration(cmzn_field_id field_id) : Field(field_id)
+	{	}
+
+	friend FieldIntegration Fieldmodule::createFieldIntegration(const Field& integrandField,
+		const Field& coordinateField, const Mesh& mesh, const Element& seedElement,
+		bool magnitudeCoordinates);
+
+public:
+
+	FieldIntegration() : Field(0)
+	{	}
+};
+
 inline FieldMeshIntegral Fieldmodule::createFieldMeshIntegral(
 	const Field& integrandField, const Field& coordinateField, const Mesh& mesh)
 {
@@ -108,6 +125,15 @@ inline FieldMeshIntegralSquares Fieldmodule::createFieldMeshIntegralSquares(
 		coordinateField.getId(), mesh.getId())));
 }
 
+inline FieldIntegration Fieldmodule::createFieldIntegration(const Field& integrandField,
+	const Field& coordinateField, const Mesh& mesh, const Element& seedElement,
+	bool magnitudeCoordinates)
+{
+	return FieldIntegration(cmzn_fieldmodule_create_field_integration(id,
+		integrandField.getId(), coordinateField.getId(), mesh.getId(),
+		seedElement.getId(), magnitudeCoordinates));
+}
+
 }  // namespace Zinc
 }
 
@@ -43,6 +43,8 @@ class FieldStringConstant;
 class FieldCoordinateTransformation;
 class FieldVectorCoordinateTransformation;
 class FieldFibreAxes;
+class FieldFibreDeformationGradient;
+class FieldFibreStrain;
 class FieldFiniteElement;
 class FieldEdgeDiscontinuity;
 class FieldEmbedded;
@@ -71,12 +73,14 @@ class FieldProjection;
 class FieldTranspose;
 class FieldMeshIntegral;
 class FieldMeshIntegralSquares;
+class FieldIntegration;
 class FieldNodesetSum;
 class FieldNodesetMean;
 class FieldNodesetSumSquares;
 class FieldNodesetMeanSquares;
 class FieldNodesetMinimum;
 class FieldNodesetMaximum;
+class FieldFindNearestNode;
 class FieldElementGroup;
 class FieldNodeGroup;
 class FieldTimeLookup;
@@ -294,6 +298,19 @@ public:
 
 	inline FieldFibreAxes createFieldFibreAxes(const Field& fibreField, const Field& coordinateField);
 
+	inline FieldFibreDeformationGradient createFieldFibreDeformationGradient(
+		const Field& deformedCoordinateField, const Field& undeformedCoordinateField,
+		const Field& fibreField);
+
+	inline FieldFibreStrain createFieldFibreRightCauchyGreenDeformation(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+
+	inline FieldFibreStrain createFieldFibreGreenLagrangeStrain(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+
+	inline FieldFibreStrain createFieldFibrePrincipalStrains(
+		const FieldFibreDeformationGradient& fibreDeformationGradientField);
+
 	inline FieldFiniteElement createFieldFiniteElement(int numberOfComponents);
 
 	inline FieldEmbedded createFieldEmbedded(const Field& sourceField, const Field& embeddedLocationField);
@@ -357,6 +374,10 @@ public:
 	inline FieldMeshIntegralSquares createFieldMeshIntegralSquares(const Field& integrandField,
 		const Field& coordinateField, const Mesh& mesh);
 
+	inline FieldIntegration createFieldIntegration(const Field& integrandField,
+		const Field& coordinateField, const Mesh& mesh, const Element& seedElement,
+		bool magnitudeCoordinates);
+
 	inline FieldNodesetSum createFieldNodesetSum(const Field& sourceField, const Nodeset& nodeset);
 
 	inline FieldNodesetMean createFieldNodesetMean(const Field& sourceField, const Nodeset& nodeset);
@@ -369,6 +390,9 @@ public:
 
 	inline FieldNodesetMaximum createFieldNodesetMaximum(const Field& sourceField, const Nodeset& nodeset);
 
+	inline FieldFindNearestNode createFieldFindNearestNode(const Field& sourceField,
+		const Field& coordinateField, const Nodeset& nodeset);
+
 	inline FieldNodeGroup createFieldNodeGroup(const Nodeset& nodeset);
 
 	inline FieldElementGroup createFieldElementGroup(const Mesh& mesh);
@@ -11,8 +11,11 @@
 #ifndef CMZN_FIELDNODESETOPERATORS_H__
 #define CMZN_FIELDNODESETOPERATORS_H__
 
+#include "types/fieldcacheid.h"
 #include "types/fieldid.h"
 #include "types/fieldmoduleid.h"
+#include "types/fieldnodesetoperatorsid.h"
+#include "types/nodeid.h"
 #include "types/nodesetid.h"
 
 #include "opencmiss/zinc/zincsharedobject.h"
@@ -112,6 +115,106 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_nodeset_maximum(
 	cmzn_fieldmodule_id field_module, cmzn_field_id source_field,
 	cmzn_nodeset_id nodeset);
 
+/**
+ * Creates a field which finds the node in the nodeset whose coordinate field
+ * value is nearest to the value of the source field, and returns the
+ * coordinate field value at that node. Only nodes at which the coordinate
+ * field is defined are considered; the field is undefined if there are none.
+ * Nodes are indexed by coordinate field values on first evaluation at each
+ * time, and indexed again after the nodeset or coordinate field change.
+ *
+ * @param field_module  Region field module which will own new field.
+ * @param source_field  Field giving location to find the nearest node to.
+ * @param coordinate_field  Field giving locations of nodes in the nodeset.
+ * Must have the same number of components as the source field, from 1 to 3.
+ * @param nodeset  The set of nodes to search.
+ * @return  Handle to new field, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_find_nearest_node(
+	cmzn_fieldmodule_id field_module, cmzn_field_id source_field,
+	cmzn_field_id coordinate_field, cmzn_nodeset_id nodeset);
+
+/**
+ * If the field is of type find_nearest_node then this function returns the
+ * derived find_nearest_node field handle.
+ *
+ * @param field  The field to be cast.
+ * @return  Handle to derived find_nearest_node field, or NULL/invalid handle
+ * if wrong type or failed.
+ */
+ZINC_API cmzn_field_find_nearest_node_id cmzn_field_cast_find_nearest_node(
+	cmzn_field_id field);
+
+/**
+ * Cast find_nearest_node field back to its base field and return the field.
+ * IMPORTANT NOTE: Returned field does not have incremented reference count and
+ * must not be destroyed. Use cmzn_field_access() to add a reference if
+ * maintaining returned handle beyond the lifetime of the derived field.
+ * Use this function to call base-class API, e.g.:
+ * cmzn_field_set_name(cmzn_field_find_nearest_node_base_cast(field), "bob");
+ *
+ * @param find_nearest_node_field  Handle to the find_nearest_node field to
+ * cast.
+ * @return  Non-accessed handle to the base field or NULL if failed.
+ */
+ZINC_C_INLINE cmzn_field_id cmzn_field_find_nearest_node_base_cast(
+	cmzn_field_find_nearest_node_id find_nearest_node_field)
+{
+	return (cmzn_field_id)(find_nearest_node_field);
+}
+
+/**
+ * Destroys handle to the find_nearest_node field and sets it to NULL.
+ * Internally this decrements the reference count.
+ *
+ * @param find_nearest_node_field_address  Address of handle to the field to
+ * destroy.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_find_nearest_node_destroy(
+	cmzn_field_find_nearest_node_id *find_nearest_node_field_address);
+
+/**
+ * Returns the nodeset the find_nearest_node field searches.
+ *
+ * @param find_nearest_node_field  The field to query.
+ * @return  Handle to nodeset, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_nodeset_id cmzn_field_find_nearest_node_get_nodeset(
+	cmzn_field_find_nearest_node_id find_nearest_node_field);
+
+/**
+ * Finds the node in the field's nodeset with coordinate field value nearest
+ * to the source field value at the location in the field cache.
+ *
+ * @param find_nearest_node_field  The field to evaluate.
+ * @param cache  Store of location to evaluate at and intermediate field
+ * values. Must be from the same region as the field.
+ * @return  Handle to nearest node, or NULL/invalid handle if none found or
+ * failed.
+ */
+ZINC_API cmzn_node_id cmzn_field_find_nearest_node_evaluate_node(
+	cmzn_field_find_nearest_node_id find_nearest_node_field,
+	cmzn_fieldcache_id cache);
+
+/**
+ * Adds to the nodeset group all nodes in the field's nodeset with coordinate
+ * field value within a distance of the source field value at the location in
+ * the field cache. Nodes already in the group are not an error.
+ *
+ * @param find_nearest_node_field  The field to evaluate.
+ * @param cache  Store of location to evaluate at and intermediate field
+ * values. Must be from the same region as the field.
+ * @param distance  Non-negative distance to find nodes within.
+ * @param nodeset_group  Group to add nodes to. Must have the same master
+ * nodeset as the field's nodeset.
+ * @return  Status CMZN_OK on success, otherwise any other error code.
+ */
+ZINC_API int cmzn_field_find_nearest_node_add_nodes_within_distance(
+	cmzn_field_find_nearest_node_id find_nearest_node_field,
+	cmzn_fieldcache_id cache, double distance,
+	cmzn_nodeset_group_id nodeset_group);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,8 +11,10 @@
 
 #include "opencmiss/zinc/fieldnodesetoperators.h"
 #include "opencmiss/zinc/field.hpp"
+#include "opencmiss/zinc/fieldcache.hpp"
 #include "opencmiss/zinc/fieldmodule.hpp"
 #include "opencmiss/zinc/node.hpp"
+#include "opencmiss/zinc/nodeset.hpp"
 
 namespace OpenCMISS
 {
@@ -120,6 +122,39 @@ public:
 
 };
 
+class FieldFindNearestNode : public Field
+{
+public:
+
+	FieldFindNearestNode() : Field(0)
+	{	}
+
+	// takes ownership of C handle, responsibility for destroying it
+	explicit FieldFindNearestNode(cmzn_field_find_nearest_node_id field_find_nearest_node_id) :
+		Field(reinterpret_cast<cmzn_field_id>(field_find_nearest_node_id))
+	{	}
+
+	Nodeset getNodeset()
+	{
+		return Nodeset(cmzn_field_find_nearest_node_get_nodeset(
+			reinterpret_cast<cmzn_field_find_nearest_node_id>(id)));
+	}
+
+	Node evaluateNode(const Fieldcache& cache)
+	{
+		return Node(cmzn_field_find_nearest_node_evaluate_node(
+			reinterpret_cast<cmzn_field_find_nearest_node_id>(id), cache.getId()));
+	}
+
+	int addNodesWithinDistance(const Fieldcache& cache, double distance,
+		const NodesetGroup& nodesetGroup)
+	{
+		return cmzn_field_find_nearest_node_add_nodes_within_distance(
+			reinterpret_cast<cmzn_field_find_nearest_node_id>(id), cache.getId(),
+			distance, nodesetGroup.getId());
+	}
+};
+
 inline FieldNodesetSum Fieldmodule::createFieldNodesetSum(const Field& sourceField, const Nodeset& nodeset)
 {
 	return FieldNodesetSum(cmzn_fieldmodule_create_field_nodeset_sum(id,
@@ -160,6 +195,19 @@ inline FieldNodesetMaximum Fieldmodule::createFieldNodesetMaximum(
 		sourceField.getId(), nodeset.getId()));
 }
 
+inline FieldFindNearestNode Fieldmodule::createFieldFindNearestNode(
+	const Field& sourceField, const Field& coordinateField, const Nodeset& nodeset)
+{
+	return FieldFindNearestNode(reinterpret_cast<cmzn_field_find_nearest_node_id>(
+		cmzn_fieldmodule_create_field_find_nearest_node(id, sourceField.getId(),
+			coordinateField.getId(), nodeset.getId())));
+}
+
+inline FieldFindNearestNode Field::castFindNearestNode()
+{
+	return FieldFindNearestNode(cmzn_field_cast_find_nearest_node(id));
+}
+
 }  // namespace Zinc
 }
 
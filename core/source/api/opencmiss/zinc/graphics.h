@@ -633,6 +633,34 @@ ZINC_API int cmzn_graphics_contours_set_range_isovalues(
 	cmzn_graphics_contours_id contours, int number_of_isovalues,
 	double first_isovalue, double last_isovalue);
 
+/**
+ * Gets flag controlling whether iso-surfaces share vertices between
+ * neighbouring elements.
+ * @see cmzn_graphics_contours_set_welded
+ *
+ * @param contours  The contours graphics to query.
+ * @return  Boolean true if welded, otherwise false.
+ */
+ZINC_API bool cmzn_graphics_contours_is_welded(
+	cmzn_graphics_contours_id contours);
+
+/**
+ * Sets flag controlling whether iso-surfaces share vertices between
+ * neighbouring elements. Welded iso-surfaces are indexed meshes with no cracks
+ * between elements, and normals averaged over all triangles sharing each
+ * vertex for smooth shading. Vertices are matched by coordinates on element
+ * boundaries within a small tolerance relative to element size. Welded
+ * contours are fully rebuilt on any change. Only affects 3-D elements;
+ * default is false.
+ *
+ * @param contours  The contours graphics to modify.
+ * @param welded  Boolean true to weld iso-surfaces, false to give each
+ * element separate vertices.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_contours_set_welded(
+	cmzn_graphics_contours_id contours, bool welded);
+
 /**
  * If the graphics is of type lines then this function returns
  * the derived lines graphics handle.
@@ -808,6 +836,30 @@ ZINC_API int cmzn_graphics_streamlines_set_track_direction(
 	cmzn_graphics_streamlines_id streamlines,
 	enum cmzn_graphics_streamlines_track_direction track_direction);
 
+/**
+ * Gets the scheme used to integrate the path of streamlines.
+ *
+ * @param streamlines  The streamlines graphics to query.
+ * @return  The current integration method, or
+ * CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID on error.
+ */
+ZINC_API enum cmzn_graphics_streamlines_integration_method
+	cmzn_graphics_streamlines_get_integration_method(
+		cmzn_graphics_streamlines_id streamlines);
+
+/**
+ * Sets the scheme used to integrate the path of streamlines. Default is
+ * CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER.
+ * @see cmzn_graphics_streamlines_integration_method
+ *
+ * @param streamlines  The streamlines graphics to modify.
+ * @param integration_method  The new integration method.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_streamlines_set_integration_method(
+	cmzn_graphics_streamlines_id streamlines,
+	enum cmzn_graphics_streamlines_integration_method integration_method);
+
 /**
  * Gets the maximum length of time streamlines are tracked along.
  *
@@ -385,6 +385,16 @@ public:
 			numberOfValues, firstIsovalue, lastIsovalue);
 	}
 
+	bool isWelded()
+	{
+		return cmzn_graphics_contours_is_welded(this->getDerivedId());
+	}
+
+	int setWelded(bool welded)
+	{
+		return cmzn_graphics_contours_set_welded(this->getDerivedId(), welded);
+	}
+
 };
 
 class GraphicsLines : public Graphics
@@ -448,6 +458,13 @@ public:
 		TRACK_DIRECTION_REVERSE = CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE
 	};
 
+	enum IntegrationMethod
+	{
+		INTEGRATION_METHOD_INVALID = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID,
+		INTEGRATION_METHOD_IMPROVED_EULER = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER,
+		INTEGRATION_METHOD_DORMAND_PRINCE = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_DORMAND_PRINCE
+	};
+
 	ColourDataType getColourDataType()
 	{
 		return static_cast<ColourDataType>(cmzn_graphics_streamlines_get_colour_data_type(this->getDerivedId()));
@@ -481,6 +498,18 @@ public:
 			static_cast<cmzn_graphics_streamlines_track_direction>(trackDirection));
 	}
 
+	IntegrationMethod getIntegrationMethod()
+	{
+		return static_cast<IntegrationMethod>(
+			cmzn_graphics_streamlines_get_integration_method(this->getDerivedId()));
+	}
+
+	int setIntegrationMethod(IntegrationMethod integrationMethod)
+	{
+		return cmzn_graphics_streamlines_set_integration_method(this->getDerivedId(),
+			static_cast<cmzn_graphics_streamlines_integration_method>(integrationMethod));
+	}
+
 	double getTrackLength()
 	{
 		return cmzn_graphics_streamlines_get_track_length(this->getDerivedId());
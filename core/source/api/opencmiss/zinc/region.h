@@ -290,6 +290,10 @@ ZINC_API cmzn_region_id cmzn_region_create_subregion(cmzn_region_id top_region,
 /**
  * Reads region data using stream resource objects provided in the
  * stream information object.
+ * Large uncompressed files are mapped into memory and read in place, and
+ * files may be read on demand after this returns: such files must remain
+ * unchanged until reading is complete. Truncating a file while it is mapped
+ * raises SIGBUS, terminating the process.
  * @see cmzn_streaminformation_id
  *
  * @param region  The region to read the resources in streaminformation into.
@@ -312,6 +316,21 @@ ZINC_API int cmzn_region_read(cmzn_region_id region,
  */
 ZINC_API int cmzn_region_read_file(cmzn_region_id region, const char *file_name);
 
+/**
+ * Reads any content deferred by a load on demand read into this region, and
+ * returns the result of loading it. Deferred content is otherwise read when
+ * the region's fieldmodule is first obtained, which cannot report failure;
+ * call this to find whether it was read successfully. Does not load
+ * subregions.
+ * @see cmzn_streaminformation_region_set_load_on_demand
+ *
+ * @param region  The region to load.
+ * @return  Status CMZN_OK if the region has no deferred content or it was
+ * read successfully, otherwise the error from reading it, which is returned
+ * again by all later calls.
+ */
+ZINC_API int cmzn_region_load(cmzn_region_id region);
+
 /**
  * Writes region data to stream resource objects described in the
  * stream information object.
@@ -109,6 +109,11 @@ public:
 		return cmzn_region_read_file(id, fileName);
 	}
 
+	int load()
+	{
+		return cmzn_region_load(id);
+	}
+
 	char *getName()
 	{
 		return cmzn_region_get_name(id);
@@ -303,6 +303,9 @@ ZINC_API enum cmzn_streaminformation_data_compression_type cmzn_streaminformatio
 
 /**
  * Specify the data compression of the streamresource in the streaminformation.
+ * On writing, only GZIP compression of EX format file resources is supported;
+ * writing any other compressed resource fails.
+ * @see cmzn_streaminformation_region_set_compression_level
  *
  * @param streaminformation  Handle to the stream information.
  * @param data_compression_type  enum to indicate the compression used in the resources
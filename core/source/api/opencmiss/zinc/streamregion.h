@@ -202,6 +202,88 @@ ZINC_API int cmzn_streaminformation_region_set_file_format(
 	cmzn_streaminformation_region_id streaminformation,
 	enum cmzn_streaminformation_region_file_format file_format);
 
+/**
+ * Gets how bulk array data is written with FieldML file format.
+ *
+ * @param streaminformation  The region stream information object.
+ * @return  The FieldML data format, or FIELDML_DATA_FORMAT_INVALID on failure.
+ */
+ZINC_API enum cmzn_streaminformation_region_fieldml_data_format
+	cmzn_streaminformation_region_get_fieldml_data_format(
+		cmzn_streaminformation_region_id streaminformation);
+
+/**
+ * Specifies how bulk array data including node parameters and element
+ * connectivity is written with FieldML file format. Writing large models to
+ * external HDF5 arrays keeps the FieldML document small and is much faster to
+ * write and read back than inline text. Has no effect on reading, where the
+ * format is determined by the document.
+ *
+ * @param streaminformation  The region stream information object.
+ * @param fieldml_data_format  The FieldML data format.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_streaminformation_region_set_fieldml_data_format(
+	cmzn_streaminformation_region_id streaminformation,
+	enum cmzn_streaminformation_region_fieldml_data_format fieldml_data_format);
+
+/**
+ * Get the compression level used when writing gzip compressed files.
+ *
+ * @param streaminformation  The region stream information object.
+ * @return  The compression level from 0 to 9, or -1 for the default level or
+ * on invalid argument.
+ */
+ZINC_API int cmzn_streaminformation_region_get_compression_level(
+	cmzn_streaminformation_region_id streaminformation);
+
+/**
+ * Set the compression level used when writing gzip compressed files. EX
+ * format files are written with gzip compression when the data compression
+ * type of the resource or stream information is GZIP. Output is compressed in
+ * blocks on multiple threads and written as a series of gzip members, which
+ * gzip and zinc read as one file. Lower levels are faster; level 1 usually
+ * compresses at disk speed. Writing bzip2 compression, or compressed FieldML
+ * or memory resources, is not supported and fails with CMZN_ERROR_ARGUMENT.
+ *
+ * @param streaminformation  The region stream information object.
+ * @param compression_level  Level from 0 (no compression) to 9 (best
+ * compression), or -1 for the zlib default, which is the initial value.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_streaminformation_region_set_compression_level(
+	cmzn_streaminformation_region_id streaminformation, int compression_level);
+
+/**
+ * Get whether region content is read from file resources when first accessed.
+ *
+ * @param streaminformation  The region stream information object.
+ * @return  Boolean true if load on demand is set, false if not or invalid
+ * argument.
+ */
+ZINC_API bool cmzn_streaminformation_region_is_load_on_demand(
+	cmzn_streaminformation_region_id streaminformation);
+
+/**
+ * Set whether region content is read from file resources when first accessed.
+ * If set, reading only scans EX format files to create the regions in them,
+ * deferring reading the nodes, elements and fields of each region until its
+ * fieldmodule is first obtained. This reduces memory use and read time when
+ * only some regions of a large model are used. Only applies to uncompressed
+ * EX format file resources; FieldML files and memory resources are always
+ * read immediately. Reading fails if a file is not in EX format or has no
+ * content. The file must not be modified or removed until all its regions
+ * have been loaded; use cmzn_region_load to check a region loaded
+ * successfully. Default is false.
+ * @see cmzn_region_load
+ *
+ * @param streaminformation  The region stream information object.
+ * @param value  The new load on demand state.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_streaminformation_region_set_load_on_demand(
+	cmzn_streaminformation_region_id streaminformation, bool value);
+
 /**
  * Get the specified domain types for a stream resource in streaminformation.
  *
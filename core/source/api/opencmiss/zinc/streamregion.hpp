@@ -54,6 +54,13 @@ public:
 		FILE_FORMAT_FIELDML = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML
 	};
 
+	enum FieldmlDataFormat
+	{
+		FIELDML_DATA_FORMAT_INVALID = CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INVALID,
+		FIELDML_DATA_FORMAT_INLINE_TEXT = CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INLINE_TEXT,
+		FIELDML_DATA_FORMAT_HDF5 = CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5
+	};
+
 	enum RecursionMode
 	{
 		RECURSION_MODE_INVALID = CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_INVALID,
@@ -114,6 +121,38 @@ public:
 			static_cast<cmzn_streaminformation_region_file_format>(fileFormat));
 	}
 
+	FieldmlDataFormat getFieldmlDataFormat()
+	{
+		return static_cast<FieldmlDataFormat>(
+			cmzn_streaminformation_region_get_fieldml_data_format(getDerivedId()));
+	}
+
+	int setFieldmlDataFormat(FieldmlDataFormat fieldmlDataFormat)
+	{
+		return cmzn_streaminformation_region_set_fieldml_data_format(getDerivedId(),
+			static_cast<cmzn_streaminformation_region_fieldml_data_format>(fieldmlDataFormat));
+	}
+
+	int getCompressionLevel()
+	{
+		return cmzn_streaminformation_region_get_compression_level(getDerivedId());
+	}
+
+	int setCompressionLevel(int compressionLevel)
+	{
+		return cmzn_streaminformation_region_set_compression_level(getDerivedId(), compressionLevel);
+	}
+
+	bool isLoadOnDemand()
+	{
+		return cmzn_streaminformation_region_is_load_on_demand(getDerivedId());
+	}
+
+	int setLoadOnDemand(bool value)
+	{
+		return cmzn_streaminformation_region_set_load_on_demand(getDerivedId(), value);
+	}
+
 	Field::DomainTypes getResourceDomainTypes(const Streamresource& resource)
 	{
 		return static_cast<Field::DomainTypes>(
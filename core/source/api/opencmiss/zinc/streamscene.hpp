@@ -52,7 +52,9 @@ public:
 	{
 		IO_FORMAT_INVALID = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_INVALID,
 		IO_FORMAT_THREEJS = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS,
-		IO_FORMAT_DESCRIPTION = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION
+		IO_FORMAT_DESCRIPTION = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION,
+		IO_FORMAT_STL_BINARY = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY,
+		IO_FORMAT_PLY_BINARY = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY
 	};
 
 	Scenefilter getScenefilter()
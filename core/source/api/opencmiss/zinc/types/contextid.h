@@ -22,4 +22,39 @@
 struct cmzn_context;
 typedef struct cmzn_context * cmzn_context_id;
 
+/**
+ * Statistics gathered on evaluation, graphics and I/O paths when Zinc is built
+ * with instrumentation. Counts are numbers of events, times are in seconds.
+ * @see cmzn_context_get_statistic
+ */
+enum cmzn_context_statistic_type
+{
+	CMZN_CONTEXT_STATISTIC_TYPE_INVALID = 0,
+	/*!< Unspecified statistic */
+	CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATIONS = 1,
+	/*!< Count of evaluations of any field */
+	CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATION_CACHE_HITS = 2,
+	/*!< Count of field evaluations using cached values for the location */
+	CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_HITS = 3,
+	/*!< Count of finite element field evaluations reusing element parameters */
+	CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_MISSES = 4,
+	/*!< Count of finite element field evaluations extracting element parameters */
+	CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_SEARCHES = 5,
+	/*!< Count of iterative searches for xi in an element */
+	CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_ITERATIONS = 6,
+	/*!< Count of Newton iterations in all find xi searches */
+	CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILDS = 7,
+	/*!< Count of builds of graphics objects for any graphics */
+	CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILD_TIME = 8,
+	/*!< Total time building graphics objects */
+	CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_BYTES = 9,
+	/*!< Bytes read from region stream resources */
+	CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_TIME = 10,
+	/*!< Total time reading region stream resources */
+	CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_BYTES = 11,
+	/*!< Bytes written to region stream resources */
+	CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_TIME = 12
+	/*!< Total time writing region stream resources */
+};
+
 #endif
@@ -0,0 +1,45 @@
+/**
+ * @file fieldderivativesid.h
+ *
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef CMZN_FIELDDERIVATIVESID_H__
+#define CMZN_FIELDDERIVATIVESID_H__
+
+/**
+ * @brief  A field calculating the gradient of a source field with respect to
+ * a coordinate field.
+ *
+ * A field calculating the gradient of a source field with respect to a
+ * coordinate field, exactly at element locations from the element Jacobian,
+ * and by a choice of approximations at nodes.
+ */
+struct cmzn_field_gradient;
+typedef struct cmzn_field_gradient *cmzn_field_gradient_id;
+
+/**
+ * Enumeration controlling how the gradient field is evaluated at nodes.
+ */
+enum cmzn_field_gradient_node_mode
+{
+	CMZN_FIELD_GRADIENT_NODE_MODE_INVALID = 0,
+	/*!< Unspecified node mode.
+	 */
+	CMZN_FIELD_GRADIENT_NODE_MODE_FINITE_DIFFERENCE = 1,
+	/*!< Central finite differences from perturbing the coordinate field at the
+	 * node. Works with any coordinate field. This is the default node mode.
+	 */
+	CMZN_FIELD_GRADIENT_NODE_MODE_ELEMENT_AVERAGE = 2
+	/*!< Average of the analytic gradients at the node in all elements of the
+	 * mesh with the same dimension as the coordinate field which use it.
+	 * Element locations of nodes are found once per time. Falls back to finite
+	 * differences at nodes not used by any such elements.
+	 */
+};
+
+#endif
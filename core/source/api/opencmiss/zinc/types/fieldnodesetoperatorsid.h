@@ -0,0 +1,25 @@
+/**
+ * @file fieldnodesetoperatorsid.h
+ *
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef CMZN_FIELDNODESETOPERATORSID_H__
+#define CMZN_FIELDNODESETOPERATORSID_H__
+
+/**
+ * @brief  A field finding the node in a nodeset nearest to a point.
+ *
+ * A field finding the node in a nodeset with coordinate field value nearest
+ * to the value of a source field, and evaluating to the coordinate field
+ * value at that node. Nodes are indexed by their coordinates for fast
+ * searches, which can also find all nodes within a distance.
+ */
+struct cmzn_field_find_nearest_node;
+typedef struct cmzn_field_find_nearest_node *cmzn_field_find_nearest_node_id;
+
+#endif
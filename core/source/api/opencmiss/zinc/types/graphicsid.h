@@ -111,6 +111,26 @@ enum cmzn_graphics_streamlines_track_direction
 	/*!< the reverse of stream_vector_field is tracked */
 };
 
+/**
+ * Enumeration giving the scheme used to integrate the path of streamlines
+ * through element xi space.
+ *
+ * @see cmzn_graphics_streamlines_set_integration_method
+ */
+enum cmzn_graphics_streamlines_integration_method
+{
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID = 0,
+	/*!< Unspecified integration method */
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER = 1,
+	/*!< Default: second order improved Euler method with step size control by
+	 * comparing full and half steps */
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_DORMAND_PRINCE = 2
+	/*!< Embedded fifth order Runge-Kutta method of Dormand and Prince with
+	 * step size control from its fourth order error estimate. Takes much larger
+	 * steps for the same accuracy, and locates element boundaries from the
+	 * continuous extension of each step. */
+};
+
 /**
  * @brief Surfaces visualise 2-D elements in the model.
  *
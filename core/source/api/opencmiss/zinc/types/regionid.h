@@ -67,6 +67,25 @@ enum cmzn_streaminformation_region_file_format
 	/*!< Latest supported FieldML format */
 };
 
+/**
+ * Describes how bulk array data, including node parameters and element
+ * connectivity, is written with FieldML format.
+ * @see cmzn_streaminformation_region_set_fieldml_data_format
+ */
+enum cmzn_streaminformation_region_fieldml_data_format
+{
+	CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INVALID = 0,
+	/*!< Invalid FieldML data format */
+	CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INLINE_TEXT = 1,
+	/*!< Arrays are written as text inline in the FieldML document. This is
+	 * the default option. */
+	CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5 = 2
+	/*!< Arrays are written as binary datasets in an external HDF5 file
+	 * referenced from the FieldML document, named as the document with its
+	 * extension replaced by .h5. Requires the FieldML API to be built with
+	 * HDF5 support. */
+};
+
 enum cmzn_streaminformation_region_recursion_mode
 {
 	CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_INVALID = 0,
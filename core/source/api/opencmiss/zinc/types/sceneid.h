@@ -57,8 +57,16 @@ enum cmzn_streaminformation_scene_io_format
 	/*!< Unspecified attribute */
 	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS = 1,
 	/*!< Export scene into ThreeJS compatible JSON file.*/
-	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION = 2
+	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION = 2,
 	/*!< Import/export scene configurations into the scene */
+	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY = 3,
+	/*!< Export surfaces in the scene as triangles in a binary STL file, with
+	 * vertices merged within a small tolerance of the scene size. Glyphs are
+	 * not exported. Write only. */
+	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY = 4
+	/*!< Export surfaces in the scene as a binary little endian PLY file of
+	 * merged vertices and triangles indexing them, in a deterministic order.
+	 * Glyphs are not exported. Write only. */
 };
 
 #endif
@@ -30,6 +30,7 @@ SET( COMPUTED_FIELD_CORE_SRCS
 	source/computed_field/differential_operator.cpp
 	source/computed_field/field_cache.cpp
 	source/computed_field/field_module.cpp
+	source/computed_field/field_tape.cpp
 	source/computed_field/fieldassignmentprivate.cpp
 	source/computed_field/fieldsmoothingprivate.cpp
 	source/computed_field/computed_field_find_xi.cpp
@@ -61,6 +62,7 @@ SET( COMPUTED_FIELD_CORE_HDRS
 	source/computed_field/differential_operator.hpp
 	source/computed_field/field_cache.hpp
 	source/computed_field/field_module.hpp
+	source/computed_field/field_tape.hpp
 	source/computed_field/fieldassignmentprivate.hpp
 	source/computed_field/fieldsmoothingprivate.hpp
 	source/computed_field/computed_field_find_xi.h
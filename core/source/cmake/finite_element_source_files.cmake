@@ -42,6 +42,7 @@ SET( FINITE_ELEMENT_GRAPHICS_SRCS
 	source/finite_element/finite_element_to_iso_surfaces.cpp
 	source/finite_element/finite_element_to_streamlines.cpp )
 SET( FINITE_ELEMENT_GRAPHICS_HDRS
+	source/finite_element/element_scalar_ranges.hpp
 	source/finite_element/finite_element_to_graphics_object.h
 	source/finite_element/finite_element_to_iso_lines.h
 	source/finite_element/finite_element_to_iso_surfaces.h
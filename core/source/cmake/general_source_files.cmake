@@ -9,6 +9,7 @@
 
 SET( GENERAL_SRCS
 	source/general/any_object.cpp
+	source/general/block_gzip_stream.cpp
 	source/general/callback.cpp
 	source/general/child_process.cpp
 	source/general/compare.cpp
@@ -17,6 +18,7 @@ SET( GENERAL_SRCS
 	source/general/geometry.cpp
 	source/general/image_utilities.cpp
 	source/general/indexed_multi_range.cpp
+	source/general/instrumentation.cpp
 	source/general/integration.cpp
 	source/general/io_stream.cpp
 	source/general/machine.cpp
@@ -38,6 +40,7 @@ SET( GENERAL_HDRS
 	source/general/any_object_private.h
 	source/general/any_object_prototype.h
 	source/general/block_array.hpp
+	source/general/block_gzip_stream.hpp
 	source/general/callback.h
 	source/general/callback_class.hpp
 	source/general/callback_private.h
@@ -57,6 +60,7 @@ SET( GENERAL_HDRS
 	source/general/indexed_list_private.h
 	source/general/indexed_list_stl_private.hpp
 	source/general/indexed_multi_range.h
+	source/general/instrumentation.hpp
 	source/general/integration.h
 	source/general/io_stream.h
 	source/general/list.h
@@ -74,10 +78,12 @@ SET( GENERAL_HDRS
 	source/general/mystring.h
 	source/general/object.h
 	source/general/octree.h
+	source/general/point_grid.hpp
 	source/general/random.h
 	source/general/refcounted.hpp
 	source/general/refhandle.hpp
 	source/general/simple_list.h
+	source/general/small_matrix.hpp
 	source/general/statistics.h
 	source/general/time.h
 	source/general/value.h
@@ -141,6 +141,8 @@ like the number of components.
 #include "region/cmiss_region_private.h"
 #include "general/message.h"
 #include "general/enumerator_conversion.hpp"
+#include <algorithm>
+#include <set>
 #include <typeinfo>
 
 /*
@@ -148,15 +150,83 @@ Module functions
 ----------------
 */
 
-/** override to set change status of fields which depend on changed fields */
+namespace {
+
+inline bool cmzn_field_dependency_level_less(cmzn_field *field1, cmzn_field *field2)
+{
+	return field1->getDependencyLevel() < field2->getDependencyLevel();
+}
+
+inline bool cmzn_field_has_changed_source_field(cmzn_field *field)
+{
+	for (int i = 0; i < field->number_of_source_fields; ++i)
+		if (MANAGER_CHANGE_NONE(Computed_field) != field->source_fields[i]->manager_change_status)
+			return true;
+	return false;
+}
+
+}
+
+/**
+ * Override to set change status of fields which depend on changed fields.
+ * Fields with non-source dependencies are checked first. Then only fields
+ * downstream of changed fields are checked, in order of dependency level so
+ * change status of their source fields is final.
+ */
 inline void MANAGER_UPDATE_DEPENDENCIES(Computed_field)(
 	struct MANAGER(Computed_field) *manager)
 {
 	cmzn_set_cmzn_field *all_fields = reinterpret_cast<cmzn_set_cmzn_field *>(manager->object_list);
+	std::vector<cmzn_field *> fieldStack;
+	// first detect changes not from source fields, e.g. to FE_fields or groups,
+	// as non-source dependencies are not in dependency order
+	std::set<cmzn_field *> nonSourceCheckedFields;
 	for (cmzn_set_cmzn_field::iterator iter = all_fields->begin(); iter != all_fields->end(); iter++)
 	{
 		cmzn_field_id field = *iter;
-		field->core->check_dependency();
+		if (field->core->has_non_source_dependencies())
+		{
+			if (MANAGER_CHANGE_NONE(Computed_field) != field->core->check_dependency())
+				fieldStack.push_back(field);
+			nonSourceCheckedFields.insert(field);
+		}
+	}
+	cmzn_set_cmzn_field *changed_fields = reinterpret_cast<cmzn_set_cmzn_field *>(manager->changed_object_list);
+	for (cmzn_set_cmzn_field::iterator iter = changed_fields->begin(); iter != changed_fields->end(); iter++)
+		fieldStack.push_back(*iter);
+	// gather fields downstream of these
+	std::set<cmzn_field *> visitedFields;
+	std::vector<cmzn_field *> checkFields;
+	while (!fieldStack.empty())
+	{
+		cmzn_field *field = fieldStack.back();
+		fieldStack.pop_back();
+		if (!visitedFields.insert(field).second)
+			continue;
+		checkFields.push_back(field);
+		if (field->dependentFields)
+		{
+			for (std::vector<cmzn_field *>::iterator iter = field->dependentFields->begin();
+				iter != field->dependentFields->end(); ++iter)
+			{
+				// skip temporary fields not in manager
+				if ((*iter)->manager == manager)
+					fieldStack.push_back(*iter);
+			}
+		}
+	}
+	std::sort(checkFields.begin(), checkFields.end(), cmzn_field_dependency_level_less);
+	for (std::vector<cmzn_field *>::iterator iter = checkFields.begin(); iter != checkFields.end(); ++iter)
+	{
+		cmzn_field_id field = *iter;
+		// fields checked above only need checking again if a source field
+		// changed, as its change status may not have been final then
+		if ((0 == nonSourceCheckedFields.count(field)) || cmzn_field_has_changed_source_field(field))
+			field->core->check_dependency();
+		// compiled tapes embed definitions and constant values of all fields
+		// used, but not values of inputs which only give partial changes
+		if (field->manager_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field))
+			field->clearTape();
 	}
 }
 
@@ -195,12 +265,14 @@ then set values - that way the field will never be left in an invalid state.
 	ENTER(Computed_field_clear_type);
 	if (field)
 	{
+		field->clearTape();
 		delete field->core;
 
 		if (field->source_fields)
 		{
 			for (i=0;i< field->number_of_source_fields;i++)
 			{
+				field->source_fields[i]->removeDependentField(field);
 				DEACCESS(Computed_field)(&(field->source_fields[i]));
 			}
 			DEALLOCATE(field->source_fields);
@@ -298,6 +370,15 @@ COMPUTED_FIELD_INVALID with no components.
 			field->manager_change_status = MANAGER_CHANGE_NONE(Computed_field);
 
 			field->attribute_flags = 0;
+
+			field->tape = 0;
+			field->tapeCompiled = false;
+			field->dependentFields = 0;
+			field->dependencyLevel = 0;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+			field->evaluationsCount = 0;
+			field->evaluationCacheHitsCount = 0;
+#endif
 		}
 		else
 		{
@@ -338,6 +419,7 @@ Frees memory/deaccess objects in computed_field at <*field_address>.
 			}
 			DEALLOCATE(field->name);
 			Computed_field_clear_type(field);
+			delete field->dependentFields;
 			DEALLOCATE(*field_address);
 			return_code=1;
 		}
@@ -587,6 +669,7 @@ int Computed_field_copy_type_specific(
 			for (int i = 0; i < source->number_of_source_fields; i++)
 			{
 				source_fields[i] = ACCESS(Computed_field)(source->source_fields[i]);
+				source_fields[i]->addDependentField(destination);
 			}
 			destination->source_fields = source_fields;
 			destination->number_of_source_values = source->number_of_source_values;
@@ -977,6 +1060,7 @@ Computed_field *Computed_field_create_generic(
 						for (int i = 0; i < number_of_source_fields; i++)
 						{
 							field->source_fields[i] = ACCESS(Computed_field)(source_fields[i]);
+							field->source_fields[i]->addDependentField(field);
 						}
 					}
 					else
@@ -1088,15 +1172,138 @@ void cmzn_field::clearCaches()
 	// some fields (integration, histogram) still have caches in field itself to clear:
 	core->clear_cache();
 	cmzn_region_id region = this->manager->owner;
-	cmzn_set_cmzn_field *all_fields = reinterpret_cast<cmzn_set_cmzn_field *>(this->manager->object_list);
-	for (cmzn_set_cmzn_field::iterator iter = all_fields->begin(); iter != all_fields->end(); iter++)
+	// visit only this field and fields downstream of it through dependentFields
+	std::set<cmzn_field *> visitedFields;
+	std::vector<cmzn_field *> fieldStack(1, this);
+	visitedFields.insert(this);
+	while (!fieldStack.empty())
+	{
+		cmzn_field *field = fieldStack.back();
+		fieldStack.pop_back();
+		// unmanaged fields have no value caches
+		if (field->manager == this->manager)
+			cmzn_region_clear_field_value_caches(region, field);
+		if (field->dependentFields)
+		{
+			for (std::vector<cmzn_field *>::iterator iter = field->dependentFields->begin();
+				iter != field->dependentFields->end(); ++iter)
+			{
+				if (visitedFields.insert(*iter).second)
+					fieldStack.push_back(*iter);
+			}
+		}
+	}
+}
+
+void cmzn_field::addDependentField(cmzn_field *dependentField)
+{
+	if (!this->dependentFields)
+		this->dependentFields = new std::vector<cmzn_field *>();
+	this->dependentFields->push_back(dependentField);
+	dependentField->invalidateDependencyLevel();
+}
+
+void cmzn_field::removeDependentField(cmzn_field *dependentField)
+{
+	if (this->dependentFields)
 	{
-		cmzn_field_id field = *iter;
-		if (field->dependsOnField(this))
+		std::vector<cmzn_field *>::iterator iter =
+			std::find(this->dependentFields->begin(), this->dependentFields->end(), dependentField);
+		if (iter != this->dependentFields->end())
+			this->dependentFields->erase(iter);
+	}
+	dependentField->invalidateDependencyLevel();
+}
+
+void cmzn_field::invalidateDependencyLevel()
+{
+	// fields downstream of an invalid level are always invalid
+	if (this->dependencyLevel < 0)
+		return;
+	std::vector<cmzn_field *> fieldStack(1, this);
+	this->dependencyLevel = -1;
+	while (!fieldStack.empty())
+	{
+		cmzn_field *field = fieldStack.back();
+		fieldStack.pop_back();
+		if (field->dependentFields)
 		{
-			cmzn_region_clear_field_value_caches(region, field);
+			for (std::vector<cmzn_field *>::iterator iter = field->dependentFields->begin();
+				iter != field->dependentFields->end(); ++iter)
+			{
+				if ((*iter)->dependencyLevel >= 0)
+				{
+					(*iter)->dependencyLevel = -1;
+					fieldStack.push_back(*iter);
+				}
+			}
+		}
+	}
+}
+
+bool cmzn_field::dependsOnField(cmzn_field *otherField)
+{
+	if (this == otherField)
+		return true;
+	// only fields with higher dependency level can depend on otherField
+	const int otherLevel = otherField->getDependencyLevel();
+	if (this->getDependencyLevel() <= otherLevel)
+		return false;
+	std::set<cmzn_field *> visitedFields;
+	std::vector<cmzn_field *> fieldStack(1, this);
+	while (!fieldStack.empty())
+	{
+		cmzn_field *field = fieldStack.back();
+		fieldStack.pop_back();
+		for (int i = 0; i < field->number_of_source_fields; ++i)
+		{
+			cmzn_field *sourceField = field->source_fields[i];
+			if (sourceField == otherField)
+				return true;
+			if ((sourceField->getDependencyLevel() > otherLevel) &&
+				visitedFields.insert(sourceField).second)
+				fieldStack.push_back(sourceField);
 		}
 	}
+	return false;
+}
+
+FieldTape *cmzn_field::getTape()
+{
+	// tapes may be out of date until changes are propagated
+	if ((!this->manager) || (0 != this->manager->cache))
+		return 0;
+	if (!this->tapeCompiled)
+	{
+		this->tape = FieldTape::create(this);
+		this->tapeCompiled = true;
+	}
+	return this->tape;
+}
+
+void cmzn_field::clearTape()
+{
+	delete this->tape;
+	this->tape = 0;
+	this->tapeCompiled = false;
+}
+
+RealFieldValueCache *cmzn_field::evaluateTapeWithDerivatives(cmzn_fieldcache& cache)
+{
+	FieldTape *fieldTape = this->getTape();
+	if (!fieldTape)
+		return 0;
+	RealFieldValueCache *valueCache = RealFieldValueCache::cast(this->getValueCache(cache));
+	if ((valueCache->evaluationCounter < cache.getLocationCounter()) ||
+		(!valueCache->hasDerivatives()))
+	{
+		if (!fieldTape->evaluateWithDerivatives(cache, valueCache->values, valueCache->derivatives))
+			return 0;
+		valueCache->derivatives_valid = 1;
+		// tape is only available when manager is not caching changes
+		valueCache->evaluationCounter = cache.getLocationCounter();
+	}
+	return valueCache;
 }
 
 int Computed_field_is_defined_in_element(struct Computed_field *field,
@@ -1150,9 +1357,9 @@ char *Computed_field_core::getComponentName(int componentNumber) const
 	return duplicate_string(name);
 }
 
-FieldValueCache *Computed_field_core::createValueCache(cmzn_fieldcache& /*parentCache*/)
+FieldValueCache *Computed_field_core::createValueCache(cmzn_fieldcache& parentCache)
 {
-	return new RealFieldValueCache(field->number_of_components);
+	return new RealFieldValueCache(parentCache, field->number_of_components);
 }
 
 /** @return  true if all source fields are defined at cache location */
@@ -2584,12 +2791,15 @@ int Computed_field::setOptionalSourceField(int index, Computed_field *sourceFiel
 				if (!tmp)
 					return CMZN_ERROR_MEMORY;
 				tmp[index - 1] = ACCESS(Computed_field)(sourceField);
+				sourceField->addDependentField(this);
 				this->source_fields = tmp;
 				++(this->number_of_source_fields);
 				Computed_field_changed(this);
 			}
 			else if (sourceField != this->source_fields[index - 1])
 			{
+				sourceField->addDependentField(this);
+				this->source_fields[index - 1]->removeDependentField(this);
 				REACCESS(Computed_field)(&(this->source_fields[index - 1]), sourceField);
 				Computed_field_changed(this);
 			}
@@ -2598,6 +2808,7 @@ int Computed_field::setOptionalSourceField(int index, Computed_field *sourceFiel
 		{
 			if (index == this->number_of_source_fields)
 			{
+				this->source_fields[index - 1]->removeDependentField(this);
 				DEACCESS(Computed_field)(&(this->source_fields[index - 1]));
 				--(this->number_of_source_fields);
 				Computed_field_changed(this);
@@ -2616,7 +2827,7 @@ int Computed_field_core::check_dependency()
 		{
 			for (int i = 0; i < field->number_of_source_fields; i++)
 			{
-				int source_change_status = field->source_fields[i]->core->check_dependency();
+				const int source_change_status = field->source_fields[i]->manager_change_status;
 				if (source_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field))
 				{
 					field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
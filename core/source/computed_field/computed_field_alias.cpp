@@ -94,7 +94,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		cmzn_region_id otherRegion = Computed_field_get_region(getSourceField(0));
 		if (otherRegion != Computed_field_get_region(field))
 		{
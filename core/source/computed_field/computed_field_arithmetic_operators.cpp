@@ -67,6 +67,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_POWER, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -97,16 +102,19 @@ int Computed_field_power::evaluate(cmzn_fieldcache& cache, FieldValueCache& inVa
 				{
 					/* d(u^v)/dx =
 					 *   v * u^(v-1) * du/dx   +   u^v * ln(u) * dv/dx
+					 * omitting second term if dv/dx is zero so negative u is valid
 					 */
 					*derivative =
 						source2Cache->values[i] *
 						(FE_value)pow((double)(source1Cache->values[i]),
 							(double)(source2Cache->values[i]-1)) *
-							source1Cache->derivatives[i * number_of_xi + j] +
-						(FE_value)pow((double)(source1Cache->values[i]),
-							(double)(source2Cache->values[i])) *
-						(FE_value)log((double)(source1Cache->values[i])) *
-						source2Cache->derivatives[i * number_of_xi + j];
+							source1Cache->derivatives[i * number_of_xi + j];
+					if (source2Cache->derivatives[i * number_of_xi + j] != 0.0)
+					{
+						*derivative += valueCache.values[i] *
+							(FE_value)log((double)(source1Cache->values[i])) *
+							source2Cache->derivatives[i * number_of_xi + j];
+					}
 					derivative++;
 				}
 			}
@@ -308,6 +316,19 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_MULTIPLY, componentRegisters);
+	}
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -353,6 +374,23 @@ int Computed_field_multiply_components::evaluate(cmzn_fieldcache& cache, FieldVa
 	return 0;
 }
 
+bool Computed_field_multiply_components::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	std::vector<FE_value> source2Values;
+	std::vector<char> source2Defined;
+	if (!(getSourceField(0)->core->evaluateAtNodes(time, nodeCount, nodes, values, defined)
+		&& evaluateSourceFieldAtNodes(1, time, nodeCount, nodes, source2Values, source2Defined)))
+		return false;
+	const FE_value *source2 = source2Values.data();
+	const int valuesCount = field->number_of_components*nodeCount;
+	for (int i = 0; i < valuesCount; ++i)
+		values[i] *= source2[i];
+	for (int n = 0; n < nodeCount; ++n)
+		defined[n] &= source2Defined[n];
+	return true;
+}
+
 int Computed_field_multiply_components::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -539,6 +577,19 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_DIVIDE, componentRegisters);
+	}
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -587,6 +638,23 @@ int Computed_field_divide_components::evaluate(cmzn_fieldcache& cache, FieldValu
 	return 0;
 }
 
+bool Computed_field_divide_components::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	std::vector<FE_value> source2Values;
+	std::vector<char> source2Defined;
+	if (!(getSourceField(0)->core->evaluateAtNodes(time, nodeCount, nodes, values, defined)
+		&& evaluateSourceFieldAtNodes(1, time, nodeCount, nodes, source2Values, source2Defined)))
+		return false;
+	const FE_value *source2 = source2Values.data();
+	const int valuesCount = field->number_of_components*nodeCount;
+	for (int i = 0; i < valuesCount; ++i)
+		values[i] /= source2[i];
+	for (int n = 0; n < nodeCount; ++n)
+		defined[n] &= source2Defined[n];
+	return true;
+}
+
 int Computed_field_divide_components::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -777,6 +845,16 @@ private:
 
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -819,6 +897,47 @@ int Computed_field_add::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValu
 	return 0;
 }
 
+bool Computed_field_add::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	std::vector<FE_value> source2Values;
+	std::vector<char> source2Defined;
+	if (!(getSourceField(0)->core->evaluateAtNodes(time, nodeCount, nodes, values, defined)
+		&& evaluateSourceFieldAtNodes(1, time, nodeCount, nodes, source2Values, source2Defined)))
+		return false;
+	const FE_value scale1 = field->source_values[0];
+	const FE_value scale2 = field->source_values[1];
+	const FE_value *source2 = source2Values.data();
+	const int valuesCount = field->number_of_components*nodeCount;
+	for (int i = 0; i < valuesCount; ++i)
+		values[i] = scale1*values[i] + scale2*source2[i];
+	for (int n = 0; n < nodeCount; ++n)
+		defined[n] &= source2Defined[n];
+	return true;
+}
+
+bool Computed_field_add::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *source1Registers = compiler.compileField(getSourceField(0));
+	const int *source2Registers = compiler.compileField(getSourceField(1));
+	if (!(source1Registers && source2Registers))
+		return false;
+	const int weight1 = compiler.constant(field->source_values[0]);
+	const int weight2 = compiler.constant(field->source_values[1]);
+	// a + (-1)*b is exactly a - b, so subtract fields need no multiply
+	const bool subtract = (field->source_values[1] == -1.0);
+	for (int i = 0; i < field->number_of_components; ++i)
+	{
+		const int term1 = compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, weight1, source1Registers[i]);
+		if (subtract)
+			componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_SUBTRACT, term1, source2Registers[i]);
+		else
+			componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_ADD, term1,
+				compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, weight2, source2Registers[i]));
+	}
+	return true;
+}
+
 int Computed_field_add::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1043,6 +1162,16 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -1160,6 +1289,32 @@ int Computed_field_scale::propagate_find_element_xi(cmzn_fieldcache& field_cache
 	return (return_code);
 } /* Computed_field_scale::propagate_find_element_xi */
 
+bool Computed_field_scale::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	if (!getSourceField(0)->core->evaluateAtNodes(time, nodeCount, nodes, values, defined))
+		return false;
+	for (int c = 0; c < field->number_of_components; ++c)
+	{
+		const FE_value scaleFactor = field->source_values[c];
+		FE_value *componentValues = values + c*nodeCount;
+		for (int n = 0; n < nodeCount; ++n)
+			componentValues[n] *= scaleFactor;
+	}
+	return true;
+}
+
+bool Computed_field_scale::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	for (int i = 0; i < field->number_of_components; ++i)
+		componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY,
+			compiler.constant(field->source_values[i]), sourceRegisters[i]);
+	return true;
+}
+
 int Computed_field_scale::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1341,6 +1496,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -1427,6 +1584,17 @@ enum FieldAssignmentResult Computed_field_clamp_maximum::assign(cmzn_fieldcache&
 	return result2;
 }
 
+bool Computed_field_clamp_maximum::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	for (int i = 0; i < field->number_of_components; ++i)
+		componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_MINIMUM,
+			sourceRegisters[i], compiler.constant(field->source_values[i]));
+	return true;
+}
+
 int Computed_field_clamp_maximum::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1611,6 +1779,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -1696,6 +1866,17 @@ enum FieldAssignmentResult Computed_field_clamp_minimum::assign(cmzn_fieldcache&
 	return result2;
 }
 
+bool Computed_field_clamp_minimum::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	for (int i = 0; i < field->number_of_components; ++i)
+		componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_MAXIMUM,
+			sourceRegisters[i], compiler.constant(field->source_values[i]));
+	return true;
+}
+
 int Computed_field_clamp_minimum::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1887,6 +2068,16 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -1987,6 +2178,32 @@ int Computed_field_offset::propagate_find_element_xi(cmzn_fieldcache& field_cach
 	return (return_code);
 } /* Computed_field_offset::propagate_find_element_xi */
 
+bool Computed_field_offset::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	if (!getSourceField(0)->core->evaluateAtNodes(time, nodeCount, nodes, values, defined))
+		return false;
+	for (int c = 0; c < field->number_of_components; ++c)
+	{
+		const FE_value offset = field->source_values[c];
+		FE_value *componentValues = values + c*nodeCount;
+		for (int n = 0; n < nodeCount; ++n)
+			componentValues[n] += offset;
+	}
+	return true;
+}
+
+bool Computed_field_offset::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	for (int i = 0; i < field->number_of_components; ++i)
+		componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_ADD,
+			compiler.constant(field->source_values[i]), sourceRegisters[i]);
+	return true;
+}
+
 int Computed_field_offset::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -2415,6 +2632,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_LOG, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -2615,6 +2837,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_SQRT, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -2816,6 +3043,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_EXP, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -3017,6 +3249,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_ABS, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
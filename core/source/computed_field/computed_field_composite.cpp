@@ -130,6 +130,16 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return sourceFieldsSupportEvaluateAtNodes();
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
 	int list();
 
 	char* get_command_string();
@@ -476,6 +486,57 @@ If <commands> is set, field/components are made into valid tokens.
 	return (source_string);
 } /* Computed_field_composite_get_source_string */
 
+bool Computed_field_composite::evaluateAtNodes(FE_value time, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	for (int n = 0; n < nodeCount; ++n)
+		defined[n] = 1;
+	std::vector<std::vector<FE_value> > sourceValues(field->number_of_source_fields);
+	std::vector<char> sourceDefined;
+	for (int i = 0; i < field->number_of_source_fields; ++i)
+	{
+		if (!evaluateSourceFieldAtNodes(i, time, nodeCount, nodes, sourceValues[i], sourceDefined))
+			return false;
+		for (int n = 0; n < nodeCount; ++n)
+			defined[n] &= sourceDefined[n];
+	}
+	for (int c = 0; c < field->number_of_components; ++c)
+	{
+		FE_value *componentValues = values + c*nodeCount;
+		if (0 <= source_field_numbers[c])
+		{
+			const FE_value *sourceComponentValues = sourceValues[source_field_numbers[c]].data() +
+				source_value_numbers[c]*nodeCount;
+			for (int n = 0; n < nodeCount; ++n)
+				componentValues[n] = sourceComponentValues[n];
+		}
+		else
+		{
+			const FE_value value = field->source_values[source_value_numbers[c]];
+			for (int n = 0; n < nodeCount; ++n)
+				componentValues[n] = value;
+		}
+	}
+	return true;
+}
+
+bool Computed_field_composite::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	for (int i = 0; i < field->number_of_components; ++i)
+	{
+		if (0 <= source_field_numbers[i])
+		{
+			const int *sourceRegisters = compiler.compileField(getSourceField(source_field_numbers[i]));
+			if (!sourceRegisters)
+				return false;
+			componentRegisters[i] = sourceRegisters[source_value_numbers[i]];
+		}
+		else
+			componentRegisters[i] = compiler.constant(field->source_values[source_value_numbers[i]]);
+	}
+	return true;
+}
+
 int Computed_field_composite::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
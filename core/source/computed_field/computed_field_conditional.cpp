@@ -68,10 +68,10 @@ private:
 		return CMZN_FIELD_TYPE_IF;
 	}
 
-	virtual FieldValueCache *createValueCache(cmzn_fieldcache& /* parentCache */)
+	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
 		if (value_type == CMZN_FIELD_VALUE_TYPE_REAL)
-			return new RealFieldValueCache(field->number_of_components);
+			return new RealFieldValueCache(parentCache, field->number_of_components);
 		else if (value_type == CMZN_FIELD_VALUE_TYPE_STRING)
 			return new StringFieldValueCache();
 		else if (value_type == CMZN_FIELD_VALUE_TYPE_MESH_LOCATION)
@@ -13,16 +13,23 @@ as derivatives w.r.t. Xi, gradient, curl, divergence etc.
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <vector>
 #include "opencmiss/zinc/zincconfigure.h"
+#include "opencmiss/zinc/fieldderivatives.h"
 #include "opencmiss/zinc/node.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_coordinate.h"
 #include "computed_field/computed_field_derivatives.h"
+#include "computed_field/computed_field_find_xi.h"
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/computed_field_set.h"
+#include "finite_element/finite_element_mesh.hpp"
 #include "finite_element/finite_element_nodeset.hpp"
+#include "finite_element/finite_element_region.h"
 #include "image_processing/computed_field_image_filter.h"
 #include "general/debug.h"
+#include "general/enumerator_conversion.hpp"
 #include "general/matrix_vector.h"
 #include "general/mystring.h"
 #include "general/message.h"
@@ -1220,13 +1227,54 @@ public:
 
 };
 
+/**
+ * Gradient of source field with respect to coordinate field. At nodes this is
+ * either found by finite differences or by averaging the gradients in the
+ * elements using the node. For the latter the element locations of all nodes
+ * are found on first use for a time and shared by all field caches. They are
+ * discarded when this field's dependencies change.
+ */
 class Computed_field_gradient : public Computed_field_core
 {
+	cmzn_field_gradient_node_mode nodeMode;
+	// element locations of nodes for ELEMENT_AVERAGE node mode:
+	bool nodeLocationsValid;
+	FE_value nodeLocationsTime;
+	FE_mesh *nodeLocationsMesh; // mesh locations are in, or 0 if none
+	// locations for node index n are from nodeLocationsStart[n] to nodeLocationsStart[n + 1] - 1
+	std::vector<DsLabelIndex> nodeLocationsStart;
+	std::vector<DsLabelIndex> nodeLocationsElementIndex;
+	std::vector<FE_value> nodeLocationsXi; // mesh dimension values per location
+
 public:
-	Computed_field_gradient() : Computed_field_core()
+	Computed_field_gradient() :
+		Computed_field_core(),
+		nodeMode(CMZN_FIELD_GRADIENT_NODE_MODE_FINITE_DIFFERENCE),
+		nodeLocationsValid(false),
+		nodeLocationsTime(0.0),
+		nodeLocationsMesh(0)
 	{
 	};
 
+	cmzn_field_gradient_node_mode getNodeMode() const
+	{
+		return this->nodeMode;
+	}
+
+	int setNodeMode(cmzn_field_gradient_node_mode nodeModeIn)
+	{
+		if ((nodeModeIn != CMZN_FIELD_GRADIENT_NODE_MODE_FINITE_DIFFERENCE) &&
+			(nodeModeIn != CMZN_FIELD_GRADIENT_NODE_MODE_ELEMENT_AVERAGE))
+			return CMZN_ERROR_ARGUMENT;
+		if (nodeModeIn != this->nodeMode)
+		{
+			this->nodeMode = nodeModeIn;
+			this->clear_cache();
+			Computed_field_changed(this->field);
+		}
+		return CMZN_OK;
+	}
+
 private:
 	~Computed_field_gradient()
 	{
@@ -1234,7 +1282,36 @@ private:
 
 	Computed_field_core *copy()
 	{
-		return new Computed_field_gradient();
+		Computed_field_gradient *core = new Computed_field_gradient();
+		core->nodeMode = this->nodeMode;
+		return core;
+	}
+
+	virtual int clear_cache()
+	{
+		this->nodeLocationsValid = false;
+		this->nodeLocationsMesh = 0;
+		this->nodeLocationsStart.clear();
+		this->nodeLocationsElementIndex.clear();
+		this->nodeLocationsXi.clear();
+		return 1;
+	}
+
+	/** Node element locations are only discarded if the coordinate field
+	 * or the elements or their nodes in the mesh change */
+	virtual int check_dependency()
+	{
+		int return_code = Computed_field_core::check_dependency();
+		if (this->nodeLocationsValid && (MANAGER_CHANGE_NONE(Computed_field) != return_code))
+		{
+			DsLabelsChangeLog *elementChangeLog = (this->nodeLocationsMesh) ?
+				this->nodeLocationsMesh->getChangeLog() : 0;
+			if ((MANAGER_CHANGE_NONE(Computed_field) != getSourceField(1)->manager_change_status)
+				|| (!elementChangeLog) || (elementChangeLog->getChangeSummary() &
+					(DS_LABEL_CHANGE_TYPE_ADD | DS_LABEL_CHANGE_TYPE_REMOVE | DS_LABEL_CHANGE_TYPE_DEFINITION)))
+				this->clear_cache();
+		}
+		return return_code;
 	}
 
 	const char *get_type_string()
@@ -1249,14 +1326,10 @@ private:
 
 	int compare(Computed_field_core* other_field)
 	{
-		if (dynamic_cast<Computed_field_gradient*>(other_field))
-		{
-			return 1;
-		}
-		else
-		{
-			return 0;
-		}
+		Computed_field_gradient *other = dynamic_cast<Computed_field_gradient*>(other_field);
+		if (other)
+			return (this->nodeMode == other->nodeMode);
+		return 0;
 	}
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& /*parentCache*/)
@@ -1271,8 +1344,150 @@ private:
 	int list();
 
 	char* get_command_string();
+
+	FE_mesh *getNodeElementLocations(cmzn_fieldcache& cache, cmzn_fieldcache& extraCache);
+
+	bool evaluateNodeElementAverage(cmzn_fieldcache& cache,
+		GradientRealFieldValueCache& valueCache, cmzn_node *node);
 };
 
+/**
+ * Get element locations of nodes for time, finding them if needed. Uses the
+ * mesh with the same dimension as the coordinate field, getting the elements
+ * using each node from all element field templates, and the nearest xi to the
+ * node coordinates in each element.
+ * @param extraCache  Cache for evaluating node coordinates and finding xi in,
+ * with time set.
+ * @return  Mesh the locations are in, or 0 if none.
+ */
+FE_mesh *Computed_field_gradient::getNodeElementLocations(cmzn_fieldcache& cache,
+	cmzn_fieldcache& extraCache)
+{
+	if (this->nodeLocationsValid && (this->nodeLocationsTime == cache.getTime()))
+		return this->nodeLocationsMesh;
+	this->clear_cache();
+	this->nodeLocationsValid = true;
+	this->nodeLocationsTime = cache.getTime();
+	cmzn_field_id coordinateField = getSourceField(1);
+	const int dimension = coordinateField->number_of_components;
+	FE_mesh *mesh = FE_region_find_FE_mesh_by_dimension(
+		cmzn_region_get_FE_region(Computed_field_get_region(this->field)), dimension);
+	if ((!mesh) || (0 == mesh->getSize()))
+		return 0;
+	// get unique node-element pairs ordered by node then element
+	std::vector<std::pair<DsLabelIndex, DsLabelIndex> > nodeElements;
+	const DsLabelIndex elementIndexLimit = mesh->getLabelsIndexSize();
+	const int eftDataCount = mesh->getElementfieldtemplateDataCount();
+	for (int e = 0; e < eftDataCount; ++e)
+	{
+		const FE_mesh_element_field_template_data *eftData = mesh->getElementfieldtemplateData(e);
+		if (!eftData)
+			continue;
+		const int localNodeCount = eftData->getElementfieldtemplate()->getNumberOfLocalNodes();
+		for (DsLabelIndex elementIndex = 0; elementIndex < elementIndexLimit; ++elementIndex)
+		{
+			const DsLabelIndex *nodeIndexes = eftData->getElementNodeIndexes(elementIndex);
+			if (nodeIndexes)
+				for (int n = 0; n < localNodeCount; ++n)
+					if (nodeIndexes[n] >= 0)
+						nodeElements.push_back(std::make_pair(nodeIndexes[n], elementIndex));
+		}
+	}
+	if (nodeElements.empty())
+		return 0;
+	std::sort(nodeElements.begin(), nodeElements.end());
+	nodeElements.erase(std::unique(nodeElements.begin(), nodeElements.end()), nodeElements.end());
+	FE_nodeset *nodeset = mesh->getNodeset();
+	const size_t pairsCount = nodeElements.size();
+	this->nodeLocationsStart.assign(nodeElements[pairsCount - 1].first + 2, 0);
+	FE_value nodeCoordinates[3];
+	FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	DsLabelIndex lastNodeIndex = DS_LABEL_INDEX_INVALID;
+	bool nodeCoordinatesValid = false;
+	for (size_t i = 0; i < pairsCount; ++i)
+	{
+		const DsLabelIndex nodeIndex = nodeElements[i].first;
+		if (nodeIndex != lastNodeIndex)
+		{
+			lastNodeIndex = nodeIndex;
+			nodeCoordinatesValid = false;
+			cmzn_node *node = nodeset->getNode(nodeIndex);
+			if (node)
+			{
+				extraCache.setNode(node);
+				const RealFieldValueCache *coordinateValueCache =
+					RealFieldValueCache::cast(coordinateField->evaluate(extraCache));
+				if (coordinateValueCache)
+				{
+					for (int c = 0; c < dimension; ++c)
+						nodeCoordinates[c] = coordinateValueCache->values[c];
+					nodeCoordinatesValid = true;
+				}
+			}
+		}
+		if (!nodeCoordinatesValid)
+			continue;
+		cmzn_element *element = mesh->getElement(nodeElements[i].second);
+		if ((element) && (Computed_field_perform_find_element_xi(coordinateField, &extraCache,
+			nodeCoordinates, dimension, &element, xi, /*search_mesh*/0, /*find_nearest*/1)) && (element))
+		{
+			++(this->nodeLocationsStart[nodeIndex + 1]);
+			this->nodeLocationsElementIndex.push_back(nodeElements[i].second);
+			this->nodeLocationsXi.insert(this->nodeLocationsXi.end(), xi, xi + dimension);
+		}
+	}
+	const size_t startCount = this->nodeLocationsStart.size();
+	for (size_t n = 1; n < startCount; ++n)
+		this->nodeLocationsStart[n] += this->nodeLocationsStart[n - 1];
+	this->nodeLocationsMesh = mesh;
+	return mesh;
+}
+
+/**
+ * Evaluate gradient at node as the average of its analytic values at the
+ * element locations of the node. Values assigned in cache only are not used.
+ * @return  True if evaluated, false if node is not in any element.
+ */
+bool Computed_field_gradient::evaluateNodeElementAverage(cmzn_fieldcache& cache,
+	GradientRealFieldValueCache& valueCache, cmzn_node *node)
+{
+	cmzn_fieldcache *extraCache = valueCache.getOrCreateExtraCache(cache);
+	if (!extraCache)
+		return false;
+	extraCache->setTime(cache.getTime());
+	FE_mesh *mesh = this->getNodeElementLocations(cache, *extraCache);
+	if ((!mesh) || (FE_node_get_FE_nodeset(node) != mesh->getNodeset()))
+		return false;
+	const DsLabelIndex nodeIndex = get_FE_node_index(node);
+	if ((nodeIndex < 0) || (static_cast<size_t>(nodeIndex + 1) >= this->nodeLocationsStart.size()))
+		return false;
+	const int dimension = getSourceField(1)->number_of_components;
+	const int componentsCount = this->field->number_of_components;
+	int locationsCount = 0;
+	const DsLabelIndex locationsEnd = this->nodeLocationsStart[nodeIndex + 1];
+	for (DsLabelIndex i = this->nodeLocationsStart[nodeIndex]; i < locationsEnd; ++i)
+	{
+		cmzn_element *element = mesh->getElement(this->nodeLocationsElementIndex[i]);
+		if (!element)
+			continue;
+		extraCache->setMeshLocation(element, this->nodeLocationsXi.data() + i*dimension);
+		const RealFieldValueCache *elementValueCache =
+			RealFieldValueCache::cast(this->field->evaluate(*extraCache));
+		if (!elementValueCache)
+			continue;
+		for (int c = 0; c < componentsCount; ++c)
+			valueCache.values[c] = (locationsCount > 0) ?
+				(valueCache.values[c] + elementValueCache->values[c]) : elementValueCache->values[c];
+		++locationsCount;
+	}
+	if (0 == locationsCount)
+		return false;
+	const FE_value scale = 1.0/static_cast<FE_value>(locationsCount);
+	for (int c = 0; c < componentsCount; ++c)
+		valueCache.values[c] *= scale;
+	return true;
+}
+
 int Computed_field_gradient::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	int return_code = 0;
@@ -1374,6 +1589,13 @@ int Computed_field_gradient::evaluate(cmzn_fieldcache& cache, FieldValueCache& i
 			}
 		}
 	}
+	else if ((this->nodeMode == CMZN_FIELD_GRADIENT_NODE_MODE_ELEMENT_AVERAGE) &&
+		(dynamic_cast<Field_node_location*>(cache.getLocation())) &&
+		(this->evaluateNodeElementAverage(cache, valueCache,
+			static_cast<Field_node_location*>(cache.getLocation())->get_node())))
+	{
+		return_code = 1;
+	}
 	else // Do a finite difference calculation varying the coordinate field: should work with any location
 	{
 		// temporary arrays are packed in GradientRealFieldValueCache::cacheValues:
@@ -1473,6 +1695,10 @@ DESCRIPTION :
 			"    coordinate field : %s\n",field->source_fields[1]->name);
 		display_message(INFORMATION_MESSAGE,
 			"    source field : %s\n",field->source_fields[0]->name);
+		char *node_mode_string = cmzn_field_gradient_node_mode_enum_to_string(this->nodeMode);
+		display_message(INFORMATION_MESSAGE,
+			"    node mode : %s\n", node_mode_string);
+		DEALLOCATE(node_mode_string);
 		return_code = 1;
 	}
 	else
@@ -1560,6 +1786,78 @@ cmzn_field_id cmzn_fieldmodule_create_field_gradient(
 	return (field);
 }
 
+cmzn_field_gradient_id cmzn_field_cast_gradient(cmzn_field_id field)
+{
+	if (field && (dynamic_cast<Computed_field_gradient*>(field->core)))
+	{
+		cmzn_field_access(field);
+		return (reinterpret_cast<cmzn_field_gradient_id>(field));
+	}
+	return 0;
+}
+
+int cmzn_field_gradient_destroy(cmzn_field_gradient_id *gradient_field_address)
+{
+	return cmzn_field_destroy(reinterpret_cast<cmzn_field_id *>(gradient_field_address));
+}
+
+inline Computed_field_gradient *Computed_field_gradient_core_cast(
+	cmzn_field_gradient *gradient_field)
+{
+	return (static_cast<Computed_field_gradient*>(
+		reinterpret_cast<Computed_field*>(gradient_field)->core));
+}
+
+class cmzn_field_gradient_node_mode_conversion
+{
+public:
+	static const char *to_string(enum cmzn_field_gradient_node_mode mode)
+	{
+		const char *enum_string = 0;
+		switch (mode)
+		{
+			case CMZN_FIELD_GRADIENT_NODE_MODE_FINITE_DIFFERENCE:
+				enum_string = "FINITE_DIFFERENCE";
+				break;
+			case CMZN_FIELD_GRADIENT_NODE_MODE_ELEMENT_AVERAGE:
+				enum_string = "ELEMENT_AVERAGE";
+				break;
+			default:
+				break;
+		}
+		return enum_string;
+	}
+};
+
+enum cmzn_field_gradient_node_mode cmzn_field_gradient_node_mode_enum_from_string(
+	const char *string)
+{
+	return string_to_enum<enum cmzn_field_gradient_node_mode,
+		cmzn_field_gradient_node_mode_conversion>(string);
+}
+
+char *cmzn_field_gradient_node_mode_enum_to_string(enum cmzn_field_gradient_node_mode mode)
+{
+	const char *mode_string = cmzn_field_gradient_node_mode_conversion::to_string(mode);
+	return (mode_string ? duplicate_string(mode_string) : 0);
+}
+
+enum cmzn_field_gradient_node_mode cmzn_field_gradient_get_node_mode(
+	cmzn_field_gradient_id gradient_field)
+{
+	if (gradient_field)
+		return Computed_field_gradient_core_cast(gradient_field)->getNodeMode();
+	return CMZN_FIELD_GRADIENT_NODE_MODE_INVALID;
+}
+
+int cmzn_field_gradient_set_node_mode(cmzn_field_gradient_id gradient_field,
+	enum cmzn_field_gradient_node_mode node_mode)
+{
+	if (gradient_field)
+		return Computed_field_gradient_core_cast(gradient_field)->setNodeMode(node_mode);
+	return CMZN_ERROR_ARGUMENT;
+}
+
 int Computed_field_get_type_gradient(struct Computed_field *field,
 	struct Computed_field **source_field,struct Computed_field **coordinate_field)
 /*******************************************************************************
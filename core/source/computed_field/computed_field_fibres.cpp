@@ -13,6 +13,8 @@ computed fields.
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include <math.h>
+#include <algorithm>
+#include <functional>
 
 #include "opencmiss/zinc/fieldfibres.h"
 #include "computed_field/computed_field.h"
@@ -20,8 +22,10 @@ computed fields.
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/computed_field_set.h"
 #include "general/debug.h"
+#include "general/matrix_vector.h"
 #include "general/mystring.h"
 #include "general/message.h"
+#include "general/small_matrix.hpp"
 
 class Computed_field_fibres_package : public Computed_field_type_package
 {
@@ -29,6 +33,119 @@ class Computed_field_fibres_package : public Computed_field_type_package
 
 namespace {
 
+/**
+ * Compute the three 3-component fibre axes in the order fibre, sheet, normal
+ * from up to 3 fibre angles and rectangular cartesian coordinate derivatives
+ * with respect to xi. See Computed_field_fibre_axes::evaluate.
+ * @param dx_dxi  3x3 coordinate derivatives, padded with zeros for xi3 in 2-D.
+ * @param axes  Array of 9 to receive fibre, sheet and normal vectors.
+ */
+void calculate_fibre_axes(const FE_value *dx_dxi, int number_of_fibre_angles,
+	const FE_value *fibre_angles, FE_value *axes)
+{
+	FE_value a_x, a_y, a_z, alpha, b_x, b_y, b_z, beta, c_x, c_y, c_z, cos_alpha,
+		cos_beta, cos_gamma, f11, f12, f13, f21, f22, f23, f31, f32, f33,
+		gamma, length, sin_alpha, sin_beta, sin_gamma;
+
+	/* get f1~ = vector in xi1 direction */
+	f11=dx_dxi[0];
+	f12=dx_dxi[3];
+	f13=dx_dxi[6];
+	/* get f2~ = vector in xi2 direction */
+	f21=dx_dxi[1];
+	f22=dx_dxi[4];
+	f23=dx_dxi[7];
+	/* get f3~ = vector normal to xi1-xi2 plane */
+	f31=f12*f23-f13*f22;
+	f32=f13*f21-f11*f23;
+	f33=f11*f22-f12*f21;
+	/* normalise vectors f1~ and f3~ */
+	if (0.0<(length=sqrt(f11*f11+f12*f12+f13*f13)))
+	{
+		f11 /= length;
+		f12 /= length;
+		f13 /= length;
+	}
+	if (0.0<(length=sqrt(f31*f31+f32*f32+f33*f33)))
+	{
+		f31 /= length;
+		f32 /= length;
+		f33 /= length;
+	}
+	/* get vector f2~ = f3~ (x) f1~ = normal to xi1 in xi1-xi2 plane */
+	f21=f32*f13-f33*f12;
+	f22=f33*f11-f31*f13;
+	f23=f31*f12-f32*f11;
+	/* get sin/cos of fibre angles alpha, beta and gamma */
+	alpha = fibre_angles[0];
+	sin_alpha = sin(alpha);
+	cos_alpha = cos(alpha);
+	if (1 < number_of_fibre_angles)
+	{
+		beta = fibre_angles[1];
+		sin_beta = sin(beta);
+		cos_beta = cos(beta);
+	}
+	else
+	{
+		/* default beta is 0 */
+		sin_beta = 0;
+		cos_beta = 1;
+	}
+	if (2 < number_of_fibre_angles)
+	{
+		gamma = fibre_angles[2];
+		sin_gamma = sin(gamma);
+		cos_gamma = cos(gamma);
+	}
+	else
+	{
+		/* default gamma is 0 */
+		sin_gamma = 0;
+		cos_gamma = 1;
+	}
+	/* calculate the fibre axes a=fibre, b=sheet, c=normal */
+	a_x =  cos_alpha*f11 + sin_alpha*f21;
+	a_y =  cos_alpha*f12 + sin_alpha*f22;
+	a_z =  cos_alpha*f13 + sin_alpha*f23;
+	b_x = -sin_alpha*f11 + cos_alpha*f21;
+	b_y = -sin_alpha*f12 + cos_alpha*f22;
+	b_z = -sin_alpha*f13 + cos_alpha*f23;
+	f11 = a_x;
+	f12 = a_y;
+	f13 = a_z;
+	f21 = b_x;
+	f22 = b_y;
+	f23 = b_z;
+	/* as per KATs change 30Nov00 in back-end function ROT_COORDSYS,
+		rotate anticlockwise about axis2, not -axis2 */
+	c_x =  cos_beta*f31 + sin_beta*f11;
+	c_y =  cos_beta*f32 + sin_beta*f12;
+	c_z =  cos_beta*f33 + sin_beta*f13;
+	a_x = -sin_beta*f31 + cos_beta*f11;
+	a_y = -sin_beta*f32 + cos_beta*f12;
+	a_z = -sin_beta*f33 + cos_beta*f13;
+	f31 = c_x;
+	f32 = c_y;
+	f33 = c_z;
+	b_x =  cos_gamma*f21 + sin_gamma*f31;
+	b_y =  cos_gamma*f22 + sin_gamma*f32;
+	b_z =  cos_gamma*f23 + sin_gamma*f33;
+	c_x = -sin_gamma*f21 + cos_gamma*f31;
+	c_y = -sin_gamma*f22 + cos_gamma*f32;
+	c_z = -sin_gamma*f23 + cos_gamma*f33;
+	/* put fibre, sheet then normal in field values */
+	axes[0]=a_x;
+	axes[1]=a_y;
+	axes[2]=a_z;
+	axes[3]=b_x;
+	axes[4]=b_y;
+	axes[5]=b_z;
+	axes[6]=c_x;
+	axes[7]=c_y;
+	axes[8]=c_z;
+}
+
 const char computed_field_fibre_axes_type_string[] = "fibre_axes";
 
 class Computed_field_fibre_axes : public Computed_field_core
@@ -134,108 +251,8 @@ int Computed_field_fibre_axes::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 				coordinate_field->number_of_components, coordinateCache->values, coordinateCache->derivatives,
 				top_level_element_dimension, x, dx_dxi))
 		{
-			FE_value a_x, a_y, a_z, alpha, b_x, b_y, b_z, beta, c_x, c_y, c_z, cos_alpha,
-				cos_beta, cos_gamma, f11, f12, f13, f21, f22, f23, f31, f32, f33,
-				gamma, length, sin_alpha, sin_beta, sin_gamma;
-
-			/* 2. Calculate the field */
-			/* get f1~ = vector in xi1 direction */
-			f11=dx_dxi[0];
-			f12=dx_dxi[3];
-			f13=dx_dxi[6];
-			/* get f2~ = vector in xi2 direction */
-			f21=dx_dxi[1];
-			f22=dx_dxi[4];
-			f23=dx_dxi[7];
-			/* get f3~ = vector normal to xi1-xi2 plane */
-			f31=f12*f23-f13*f22;
-			f32=f13*f21-f11*f23;
-			f33=f11*f22-f12*f21;
-			/* normalise vectors f1~ and f3~ */
-			if (0.0<(length=sqrt(f11*f11+f12*f12+f13*f13)))
-			{
-				f11 /= length;
-				f12 /= length;
-				f13 /= length;
-			}
-			if (0.0<(length=sqrt(f31*f31+f32*f32+f33*f33)))
-			{
-				f31 /= length;
-				f32 /= length;
-				f33 /= length;
-			}
-			/* get vector f2~ = f3~ (x) f1~ = normal to xi1 in xi1-xi2 plane */
-			f21=f32*f13-f33*f12;
-			f22=f33*f11-f31*f13;
-			f23=f31*f12-f32*f11;
-			/* get sin/cos of fibre angles alpha, beta and gamma */
-			alpha = fibreCache->values[0];
-			sin_alpha = sin(alpha);
-			cos_alpha = cos(alpha);
-			if (1 < fibre_field->number_of_components)
-			{
-				beta = fibreCache->values[1];
-				sin_beta = sin(beta);
-				cos_beta = cos(beta);
-			}
-			else
-			{
-				/* default beta is 0 */
-				sin_beta = 0;
-				cos_beta = 1;
-			}
-			if (2 < fibre_field->number_of_components)
-			{
-				gamma = fibreCache->values[2];
-				sin_gamma = sin(gamma);
-				cos_gamma = cos(gamma);
-			}
-			else
-			{
-				/* default gamma is 0 */
-				sin_gamma = 0;
-				cos_gamma = 1;
-			}
-			/* calculate the fibre axes a=fibre, b=sheet, c=normal */
-			a_x =  cos_alpha*f11 + sin_alpha*f21;
-			a_y =  cos_alpha*f12 + sin_alpha*f22;
-			a_z =  cos_alpha*f13 + sin_alpha*f23;
-			b_x = -sin_alpha*f11 + cos_alpha*f21;
-			b_y = -sin_alpha*f12 + cos_alpha*f22;
-			b_z = -sin_alpha*f13 + cos_alpha*f23;
-			f11 = a_x;
-			f12 = a_y;
-			f13 = a_z;
-			f21 = b_x;
-			f22 = b_y;
-			f23 = b_z;
-			/* as per KATs change 30Nov00 in back-end function ROT_COORDSYS,
-				rotate anticlockwise about axis2, not -axis2 */
-			c_x =  cos_beta*f31 + sin_beta*f11;
-			c_y =  cos_beta*f32 + sin_beta*f12;
-			c_z =  cos_beta*f33 + sin_beta*f13;
-			a_x = -sin_beta*f31 + cos_beta*f11;
-			a_y = -sin_beta*f32 + cos_beta*f12;
-			a_z = -sin_beta*f33 + cos_beta*f13;
-			f31 = c_x;
-			f32 = c_y;
-			f33 = c_z;
-			b_x =  cos_gamma*f21 + sin_gamma*f31;
-			b_y =  cos_gamma*f22 + sin_gamma*f32;
-			b_z =  cos_gamma*f23 + sin_gamma*f33;
-			c_x = -sin_gamma*f21 + cos_gamma*f31;
-			c_y = -sin_gamma*f22 + cos_gamma*f32;
-			c_z = -sin_gamma*f23 + cos_gamma*f33;
-			/* put fibre, sheet then normal in field values */
-			valueCache.values[0]=a_x;
-			valueCache.values[1]=a_y;
-			valueCache.values[2]=a_z;
-			valueCache.values[3]=b_x;
-			valueCache.values[4]=b_y;
-			valueCache.values[5]=b_z;
-			valueCache.values[6]=c_x;
-			valueCache.values[7]=c_y;
-			valueCache.values[8]=c_z;
+			calculate_fibre_axes(dx_dxi, fibre_field->number_of_components,
+				fibreCache->values, valueCache.values);
 			return 1;
 		}
 	}
@@ -315,6 +332,383 @@ Returns allocated command string for reproducing field. Includes type.
 	return (command_string);
 } /* Computed_field_fibre_axes::get_command_string */
 
+/**
+ * Value cache for the fibre deformation gradient field, which also holds the
+ * other kinematic quantities calculated with it for fibre strain fields.
+ */
+class FibreDeformationGradientFieldValueCache : public RealFieldValueCache
+{
+public:
+	// right Cauchy-Green deformation tensor and Green-Lagrange strain
+	FE_value C[9], E[9];
+	// eigenvalues of E from largest to smallest
+	FE_value principalStrains[3];
+
+	FibreDeformationGradientFieldValueCache() :
+		RealFieldValueCache(9)
+	{
+	}
+
+	static FibreDeformationGradientFieldValueCache* cast(FieldValueCache* valueCache)
+	{
+		return FIELD_VALUE_CACHE_CAST<FibreDeformationGradientFieldValueCache*>(valueCache);
+	}
+
+	static FibreDeformationGradientFieldValueCache& cast(FieldValueCache& valueCache)
+	{
+		return FIELD_VALUE_CACHE_CAST<FibreDeformationGradientFieldValueCache&>(valueCache);
+	}
+};
+
+const char computed_field_fibre_deformation_gradient_type_string[] = "fibre_deformation_gradient";
+
+class Computed_field_fibre_deformation_gradient : public Computed_field_core
+{
+public:
+	Computed_field_fibre_deformation_gradient() : Computed_field_core()
+	{
+	};
+
+private:
+	Computed_field_core *copy()
+	{
+		return new Computed_field_fibre_deformation_gradient();
+	}
+
+	const char *get_type_string()
+	{
+		return(computed_field_fibre_deformation_gradient_type_string);
+	}
+
+	int compare(Computed_field_core* other_field)
+	{
+		if (dynamic_cast<Computed_field_fibre_deformation_gradient*>(other_field))
+		{
+			return 1;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	virtual FieldValueCache *createValueCache(cmzn_fieldcache& /*parentCache*/)
+	{
+		return new FibreDeformationGradientFieldValueCache();
+	}
+
+	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
+
+	int list();
+
+	char* get_command_string();
+
+	virtual bool is_defined_at_location(cmzn_fieldcache& cache);
+};
+
+bool Computed_field_fibre_deformation_gradient::is_defined_at_location(cmzn_fieldcache& cache)
+{
+	Field_element_xi_location* element_xi_location;
+	// only works for element_xi locations on or in 3-D elements
+	if (0 != (element_xi_location = dynamic_cast<Field_element_xi_location*>(cache.getLocation())))
+	{
+		FE_element* element = element_xi_location->get_element();
+		const int element_dimension = get_FE_element_dimension(element);
+		FE_element *top_level_element = element_xi_location->get_top_level_element();
+		FE_value top_level_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		int top_level_element_dimension = 0;
+		if (FE_element_get_top_level_element_and_xi(element,
+				element_xi_location->get_xi(), element_dimension,
+				&top_level_element, top_level_xi, &top_level_element_dimension) &&
+			(3 == top_level_element_dimension))
+		{
+			// check the source fields
+			return Computed_field_core::is_defined_at_location(cache);
+		}
+	}
+	return false;
+}
+
+/**
+ * Calculate the deformation gradient F = dx/dX with respect to the fibre axes
+ * of the undeformed coordinates, and from it the right Cauchy-Green
+ * deformation tensor C = F^T F, the Green-Lagrange strain E = (C - I)/2 and
+ * the principal strains, in one pass. Coordinates and derivatives are
+ * evaluated in the top level 3-D element and converted to rectangular
+ * cartesian. Derivatives are not calculated.
+ */
+int Computed_field_fibre_deformation_gradient::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
+{
+	Field_element_xi_location* element_xi_location;
+	if (0 != (element_xi_location = dynamic_cast<Field_element_xi_location*>(cache.getLocation())))
+	{
+		FibreDeformationGradientFieldValueCache& valueCache = FibreDeformationGradientFieldValueCache::cast(inValueCache);
+		FE_element* element = element_xi_location->get_element();
+		const int element_dimension = get_FE_element_dimension(element);
+		FE_element *top_level_element = element_xi_location->get_top_level_element();
+		FE_value top_level_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		int top_level_element_dimension = 0;
+		FE_element_get_top_level_element_and_xi(element,
+			element_xi_location->get_xi(), element_dimension,
+			&top_level_element, top_level_xi, &top_level_element_dimension);
+		if (3 != top_level_element_dimension)
+			return 0;
+		// use the normal cache if already on a top level element, otherwise use extra cache
+		cmzn_fieldcache *workingCache = &cache;
+		if (top_level_element != element)
+		{
+			workingCache = valueCache.getOrCreateExtraCache(cache);
+			workingCache->setTime(cache.getTime());
+			workingCache->setMeshLocation(top_level_element, top_level_xi);
+		}
+		cmzn_field_id deformed_field = getSourceField(0);
+		cmzn_field_id undeformed_field = getSourceField(1);
+		cmzn_field_id fibre_field = getSourceField(2);
+		RealFieldValueCache *deformedCache = RealFieldValueCache::cast(
+			deformed_field->evaluateWithDerivatives(*workingCache, top_level_element_dimension));
+		RealFieldValueCache *undeformedCache = RealFieldValueCache::cast(
+			undeformed_field->evaluateWithDerivatives(*workingCache, top_level_element_dimension));
+		RealFieldValueCache *fibreCache = RealFieldValueCache::cast(fibre_field->evaluate(*workingCache));
+		FE_value x[3], dx_dxi[9], X[3], dX_dxi[9];
+		if (deformedCache && deformedCache->derivatives_valid &&
+			undeformedCache && undeformedCache->derivatives_valid && fibreCache &&
+			convert_coordinates_and_derivatives_to_rc(&(deformed_field->coordinate_system),
+				deformed_field->number_of_components, deformedCache->values, deformedCache->derivatives,
+				top_level_element_dimension, x, dx_dxi) &&
+			convert_coordinates_and_derivatives_to_rc(&(undeformed_field->coordinate_system),
+				undeformed_field->number_of_components, undeformedCache->values, undeformedCache->derivatives,
+				top_level_element_dimension, X, dX_dxi))
+		{
+			FE_value dxi_dX[9];
+			if (!SmallMatrix<3>::invert(dX_dxi, dxi_dX, /*singularTolerance*/1.0E-12))
+			{
+				display_message(ERROR_MESSAGE, "Computed_field_fibre_deformation_gradient::evaluate.  "
+					"Undeformed coordinates are degenerate");
+				return 0;
+			}
+			// fibre, sheet and normal axes in rows of Q
+			FE_value Q[9];
+			calculate_fibre_axes(dX_dxi, fibre_field->number_of_components, fibreCache->values, Q);
+			// global F = dx/dxi.dxi/dX; FQ = F.Q^T
+			FE_value F[9], FQ[9];
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					F[i*3 + j] = dx_dxi[i*3]*dxi_dX[j] + dx_dxi[i*3 + 1]*dxi_dX[3 + j] + dx_dxi[i*3 + 2]*dxi_dX[6 + j];
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					FQ[i*3 + j] = F[i*3]*Q[j*3] + F[i*3 + 1]*Q[j*3 + 1] + F[i*3 + 2]*Q[j*3 + 2];
+			// F in fibre axes = Q.F.Q^T
+			FE_value *fibreF = valueCache.values;
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					fibreF[i*3 + j] = Q[i*3]*FQ[j] + Q[i*3 + 1]*FQ[3 + j] + Q[i*3 + 2]*FQ[6 + j];
+			valueCache.derivatives_valid = 0;
+			for (int i = 0; i < 3; ++i)
+				for (int j = i; j < 3; ++j)
+				{
+					const FE_value c = fibreF[i]*fibreF[j] + fibreF[3 + i]*fibreF[3 + j] + fibreF[6 + i]*fibreF[6 + j];
+					valueCache.C[i*3 + j] = valueCache.C[j*3 + i] = c;
+					valueCache.E[i*3 + j] = valueCache.E[j*3 + i] = 0.5*((i == j) ? (c - 1.0) : c);
+				}
+			// principal strains in closed form unless close, otherwise iteratively
+			FE_value *strains = valueCache.principalStrains;
+			FE_value vectors[9];
+			if (!SmallMatrix<3>::symmetricEigenanalysis(valueCache.E, strains, vectors))
+			{
+				double a[9];
+				int nrot;
+				for (int i = 0; i < 9; ++i)
+					a[i] = valueCache.E[i];
+				if (!Jacobi_eigenanalysis(3, a, strains, vectors, &nrot))
+				{
+					display_message(ERROR_MESSAGE, "Computed_field_fibre_deformation_gradient::evaluate.  "
+						"Eigenanalysis of strain failed");
+					return 0;
+				}
+			}
+			std::sort(strains, strains + 3, std::greater<FE_value>());
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int Computed_field_fibre_deformation_gradient::list()
+{
+	if (field)
+	{
+		display_message(INFORMATION_MESSAGE,
+			"    deformed coordinate field : %s\n", field->source_fields[0]->name);
+		display_message(INFORMATION_MESSAGE,
+			"    undeformed coordinate field : %s\n", field->source_fields[1]->name);
+		display_message(INFORMATION_MESSAGE,
+			"    fibre field : %s\n", field->source_fields[2]->name);
+		return 1;
+	}
+	return 0;
+}
+
+/** Returns allocated command string for reproducing field. Includes type. */
+char *Computed_field_fibre_deformation_gradient::get_command_string()
+{
+	char *command_string = 0;
+	char *field_name;
+	int error = 0;
+	append_string(&command_string,
+		computed_field_fibre_deformation_gradient_type_string, &error);
+	const char *tokens[3] = { " deformed_coordinate ", " undeformed_coordinate ", " fibre " };
+	for (int i = 0; i < 3; ++i)
+	{
+		append_string(&command_string, tokens[i], &error);
+		if (GET_NAME(Computed_field)(field->source_fields[i], &field_name))
+		{
+			make_valid_token(&field_name);
+			append_string(&command_string, field_name, &error);
+			DEALLOCATE(field_name);
+		}
+	}
+	return (command_string);
+}
+
+/** Kinematic quantity returned by a fibre strain field */
+enum FibreStrainQuantity
+{
+	FIBRE_STRAIN_QUANTITY_RIGHT_CAUCHY_GREEN_DEFORMATION,
+	FIBRE_STRAIN_QUANTITY_GREEN_LAGRANGE_STRAIN,
+	FIBRE_STRAIN_QUANTITY_PRINCIPAL_STRAINS
+};
+
+const char computed_field_fibre_strain_type_string[] = "fibre_strain";
+
+/**
+ * Returns a kinematic quantity calculated and cached with a fibre deformation
+ * gradient field, so all quantities at a location share one evaluation of it.
+ */
+class Computed_field_fibre_strain : public Computed_field_core
+{
+	FibreStrainQuantity quantity;
+
+public:
+	Computed_field_fibre_strain(FibreStrainQuantity quantityIn) :
+		Computed_field_core(),
+		quantity(quantityIn)
+	{
+	};
+
+	static const char *getQuantityName(FibreStrainQuantity quantity)
+	{
+		switch (quantity)
+		{
+		case FIBRE_STRAIN_QUANTITY_RIGHT_CAUCHY_GREEN_DEFORMATION:
+			return "right_cauchy_green_deformation";
+		case FIBRE_STRAIN_QUANTITY_GREEN_LAGRANGE_STRAIN:
+			return "green_lagrange_strain";
+		case FIBRE_STRAIN_QUANTITY_PRINCIPAL_STRAINS:
+			return "principal_strains";
+		}
+		return 0;
+	}
+
+private:
+	Computed_field_core *copy()
+	{
+		return new Computed_field_fibre_strain(this->quantity);
+	}
+
+	const char *get_type_string()
+	{
+		return(computed_field_fibre_strain_type_string);
+	}
+
+	int compare(Computed_field_core* other_field)
+	{
+		Computed_field_fibre_strain *other = dynamic_cast<Computed_field_fibre_strain*>(other_field);
+		if (other && (other->quantity == this->quantity))
+		{
+			return 1;
+		}
+		return 0;
+	}
+
+	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
+
+	int list();
+
+	char* get_command_string();
+};
+
+int Computed_field_fibre_strain::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
+{
+	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	FibreDeformationGradientFieldValueCache *sourceCache =
+		FibreDeformationGradientFieldValueCache::cast(getSourceField(0)->evaluate(cache));
+	if (sourceCache)
+	{
+		const FE_value *values = (this->quantity == FIBRE_STRAIN_QUANTITY_RIGHT_CAUCHY_GREEN_DEFORMATION) ? sourceCache->C :
+			(this->quantity == FIBRE_STRAIN_QUANTITY_GREEN_LAGRANGE_STRAIN) ? sourceCache->E : sourceCache->principalStrains;
+		for (int i = 0; i < field->number_of_components; ++i)
+			valueCache.values[i] = values[i];
+		valueCache.derivatives_valid = 0;
+		return 1;
+	}
+	return 0;
+}
+
+int Computed_field_fibre_strain::list()
+{
+	if (field)
+	{
+		display_message(INFORMATION_MESSAGE,
+			"    quantity : %s\n", getQuantityName(this->quantity));
+		display_message(INFORMATION_MESSAGE,
+			"    fibre deformation gradient field : %s\n", field->source_fields[0]->name);
+		return 1;
+	}
+	return 0;
+}
+
+/** Returns allocated command string for reproducing field. Includes type. */
+char *Computed_field_fibre_strain::get_command_string()
+{
+	char *command_string = 0;
+	char *field_name;
+	int error = 0;
+	append_string(&command_string, computed_field_fibre_strain_type_string, &error);
+	append_string(&command_string, " ", &error);
+	append_string(&command_string, getQuantityName(this->quantity), &error);
+	append_string(&command_string, " fibre_deformation_gradient ", &error);
+	if (GET_NAME(Computed_field)(field->source_fields[0], &field_name))
+	{
+		make_valid_token(&field_name);
+		append_string(&command_string, field_name, &error);
+		DEALLOCATE(field_name);
+	}
+	return (command_string);
+}
+
+cmzn_field_id create_field_fibre_strain(cmzn_fieldmodule_id field_module,
+	cmzn_field_id fibre_deformation_gradient_field, FibreStrainQuantity quantity)
+{
+	Computed_field *field = 0;
+	if (field_module && fibre_deformation_gradient_field &&
+		dynamic_cast<Computed_field_fibre_deformation_gradient*>(fibre_deformation_gradient_field->core))
+	{
+		field = Computed_field_create_generic(field_module,
+			/*check_source_field_regions*/true,
+			/*number_of_components*/(quantity == FIBRE_STRAIN_QUANTITY_PRINCIPAL_STRAINS) ? 3 : 9,
+			/*number_of_source_fields*/1, &fibre_deformation_gradient_field,
+			/*number_of_source_values*/0, NULL,
+			new Computed_field_fibre_strain(quantity));
+	}
+	else
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_fieldmodule_create_field_fibre_%s.  Invalid argument(s)",
+			Computed_field_fibre_strain::getQuantityName(quantity));
+	}
+	return (field);
+}
+
 } //namespace
 
 cmzn_field_id cmzn_fieldmodule_create_field_fibre_axes(
@@ -347,6 +741,59 @@ cmzn_field_id cmzn_fieldmodule_create_field_fibre_axes(
 	return (field);
 }
 
+cmzn_field_id cmzn_fieldmodule_create_field_fibre_deformation_gradient(
+	cmzn_fieldmodule_id field_module, cmzn_field_id deformed_coordinate_field,
+	cmzn_field_id undeformed_coordinate_field, cmzn_field_id fibre_field)
+{
+	Computed_field *field = 0;
+	if (field_module &&
+		deformed_coordinate_field && deformed_coordinate_field->isNumerical() &&
+		(3 >= deformed_coordinate_field->number_of_components) &&
+		undeformed_coordinate_field && undeformed_coordinate_field->isNumerical() &&
+		(3 >= undeformed_coordinate_field->number_of_components) &&
+		fibre_field && fibre_field->isNumerical() &&
+		(3 >= fibre_field->number_of_components))
+	{
+		Computed_field *source_fields[3];
+		source_fields[0] = deformed_coordinate_field;
+		source_fields[1] = undeformed_coordinate_field;
+		source_fields[2] = fibre_field;
+		field = Computed_field_create_generic(field_module,
+			/*check_source_field_regions*/true,
+			/*number_of_components*/9,
+			/*number_of_source_fields*/3, source_fields,
+			/*number_of_source_values*/0, NULL,
+			new Computed_field_fibre_deformation_gradient());
+	}
+	else
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_fieldmodule_create_field_fibre_deformation_gradient.  Invalid argument(s)");
+	}
+	return (field);
+}
+
+cmzn_field_id cmzn_fieldmodule_create_field_fibre_right_cauchy_green_deformation(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field)
+{
+	return create_field_fibre_strain(field_module, fibre_deformation_gradient_field,
+		FIBRE_STRAIN_QUANTITY_RIGHT_CAUCHY_GREEN_DEFORMATION);
+}
+
+cmzn_field_id cmzn_fieldmodule_create_field_fibre_green_lagrange_strain(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field)
+{
+	return create_field_fibre_strain(field_module, fibre_deformation_gradient_field,
+		FIBRE_STRAIN_QUANTITY_GREEN_LAGRANGE_STRAIN);
+}
+
+cmzn_field_id cmzn_fieldmodule_create_field_fibre_principal_strains(
+	cmzn_fieldmodule_id field_module, cmzn_field_id fibre_deformation_gradient_field)
+{
+	return create_field_fibre_strain(field_module, fibre_deformation_gradient_field,
+		FIBRE_STRAIN_QUANTITY_PRINCIPAL_STRAINS);
+}
+
 int Computed_field_get_type_fibre_axes(struct Computed_field *field,
 	struct Computed_field **fibre_field,struct Computed_field **coordinate_field)
 /*******************************************************************************
@@ -17,6 +17,7 @@ lookup of the element.
 #include <math.h>
 
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/matrix_vector.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_private.hpp"
@@ -105,6 +106,7 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
 				}
 				converged = 0;
 				iterations = 0;
+				ZINC_INSTRUMENT_COUNT(instrumentationCounters.findXiSearches);
 				while ((!converged) && return_code)
 				{
 					if ((CMZN_OK == cmzn_fieldcache_set_mesh_location(data->field_cache, element, number_of_xi, data->xi)) &&
@@ -168,6 +170,7 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
 								data->xi[i] += b[i];
 							}
 							iterations++;
+							ZINC_INSTRUMENT_COUNT(instrumentationCounters.findXiIterations);
 							if (!converged)
 							{
 								FE_element_shape_limit_xi_to_element(shape,
@@ -29,6 +29,7 @@ Implements a number of basic component wise operations on computed fields.
 #include "finite_element/finite_element_time.h"
 #include "general/debug.h"
 #include "general/enumerator_private.hpp"
+#include "general/instrumentation.hpp"
 #include "general/mystring.h"
 #include "general/message.h"
 #include "computed_field/computed_field_finite_element.h"
@@ -98,6 +99,7 @@ int calculate_FE_element_field_values_for_element(
 				FE_element_field_values, element)(element, field_values_cache)))
 			{
 				needUpdate = true;
+				ZINC_INSTRUMENT_COUNT(instrumentationCounters.elementFieldValuesCacheMisses);
 				fe_element_field_values = CREATE(FE_element_field_values)();
 				if (fe_element_field_values)
 				{
@@ -117,8 +119,13 @@ int calculate_FE_element_field_values_for_element(
 						(!FE_element_field_values_have_derivatives_calculated(fe_element_field_values))))
 				{
 					needUpdate = true;
+					ZINC_INSTRUMENT_COUNT(instrumentationCounters.elementFieldValuesCacheMisses);
 					clear_FE_element_field_values(fe_element_field_values);
 				}
+				else
+				{
+					ZINC_INSTRUMENT_COUNT(instrumentationCounters.elementFieldValuesCacheHits);
+				}
 			}
 			if (return_code && needUpdate)
 			{
@@ -154,6 +161,10 @@ int calculate_FE_element_field_values_for_element(
 				}
 			}
 		}
+		else
+		{
+			ZINC_INSTRUMENT_COUNT(instrumentationCounters.elementFieldValuesCacheHits);
+		}
 	}
 	else
 	{
@@ -224,6 +235,14 @@ public:
 		RealFieldValueCache::clear();
 	}
 
+	virtual void clearChanges(FE_region_changes& changes)
+	{
+		FE_element_field_values_list_remove_changed(field_values_cache, &changes);
+		// Following may have been destroyed, and is found again from list
+		fe_element_field_values = (FE_element_field_values *)NULL;
+		RealFieldValueCache::clear();
+	}
+
 	static FiniteElementRealFieldValueCache* cast(FieldValueCache* valueCache)
 	{
 		return FIELD_VALUE_CACHE_CAST<FiniteElementRealFieldValueCache*>(valueCache);
@@ -265,6 +284,14 @@ public:
 		StringFieldValueCache::clear();
 	}
 
+	virtual void clearChanges(FE_region_changes& changes)
+	{
+		FE_element_field_values_list_remove_changed(field_values_cache, &changes);
+		// Following may have been destroyed, and is found again from list
+		fe_element_field_values = (FE_element_field_values *)NULL;
+		StringFieldValueCache::clear();
+	}
+
 	static FiniteElementStringFieldValueCache* cast(FieldValueCache* valueCache)
    {
 		return FIELD_VALUE_CACHE_CAST<FiniteElementStringFieldValueCache*>(valueCache);
@@ -393,6 +420,11 @@ private:
 	int get_native_discretization_in_element(
 		struct FE_element *element,int *number_in_xi);
 
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
+
 	virtual int check_dependency()
 	{
 		if (field)
@@ -421,6 +453,19 @@ private:
 		return FE_region_set_FE_field_name(FE_field_get_FE_region(fe_field), fe_field, name);
 	};
 
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return (FE_VALUE_VALUE == get_FE_field_value_type(this->fe_field))
+			&& (GENERAL_FE_FIELD == get_FE_field_FE_field_type(this->fe_field));
+	}
+
+	virtual bool evaluateAtNodes(FE_value time, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined)
+	{
+		return CMZN_OK == FE_field_get_nodes_FE_value_values(this->fe_field, time,
+			nodeCount, nodes, values, defined);
+	}
+
 	virtual bool isTypeCoordinate() const
 	{
 		return (get_FE_field_CM_field_type(this->fe_field) == CM_COORDINATE_FIELD);
@@ -2560,7 +2605,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		// need extra cache for evaluating at parent element locations
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		return valueCache;
@@ -2925,7 +2970,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		return valueCache;
 	}
@@ -2947,13 +2992,13 @@ private:
 			if (0 == (field->manager_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field)))
 			{
 				// any change to result of source field is a full change to the embedded field
-				int source_change_status = getSourceField(0)->core->check_dependency();
+				int source_change_status = getSourceField(0)->manager_change_status;
 				if (source_change_status & MANAGER_CHANGE_RESULT(Computed_field))
 					field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
 				else
 				{
 					// propagate full or partial result from mesh location field
-					source_change_status = getSourceField(1)->core->check_dependency();
+					source_change_status = getSourceField(1)->manager_change_status;
 					if (source_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field))
 						field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
 					else if (source_change_status & MANAGER_CHANGE_PARTIAL_RESULT(Computed_field))
@@ -3226,6 +3271,11 @@ private:
 		return CMZN_FIELD_VALUE_TYPE_MESH_LOCATION;
 	}
 
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
+
 	// if the mesh is a mesh group, also need to propagate changes from it
 	virtual int check_dependency()
 	{
@@ -58,7 +58,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		return valueCache;
 	}
@@ -61,6 +61,12 @@ public:
 	{
 		return (this->field == other_field);
 	}
+
+	// groups change with their master nodeset or mesh, or subgroups
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
 };
 
 #endif /* COMPUTED_FIELD_GROUP_BASE_HPP */
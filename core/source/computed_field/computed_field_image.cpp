@@ -1673,6 +1673,8 @@ int cmzn_field_image_set_domain_field(
 		Texture_get_dimension(image_core->texture, &textureDimension);
 		if (domainDimension >= textureDimension)
 		{
+			domain_field->addDependentField(field);
+			field->source_fields[0]->removeDependentField(field);
 			REACCESS(Computed_field)(&(field->source_fields[0]), domain_field);
 			return CMZN_OK;
 		}
@@ -15,6 +15,12 @@ and the nodes for 1D elements.
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include <math.h>
 #include <stdio.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "opencmiss/zinc/fieldmeshoperators.h"
 #include "opencmiss/zinc/fieldmodule.h"
 #include "opencmiss/zinc/mesh.h"
 #include "computed_field/computed_field.h"
@@ -22,16 +28,15 @@ and the nodes for 1D elements.
 #include "computed_field/computed_field_finite_element.h"
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/computed_field_set.h"
+#include "datastore/labelschangelog.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_mesh.hpp"
+#include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
 #include "finite_element/finite_element_adjacent_elements.h"
 #include "general/compare.h"
 #include "general/debug.h"
 #include "general/mystring.h"
-#include "general/indexed_list_private.h"
-#include "general/indexed_multi_range.h"
-#include "general/list_private.h"
 #include "general/message.h"
 #include "computed_field/computed_field_integration.h"
 #include "mesh/cmiss_element_private.hpp"
@@ -44,287 +49,71 @@ public:
 	cmzn_region *root_region;
 };
 
-struct Computed_field_element_integration_mapping
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-==============================================================================*/
-{
-	/* Holds the pointer to the element */
-	FE_element *element;
-	/* The values for the xi1 = 0, xi2 = 0, xi3 = 0 corner,
-		a vector of size number_of_components. */
-	FE_value *values;
-
-	int access_count;
-}; /* Computed_field_element_integration_mapping */
-
-struct Computed_field_node_integration_mapping
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-==============================================================================*/
-{
-	/* Holds the pointer to the node, can't use node as this is a symbol in the LISTS */
-	FE_node *node_ptr;
-	/* The field values for the node. */
-	FE_value *values;
-
-	int access_count;
-}; /* Computed_field_node_integration_mapping */
-
-struct Computed_field_element_integration_mapping_fifo
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-Simple linked-list node structure for building a FIFO stack for the mapping
-structure - needed for consistent growth of integration.
-==============================================================================*/
-{
-	Computed_field_element_integration_mapping *mapping_item;
-	Computed_field_element_integration_mapping_fifo *next;
-}; /* Computed_field_element_integration_mapping_fifo */
-
-struct Computed_field_integration_has_values_data
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-==============================================================================*/
-{
-	int number_of_values;
-	FE_value *values;
-}; /* Computed_field_integration_has_values_data */
-
-Computed_field_element_integration_mapping *CREATE(Computed_field_element_integration_mapping)
-	(FE_element *element, int number_of_components)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-Creates a basic Computed_field with the given <name>. Its type is initially
-COMPUTED_FIELD_CONSTANT with 1 component, returning a value of zero.
-==============================================================================*/
-{
-	int i;
-	Computed_field_element_integration_mapping *mapping_item;
-
-	ENTER(CREATE(Computed_field_element_integration_mapping));
-
-	if (element &&
-		ALLOCATE(mapping_item,Computed_field_element_integration_mapping,1) &&
-		ALLOCATE(mapping_item->values, FE_value, number_of_components))
-	{
-		mapping_item->element = ACCESS(FE_element)(element);
-		for (i = 0 ; i < number_of_components ; i++)
-		{
-			mapping_item->values[i] = 0.0;
-		}
-		mapping_item->access_count = 0;
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"CREATE(Computed_field_element_integration_mapping).  Not enough memory");
-		mapping_item = (Computed_field_element_integration_mapping *)NULL;
-	}
-	LEAVE;
-
-	return (mapping_item);
-} /* CREATE(Computed_field_element_integration_mapping) */
-
-int DESTROY(Computed_field_element_integration_mapping)
-	  (Computed_field_element_integration_mapping **mapping_address)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-Frees memory/deaccess mapping at <*mapping_address>.
-==============================================================================*/
-{
-	int return_code;
-
-	ENTER(DESTROY(Computed_field_element_integration_mapping));
-	if (mapping_address&&*mapping_address)
-	{
-		if (0 >= (*mapping_address)->access_count)
-		{
-			if ((*mapping_address)->element)
-			{
-				DEACCESS(FE_element)(&((*mapping_address)->element));
-			}
-			DEALLOCATE((*mapping_address)->values);
-			DEALLOCATE(*mapping_address);
-			return_code=1;
-		}
-		else
-		{
-			display_message(ERROR_MESSAGE,
-				"DESTROY(Computed_field_element_integration_mapping).  Positive access_count");
-			return_code=0;
-		}
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"DESTROY(Computed_field_element_integration_mapping).  Missing mapping");
-		return_code=0;
-	}
-	LEAVE;
-
-	return (return_code);
-} /* DESTROY(Computed_field_element_integration_mapping) */
-
-DECLARE_OBJECT_FUNCTIONS(Computed_field_element_integration_mapping)
-DECLARE_LIST_TYPES(Computed_field_element_integration_mapping);
-FULL_DECLARE_INDEXED_LIST_TYPE(Computed_field_element_integration_mapping);
-DECLARE_INDEXED_LIST_MODULE_FUNCTIONS(Computed_field_element_integration_mapping,
-  element,FE_element *,compare_pointer)
-DECLARE_INDEXED_LIST_FUNCTIONS(Computed_field_element_integration_mapping)
-DECLARE_FIND_BY_IDENTIFIER_IN_INDEXED_LIST_FUNCTION(
-	Computed_field_element_integration_mapping,
-	element,FE_element *,compare_pointer)
-
-Computed_field_node_integration_mapping *CREATE(Computed_field_node_integration_mapping)
-	(FE_node *node, int number_of_components)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-Creates a basic Computed_field with the given <name>. Its type is initially
-COMPUTED_FIELD_CONSTANT with 1 component, returning a value of zero.
-==============================================================================*/
-{
-	int i;
-	Computed_field_node_integration_mapping *mapping_item;
-
-	ENTER(CREATE(Computed_field_node_integration_mapping));
-
-	if (node &&
-		ALLOCATE(mapping_item,Computed_field_node_integration_mapping,1) &&
-		ALLOCATE(mapping_item->values, FE_value, number_of_components))
-	{
-		mapping_item->node_ptr = ACCESS(FE_node)(node);
-		for (i = 0 ; i < number_of_components ; i++)
-		{
-			mapping_item->values[i] = 0.0;
-		}
-		mapping_item->access_count = 0;
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"CREATE(Computed_field_node_integration_mapping).  Not enough memory");
-		mapping_item = (Computed_field_node_integration_mapping *)NULL;
-	}
-	LEAVE;
-
-	return (mapping_item);
-} /* CREATE(Computed_field_node_integration_mapping) */
-
-int DESTROY(Computed_field_node_integration_mapping)
-	  (Computed_field_node_integration_mapping **mapping_address)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-Frees memory/deaccess mapping at <*mapping_address>.
-==============================================================================*/
-{
-	int return_code;
-
-	ENTER(DESTROY(Computed_field_node_integration_mapping));
-	if (mapping_address&&*mapping_address)
-	{
-		if (0 >= (*mapping_address)->access_count)
-		{
-			if ((*mapping_address)->node_ptr)
-			{
-				DEACCESS(FE_node)(&((*mapping_address)->node_ptr));
-			}
-			DEALLOCATE((*mapping_address)->values);
-			DEALLOCATE(*mapping_address);
-			return_code=1;
-		}
-		else
-		{
-			display_message(ERROR_MESSAGE,
-				"DESTROY(Computed_field_node_integration_mapping).  Positive access_count");
-			return_code=0;
-		}
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"DESTROY(Computed_field_node_integration_mapping).  Missing mapping");
-		return_code=0;
-	}
-	LEAVE;
-
-	return (return_code);
-} /* DESTROY(Computed_field_node_integration_mapping) */
-
-DECLARE_OBJECT_FUNCTIONS(Computed_field_node_integration_mapping)
-DECLARE_LIST_TYPES(Computed_field_node_integration_mapping);
-FULL_DECLARE_INDEXED_LIST_TYPE(Computed_field_node_integration_mapping);
-DECLARE_INDEXED_LIST_MODULE_FUNCTIONS(Computed_field_node_integration_mapping,
-  node_ptr,FE_node *,compare_pointer)
-DECLARE_INDEXED_LIST_FUNCTIONS(Computed_field_node_integration_mapping)
-DECLARE_FIND_BY_IDENTIFIER_IN_INDEXED_LIST_FUNCTION(
-	Computed_field_node_integration_mapping,
-	node_ptr,FE_node *,compare_pointer)
-
-int write_Computed_field_element_integration_mapping(
-	Computed_field_element_integration_mapping *mapping,
-	void *user_data)
-{
-	USE_PARAMETER(user_data);
-	printf("Mapping %p Element %p (%f)\n",
-		mapping, mapping->element, mapping->values[0]);
-
-	return( 1 );
-}
-
 const char computed_field_integration_type_string[] = "integration";
 const char computed_field_xi_texture_coordinates_type_string[] = "xi_texture_coordinates";
 
+/**
+ * Integrates along paths from the xi = 0 corner of the seed element, through
+ * faces of 2D and 3D elements or nodes of 1D elements, to any location in
+ * elements reached from it. The values at the xi = 0 corner of reached
+ * elements and at nodes of line elements are held in arrays indexed by
+ * element and node index. Elements are reached in order of distance from the
+ * seed, summing the magnitude of change in integrated values between them, so
+ * each element's values are integrated along its shortest path. After changes
+ * to some nodes or elements only elements whose paths pass through them are
+ * recalculated.
+ */
 class Computed_field_integration : public Computed_field_core
 {
 public:
-	FE_value cached_time;
 	cmzn_mesh_id mesh;
 	cmzn_element_id seed_element;
 	/* Whether to integrate wrt to each coordinate separately or wrt the
 		magnitude of the coordinate field */
 	int magnitude_coordinates;
-	LIST(Computed_field_element_integration_mapping) *texture_mapping;
-	LIST(Computed_field_node_integration_mapping) *node_mapping;
-	/* last mapping successfully used by Computed_field_find_element_xi so
-		that it can first try this element again */
-	Computed_field_element_integration_mapping *find_element_xi_mapping;
 
 	Computed_field_integration(cmzn_mesh_id mesh, cmzn_element_id seed_element,
 		int magnitude_coordinates) :
 		Computed_field_core(),
 		mesh(cmzn_mesh_access(mesh)),
 		seed_element(seed_element->access()),
-		magnitude_coordinates(magnitude_coordinates)
+		magnitude_coordinates(magnitude_coordinates),
+		mappingValid(false),
+		cached_time(0),
+		nodeElementsValid(false),
+		changedElements(0)
 	{
-		cached_time = 0;
-		texture_mapping =
-			(LIST(Computed_field_element_integration_mapping) *)NULL;
-		node_mapping =
-			(LIST(Computed_field_node_integration_mapping) *)NULL;
-		find_element_xi_mapping=
-			(Computed_field_element_integration_mapping *)NULL;
 	};
 
 	~Computed_field_integration();
 
 private:
+	/* elements to process with their distance from the seed, nearest first */
+	typedef std::pair<FE_value, DsLabelIndex> QueueItem;
+	typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > Queue;
+
+	bool mappingValid;
+	FE_value cached_time;
+	/* following are indexed by element index in the seed element's mesh */
+	/* values at the xi = 0 corner of reached elements, number_of_components each */
+	std::vector<FE_value> elementValues;
+	/* distance from the seed element, negative if not reached */
+	std::vector<FE_value> elementDistances;
+	/* previous element on path from the seed element */
+	std::vector<DsLabelIndex> elementPathParents;
+	/* following are indexed by node index in the mesh's nodeset */
+	std::vector<FE_value> nodeValues;
+	/* distance of element node values are integrated from, negative if not reached */
+	std::vector<FE_value> nodeDistances;
+	std::vector<DsLabelIndex> nodeSourceElements;
+	/* false if element nodes may have changed since node elements were calculated */
+	bool nodeElementsValid;
+	/* elements using node index n are from nodeElementsStart[n] to nodeElementsStart[n + 1] - 1 */
+	std::vector<DsLabelIndex> nodeElementsStart;
+	std::vector<DsLabelIndex> nodeElements;
+	/* reached elements changed since the mapping was calculated, or 0 if none */
+	DsLabelsGroup *changedElements;
+
 	Computed_field_core *copy();
 
 	const char *get_type_string()
@@ -344,25 +133,40 @@ private:
 		int magnitude_coordinates, Computed_field *coordinate_field,
 		FE_value *values);
 
-	int add_neighbours(cmzn_fieldcache& workingCache,
-		Computed_field_element_integration_mapping *mapping_item,
-		LIST(Computed_field_element_integration_mapping) *texture_mapping,
-		Computed_field_element_integration_mapping_fifo **last_to_be_checked,
-		Computed_field *integrand,
-		int magnitude_coordinates, Computed_field *coordinate_field,
+	bool get_adjacent_elements(FE_element *element, int face_index,
 		AdjacentElements1d **adjacentElements1d,
-		LIST(Computed_field_element_integration_mapping) *previous_texture_mapping,
-		ZnReal time_step,
-		LIST(Computed_field_node_integration_mapping) *node_mapping);
+		int *number_of_neighbour_elements, FE_element ***neighbour_elements);
+
+	int add_neighbours(cmzn_fieldcache& workingCache, FE_mesh& feMesh,
+		DsLabelIndex elementIndex, Queue& queue,
+		AdjacentElements1d **adjacentElements1d);
+
+	int propagate_mapping(FE_mesh& feMesh, Queue& queue);
+
+	void clear_mapping();
+
+	void calculate_node_elements(FE_mesh& feMesh);
 
 	int calculate_mapping(FE_value time);
 
-	int clear_cache();
+	int recalculate_changed_elements();
+
+	int update_mapping(FE_value time);
+
+	void add_changed_elements(FE_mesh& feMesh, DsLabelsChangeLog& elementChangeLog);
 
 	bool is_defined_at_location(cmzn_fieldcache& cache);
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	/* the mesh adjacency is a dependency */
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
+
+	virtual int check_dependency();
+
 };
 
 int Computed_field_integration::integrate_path(FE_element *element,
@@ -486,435 +290,588 @@ time is supplied in the workingCache
 	return(return_code);
 } /* Computed_field_integration_integrate_path */
 
-int Computed_field_integration::add_neighbours(cmzn_fieldcache& workingCache,
-	Computed_field_element_integration_mapping *mapping_item,
-	LIST(Computed_field_element_integration_mapping) *texture_mapping,
-	Computed_field_element_integration_mapping_fifo **last_to_be_checked,
-	Computed_field *integrand,
-	int magnitude_coordinates, Computed_field *coordinate_field,
-	AdjacentElements1d **adjacentElements1d,
-	LIST(Computed_field_element_integration_mapping) *previous_texture_mapping,
-	ZnReal time_step,
-	LIST(Computed_field_node_integration_mapping) *node_mapping)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
+/**
+ * Get the elements adjacent to <element> across the face with xi = 0 for
+ * even <face_index>, or xi = 1 for odd <face_index> in xi direction
+ * <face_index>/2. Uses the nodes to find adjacent 1D elements, otherwise the
+ * faces.
+ * @param adjacentElements1d  Address of node adjacency for 1D elements;
+ * created on demand, to be deleted by caller.
+ * @param neighbour_elements  On success set to allocated array of elements,
+ * to be deallocated by caller.
+ * @return  True if any adjacent elements found, otherwise false.
+ */
+bool Computed_field_integration::get_adjacent_elements(FE_element *element,
+	int face_index, AdjacentElements1d **adjacentElements1d,
+	int *number_of_neighbour_elements, FE_element ***neighbour_elements)
+{
+	*number_of_neighbour_elements = 0;
+	if (get_FE_element_dimension(element) == 1)
+	{
+		if (!(*adjacentElements1d))
+		{
+			*adjacentElements1d = AdjacentElements1d::create(mesh, field->source_fields[1]);
+		}
+		if (!(*adjacentElements1d && (*adjacentElements1d)->getAdjacentElements(element, face_index,
+			number_of_neighbour_elements, neighbour_elements)))
+		{
+			*number_of_neighbour_elements = 0;
+		}
+	}
+	else
+	{
+		/* need an xi location to find the appropriate face for */
+		FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 0.5, 0.5, 0.5 };
+		xi[face_index / 2] = (face_index % 2) ? 1.0 : 0.0;
+		int face_number;
+		if (!(FE_element_shape_find_face_number_for_xi(get_FE_element_shape(element), xi, &face_number) &&
+			(CMZN_OK == adjacent_FE_element(element, face_number,
+				number_of_neighbour_elements, neighbour_elements))))
+		{
+			*number_of_neighbour_elements = 0;
+		}
+	}
+	if ((*number_of_neighbour_elements) <= 0)
+	{
+		*number_of_neighbour_elements = 0;
+		return false;
+	}
+	return true;
+}
 
-DESCRIPTION :
-Add the neighbours that haven't already been put in the texture_mapping list and
-puts each new member in the texture_mapping list and the to_be_checked list.
-If <previous_texture_mapping> is set then this is being used to update a time
-varying integration and the behaviour is significantly different.
-time is supplied in the workingCache.
-==============================================================================*/
+/**
+ * Integrates from the xi = 0 corner of the element at <elementIndex> to the
+ * xi = 0 corners of its neighbours, updating and adding to the <queue> those
+ * not yet reached or reached by a longer path. For line elements also
+ * integrates to element nodes not reached from a nearer element.
+ * time is supplied in the workingCache.
+ * @return  CMZN_OK on success, otherwise an error code.
+ */
+int Computed_field_integration::add_neighbours(cmzn_fieldcache& workingCache,
+	FE_mesh& feMesh, DsLabelIndex elementIndex, Queue& queue,
+	AdjacentElements1d **adjacentElements1d)
 {
 	FE_value final_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
-		initial_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
-		xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-	int element_dimension, face_number, i, j, k, number_of_components,
-		number_of_element_field_nodes, number_of_faces,
-		number_of_neighbour_elements, return_code;
-	Computed_field_element_integration_mapping *mapping_neighbour;
-	Computed_field_element_integration_mapping_fifo *fifo_node;
-	Computed_field_node_integration_mapping *node_map;
-	FE_element *integrate_element = NULL, **neighbour_elements;
-	FE_element_shape *shape;
+		initial_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	int i, j, k, number_of_element_field_nodes, number_of_neighbour_elements;
+	FE_element *integrate_element, **neighbour_elements;
 	FE_field *fe_field;
 	FE_node **element_field_nodes_array;
 	LIST(FE_field) *fe_field_list;
 
-	ENTER(Computed_field_integration_add_neighbours);
-	if (mapping_item && texture_mapping && last_to_be_checked &&
-		(*last_to_be_checked))
+	FE_element *element = feMesh.getElement(elementIndex);
+	if (!element)
 	{
-		return_code=CMZN_OK;
-		element_dimension = get_FE_element_dimension(mapping_item->element);
-		number_of_faces = element_dimension*2;
-		if (magnitude_coordinates)
-		{
-			number_of_components = 1;
-		}
-		else
+		display_message(ERROR_MESSAGE,
+			"Computed_field_integration::add_neighbours.  Invalid argument(s)");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	Computed_field *integrand = field->source_fields[0];
+	Computed_field *coordinate_field = field->source_fields[1];
+	const int number_of_components = field->number_of_components;
+	const FE_value distance = this->elementDistances[elementIndex];
+	FE_value *values = this->elementValues.data() + elementIndex*number_of_components;
+	std::vector<FE_value> neighbourValues(number_of_components);
+	int return_code = CMZN_OK;
+	const int element_dimension = get_FE_element_dimension(element);
+	const int number_of_faces = element_dimension*2;
+	for (i = 0; (return_code == CMZN_OK) && (i < number_of_faces); i++)
+	{
+		if (!this->get_adjacent_elements(element, i, adjacentElements1d,
+			&number_of_neighbour_elements, &neighbour_elements))
 		{
-			number_of_components = Computed_field_get_number_of_components(
-				coordinate_field);
+			continue;
 		}
-		for (i = 0; (return_code == CMZN_OK)&&(i<number_of_faces);i++)
+		for (j = 0 ; (return_code == CMZN_OK) && (j < number_of_neighbour_elements) ; j++)
 		{
-			if (element_dimension == 1)
+			const DsLabelIndex neighbourIndex = get_FE_element_index(neighbour_elements[j]);
+			if ((neighbour_elements[j]->getMesh() != &feMesh) || (neighbourIndex < 0) ||
+				(neighbourIndex >= static_cast<DsLabelIndex>(this->elementDistances.size())))
 			{
-				// if we have 1D elements then we use the nodes to get to the
-				// adjacent elements; normally use the faces
-				if (!(*adjacentElements1d))
-				{
-					*adjacentElements1d = AdjacentElements1d::create(mesh, coordinate_field);
-				}
-				if (!(*adjacentElements1d && (*adjacentElements1d)->getAdjacentElements(mapping_item->element, i,
-					&number_of_neighbour_elements, &neighbour_elements)))
-				{
-					number_of_neighbour_elements = 0;
-				}
+				continue;
+			}
+			for (k = 0 ; k < element_dimension ; k++)
+			{
+				initial_xi[k] = 0.0;
+				final_xi[k] = 0.0;
+			}
+			if (0 == (i % 2))
+			{
+				initial_xi[i / 2] = 1.0;
+				integrate_element = neighbour_elements[j];
 			}
 			else
 			{
-				/* else we need an xi location to find the appropriate face for */
-				xi[0] = 0.5;
-				xi[1] = 0.5;
-				xi[2] = 0.5;
-				switch (i)
+				final_xi[i / 2] = 1.0;
+				integrate_element = element;
+			}
+			if (!integrate_path(integrate_element,
+				values, initial_xi, final_xi,
+				/*number_of_gauss_points*/2, workingCache, integrand,
+				magnitude_coordinates, coordinate_field,
+				neighbourValues.data()))
+			{
+				return_code = CMZN_ERROR_GENERAL;
+				break;
+			}
+			FE_value distanceSquared = 0.0;
+			for (k = 0 ; k < number_of_components ; k++)
+			{
+				const FE_value delta = neighbourValues[k] - values[k];
+				distanceSquared += delta*delta;
+			}
+			const FE_value neighbourDistance = distance + sqrt(distanceSquared);
+			if ((this->elementDistances[neighbourIndex] < 0.0) ||
+				(neighbourDistance < this->elementDistances[neighbourIndex]))
+			{
+				std::copy(neighbourValues.begin(), neighbourValues.end(),
+					this->elementValues.begin() + neighbourIndex*number_of_components);
+				this->elementDistances[neighbourIndex] = neighbourDistance;
+				this->elementPathParents[neighbourIndex] = elementIndex;
+				queue.push(QueueItem(neighbourDistance, neighbourIndex));
+			}
+		}
+		DEALLOCATE(neighbour_elements);
+	}
+	if (CMZN_OK != return_code)
+	{
+		display_message(ERROR_MESSAGE,
+			"Computed_field_integration::add_neighbours.  Failed to integrate field %s",
+			field->name);
+		return return_code;
+	}
+	/* Try to add mappings for nodes too. */
+	if ((fe_field_list = Computed_field_get_defining_FE_field_list(coordinate_field))
+		&& (1 == NUMBER_IN_LIST(FE_field)(fe_field_list)))
+	{
+		fe_field = FIRST_OBJECT_IN_LIST_THAT(FE_field)(
+			(LIST_CONDITIONAL_FUNCTION(FE_field) *)NULL, (void *)NULL,
+			fe_field_list);
+	}
+	else
+	{
+		/* We would like this to work for xi and other computed fields that
+			have no fe_fields so we use the 'feature' that allows us to pass NULL */
+		fe_field = (FE_field *)NULL;
+	}
+	if (fe_field_list)
+	{
+		DESTROY(LIST(FE_field))(&fe_field_list);
+	}
+	if (FE_element_shape_is_line(get_FE_element_shape(element))
+		&& (CMZN_OK == calculate_FE_element_field_nodes(element,
+			/*inherit_face_number*/-1,
+			fe_field, &number_of_element_field_nodes,
+			&element_field_nodes_array, element)))
+	{
+		/* Make assumptions about the distribution of the nodes */
+		if (number_of_element_field_nodes == pow(2.0, element_dimension))
+		{
+			for (i = 0 ; i < number_of_element_field_nodes ; i++)
+			{
+				const DsLabelIndex nodeIndex = get_FE_node_index(element_field_nodes_array[i]);
+				if ((nodeIndex < 0) || (FE_node_get_FE_nodeset(element_field_nodes_array[i]) != feMesh.getNodeset()))
 				{
-					case 0:
-					{
-						xi[0] = 0.0;
-					} break;
-					case 1:
-					{
-						xi[0] = 1.0;
-					} break;
-					case 2:
-					{
-						xi[1] = 0.0;
-					} break;
-					case 3:
-					{
-						xi[1] = 1.0;
-					} break;
-					case 4:
-					{
-						xi[2] = 0.0;
-					} break;
-					case 5:
-					{
-						xi[2] = 1.0;
-					} break;
+					continue;
 				}
-				shape = get_FE_element_shape(mapping_item->element);
-				if (!(FE_element_shape_find_face_number_for_xi(shape, xi, &face_number) &&
-					(((CMZN_OK == adjacent_FE_element(mapping_item->element, face_number,
-						&number_of_neighbour_elements, &neighbour_elements))))))
+				if (nodeIndex >= static_cast<DsLabelIndex>(this->nodeDistances.size()))
 				{
-					number_of_neighbour_elements = 0;
+					this->nodeValues.resize((nodeIndex + 1)*number_of_components, 0.0);
+					this->nodeDistances.resize(nodeIndex + 1, -1.0);
+					this->nodeSourceElements.resize(nodeIndex + 1, DS_LABEL_INDEX_INVALID);
 				}
-			}
-			if (number_of_neighbour_elements)
-			{
-				for (j = 0 ; j < number_of_neighbour_elements ; j++)
+				/* Add nodes not already reached from a nearer element */
+				if ((this->nodeDistances[nodeIndex] < 0.0) || (distance < this->nodeDistances[nodeIndex]))
 				{
-					if(!(mapping_neighbour = FIND_BY_IDENTIFIER_IN_LIST(
-						Computed_field_element_integration_mapping, element)
-						(neighbour_elements[j], texture_mapping)))
+					for (k = 0 ; k < element_dimension ; k++)
 					{
-						if (ALLOCATE(fifo_node,
-							Computed_field_element_integration_mapping_fifo,1)&&
-							(mapping_neighbour =
-								CREATE(Computed_field_element_integration_mapping)(
-									neighbour_elements[j], number_of_components)))
+						initial_xi[k] = 0.0;
+						if (i & (1 << k))
 						{
-							for (k = 0 ; k < element_dimension ; k++)
-							{
-								initial_xi[k] = 0.0;
-								final_xi[k] = 0.0;
-							}
-							switch (i)
-							{
-								case 0:
-								case 2:
-								case 4:
-								{
-									initial_xi[i / 2] = 1.0;
-									integrate_element = mapping_neighbour->element;
-								} break;
-								case 1:
-								case 3:
-								case 5:
-								{
-									final_xi[(i - 1)/ 2] = 1.0;
-									integrate_element = mapping_item->element;
-								} break;
-							}
-							integrate_path(integrate_element,
-								mapping_item->values, initial_xi, final_xi,
-								/*number_of_gauss_points*/2, workingCache, integrand,
-								magnitude_coordinates, coordinate_field,
-								mapping_neighbour->values);
-							USE_PARAMETER(previous_texture_mapping);
-							USE_PARAMETER(time_step);
-							if (ADD_OBJECT_TO_LIST(Computed_field_element_integration_mapping)(
-								mapping_neighbour, texture_mapping))
-							{
-								/* fill the fifo_node for the mapping_item; put at end of list */
-								fifo_node->mapping_item=mapping_neighbour;
-								fifo_node->next=
-									(Computed_field_element_integration_mapping_fifo *)NULL;
-								(*last_to_be_checked)->next = fifo_node;
-								(*last_to_be_checked) = fifo_node;
-							}
-							else
-							{
-								printf("Error adding neighbour\n");
-								write_Computed_field_element_integration_mapping(mapping_neighbour, NULL);
-								printf("Texture mapping list\n");
-								FOR_EACH_OBJECT_IN_LIST(Computed_field_element_integration_mapping)(
-									write_Computed_field_element_integration_mapping, NULL, texture_mapping);
-								DEALLOCATE(fifo_node);
-								DESTROY(Computed_field_element_integration_mapping)(
-									&mapping_neighbour);
-								return_code=CMZN_ERROR_GENERAL;
-							}
+							final_xi[k] = 1.0;
 						}
 						else
 						{
-							display_message(ERROR_MESSAGE,
-								"Computed_field_set_type_integration.  "
-								"Unable to allocate member");
-							DEALLOCATE(fifo_node);
-							return_code=CMZN_ERROR_MEMORY;
+							final_xi[k] = 0.0;
 						}
 					}
+					integrate_path(element,
+						values, initial_xi, final_xi,
+						/*number_of_gauss_points*/2, workingCache, integrand,
+						magnitude_coordinates, coordinate_field,
+						this->nodeValues.data() + nodeIndex*number_of_components);
+					this->nodeDistances[nodeIndex] = distance;
+					this->nodeSourceElements[nodeIndex] = elementIndex;
 				}
-				DEALLOCATE(neighbour_elements);
 			}
 		}
-		/* Try to add mappings for nodes too. */
-		if ((fe_field_list = Computed_field_get_defining_FE_field_list(coordinate_field))
-			&& (1 == NUMBER_IN_LIST(FE_field)(fe_field_list)))
+		/* else we don't know what we are looking at so don't do anything */
+
+		for (i = 0 ; i < number_of_element_field_nodes ; i++)
+		{
+			DEACCESS(FE_node)(element_field_nodes_array + i);
+		}
+		DEALLOCATE(element_field_nodes_array);
+	}
+	return (return_code);
+}
+
+/**
+ * Processes elements in the queue, nearest first, until all elements
+ * reachable from them are at their shortest distance from the seed.
+ * Entries for elements since reached by a shorter path are skipped.
+ */
+int Computed_field_integration::propagate_mapping(FE_mesh& feMesh, Queue& queue)
+{
+	// use a temporary working cache
+	cmzn_fieldmodule_id field_module = cmzn_field_get_fieldmodule(field);
+	cmzn_fieldcache_id field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
+	field_cache->setTime(this->cached_time);
+	AdjacentElements1d *adjacentElements1d = 0;
+	int return_code = CMZN_OK;
+	while ((CMZN_OK == return_code) && (!queue.empty()))
+	{
+		const QueueItem item = queue.top();
+		queue.pop();
+		if (item.first == this->elementDistances[item.second])
+		{
+			return_code = this->add_neighbours(*field_cache, feMesh, item.second,
+				queue, &adjacentElements1d);
+		}
+	}
+	delete adjacentElements1d;
+	cmzn_fieldcache_destroy(&field_cache);
+	cmzn_fieldmodule_destroy(&field_module);
+	return return_code;
+}
+
+/** Clear mapping so it is fully calculated when next evaluated. */
+void Computed_field_integration::clear_mapping()
+{
+	this->mappingValid = false;
+	this->elementValues.clear();
+	this->elementDistances.clear();
+	this->elementPathParents.clear();
+	this->nodeValues.clear();
+	this->nodeDistances.clear();
+	this->nodeSourceElements.clear();
+	this->nodeElementsValid = false;
+	this->nodeElementsStart.clear();
+	this->nodeElements.clear();
+	cmzn::Deaccess(this->changedElements);
+}
+
+/**
+ * Calculates the elements of the mesh using each node, so elements affected by
+ * node changes are found without visiting all elements.
+ */
+void Computed_field_integration::calculate_node_elements(FE_mesh& feMesh)
+{
+	// get unique node-element pairs ordered by node then element
+	std::vector<std::pair<DsLabelIndex, DsLabelIndex> > nodeElementPairs;
+	const DsLabelIndex elementIndexLimit = feMesh.getLabelsIndexSize();
+	const int eftDataCount = feMesh.getElementfieldtemplateDataCount();
+	for (int e = 0; e < eftDataCount; ++e)
+	{
+		const FE_mesh_element_field_template_data *eftData = feMesh.getElementfieldtemplateData(e);
+		if (!eftData)
+			continue;
+		const int localNodeCount = eftData->getElementfieldtemplate()->getNumberOfLocalNodes();
+		for (DsLabelIndex elementIndex = 0; elementIndex < elementIndexLimit; ++elementIndex)
+		{
+			const DsLabelIndex *nodeIndexes = eftData->getElementNodeIndexes(elementIndex);
+			if (nodeIndexes)
+				for (int n = 0; n < localNodeCount; ++n)
+					if (nodeIndexes[n] >= 0)
+						nodeElementPairs.push_back(std::make_pair(nodeIndexes[n], elementIndex));
+		}
+	}
+	this->nodeElementsValid = true;
+	this->nodeElementsStart.clear();
+	this->nodeElements.clear();
+	if (nodeElementPairs.empty())
+		return;
+	std::sort(nodeElementPairs.begin(), nodeElementPairs.end());
+	nodeElementPairs.erase(std::unique(nodeElementPairs.begin(), nodeElementPairs.end()), nodeElementPairs.end());
+	const size_t pairsCount = nodeElementPairs.size();
+	this->nodeElementsStart.assign(nodeElementPairs[pairsCount - 1].first + 2, 0);
+	this->nodeElements.reserve(pairsCount);
+	for (size_t i = 0; i < pairsCount; ++i)
+	{
+		++(this->nodeElementsStart[nodeElementPairs[i].first + 1]);
+		this->nodeElements.push_back(nodeElementPairs[i].second);
+	}
+	const size_t startCount = this->nodeElementsStart.size();
+	for (size_t n = 1; n < startCount; ++n)
+		this->nodeElementsStart[n] += this->nodeElementsStart[n - 1];
+}
+
+/***************************************************************************//**
+ * Calculates the mapping from the seed element at the given time.
+ */
+int Computed_field_integration::calculate_mapping(FE_value time)
+{
+	this->clear_mapping();
+	FE_mesh *feMesh = (field) ? this->seed_element->getMesh() : 0;
+	if (!feMesh)
+	{
+		display_message(ERROR_MESSAGE,
+			"Computed_field_integration::calculate_mapping.  "
+			"Invalid arguments.");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	this->cached_time = time;
+	const int number_of_components = field->number_of_components;
+	const DsLabelIndex elementIndexSize = feMesh->getLabelsIndexSize();
+	this->elementValues.assign(elementIndexSize*number_of_components, 0.0);
+	this->elementDistances.assign(elementIndexSize, -1.0);
+	this->elementPathParents.assign(elementIndexSize, DS_LABEL_INDEX_INVALID);
+	FE_nodeset *feNodeset = feMesh->getNodeset();
+	const DsLabelIndex nodeIndexSize = (feNodeset) ? feNodeset->getLabels().getIndexSize() : 0;
+	this->nodeValues.assign(nodeIndexSize*number_of_components, 0.0);
+	this->nodeDistances.assign(nodeIndexSize, -1.0);
+	this->nodeSourceElements.assign(nodeIndexSize, DS_LABEL_INDEX_INVALID);
+	const DsLabelIndex seedIndex = get_FE_element_index(this->seed_element);
+	this->elementDistances[seedIndex] = 0.0;
+	Queue queue;
+	queue.push(QueueItem(0.0, seedIndex));
+	const int return_code = this->propagate_mapping(*feMesh, queue);
+	if (CMZN_OK == return_code)
+	{
+		this->calculate_node_elements(*feMesh);
+		this->mappingValid = true;
+	}
+	else
+	{
+		this->clear_mapping();
+	}
+	return (return_code);
+}
+
+/**
+ * Recalculates the mapping for elements whose paths from the seed pass
+ * through changed elements, restarting from their unchanged neighbours.
+ * Reverts to full calculation if the seed element has changed.
+ */
+int Computed_field_integration::recalculate_changed_elements()
+{
+	FE_mesh *feMesh = this->seed_element->getMesh();
+	const DsLabelIndex seedIndex = get_FE_element_index(this->seed_element);
+	const DsLabelIndex elementIndexSize = static_cast<DsLabelIndex>(this->elementDistances.size());
+	if ((!feMesh) || (seedIndex < 0) || (seedIndex >= elementIndexSize))
+	{
+		return this->calculate_mapping(this->cached_time);
+	}
+	// 0 = not determined, 1 = unchanged, 2 = changed, 3 = unchanged and queued
+	std::vector<char> elementChange(elementIndexSize, 0);
+	DsLabelIndex elementIndex = DS_LABEL_INDEX_INVALID;
+	while (this->changedElements->incrementIndex(elementIndex) && (elementIndex < elementIndexSize))
+	{
+		elementChange[elementIndex] = 2;
+	}
+	cmzn::Deaccess(this->changedElements);
+	if (2 == elementChange[seedIndex])
+	{
+		return this->calculate_mapping(this->cached_time);
+	}
+	elementChange[seedIndex] = 1;
+	// elements are changed if any element on their path from the seed is
+	std::vector<DsLabelIndex> path;
+	for (elementIndex = 0; elementIndex < elementIndexSize; ++elementIndex)
+	{
+		if (this->elementDistances[elementIndex] < 0.0)
+		{
+			continue;
+		}
+		DsLabelIndex index = elementIndex;
+		while (0 == elementChange[index])
+		{
+			path.push_back(index);
+			index = this->elementPathParents[index];
+		}
+		const char change = elementChange[index];
+		for (std::vector<DsLabelIndex>::iterator iter = path.begin(); iter != path.end(); ++iter)
+		{
+			elementChange[*iter] = change;
+		}
+		path.clear();
+	}
+	for (elementIndex = 0; elementIndex < elementIndexSize; ++elementIndex)
+	{
+		if (2 == elementChange[elementIndex])
+		{
+			this->elementDistances[elementIndex] = -1.0;
+			this->elementPathParents[elementIndex] = DS_LABEL_INDEX_INVALID;
+		}
+	}
+	const DsLabelIndex nodeIndexSize = static_cast<DsLabelIndex>(this->nodeDistances.size());
+	for (DsLabelIndex nodeIndex = 0; nodeIndex < nodeIndexSize; ++nodeIndex)
+	{
+		const DsLabelIndex sourceIndex = this->nodeSourceElements[nodeIndex];
+		if ((sourceIndex >= 0) && (2 == elementChange[sourceIndex]))
 		{
-			fe_field = FIRST_OBJECT_IN_LIST_THAT(FE_field)(
-				(LIST_CONDITIONAL_FUNCTION(FE_field) *)NULL, (void *)NULL,
-				fe_field_list);
+			this->nodeDistances[nodeIndex] = -1.0;
+			this->nodeSourceElements[nodeIndex] = DS_LABEL_INDEX_INVALID;
 		}
-		else
+	}
+	Queue queue;
+	AdjacentElements1d *adjacentElements1d = 0;
+	int number_of_neighbour_elements;
+	FE_element **neighbour_elements;
+	for (elementIndex = 0; elementIndex < elementIndexSize; ++elementIndex)
+	{
+		if (2 != elementChange[elementIndex])
 		{
-			/* We would like this to work for xi and other computed fields that
-				have no fe_fields so we use the 'feature' that allows us to pass NULL */
-			fe_field = (FE_field *)NULL;
+			continue;
 		}
-		if (fe_field_list)
+		FE_element *element = feMesh->getElement(elementIndex);
+		if (!element)
 		{
-			DESTROY(LIST(FE_field))(&fe_field_list);
+			continue;
 		}
-		shape = get_FE_element_shape(mapping_item->element);
-		if (node_mapping
-			&& FE_element_shape_is_line(shape)
-			&& (CMZN_OK == calculate_FE_element_field_nodes(mapping_item->element,
-				/*inherit_face_number*/-1,
-				fe_field, &number_of_element_field_nodes,
-				&element_field_nodes_array, mapping_item->element)))
+		const int number_of_faces = 2*get_FE_element_dimension(element);
+		for (int i = 0; i < number_of_faces; ++i)
 		{
-			/* Make assumptions about the distribution of the nodes */
-			if (number_of_element_field_nodes == pow(2.0, element_dimension))
+			if (this->get_adjacent_elements(element, i, &adjacentElements1d,
+				&number_of_neighbour_elements, &neighbour_elements))
 			{
-				/* Add nodes not already included */
-				for (i = 0 ; i < number_of_element_field_nodes ; i++)
+				for (int j = 0; j < number_of_neighbour_elements; ++j)
 				{
-					if (!(FIND_BY_IDENTIFIER_IN_LIST(
-						Computed_field_node_integration_mapping, node_ptr)
-						(element_field_nodes_array[i], node_mapping)))
+					const DsLabelIndex neighbourIndex = get_FE_element_index(neighbour_elements[j]);
+					if ((neighbour_elements[j]->getMesh() == feMesh) && (neighbourIndex >= 0) &&
+						(neighbourIndex < elementIndexSize) && (1 == elementChange[neighbourIndex]))
 					{
-						node_map = CREATE(Computed_field_node_integration_mapping)(
-							element_field_nodes_array[i], number_of_components);
-
-						for (k = 0 ; k < element_dimension ; k++)
-						{
-							initial_xi[k] = 0.0;
-							if (i & (1 << k))
-							{
-								final_xi[k] = 1.0;
-							}
-							else
-							{
-								final_xi[k] = 0.0;
-							}
-						}
-						integrate_path(mapping_item->element,
-							mapping_item->values, initial_xi, final_xi,
-							/*number_of_gauss_points*/2, workingCache, integrand,
-							magnitude_coordinates, coordinate_field,
-							node_map->values);
-
-						ADD_OBJECT_TO_LIST(Computed_field_node_integration_mapping)(
-							node_map, node_mapping);
+						elementChange[neighbourIndex] = 3;
+						queue.push(QueueItem(this->elementDistances[neighbourIndex], neighbourIndex));
 					}
 				}
+				DEALLOCATE(neighbour_elements);
 			}
-			/* else we don't know what we are looking at so don't do anything */
-
-			for (i = 0 ; i < number_of_element_field_nodes ; i++)
-			{
-				DEACCESS(FE_node)(element_field_nodes_array + i);
-			}
-			DEALLOCATE(element_field_nodes_array);
 		}
-
 	}
-	else
+	delete adjacentElements1d;
+	const int return_code = this->propagate_mapping(*feMesh, queue);
+	if (CMZN_OK != return_code)
 	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_integration_add_neighbours.  Invalid argument(s)");
-		return_code=CMZN_ERROR_ARGUMENT;
+		this->clear_mapping();
+	}
+	else if (!this->nodeElementsValid)
+	{
+		this->calculate_node_elements(*feMesh);
 	}
-	LEAVE;
-
 	return (return_code);
-} /* Computed_field_integration_add_neighbours */
+}
 
-/***************************************************************************//**
- * Calculates the mapping for the time and location details in the cache.
+/**
+ * Ensure mapping is calculated for time, recalculating only changed elements
+ * if possible.
  */
-int Computed_field_integration::calculate_mapping(FE_value time)
+int Computed_field_integration::update_mapping(FE_value time)
 {
-	int return_code;
-	Computed_field *integrand, *coordinate_field;
-	Computed_field_element_integration_mapping *mapping_item;
-	Computed_field_element_integration_mapping_fifo *fifo_node,
-		*first_to_be_checked, *last_to_be_checked;
+	if ((!this->mappingValid) || ((time != this->cached_time)
+		&& (Computed_field_has_multiple_times(field->source_fields[0])
+			|| Computed_field_has_multiple_times(field->source_fields[1]))))
+	{
+		return this->calculate_mapping(time);
+	}
+	if (this->changedElements)
+	{
+		return this->recalculate_changed_elements();
+	}
+	return CMZN_OK;
+}
 
-	if (field && (integrand = field->source_fields[0])
-		&& (coordinate_field = field->source_fields[1]))
+/**
+ * Records reached elements of the mesh with changed fields or nodes for
+ * partial recalculation, visiting only changed elements and the elements
+ * using changed nodes. Clears the mapping if changes cannot be found per
+ * element, including when faces inherit fields from changed parent elements.
+ */
+void Computed_field_integration::add_changed_elements(FE_mesh& feMesh,
+	DsLabelsChangeLog& elementChangeLog)
+{
+	FE_nodeset *feNodeset = feMesh.getNodeset();
+	DsLabelsChangeLog *nodeChangeLog = (feNodeset) ? feNodeset->getChangeLog() : 0;
+	FE_mesh *parentMesh = feMesh.getParentMesh();
+	if (elementChangeLog.isAllChange() || (!nodeChangeLog) || nodeChangeLog->isAllChange() ||
+		(parentMesh && (0 < parentMesh->getSize())))
 	{
-		// use a temporary working cache
-		cmzn_fieldmodule_id field_module = cmzn_field_get_fieldmodule(field);
-		cmzn_fieldcache_id field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
-		field_cache->setTime(time);
-		return_code = CMZN_OK;
-		first_to_be_checked=last_to_be_checked=
-			(Computed_field_element_integration_mapping_fifo *)NULL;
-		AdjacentElements1d *adjacentElements1d = 0;
-		if ((texture_mapping = CREATE_LIST(Computed_field_element_integration_mapping)())
-			&& (node_mapping = CREATE_LIST(Computed_field_node_integration_mapping)()))
-		{
-			if (ALLOCATE(fifo_node,
-				Computed_field_element_integration_mapping_fifo,1)&&
-				(mapping_item=CREATE(Computed_field_element_integration_mapping)(
-					 seed_element, Computed_field_get_number_of_components(field))))
-			{
-				ADD_OBJECT_TO_LIST(Computed_field_element_integration_mapping)
-					(mapping_item, texture_mapping);
-				/* fill the fifo_node for the mapping_item; put at end of list */
-				fifo_node->mapping_item=mapping_item;
-				fifo_node->next=
-					(Computed_field_element_integration_mapping_fifo *)NULL;
-				first_to_be_checked=last_to_be_checked=fifo_node;
-			}
-			else
-			{
-				display_message(ERROR_MESSAGE,
-					"Computed_field_set_type_integration.  "
-					"Unable to allocate member");
-				DEALLOCATE(fifo_node);
-				return_code=CMZN_ERROR_MEMORY;
-			}
-			if (CMZN_OK == return_code)
-			{
-				while ((CMZN_OK == return_code) && first_to_be_checked)
-				{
-					return_code = add_neighbours(*field_cache,
-						first_to_be_checked->mapping_item, texture_mapping,
-						&last_to_be_checked, integrand,
-						magnitude_coordinates, coordinate_field,
-						&adjacentElements1d,
-						(LIST(Computed_field_element_integration_mapping) *)NULL,
-						0.0, node_mapping);
-
-#if defined (DEBUG_CODE)
-					printf("Item removed\n");
-					write_Computed_field_element_integration_mapping(mapping_item, NULL);
-#endif /* defined (DEBUG_CODE) */
-
-					/* remove first_to_be_checked */
-					fifo_node=first_to_be_checked;
-					if (!(first_to_be_checked=first_to_be_checked->next))
-					{
-						last_to_be_checked=
-							(Computed_field_element_integration_mapping_fifo *)NULL;
-					}
-					DEALLOCATE(fifo_node);
-
-#if defined (DEBUG_CODE)
-					printf("Texture mapping list\n");
-					FOR_EACH_OBJECT_IN_LIST(Computed_field_element_integration_mapping)(
-						write_Computed_field_element_integration_mapping, NULL, texture_mapping);
-					//printf("To be checked list\n");
-					//FOR_EACH_OBJECT_IN_LIST(Computed_field_element_integration_mapping)(
-					//	write_Computed_field_element_integration_mapping, NULL, to_be_checked);
-#endif /* defined (DEBUG_CODE) */
-				}
-				cached_time = time;
-				if (0 == NUMBER_IN_LIST(Computed_field_node_integration_mapping)(node_mapping))
-				{
-					DESTROY(LIST(Computed_field_node_integration_mapping)(&node_mapping));
-				}
-				find_element_xi_mapping=
-					(Computed_field_element_integration_mapping *)NULL;
-			}
-			/* clean up to_be_checked list */
-			while (first_to_be_checked)
-			{
-				fifo_node = first_to_be_checked;
-				first_to_be_checked = first_to_be_checked->next;
-				DEALLOCATE(fifo_node);
-			}
-			if (return_code != CMZN_OK)
-			{
-				DESTROY_LIST(Computed_field_element_integration_mapping)(&texture_mapping);
-			}
-		}
-		else
+		this->clear_mapping();
+		return;
+	}
+	if ((!this->changedElements) && (!(this->changedElements = feMesh.createLabelsGroup())))
+	{
+		this->clear_mapping();
+		return;
+	}
+	const DsLabelIndex elementIndexSize = static_cast<DsLabelIndex>(this->elementDistances.size());
+	DsLabelIndex elementIndex = DS_LABEL_INDEX_INVALID;
+	if (DS_LABEL_CHANGE_TYPE_NONE != elementChangeLog.getChangeSummary())
+	{
+		DsLabelsGroup *elementGroup = elementChangeLog.getLabelsGroup();
+		while (elementGroup->incrementIndex(elementIndex) && (elementIndex < elementIndexSize))
 		{
-			display_message(ERROR_MESSAGE,
-				"Computed_field_integration_calculate_mapping.  "
-				"Unable to create mapping list.");
-			return_code=CMZN_ERROR_GENERAL;
+			if (this->elementDistances[elementIndex] >= 0.0)
+				this->changedElements->setIndex(elementIndex, true);
 		}
-		delete adjacentElements1d;
-		cmzn_fieldcache_destroy(&field_cache);
-		cmzn_fieldmodule_destroy(&field_module);
 	}
-	else
+	if (DS_LABEL_CHANGE_TYPE_NONE != nodeChangeLog->getChangeSummary())
 	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_integration_calculate_mapping.  "
-			"Invalid arguments.");
-		return_code=CMZN_ERROR_ARGUMENT;
+		DsLabelsGroup *nodeGroup = nodeChangeLog->getLabelsGroup();
+		// nodes beyond the start array are not used by any element
+		const DsLabelIndex nodeIndexLimit = static_cast<DsLabelIndex>(this->nodeElementsStart.size()) - 1;
+		DsLabelIndex nodeIndex = DS_LABEL_INDEX_INVALID;
+		while (nodeGroup->incrementIndex(nodeIndex) && (nodeIndex < nodeIndexLimit))
+		{
+			const DsLabelIndex end = this->nodeElementsStart[nodeIndex + 1];
+			for (DsLabelIndex i = this->nodeElementsStart[nodeIndex]; i < end; ++i)
+			{
+				elementIndex = this->nodeElements[i];
+				if ((elementIndex < elementIndexSize) && (this->elementDistances[elementIndex] >= 0.0))
+					this->changedElements->setIndex(elementIndex, true);
+			}
+		}
 	}
-	return (return_code);
-} /* Computed_field_integration_calculate_mapping */
-
-int Computed_field_element_integration_mapping_has_values(
-	Computed_field_element_integration_mapping *mapping, void *user_data)
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
+	// element nodes may have changed with their field definitions
+	if (0 < elementChangeLog.getChangeCount())
+		this->nodeElementsValid = false;
+	if (0 == this->changedElements->getSize())
+		cmzn::Deaccess(this->changedElements);
+}
 
-DESCRIPTION :
-Compares the user_data values with the offsets in the <mapping>
-==============================================================================*/
+int Computed_field_integration::check_dependency()
 {
-	int i, return_code;
-	Computed_field_integration_has_values_data *data;
-
-	ENTER(Computed_field_element_integration_mapping_has_values);
-	if (mapping && (data =
-			(Computed_field_integration_has_values_data *)user_data))
+	int return_code = Computed_field_core::check_dependency();
+	FE_mesh *feMesh = (field) ? this->seed_element->getMesh() : 0;
+	DsLabelsChangeLog *elementChangeLog = (feMesh) ? feMesh->getChangeLog() : 0;
+	if (!elementChangeLog)
 	{
-		return_code = 1;
-		for (i = 0 ; return_code && (i < data->number_of_values) ; i++)
+		this->clear_mapping();
+	}
+	else if (elementChangeLog->getChangeSummary() &
+		(DS_LABEL_CHANGE_TYPE_ADD | DS_LABEL_CHANGE_TYPE_REMOVE | DS_LABEL_CHANGE_TYPE_DEFINITION))
+	{
+		// elements reached, their nodes and adjacency may have changed
+		if (field && (0 == (return_code & MANAGER_CHANGE_FULL_RESULT(Computed_field))))
 		{
-			if (data->values[i] != mapping->values[i])
-			{
-				return_code = 0;
-			}
+			field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
+			return_code = field->manager_change_status;
 		}
+		this->clear_mapping();
 	}
-	else
+	else if (this->mappingValid)
 	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_element_integration_mapping_has_values.  "
-			"Invalid argument(s)");
-		return_code=0;
+		if (return_code & MANAGER_CHANGE_FULL_RESULT(Computed_field))
+		{
+			this->clear_mapping();
+		}
+		else if (return_code & MANAGER_CHANGE_PARTIAL_RESULT(Computed_field))
+		{
+			this->add_changed_elements(*feMesh, *elementChangeLog);
+		}
 	}
-	LEAVE;
-
-	return (return_code);
-} /* Computed_field_element_integration_mapping_has_values */
+	return return_code;
+}
 
 Computed_field_integration::~Computed_field_integration()
 /*******************************************************************************
@@ -926,6 +883,7 @@ Clear the type specific data used by this type.
 {
 
 	ENTER(Computed_field_integration::~Computed_field_integration);
+	cmzn::Deaccess(this->changedElements);
 	if (field)
 	{
 		cmzn_mesh_destroy(&mesh);
@@ -933,16 +891,6 @@ Clear the type specific data used by this type.
 		{
 			DEACCESS(FE_element)(&(seed_element));
 		}
-		if (texture_mapping)
-		{
-			DESTROY_LIST(Computed_field_element_integration_mapping)
-				(&texture_mapping);
-		}
-		if (node_mapping)
-		{
-			DESTROY_LIST(Computed_field_node_integration_mapping)
-				(&node_mapping);
-		}
 	}
 	else
 	{
@@ -968,37 +916,6 @@ Copy the type specific data used by this type.
 	return (core);
 } /* Computed_field_integration::copy */
 
-int Computed_field_integration::clear_cache()
-/*******************************************************************************
-LAST MODIFIED : 24 August 2006
-
-DESCRIPTION :
-==============================================================================*/
-{
-	int return_code;
-
-	ENTER(Computed_field_integration::clear_cache);
-	if (field)
-	{
-		if (find_element_xi_mapping)
-		{
-			DEACCESS(Computed_field_element_integration_mapping)
-				(&find_element_xi_mapping);
-		}
-		return_code = 1;
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_integration::clear_cache.  "
-			"Invalid arguments.");
-		return_code = 0;
-	}
-	LEAVE;
-
-	return(return_code);
-} /* Computed_field_integration::clear_cache */
-
 int Computed_field_integration::compare(Computed_field_core *other_core)
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1038,119 +955,6 @@ Compare the type specific data
 bool Computed_field_integration::is_defined_at_location(cmzn_fieldcache& cache)
 {
 	return (0 != field->evaluate(cache));
-#if defined (TODO_CODE)
-	// @TODO: resurrect the slightly more efficient old code?
-	FE_value element_to_top_level[9];
-	int return_code;
-	FE_element *top_level_element;
-
-	ENTER(Computed_field_default::is_defined_at_location);
-	if (field && location)
-	{
-		return_code = Computed_field_core::is_defined_at_location(location);
-		if (return_code)
-		{
-			Field_element_xi_location *element_xi_location;
-			Field_node_location *node_location;
-
-			element_xi_location =
-				dynamic_cast<Field_element_xi_location*>(location);
-			if (element_xi_location != 0)
-			{
-				FE_element* element = element_xi_location->get_element();
-
-				if (!texture_mapping)
-				{
-					/* Try time 0 */
-					calculate_mapping(/*time*/0.0);
-				}
-				else
-				{
-					/* Use the mapping from whatever time */
-				}
-				/* 1. Get top_level_element for types that must be calculated on them */
-				if (FE_element_is_top_level(element, (void *)NULL))
-				{
-					top_level_element=element;
-				}
-				else
-				{
-					/* check or get top_level element,
-						we don't have a top_level element to test with */
-					if (!(top_level_element=FE_element_get_top_level_element_conversion(
-						element,(struct FE_element *)NULL,
-						CMZN_ELEMENT_FACE_TYPE_ALL, element_to_top_level)))
-					{
-						return_code=0;
-					}
-				}
-				/* 2. Calculate the field */
-				if (return_code && texture_mapping)
-				{
-					if (FIND_BY_IDENTIFIER_IN_LIST
-						(Computed_field_element_integration_mapping,element)
-						(top_level_element, texture_mapping))
-					{
-						return_code = 1;
-					}
-					else
-					{
-						return_code = 0;
-					}
-				}
-			}
-			else if (0 != (node_location =
-				dynamic_cast<Field_node_location*>(location)))
-			{
-				FE_node *node = node_location->get_node();
-
-				if (!texture_mapping)
-				{
-					/* Try time 0 */
-					calculate_mapping(/*time*/0.0);
-				}
-				else
-				{
-					/* Use the mapping from whatever time */
-				}
-				/* If we calculated the mapping but no node_mapping was created then
-					the field is not defined at nodes. */
-				if (node_mapping)
-				{
-					/* If we have a mapping look for the node */
-					if (FIND_BY_IDENTIFIER_IN_LIST
-						(Computed_field_node_integration_mapping,node_ptr)
-						(node, node_mapping))
-					{
-						return_code = 1;
-					}
-					else
-					{
-						return_code = 0;
-					}
-				}
-				else
-				{
-					return_code = 0;
-				}
-			}
-			else
-			{
-				return_code = 0;
-			}
-		}
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_default::is_defined_at_location.  "
-			"Invalid arguments.");
-		return_code = 0;
-	}
-	LEAVE;
-
-	return (return_code);
-#endif // defined (TODO_CODE)
 }
 
 int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
@@ -1176,23 +980,7 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 		const FE_value* xi = element_xi_location->get_xi();
 		int number_of_derivatives = cache.getRequestedDerivatives();
 
-		Computed_field_element_integration_mapping *mapping;
-
-		if (!texture_mapping)
-		{
-			calculate_mapping(time);
-		}
-		else
-		{
-			if ((time != cached_time)
-				&& (Computed_field_has_multiple_times(field->source_fields[0])
-					|| Computed_field_has_multiple_times(field->source_fields[1])))
-			{
-				DESTROY_LIST(Computed_field_element_integration_mapping)
-					(&texture_mapping);
-				calculate_mapping(time);
-			}
-		}
+		const bool mapped = (CMZN_OK == this->update_mapping(time));
 		/* 1. Get top_level_element for types that must be calculated on them */
 		element_dimension=get_FE_element_dimension(element);
 		if (FE_element_is_top_level(element, (void *)NULL))
@@ -1246,12 +1034,14 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 			coordinate_dimension = top_level_element_dimension;
 		}
 		/* 2. Calculate the field */
-		if (texture_mapping)
+		if (mapped)
 		{
-			mapping = FIND_BY_IDENTIFIER_IN_LIST
-				(Computed_field_element_integration_mapping,element)
-				(top_level_element, texture_mapping);
-			if (mapping != 0)
+			const DsLabelIndex elementIndex = (top_level_element &&
+				(top_level_element->getMesh() == this->seed_element->getMesh())) ?
+				get_FE_element_index(top_level_element) : DS_LABEL_INDEX_INVALID;
+			if ((elementIndex >= 0) &&
+				(elementIndex < static_cast<DsLabelIndex>(this->elementDistances.size())) &&
+				(this->elementDistances[elementIndex] >= 0.0))
 			{
 				cmzn_fieldcache& workingCache = *(valueCache.getOrCreateExtraCache(cache));
 				workingCache.setTime(time);
@@ -1261,7 +1051,8 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 					initial_xi[i] = 0.0;
 				}
 				integrate_path(top_level_element,
-					mapping->values, initial_xi, top_level_xi,
+					this->elementValues.data() + elementIndex*field->number_of_components,
+					initial_xi, top_level_xi,
 					/*number_of_gauss_points*/2, workingCache, field->source_fields[0],
 					magnitude_coordinates, field->source_fields[1],
 					valueCache.values);
@@ -1333,36 +1124,23 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 	{
 		FE_node *node = node_location->get_node();
 
-		Computed_field_node_integration_mapping *mapping;
-
 		return_code = 1;
 
-		if (!texture_mapping)
-		{
-			calculate_mapping(time);
-		}
-		else
-		{
-			if ((time != cached_time)
-				&& (Computed_field_has_multiple_times(field->source_fields[0])
-					|| Computed_field_has_multiple_times(field->source_fields[1])))
-			{
-				DESTROY_LIST(Computed_field_element_integration_mapping)
-					(&texture_mapping);
-				calculate_mapping(time);
-			}
-		}
+		const bool mapped = (CMZN_OK == this->update_mapping(time));
 		/* 2. Calculate the field */
-		if (node_mapping)
+		if (mapped)
 		{
-			mapping = FIND_BY_IDENTIFIER_IN_LIST
-				(Computed_field_node_integration_mapping,node_ptr)
-				(node, node_mapping);
-			if (mapping != 0)
+			const DsLabelIndex nodeIndex =
+				(FE_node_get_FE_nodeset(node) == this->seed_element->getMesh()->getNodeset()) ?
+				get_FE_node_index(node) : DS_LABEL_INDEX_INVALID;
+			if ((nodeIndex >= 0) &&
+				(nodeIndex < static_cast<DsLabelIndex>(this->nodeDistances.size())) &&
+				(this->nodeDistances[nodeIndex] >= 0.0))
 			{
+				const FE_value *nodeValues = this->nodeValues.data() + nodeIndex*field->number_of_components;
 				for(i = 0 ; i < field->number_of_components ; i++)
 				{
-					valueCache.values[i] = mapping->values[i];
+					valueCache.values[i] = nodeValues[i];
 				}
 				valueCache.derivatives_valid = 0;
 			}
@@ -1371,7 +1149,7 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 				display_message(ERROR_MESSAGE,
 					"Computed_field_integration_evaluate_cache_at_node."
 					"  Node %d not found in Xi texture coordinate mapping field %s",
-					get_FE_node_identifier(node));
+					get_FE_node_identifier(node), field->name);
 				return_code=0;
 			}
 		}
@@ -1391,131 +1169,6 @@ int Computed_field_integration::evaluate(cmzn_fieldcache& cache, FieldValueCache
 	return (return_code);
 }
 
-// @TODO Migrate to new external field cache
-#if defined (FUTURE_CODE)
-int Computed_field_integration::propagate_find_element_xi(
-	const FE_value *values, int number_of_values, struct FE_element **element_address,
-	FE_value *xi, FE_value time, cmzn_mesh_id search_mesh)
-{
-	FE_value floor_values[3];
-	int i, return_code;
-	Computed_field_element_integration_mapping *mapping;
-	Computed_field_integration_has_values_data has_values_data;
-
-	ENTER(Computed_field_integration::propagate_find_element_xi);
-	USE_PARAMETER(time);
-	if (field && values && (number_of_values==field->number_of_components) && search_mesh)
-	{
-		const int element_dimension = search_mesh ?
-			cmzn_mesh_get_dimension(search_mesh) : get_FE_element_dimension(*element_address);
-		if (!texture_mapping)
-		{
-			calculate_mapping(/*time*/0);
-		}
-		else
-		{
-#if defined (NEW_CODE)
-			/* Until we are calculating this at the correct time there is no
-				point seeing if the time has changed */
-			if ((time != cached_time)
-				&& (Computed_field_has_multiple_times(field->source_fields[0])
-				|| Computed_field_has_multiple_times(field->source_fields[1])))
-			{
-				DESTROY_LIST(Computed_field_element_integration_mapping)
-					(&texture_mapping);
-				Computed_field_integration_calculate_mapping(field, time);
-			}
-#endif /* defined (NEW_CODE) */
-		}
-		if (number_of_values<=3)
-		{
-			for (i = 0 ; i < number_of_values ; i++)
-			{
-				floor_values[i] = floor(values[i]);
-			}
-			has_values_data.values = floor_values;
-			has_values_data.number_of_values = number_of_values;
-			if (texture_mapping)
-			{
-				return_code=0;
-				/* Check the last successful mapping first */
-				if (find_element_xi_mapping&&
-					Computed_field_element_integration_mapping_has_values(
-						find_element_xi_mapping, (void *)&has_values_data))
-				{
-					return_code = 1;
-				}
-				else
-				{
-					/* Find in the list */
-					mapping = FIRST_OBJECT_IN_LIST_THAT(Computed_field_element_integration_mapping)
-						(Computed_field_element_integration_mapping_has_values, (void *)&has_values_data,
-							texture_mapping);
-					if (mapping != 0)
-					{
-						REACCESS(Computed_field_element_integration_mapping)(&(find_element_xi_mapping),
-							mapping);
-						return_code = 1;
-					}
-				}
-				if (return_code)
-				{
-					*element_address = find_element_xi_mapping->element;
-					for (i = 0 ; i < get_FE_element_dimension(*element_address) ; i++)
-					{
-						xi[i] = values[i] - floor_values[i];
-					}
-					if (!cmzn_mesh_contains_element(mesh, *element_address))
-					{
-						*element_address = (FE_element *)NULL;
-						display_message(ERROR_MESSAGE,
-							"Computed_field_integration::propagate_find_element_xi.  "
-							"Element is not in integration mesh");
-						return_code=0;
-					}
-					if (element_dimension && (element_dimension != get_FE_element_dimension(*element_address)))
-					{
-						*element_address = (FE_element *)NULL;
-						display_message(ERROR_MESSAGE,
-							"Computed_field_integration::propagate_find_element_xi.  "
-							"Element is not of the required dimension");
-						return_code=0;
-					}
-				}
-				else
-				{
-					return_code=0;
-				}
-			}
-			else
-			{
-				display_message(ERROR_MESSAGE,
-					"Computed_field_integration::propagate_find_element_xi.  "
-					"Xi texture coordinate mapping not calculated");
-				return_code=0;
-			}
-		}
-		else
-		{
-			display_message(ERROR_MESSAGE,
-				"Computed_field_integration::propagate_find_element_xi.  "
-				"Only implemented for three or less values");
-			return_code=0;
-		}
-	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_integration::propagate_find_element_xi.  "
-			"Invalid argument(s)");
-		return_code=0;
-	}
-	LEAVE;
-
-	return (return_code);
-} /* Computed_field_integration::propagate_find_element_xi */
-#endif // defined (FUTURE_CODE)
-
 int Computed_field_integration::list(
 	)
 /*******************************************************************************
@@ -1722,6 +1375,21 @@ struct Computed_field *Computed_field_create_integration(
 	return (field);
 }
 
+cmzn_field_id cmzn_fieldmodule_create_field_integration(
+	cmzn_fieldmodule_id field_module, cmzn_field_id integrand_field,
+	cmzn_field_id coordinate_field, cmzn_mesh_id mesh,
+	cmzn_element_id seed_element, bool magnitude_coordinates)
+{
+	if (!((field_module) && (integrand_field) && integrand_field->isNumerical() &&
+		(coordinate_field) && coordinate_field->isNumerical()))
+	{
+		display_message(ERROR_MESSAGE, "Fieldmodule createFieldIntegration.  Invalid argument(s)");
+		return 0;
+	}
+	return Computed_field_create_integration(field_module, mesh, seed_element,
+		integrand_field, magnitude_coordinates ? 1 : 0, coordinate_field);
+}
+
 int Computed_field_get_type_integration(Computed_field *field,
 	cmzn_mesh_id *mesh_address, FE_element **seed_element,
 	Computed_field **integrand, int *magnitude_coordinates,
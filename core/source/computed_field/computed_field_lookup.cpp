@@ -80,7 +80,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		// set node once as doesn't change
 		valueCache->getExtraCache()->setNode(lookup_node);
@@ -256,7 +256,7 @@ int Computed_field_nodal_lookup::check_dependency()
 	{
 		if (0 == (field->manager_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field)))
 		{
-			int source_change_status = field->source_fields[0]->core->check_dependency();
+			const int source_change_status = field->source_fields[0]->manager_change_status;
 			if (source_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field))
 				field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
 			else if (source_change_status & MANAGER_CHANGE_PARTIAL_RESULT(Computed_field))
@@ -369,7 +369,7 @@ private:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		// set node once as doesn't change
 		valueCache->getExtraCache()->setNode(nodal_lookup_node);
@@ -597,7 +597,7 @@ int Computed_field_quaternion_SLERP::check_dependency()
 	{
 		if (0 == (field->manager_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field)))
 		{
-			int source_change_status = field->source_fields[0]->core->check_dependency();
+			const int source_change_status = field->source_fields[0]->manager_change_status;
 			if (source_change_status & MANAGER_CHANGE_FULL_RESULT(Computed_field))
 				field->setChangedPrivate(MANAGER_CHANGE_FULL_RESULT(Computed_field));
 			else if (source_change_status & MANAGER_CHANGE_PARTIAL_RESULT(Computed_field))
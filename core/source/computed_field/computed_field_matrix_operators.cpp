@@ -18,6 +18,7 @@
 #include "general/matrix_vector.h"
 #include "general/mystring.h"
 #include "general/message.h"
+#include "general/small_matrix.hpp"
 #include "graphics/quaternion.hpp"
 
 class Computed_field_matrix_operators_package : public Computed_field_type_package
@@ -93,6 +94,53 @@ components, where n is a positive integer. If matrix is square, n is returned.
 
 namespace {
 
+/** Evaluate determinant of N*N source matrix and its derivatives, if requested */
+template <int N> void evaluateDeterminant(RealFieldValueCache& sourceCache,
+	int number_of_xi, RealFieldValueCache& valueCache)
+{
+	FE_value adjugate[N*N];
+	valueCache.values[0] = SmallMatrix<N>::adjugate(sourceCache.values, adjugate);
+	if (number_of_xi && sourceCache.derivatives_valid)
+	{
+		SmallMatrix<N>::determinantDerivatives(adjugate, sourceCache.derivatives,
+			number_of_xi, valueCache.derivatives);
+		valueCache.derivatives_valid = 1;
+	}
+	else
+	{
+		valueCache.derivatives_valid = 0;
+	}
+}
+
+/**
+ * Compile determinant of the minor of n*n matrix in registers a from row
+ * down, in the given columns, by cofactor expansion along its first row.
+ * Minors of lower rows are shared by the compiler.
+ */
+int compileDeterminant(FieldTapeCompiler& compiler, const int *a, int n, int row,
+	const int *columns, int columnCount)
+{
+	if (1 == columnCount)
+		return a[row*n + columns[0]];
+	int result = -1;
+	int subColumns[3];
+	for (int c = 0; c < columnCount; ++c)
+	{
+		int s = 0;
+		for (int k = 0; k < columnCount; ++k)
+			if (k != c)
+				subColumns[s++] = columns[k];
+		const int term = compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, a[row*n + columns[c]],
+			compileDeterminant(compiler, a, n, row + 1, subColumns, columnCount - 1));
+		if (0 == c)
+			result = term;
+		else
+			result = compiler.binary((c % 2) ? FIELD_TAPE_OPERATION_SUBTRACT : FIELD_TAPE_OPERATION_ADD,
+				result, term);
+	}
+	return result;
+}
+
 const char computed_field_determinant_type_string[] = "determinant";
 
 class Computed_field_determinant : public Computed_field_core
@@ -127,6 +175,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -138,20 +188,20 @@ int Computed_field_determinant::evaluate(cmzn_fieldcache& cache, FieldValueCache
 	RealFieldValueCache *sourceCache = RealFieldValueCache::cast(getSourceField(0)->evaluate(cache));
 	if (sourceCache)
 	{
-		FE_value *source_values = sourceCache->values;
+		const int number_of_xi = cache.getRequestedDerivatives();
 		switch (getSourceField(0)->number_of_components)
 		{
 		case 1:
-			valueCache.values[0] = source_values[0];
+			evaluateDeterminant<1>(*sourceCache, number_of_xi, valueCache);
 			break;
 		case 4:
-			valueCache.values[0] = source_values[0]*source_values[3] - source_values[1]*source_values[2];
+			evaluateDeterminant<2>(*sourceCache, number_of_xi, valueCache);
 			break;
 		case 9:
-			valueCache.values[0] =
-				source_values[0]*(source_values[4]*source_values[8] - source_values[5]*source_values[7]) +
-				source_values[1]*(source_values[5]*source_values[6] - source_values[3]*source_values[8]) +
-				source_values[2]*(source_values[3]*source_values[7] - source_values[4]*source_values[6]);
+			evaluateDeterminant<3>(*sourceCache, number_of_xi, valueCache);
+			break;
+		case 16:
+			evaluateDeterminant<4>(*sourceCache, number_of_xi, valueCache);
 			break;
 		default:
 			return 0;
@@ -162,6 +212,22 @@ int Computed_field_determinant::evaluate(cmzn_fieldcache& cache, FieldValueCache
 	return 0;
 }
 
+bool Computed_field_determinant::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	const int componentsCount = getSourceField(0)->number_of_components;
+	int n = 1;
+	while ((n < 4) && (n*n < componentsCount))
+		++n;
+	if (n*n != componentsCount)
+		return false;
+	const int columns[4] = { 0, 1, 2, 3 };
+	componentRegisters[0] = compileDeterminant(compiler, sourceRegisters, n, /*row*/0, columns, n);
+	return true;
+}
+
 int Computed_field_determinant::list()
 {
 	int return_code = 0;
@@ -196,7 +262,7 @@ cmzn_field_id cmzn_fieldmodule_create_field_determinant(
 	cmzn_field_id field = 0;
 	if (field_module && source_field &&
 		Computed_field_is_square_matrix(source_field, (void *)NULL) &&
-		(cmzn_field_get_number_of_components(source_field) <= 9))
+		(cmzn_field_get_number_of_components(source_field) <= 16))
 	{
 		field = Computed_field_create_generic(field_module,
 			/*check_source_field_regions*/true,
@@ -240,6 +306,30 @@ public:
 	}
 };
 
+/**
+ * Calculate derivatives of eigenvalues of N*N symmetric source matrix, if
+ * requested and defined, from eigenvectors in columns of v.
+ */
+template <int N> void evaluateEigenvalueDerivatives(RealFieldValueCache& sourceCache,
+	int number_of_xi, EigenvalueFieldValueCache& valueCache)
+{
+	valueCache.derivatives_valid = 0;
+	if (!(number_of_xi && sourceCache.derivatives_valid))
+		return;
+	// eigenvalues are not differentiable where repeated
+	FE_value scale = 0.0;
+	for (int i = 0; i < N; ++i)
+		if (std::fabs(valueCache.values[i]) > scale)
+			scale = std::fabs(valueCache.values[i]);
+	for (int i = 0; i < N; ++i)
+		for (int j = i + 1; j < N; ++j)
+			if (std::fabs(valueCache.values[i] - valueCache.values[j]) <= 1.0E-8*scale)
+				return;
+	SmallMatrix<N>::eigenvalueDerivatives(valueCache.v, sourceCache.derivatives,
+		number_of_xi, valueCache.derivatives);
+	valueCache.derivatives_valid = 1;
+}
+
 const char computed_field_eigenvalues_type_string[] = "eigenvalues";
 
 class Computed_field_eigenvalues : public Computed_field_core
@@ -309,13 +399,39 @@ int Computed_field_eigenvalues::evaluate(cmzn_fieldcache& cache, FieldValueCache
 				"Eigenanalysis of field %s may be wrong as matrix not symmetric",
 				source_field->name);
 		}
-		/* get eigenvalues and eigenvectors sorted from largest to smallest */
+		/* get eigenvalues and eigenvectors sorted from largest to smallest,
+			 using closed form for 2x2 and 3x3 unless eigenvalues are close */
+		bool solved = false;
+		if (2 == n)
+			solved = SmallMatrix<2>::symmetricEigenanalysis(valueCache.a, valueCache.values, valueCache.v);
+		else if (3 == n)
+			solved = SmallMatrix<3>::symmetricEigenanalysis(valueCache.a, valueCache.values, valueCache.v);
 		int nrot;
-		if (Jacobi_eigenanalysis(n, valueCache.a, valueCache.values, valueCache.v, &nrot) &&
-			eigensort(n, valueCache.values, valueCache.v))
+		if (!solved)
+			solved = (0 != Jacobi_eigenanalysis(n, valueCache.a, valueCache.values, valueCache.v, &nrot));
+		if (solved && eigensort(n, valueCache.values, valueCache.v))
 		{
 			/* values now contains the eigenvalues, v the eigenvectors in columns, while
-				 values of a above the main diagonal are destroyed */
+				 values of a above the main diagonal may be destroyed */
+			const int number_of_xi = cache.getRequestedDerivatives();
+			switch (n)
+			{
+			case 1:
+				evaluateEigenvalueDerivatives<1>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 2:
+				evaluateEigenvalueDerivatives<2>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 3:
+				evaluateEigenvalueDerivatives<3>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 4:
+				evaluateEigenvalueDerivatives<4>(*sourceCache, number_of_xi, valueCache);
+				break;
+			default:
+				valueCache.derivatives_valid = 0;
+				break;
+			}
 			return 1;
 		}
 	}
@@ -694,7 +810,7 @@ class MatrixInvertFieldValueCache : public RealFieldValueCache
 {
 public:
 	// cache stores intermediate LU-decomposed matrix and RHS vector in double
-	// precision, as well as the integer pivot indx
+	// precision, as well as the integer pivot indx, used for matrices over 4x4
 	int n;
 	double *a, *b;
 	int *indx;
@@ -726,6 +842,28 @@ public:
 	}
 };
 
+/**
+ * Evaluate inverse of N*N source matrix and its derivatives, if requested.
+ * @return  True on success, false if matrix is singular.
+ */
+template <int N> bool evaluateInverse(RealFieldValueCache& sourceCache,
+	int number_of_xi, RealFieldValueCache& valueCache)
+{
+	if (!SmallMatrix<N>::invert(sourceCache.values, valueCache.values, /*singularTolerance*/1.0E-12))
+		return false;
+	if (number_of_xi && sourceCache.derivatives_valid)
+	{
+		SmallMatrix<N>::inverseDerivatives(valueCache.values, sourceCache.derivatives,
+			number_of_xi, valueCache.derivatives);
+		valueCache.derivatives_valid = 1;
+	}
+	else
+	{
+		valueCache.derivatives_valid = 0;
+	}
+	return true;
+}
+
 const char computed_field_matrix_invert_type_string[] = "matrix_invert";
 
 class Computed_field_matrix_invert : public Computed_field_core
@@ -783,12 +921,40 @@ int Computed_field_matrix_invert::evaluate(cmzn_fieldcache& cache, FieldValueCac
 	if (sourceCache)
 	{
 		const int n = valueCache.n;
+		if (n <= 4)
+		{
+			const int number_of_xi = cache.getRequestedDerivatives();
+			bool result = false;
+			switch (n)
+			{
+			case 1:
+				result = evaluateInverse<1>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 2:
+				result = evaluateInverse<2>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 3:
+				result = evaluateInverse<3>(*sourceCache, number_of_xi, valueCache);
+				break;
+			case 4:
+				result = evaluateInverse<4>(*sourceCache, number_of_xi, valueCache);
+				break;
+			}
+			if (!result)
+			{
+				display_message(ERROR_MESSAGE,
+					"Computed_field_matrix_invert::evaluate.  Matrix is singular");
+				return 0;
+			}
+			return 1;
+		}
 		const int matrix_size = n * n;
 		for (int i = 0; i < matrix_size; i++)
 		{
 			valueCache.a[i] = (double)(sourceCache->values[i]);
 		}
 		double d;
+		valueCache.derivatives_valid = 0;
 		if (LU_decompose(n, valueCache.a, valueCache.indx, &d,/*singular_tolerance*/1.0e-12))
 		{
 			for (int i = 0; i < n; i++)
@@ -979,6 +1145,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -1075,6 +1243,29 @@ int Computed_field_matrix_multiply::evaluate(cmzn_fieldcache& cache, FieldValueC
 	return 0;
 }
 
+bool Computed_field_matrix_multiply::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *a = compiler.compileField(getSourceField(0));
+	const int *b = compiler.compileField(getSourceField(1));
+	if (!(a && b))
+		return false;
+	const int m = this->number_of_rows;
+	const int s = getSourceField(0)->number_of_components / m;
+	const int n = getSourceField(1)->number_of_components / s;
+	for (int i = 0; i < m; ++i)
+	{
+		for (int j = 0; j < n; ++j)
+		{
+			int sum = compiler.constant(0.0);
+			for (int k = 0; k < s; ++k)
+				sum = compiler.binary(FIELD_TAPE_OPERATION_ADD, sum,
+					compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, a[i*s + k], b[k*n + j]));
+			componentRegisters[i*n + j] = sum;
+		}
+	}
+	return true;
+}
+
 int Computed_field_matrix_multiply::list()
 /*******************************************************************************
 LAST MODIFIED : 25 August 2006
@@ -1587,6 +1778,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -1671,6 +1864,19 @@ int Computed_field_transpose::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 	return 0;
 }
 
+bool Computed_field_transpose::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	const int m = this->source_number_of_rows;
+	const int n = getSourceField(0)->number_of_components / m;
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < m; ++j)
+			componentRegisters[i*m + j] = sourceRegisters[j*n + i];
+	return true;
+}
+
 int Computed_field_transpose::list()
 /*******************************************************************************
 LAST MODIFIED : 25 August 2006
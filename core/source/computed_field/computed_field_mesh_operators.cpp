@@ -72,7 +72,7 @@ public:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		return valueCache;
 	}
@@ -150,6 +150,11 @@ public:
 
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
+
 	// if the mesh is a mesh group, also need to propagate changes from it
 	virtual int check_dependency()
 	{
@@ -20,9 +20,11 @@
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/message.h"
+#include "general/point_grid.hpp"
 #include "finite_element/finite_element_region.h"
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -34,6 +36,216 @@ namespace {
 
 const char computed_field_nodeset_operator_type_string[] = "nodeset_operator";
 
+/** Number of nodes evaluated together in fast nodeset reductions */
+const int nodesetOperatorBlockSize = 256;
+
+/**
+ * Accumulates sums or sums of squares of source field components over blocks
+ * of node values in component-major order from evaluateAtNodes.
+ */
+class NodesetSumReducer
+{
+	const int componentCount;
+	const bool squares;
+	std::vector<FE_value> sums;
+	int termCount;
+
+public:
+	NodesetSumReducer(int componentCountIn, bool squaresIn) :
+		componentCount(componentCountIn),
+		squares(squaresIn),
+		sums(componentCountIn, 0.0),
+		termCount(0)
+	{
+	}
+
+	void reduce(int nodeCount, const FE_value *values, const char *defined)
+	{
+		int definedCount = 0;
+		for (int n = 0; n < nodeCount; ++n)
+			definedCount += defined[n];
+		for (int c = 0; c < this->componentCount; ++c)
+		{
+			const FE_value *componentValues = values + c*nodeCount;
+			// independent partial sums permit vectorisation of the common case
+			FE_value partialSums[4] = { 0.0, 0.0, 0.0, 0.0 };
+			int n = 0;
+			if (definedCount == nodeCount)
+			{
+				if (this->squares)
+				{
+					for (; n + 4 <= nodeCount; n += 4)
+					{
+						partialSums[0] += componentValues[n]*componentValues[n];
+						partialSums[1] += componentValues[n + 1]*componentValues[n + 1];
+						partialSums[2] += componentValues[n + 2]*componentValues[n + 2];
+						partialSums[3] += componentValues[n + 3]*componentValues[n + 3];
+					}
+				}
+				else
+				{
+					for (; n + 4 <= nodeCount; n += 4)
+					{
+						partialSums[0] += componentValues[n];
+						partialSums[1] += componentValues[n + 1];
+						partialSums[2] += componentValues[n + 2];
+						partialSums[3] += componentValues[n + 3];
+					}
+				}
+			}
+			for (; n < nodeCount; ++n)
+			{
+				if (defined[n])
+					partialSums[0] += (this->squares) ? componentValues[n]*componentValues[n] : componentValues[n];
+			}
+			this->sums[c] += (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+		}
+		this->termCount += definedCount;
+	}
+
+	/** @param sumsOut  Array to receive componentCount sums. */
+	void getSums(FE_value *sumsOut) const
+	{
+		for (int c = 0; c < this->componentCount; ++c)
+			sumsOut[c] = this->sums[c];
+	}
+
+	int getTermCount() const
+	{
+		return this->termCount;
+	}
+};
+
+/**
+ * Finds the minimum or maximum of each source field component over blocks of
+ * node values in component-major order from evaluateAtNodes.
+ */
+class NodesetExtremumReducer
+{
+	const int componentCount;
+	const bool maximum;
+	std::vector<FE_value> extrema;
+	int nodeCount;
+	bool initialised;
+
+public:
+	NodesetExtremumReducer(int componentCountIn, bool maximumIn) :
+		componentCount(componentCountIn),
+		maximum(maximumIn),
+		extrema(componentCountIn, 0.0),
+		nodeCount(0),
+		initialised(false)
+	{
+	}
+
+	void reduce(int blockNodeCount, const FE_value *values, const char *defined)
+	{
+		this->nodeCount += blockNodeCount;
+		int firstDefined = 0;
+		while ((firstDefined < blockNodeCount) && (!defined[firstDefined]))
+			++firstDefined;
+		if (firstDefined == blockNodeCount)
+			return;
+		bool allDefined = (0 == firstDefined);
+		for (int n = firstDefined + 1; allDefined && (n < blockNodeCount); ++n)
+			allDefined = (0 != defined[n]);
+		for (int c = 0; c < this->componentCount; ++c)
+		{
+			const FE_value *componentValues = values + c*blockNodeCount;
+			FE_value extremum = componentValues[firstDefined];
+			if (allDefined)
+			{
+				// branch-free selects in simple loops are vectorised by compilers
+				if (this->maximum)
+				{
+					for (int n = 1; n < blockNodeCount; ++n)
+						extremum = (componentValues[n] > extremum) ? componentValues[n] : extremum;
+				}
+				else
+				{
+					for (int n = 1; n < blockNodeCount; ++n)
+						extremum = (componentValues[n] < extremum) ? componentValues[n] : extremum;
+				}
+			}
+			else
+			{
+				for (int n = firstDefined + 1; n < blockNodeCount; ++n)
+				{
+					if (defined[n] && ((this->maximum) ?
+						(componentValues[n] > extremum) : (componentValues[n] < extremum)))
+						extremum = componentValues[n];
+				}
+			}
+			if ((!this->initialised) || ((this->maximum) ?
+				(extremum > this->extrema[c]) : (extremum < this->extrema[c])))
+				this->extrema[c] = extremum;
+		}
+		this->initialised = true;
+	}
+
+	/** @return  True if any nodes were reduced, even if source field was not
+	 * defined at them, consistent with per-node evaluation. */
+	bool hasNodes() const
+	{
+		return (this->nodeCount > 0);
+	}
+
+	/** Copy extrema to values if found at any nodes, otherwise leave unchanged. */
+	void getExtrema(FE_value *extremaOut) const
+	{
+		if (this->initialised)
+		{
+			for (int c = 0; c < this->componentCount; ++c)
+				extremaOut[c] = this->extrema[c];
+		}
+	}
+};
+
+/**
+ * Collects source field values at defined nodes into a node-major array of
+ * terms, as required for sum squares terms.
+ */
+class NodesetTermsReducer
+{
+	const int componentCount;
+	const int maximumTermCount;
+	FE_value *terms;
+	int termCount;
+
+public:
+	/** @param termsIn  Array to put terms in; can be 0 to only count terms */
+	NodesetTermsReducer(int componentCountIn, int maximumTermCountIn, FE_value *termsIn) :
+		componentCount(componentCountIn),
+		maximumTermCount(maximumTermCountIn),
+		terms(termsIn),
+		termCount(0)
+	{
+	}
+
+	void reduce(int nodeCount, const FE_value *values, const char *defined)
+	{
+		for (int n = 0; n < nodeCount; ++n)
+		{
+			if (defined[n])
+			{
+				if ((this->terms) && (this->termCount < this->maximumTermCount))
+				{
+					FE_value *term = this->terms + this->termCount*this->componentCount;
+					for (int c = 0; c < this->componentCount; ++c)
+						term[c] = values[c*nodeCount + n];
+				}
+				++this->termCount;
+			}
+		}
+	}
+
+	/** @return  Number of terms found, which may exceed the maximum stored */
+	int getTermCount() const
+	{
+		return this->termCount;
+	}
+};
+
 class Computed_field_nodeset_operator : public Computed_field_core
 {
 protected:
@@ -71,7 +283,7 @@ public:
 
 	virtual FieldValueCache *createValueCache(cmzn_fieldcache& parentCache)
 	{
-		RealFieldValueCache *valueCache = new RealFieldValueCache(field->number_of_components);
+		RealFieldValueCache *valueCache = new RealFieldValueCache(parentCache, field->number_of_components);
 		valueCache->createExtraCache(parentCache, Computed_field_get_region(field));
 		return valueCache;
 	}
@@ -82,6 +294,57 @@ public:
 
 	char* get_command_string();
 
+	/**
+	 * Fast path for nodeset reductions: if the source field can be compiled to
+	 * a tape or evaluated directly from node parameters, evaluate it over the
+	 * nodeset in blocks and pass component-major values for each block to
+	 * reducer.reduce().
+	 * @return  True if fast path succeeded, false if caller must evaluate
+	 * source field node-by-node with a field cache.
+	 */
+	template <class Reducer> bool reduceAtNodeBlocks(cmzn_fieldcache& cache, Reducer& reducer) const
+	{
+		cmzn_field_id sourceField = getSourceField(0);
+		// tape inputs not supporting evaluateAtNodes are evaluated with extra cache
+		FieldTape *tape = sourceField->getTape();
+		if ((!tape) && (!sourceField->core->supportsEvaluateAtNodes()))
+			return false;
+		cmzn_fieldcache& extraCache = *(field->getValueCache(cache)->getExtraCache());
+		extraCache.setTime(cache.getTime());
+		cmzn_node *nodes[nodesetOperatorBlockSize];
+		char defined[nodesetOperatorBlockSize];
+		std::vector<FE_value> values(sourceField->number_of_components*nodesetOperatorBlockSize);
+		bool success = true;
+		int nodeCount = 0;
+		cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(this->nodeset);
+		cmzn_node_id node = 0;
+		do
+		{
+			node = cmzn_nodeiterator_next_non_access(iterator);
+			if (node)
+				nodes[nodeCount++] = node;
+			if ((nodeCount == nodesetOperatorBlockSize) || ((!node) && (0 < nodeCount)))
+			{
+				if (!((tape) ?
+					tape->evaluateAtNodes(extraCache, nodeCount, nodes, values.data(), defined) :
+					sourceField->core->evaluateAtNodes(cache.getTime(), nodeCount, nodes, values.data(), defined)))
+				{
+					success = false;
+					break;
+				}
+				reducer.reduce(nodeCount, values.data(), defined);
+				nodeCount = 0;
+			}
+		} while (node);
+		cmzn_nodeiterator_destroy(&iterator);
+		return success;
+	}
+
+	virtual bool has_non_source_dependencies() const
+	{
+		return true;
+	}
+
 	// if the nodeset is a nodeset group, also need to propagate changes from it
 	virtual int check_dependency()
 	{
@@ -200,6 +463,13 @@ protected:
 int Computed_field_nodeset_sum::evaluate_sum(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	NodesetSumReducer reducer(field->number_of_components, /*squares*/false);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+	{
+		reducer.getSums(valueCache.values);
+		valueCache.derivatives_valid = 0;
+		return reducer.getTermCount();
+	}
 	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
 	extraCache.setTime(cache.getTime());
 	int number_of_terms = 0;
@@ -333,6 +603,9 @@ protected:
 int Computed_field_nodeset_sum_squares::get_number_of_sum_square_terms(
 	cmzn_fieldcache& cache) const
 {
+	NodesetTermsReducer reducer(field->number_of_components, /*maximumTermCount*/0, /*terms*/0);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+		return reducer.getTermCount();
 	int number_of_terms = 0;
 	cmzn_field_id sourceField = field->source_fields[0];
 	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
@@ -352,12 +625,15 @@ int Computed_field_nodeset_sum_squares::get_number_of_sum_square_terms(
 int Computed_field_nodeset_sum_squares::evaluate_sum_square_terms(
 	cmzn_fieldcache& cache, RealFieldValueCache& valueCache, int number_of_values, FE_value *values)
 {
+	const int number_of_components = field->number_of_components;
+	const int max_terms = number_of_values / number_of_components;
+	NodesetTermsReducer reducer(number_of_components, max_terms, values);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+		return (reducer.getTermCount()*number_of_components == number_of_values) ? 1 : 0;
 	cmzn_fieldcache& extraCache = *(valueCache.getExtraCache());
 	extraCache.setTime(cache.getTime());
 	int return_code = 1;
 	int number_of_terms = 0;
-	const int number_of_components = field->number_of_components;
-	const int max_terms = number_of_values / number_of_components;
 	FE_value *value = values;
 	cmzn_field_id sourceField = getSourceField(0);
 	int i;
@@ -393,6 +669,13 @@ int Computed_field_nodeset_sum_squares::evaluate_sum_square_terms(
 int Computed_field_nodeset_sum_squares::evaluate_sum_squares(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	NodesetSumReducer reducer(field->number_of_components, /*squares*/true);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+	{
+		reducer.getSums(valueCache.values);
+		valueCache.derivatives_valid = 0;
+		return reducer.getTermCount();
+	}
 	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
 	extraCache.setTime(cache.getTime());
 	int number_of_terms = 0;
@@ -535,6 +818,13 @@ public:
 int Computed_field_nodeset_minimum::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	NodesetExtremumReducer reducer(field->number_of_components, /*maximum*/false);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+	{
+		reducer.getExtrema(valueCache.values);
+		valueCache.derivatives_valid = 0;
+		return reducer.hasNodes() ? 1 : 0;
+	}
 	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
 	extraCache.setTime(cache.getTime());
 	cmzn_field_id sourceField = getSourceField(0);
@@ -613,6 +903,13 @@ public:
 int Computed_field_nodeset_maximum::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	NodesetExtremumReducer reducer(field->number_of_components, /*maximum*/true);
+	if (this->reduceAtNodeBlocks(cache, reducer))
+	{
+		reducer.getExtrema(valueCache.values);
+		valueCache.derivatives_valid = 0;
+		return reducer.hasNodes() ? 1 : 0;
+	}
 	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
 	extraCache.setTime(cache.getTime());
 	cmzn_field_id sourceField = getSourceField(0);
@@ -655,6 +952,272 @@ int Computed_field_nodeset_maximum::evaluate(cmzn_fieldcache& cache, FieldValueC
 	return 0;
 }
 
+const char computed_field_find_nearest_node_type_string[] = "find_nearest_node";
+
+/**
+ * Finds the node in nodeset with coordinate field value nearest to the source
+ * field value, evaluating to the coordinate field value at that node.
+ * Nodes are indexed by their coordinates in a uniform grid which is built on
+ * first use for a time and shared by all field caches. It is discarded when
+ * the coordinate field or the nodeset group, if any, change, but not when
+ * the source field changes.
+ */
+class Computed_field_find_nearest_node : public Computed_field_nodeset_operator
+{
+	PointGrid<DsLabelIdentifier> *nodeGrid; // indexes node identifiers
+	FE_value nodeGridTime;
+
+public:
+	Computed_field_find_nearest_node(cmzn_nodeset_id nodeset_in) :
+		Computed_field_nodeset_operator(nodeset_in),
+		nodeGrid(0),
+		nodeGridTime(0.0)
+	{
+	}
+
+	virtual ~Computed_field_find_nearest_node()
+	{
+		delete this->nodeGrid;
+	}
+
+	Computed_field_core *copy()
+	{
+		return new Computed_field_find_nearest_node(nodeset);
+	}
+
+	const char *get_type_string()
+	{
+		return (computed_field_find_nearest_node_type_string);
+	}
+
+	int compare(Computed_field_core* other_core)
+	{
+		Computed_field_find_nearest_node *other =
+			dynamic_cast<Computed_field_find_nearest_node*>(other_core);
+		if (other)
+			return cmzn_nodeset_match(nodeset, other->get_nodeset());
+		return 0;
+	}
+
+	cmzn_field_id get_source_field()
+	{
+		return field->source_fields[0];
+	}
+
+	cmzn_field_id get_coordinate_field()
+	{
+		return field->source_fields[1];
+	}
+
+	virtual int clear_cache()
+	{
+		delete this->nodeGrid;
+		this->nodeGrid = 0;
+		return 1;
+	}
+
+	/** Discards node grid only if node coordinates or nodes in nodeset change,
+	 * not for changes to the source field being searched for */
+	virtual int check_dependency()
+	{
+		int return_code = Computed_field_nodeset_operator::check_dependency();
+		if ((this->nodeGrid) && (MANAGER_CHANGE_NONE(Computed_field) != return_code))
+		{
+			cmzn_field_node_group *nodeGroupField = cmzn_nodeset_get_node_group_field_internal(this->nodeset);
+			if ((MANAGER_CHANGE_NONE(Computed_field) != this->get_coordinate_field()->manager_change_status)
+				|| (nodeGroupField && (MANAGER_CHANGE_NONE(Computed_field) !=
+					cmzn_field_node_group_base_cast(nodeGroupField)->manager_change_status)))
+				this->clear_cache();
+		}
+		return return_code;
+	}
+
+	virtual bool is_defined_at_location(cmzn_fieldcache& cache)
+	{
+		return (0 != field->evaluate(cache));
+	}
+
+	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
+
+	int list();
+
+	char* get_command_string();
+
+	cmzn_node_id findNearestNode(cmzn_fieldcache& cache);
+
+	int addNodesWithinDistance(cmzn_fieldcache& cache, FE_value distance,
+		cmzn_nodeset_group_id nodesetGroup);
+
+private:
+	const PointGrid<DsLabelIdentifier> *getNodeGrid(cmzn_fieldcache& cache);
+
+};
+
+/**
+ * Get node grid for time, building it if needed with a cell size giving
+ * about one node per cell over their bounding box.
+ */
+const PointGrid<DsLabelIdentifier> *Computed_field_find_nearest_node::getNodeGrid(
+	cmzn_fieldcache& cache)
+{
+	if (this->nodeGrid && (this->nodeGridTime == cache.getTime()))
+		return this->nodeGrid;
+	this->clear_cache();
+	cmzn_field_id coordinateField = this->get_coordinate_field();
+	const int componentsCount = coordinateField->number_of_components;
+	cmzn_fieldcache& extraCache = *(field->getValueCache(cache)->getExtraCache());
+	extraCache.setTime(cache.getTime());
+	std::vector<DsLabelIdentifier> identifiers;
+	std::vector<FE_value> coordinates;
+	FE_value minimum[3], maximum[3];
+	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(this->nodeset);
+	cmzn_node_id node = 0;
+	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	{
+		extraCache.setNode(node);
+		const RealFieldValueCache *coordinateValueCache =
+			RealFieldValueCache::cast(coordinateField->evaluateNoDerivatives(extraCache));
+		if (coordinateValueCache)
+		{
+			for (int c = 0; c < componentsCount; ++c)
+			{
+				const FE_value value = coordinateValueCache->values[c];
+				if (identifiers.empty() || (value < minimum[c]))
+					minimum[c] = value;
+				if (identifiers.empty() || (value > maximum[c]))
+					maximum[c] = value;
+				coordinates.push_back(value);
+			}
+			identifiers.push_back(cmzn_node_get_identifier(node));
+		}
+	}
+	cmzn_nodeiterator_destroy(&iterator);
+	const int nodesCount = static_cast<int>(identifiers.size());
+	FE_value cellSize = 0.0;
+	for (int c = 0; c < componentsCount; ++c)
+		if ((0 < nodesCount) && (maximum[c] - minimum[c] > cellSize))
+			cellSize = maximum[c] - minimum[c];
+	if (1 < nodesCount)
+		cellSize /= pow(static_cast<FE_value>(nodesCount), 1.0/componentsCount);
+	this->nodeGrid = new PointGrid<DsLabelIdentifier>(componentsCount, cellSize);
+	for (int n = 0; n < nodesCount; ++n)
+		this->nodeGrid->add(coordinates.data() + n*componentsCount, identifiers[n]);
+	this->nodeGridTime = cache.getTime();
+	return this->nodeGrid;
+}
+
+/** @return  Accessed nearest node to source field value, or 0 if none */
+cmzn_node_id Computed_field_find_nearest_node::findNearestNode(cmzn_fieldcache& cache)
+{
+	const RealFieldValueCache *sourceValueCache =
+		RealFieldValueCache::cast(this->get_source_field()->evaluateNoDerivatives(cache));
+	if (!sourceValueCache)
+		return 0;
+	const PointGrid<DsLabelIdentifier> *grid = this->getNodeGrid(cache);
+	DsLabelIdentifier identifier;
+	FE_value distance;
+	if (!grid->findNearest(sourceValueCache->values, /*maximumDistance*/-1.0, identifier, distance))
+		return 0;
+	return cmzn_nodeset_find_node_by_identifier(this->nodeset, identifier);
+}
+
+int Computed_field_find_nearest_node::addNodesWithinDistance(cmzn_fieldcache& cache,
+	FE_value distance, cmzn_nodeset_group_id nodesetGroup)
+{
+	const RealFieldValueCache *sourceValueCache =
+		RealFieldValueCache::cast(this->get_source_field()->evaluateNoDerivatives(cache));
+	if (!sourceValueCache)
+		return CMZN_ERROR_GENERAL;
+	const PointGrid<DsLabelIdentifier> *grid = this->getNodeGrid(cache);
+	std::vector<DsLabelIdentifier> identifiers;
+	grid->findWithinDistance(sourceValueCache->values, distance, identifiers);
+	int return_code = CMZN_OK;
+	cmzn_fieldmodule_id fieldmodule = cmzn_field_get_fieldmodule(this->field);
+	cmzn_fieldmodule_begin_change(fieldmodule);
+	const size_t identifiersCount = identifiers.size();
+	for (size_t i = 0; i < identifiersCount; ++i)
+	{
+		cmzn_node_id node = cmzn_nodeset_find_node_by_identifier(this->nodeset, identifiers[i]);
+		if (node)
+		{
+			if (!cmzn_nodeset_contains_node(cmzn_nodeset_group_base_cast(nodesetGroup), node))
+				return_code = cmzn_nodeset_group_add_node(nodesetGroup, node);
+			cmzn_node_destroy(&node);
+			if (CMZN_OK != return_code)
+				break;
+		}
+	}
+	cmzn_fieldmodule_end_change(fieldmodule);
+	cmzn_fieldmodule_destroy(&fieldmodule);
+	return return_code;
+}
+
+int Computed_field_find_nearest_node::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
+{
+	cmzn_node_id node = this->findNearestNode(cache);
+	if (!node)
+		return 0;
+	int return_code = 0;
+	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
+	extraCache.setTime(cache.getTime());
+	extraCache.setNode(node);
+	const RealFieldValueCache *coordinateValueCache =
+		RealFieldValueCache::cast(this->get_coordinate_field()->evaluateNoDerivatives(extraCache));
+	if (coordinateValueCache)
+	{
+		for (int i = 0; i < field->number_of_components; ++i)
+			valueCache.values[i] = coordinateValueCache->values[i];
+		valueCache.derivatives_valid = 0;
+		return_code = 1;
+	}
+	cmzn_node_destroy(&node);
+	return return_code;
+}
+
+int Computed_field_find_nearest_node::list()
+{
+	if (field)
+	{
+		display_message(INFORMATION_MESSAGE, "    source field : %s\n",
+			this->get_source_field()->name);
+		display_message(INFORMATION_MESSAGE, "    coordinate field : %s\n",
+			this->get_coordinate_field()->name);
+		char *nodeset_name = cmzn_nodeset_get_name(nodeset);
+		display_message(INFORMATION_MESSAGE, "    nodeset : %s\n", nodeset_name);
+		DEALLOCATE(nodeset_name);
+		return 1;
+	}
+	return 0;
+}
+
+/** Returns allocated command string for reproducing field. Includes type. */
+char *Computed_field_find_nearest_node::get_command_string()
+{
+	char *command_string = 0;
+	if (field)
+	{
+		int error = 0;
+		append_string(&command_string, get_type_string(), &error);
+		char *field_name = cmzn_field_get_name(this->get_source_field());
+		make_valid_token(&field_name);
+		append_string(&command_string, " source_field ", &error);
+		append_string(&command_string, field_name, &error);
+		DEALLOCATE(field_name);
+		field_name = cmzn_field_get_name(this->get_coordinate_field());
+		make_valid_token(&field_name);
+		append_string(&command_string, " coordinate_field ", &error);
+		append_string(&command_string, field_name, &error);
+		DEALLOCATE(field_name);
+		char *nodeset_name = cmzn_nodeset_get_name(nodeset);
+		append_string(&command_string, " nodeset ", &error);
+		make_valid_token(&nodeset_name);
+		append_string(&command_string, nodeset_name, &error);
+		DEALLOCATE(nodeset_name);
+	}
+	return (command_string);
+}
+
 } //namespace
 
 cmzn_field_id cmzn_fieldmodule_create_field_nodeset_sum(
@@ -771,3 +1334,98 @@ cmzn_field_id cmzn_fieldmodule_create_field_nodeset_maximum(
 	return field;
 }
 
+
+cmzn_field_id cmzn_fieldmodule_create_field_find_nearest_node(
+	cmzn_fieldmodule_id field_module, cmzn_field_id source_field,
+	cmzn_field_id coordinate_field, cmzn_nodeset_id nodeset)
+{
+	cmzn_field_id field = 0;
+	if (source_field && source_field->isNumerical() &&
+		coordinate_field && coordinate_field->isNumerical() &&
+		(source_field->number_of_components == coordinate_field->number_of_components) &&
+		(coordinate_field->number_of_components <= 3) && nodeset &&
+		(cmzn_fieldmodule_get_region_internal(field_module) ==
+			cmzn_nodeset_get_region_internal(nodeset)))
+	{
+		cmzn_field_id source_fields[2];
+		source_fields[0] = source_field;
+		source_fields[1] = coordinate_field;
+		field = Computed_field_create_generic(field_module,
+			/*check_source_field_regions*/true,
+			coordinate_field->number_of_components,
+			/*number_of_source_fields*/2, source_fields,
+			/*number_of_source_values*/0, NULL,
+			new Computed_field_find_nearest_node(nodeset));
+	}
+	else
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_fieldmodule_create_field_find_nearest_node.  Invalid argument(s)");
+	}
+	return field;
+}
+
+struct cmzn_field_find_nearest_node : private Computed_field
+{
+	inline Computed_field_find_nearest_node *get_core()
+	{
+		return static_cast<Computed_field_find_nearest_node*>(core);
+	}
+
+	inline cmzn_region_id getRegion()
+	{
+		return this->manager->owner;
+	}
+};
+
+cmzn_field_find_nearest_node_id cmzn_field_cast_find_nearest_node(
+	cmzn_field_id field)
+{
+	if (field && dynamic_cast<Computed_field_find_nearest_node*>(field->core))
+	{
+		cmzn_field_access(field);
+		return (reinterpret_cast<cmzn_field_find_nearest_node_id>(field));
+	}
+	return 0;
+}
+
+int cmzn_field_find_nearest_node_destroy(
+	cmzn_field_find_nearest_node_id *find_nearest_node_field_address)
+{
+	return cmzn_field_destroy(reinterpret_cast<cmzn_field_id *>(find_nearest_node_field_address));
+}
+
+cmzn_nodeset_id cmzn_field_find_nearest_node_get_nodeset(
+	cmzn_field_find_nearest_node_id find_nearest_node_field)
+{
+	if (find_nearest_node_field)
+		return cmzn_nodeset_access(find_nearest_node_field->get_core()->get_nodeset());
+	return 0;
+}
+
+cmzn_node_id cmzn_field_find_nearest_node_evaluate_node(
+	cmzn_field_find_nearest_node_id find_nearest_node_field,
+	cmzn_fieldcache_id cache)
+{
+	if (find_nearest_node_field && cache &&
+		(find_nearest_node_field->getRegion() == cache->getRegion()))
+		return find_nearest_node_field->get_core()->findNearestNode(*cache);
+	display_message(ERROR_MESSAGE,
+		"cmzn_field_find_nearest_node_evaluate_node.  Invalid argument(s)");
+	return 0;
+}
+
+int cmzn_field_find_nearest_node_add_nodes_within_distance(
+	cmzn_field_find_nearest_node_id find_nearest_node_field,
+	cmzn_fieldcache_id cache, double distance,
+	cmzn_nodeset_group_id nodeset_group)
+{
+	if (find_nearest_node_field && cache &&
+		(find_nearest_node_field->getRegion() == cache->getRegion()) &&
+		(distance >= 0.0) && nodeset_group)
+		return find_nearest_node_field->get_core()->addNodesWithinDistance(*cache,
+			distance, nodeset_group);
+	display_message(ERROR_MESSAGE,
+		"cmzn_field_find_nearest_node_add_nodes_within_distance.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
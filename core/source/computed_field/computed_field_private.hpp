@@ -24,10 +24,13 @@ Types used only internally to computed fields.
 #include "general/cmiss_set.hpp"
 #include "computed_field/field_location.hpp"
 #include "computed_field/field_cache.hpp"
+#include "computed_field/field_tape.hpp"
 #include "computed_field/computed_field.h"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/manager_private.h"
 #include "region/cmiss_region.h"
+#include <vector>
 
 /**
  * Argument to field modifier functions supplying region, default name,
@@ -218,6 +221,15 @@ public:
 
 	inline cmzn_field_id getSourceField(int index) const;
 
+	/** @return  True if all source fields support evaluateAtNodes. */
+	inline bool sourceFieldsSupportEvaluateAtNodes() const;
+
+	/** Evaluate source field at a block of nodes into arrays which are resized
+	 * to fit. Only call if source field supports evaluateAtNodes.
+	 * @see evaluateAtNodes */
+	inline bool evaluateSourceFieldAtNodes(int index, FE_value time, int nodeCount,
+		cmzn_node * const *nodes, std::vector<FE_value>& values, std::vector<char>& defined) const;
+
 	/**
 	 * Override to inherit attributes such as coordinate system from source fields.
 	 */
@@ -282,6 +294,53 @@ public:
 		return 0;
 	}
 
+	/**
+	 * Override & return true for real-valued field types implementing
+	 * evaluateAtNodes. Field types with source fields should only return true
+	 * if sourceFieldsSupportEvaluateAtNodes().
+	 */
+	virtual bool supportsEvaluateAtNodes() const
+	{
+		return false;
+	}
+
+	/**
+	 * Override to evaluate real field values at a block of nodes directly
+	 * from node parameters, bypassing the per-node overheads of field caches.
+	 * Used for fast reductions over nodesets. Only call if
+	 * supportsEvaluateAtNodes() returns true.
+	 * @param time  The time to evaluate at.
+	 * @param nodeCount  The number of nodes in the block.
+	 * @param nodes  Array of nodeCount nodes.
+	 * @param values  Array of size components*nodeCount to receive values in
+	 * component-major order: value of component c at node n is put at
+	 * values[c*nodeCount + n]. Values where not defined are unspecified.
+	 * @param defined  Array of size nodeCount to receive 1 for nodes at which
+	 * the field is defined, 0 otherwise.
+	 * @return  True on success, false on failure.
+	 */
+	virtual bool evaluateAtNodes(FE_value /*time*/, int /*nodeCount*/,
+		cmzn_node * const * /*nodes*/, FE_value * /*values*/, char * /*defined*/)
+	{
+		return false;
+	}
+
+	/**
+	 * Override for real-valued field types whose values are a simple function
+	 * of source field values, to add instructions computing them to a tape.
+	 * Get source field registers from compiler.compileField(). The resulting
+	 * values must be identical to those from evaluate().
+	 * @param compiler  The tape compiler.
+	 * @param componentRegisters  Array of size number_of_components to receive
+	 * the compiler register holding the value of each component.
+	 * @return  True on success, false if field type cannot be compiled, in
+	 * which case the field is evaluated as an input to the tape.
+	 */
+	virtual bool compileTape(FieldTapeCompiler& /*compiler*/, int * /*componentRegisters*/)
+	{
+		return false;
+	}
+
 	virtual enum FieldAssignmentResult assign(cmzn_fieldcache& /*cache*/, MeshLocationFieldValueCache& /*valueCache*/)
 	{
 		return FIELD_ASSIGNMENT_RESULT_FAIL;
@@ -355,11 +414,24 @@ public:
 	 * MANAGER_CHANGE_PARTIAL_RESULT set, then set and return this value.
 	 * In all other cases return current change status of field.
 	 * Override for customised dependencies on fields, external or sub-objects.
+	 * Only called by MANAGER_UPDATE_DEPENDENCIES(Computed_field), which visits
+	 * fields in dependency order so change status of source fields is final.
 	 * @return  MANAGER_CHANGE_FULL_RESULT, MANAGER_CHANGE_PARTIAL_RESULT or
 	 * MANAGER_CHANGE_NONE.
 	 */
 	virtual int check_dependency();
 
+	/**
+	 * Override to return true if check_dependency can find changes other than
+	 * from source fields, e.g. from FE_region change logs or group fields not
+	 * used as source fields. Such fields are checked in every manager update;
+	 * others only when downstream of a changed field.
+	 */
+	virtual bool has_non_source_dependencies() const
+	{
+		return false;
+	}
+
 	// override if field knows its function is non-linear over its domain
 	// base implementation returns true if any source fields are non_linear.
 	// Overrides must call the base implementation if function is not non-linear
@@ -491,6 +563,27 @@ DESCRIPTION :
 	/** bit flag attributes. @see Computed_field_attribute_flags. */
 	int attribute_flags;
 
+	/* tape for evaluating field in blocks, compiled on demand. Cleared when
+	 * field or any of its source fields changes in definition or full result */
+	FieldTape *tape;
+	/* true if tape compilation has been attempted since it was last cleared */
+	bool tapeCompiled;
+
+	/* reverse of source_fields: fields using this field as a source, once per
+	 * use. Not accessed. Created on demand */
+	std::vector<cmzn_field *> *dependentFields;
+
+	/* cached topological order: 0 for fields without source fields, otherwise
+	 * 1 + maximum level of source fields; -1 if not yet calculated */
+	int dependencyLevel;
+
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	/* number of evaluations of this field, and those satisfied from the
+	 * value cache without recomputing */
+	unsigned long long evaluationsCount;
+	unsigned long long evaluationCacheHitsCount;
+#endif
+
 	inline Computed_field *access()
 	{
 		++access_count;
@@ -507,6 +600,36 @@ DESCRIPTION :
 	 */
 	void clearCaches();
 
+	/** Record that dependentField uses this field as a source field. Call once
+	 * for each use, on setting source fields. */
+	void addDependentField(cmzn_field *dependentField);
+
+	/** Remove one record of dependentField using this field as a source field.
+	 * Call once for each use, on clearing source fields. */
+	void removeDependentField(cmzn_field *dependentField);
+
+	/** @return  Dependency level, calculating it and levels of source fields
+	 * if needed. Always greater than the levels of its source fields. */
+	int getDependencyLevel()
+	{
+		if (this->dependencyLevel < 0)
+		{
+			int level = 0;
+			for (int i = 0; i < this->number_of_source_fields; ++i)
+			{
+				const int sourceLevel = this->source_fields[i]->getDependencyLevel();
+				if (sourceLevel >= level)
+					level = sourceLevel + 1;
+			}
+			this->dependencyLevel = level;
+		}
+		return this->dependencyLevel;
+	}
+
+	/** Mark dependency level of this field and all fields depending on it as
+	 * needing recalculation. Call when source fields change. */
+	void invalidateDependencyLevel();
+
 	inline FieldValueCache *getValueCache(cmzn_fieldcache& cache)
 	{
 		FieldValueCache *valueCache = cache.getValueCache(cache_index);
@@ -538,12 +661,29 @@ DESCRIPTION :
 
 	inline FieldValueCache *evaluate(cmzn_fieldcache& cache);
 
+	/**
+	 * Get tape for evaluating field values over blocks of locations, compiling
+	 * it on first call. Not available while manager changes are being cached.
+	 * @return  Tape owned by this field, or 0 if field type is not compilable.
+	 */
+	FieldTape *getTape();
+
+	/** Discard tape, if any, so it is recompiled on next use. */
+	void clearTape();
+
+	/** Evaluate values and derivatives requested by cache from tape, if any,
+	 * by forward-mode automatic differentiation.
+	 * @return  Value cache with valid derivatives, or 0 if no tape or failed. */
+	RealFieldValueCache *evaluateTapeWithDerivatives(cmzn_fieldcache& cache);
+
 	/** @param numberOfDerivatives  positive number of xi dimension of element location */
 	inline RealFieldValueCache *evaluateWithDerivatives(cmzn_fieldcache& cache, int numberOfDerivatives)
 	{
 		int requestedDerivatives = cache.getRequestedDerivatives();
 		cache.setRequestedDerivatives(numberOfDerivatives);
-		RealFieldValueCache *valueCache = RealFieldValueCache::cast(evaluate(cache));
+		RealFieldValueCache *valueCache = this->evaluateTapeWithDerivatives(cache);
+		if (!valueCache)
+			valueCache = RealFieldValueCache::cast(evaluate(cache));
 		cache.setRequestedDerivatives(requestedDerivatives);
 		if (valueCache && valueCache->derivatives_valid)
 			return valueCache;
@@ -562,17 +702,7 @@ DESCRIPTION :
 	/** @return  true if this field equals otherField or otherField is a source
 	 * field directly or indirectly, otherwise false.
 	 */
-	bool dependsOnField(cmzn_field *otherField)
-	{
-		if (this == otherField)
-			return true;
-		for (int i = 0; i < this->number_of_source_fields; ++i)
-		{
-			if (this->source_fields[i]->dependsOnField(otherField))
-				return true;
-		}
-		return false;
-	}
+	bool dependsOnField(cmzn_field *otherField);
 
 	int isNumerical()
 	{
@@ -634,6 +764,26 @@ inline cmzn_field_id Computed_field_core::getSourceField(int index) const
 	return field->source_fields[index];
 }
 
+inline bool Computed_field_core::sourceFieldsSupportEvaluateAtNodes() const
+{
+	for (int i = 0; i < field->number_of_source_fields; ++i)
+	{
+		if (!field->source_fields[i]->core->supportsEvaluateAtNodes())
+			return false;
+	}
+	return true;
+}
+
+inline bool Computed_field_core::evaluateSourceFieldAtNodes(int index, FE_value time,
+	int nodeCount, cmzn_node * const *nodes, std::vector<FE_value>& values,
+	std::vector<char>& defined) const
+{
+	cmzn_field *sourceField = field->source_fields[index];
+	values.resize(sourceField->number_of_components*nodeCount);
+	defined.resize(nodeCount);
+	return sourceField->core->evaluateAtNodes(time, nodeCount, nodes, values.data(), defined.data());
+}
+
 /* Only to be used from FIND_BY_IDENTIFIER_IN_INDEXED_LIST_STL function
  * Creates a pseudo object with name identifier suitable for finding
  * objects by identifier with cmzn_set.
@@ -673,6 +823,8 @@ FULL_DECLARE_MANAGER_TYPE_WITH_OWNER(Computed_field, struct cmzn_region, struct
 inline FieldValueCache *Computed_field::evaluate(cmzn_fieldcache& cache)
 {
 	FieldValueCache *valueCache = getValueCache(cache);
+	ZINC_INSTRUMENT_COUNT(this->evaluationsCount);
+	ZINC_INSTRUMENT_COUNT(instrumentationCounters.fieldEvaluations);
 	// GRC: move derivatives to a separate value cache in future
 	if ((valueCache->evaluationCounter < cache.getLocationCounter()) ||
 		(cache.getRequestedDerivatives() && (!valueCache->hasDerivatives())))
@@ -686,6 +838,11 @@ inline FieldValueCache *Computed_field::evaluate(cmzn_fieldcache& cache)
 		else
 			valueCache = 0;
 	}
+	else
+	{
+		ZINC_INSTRUMENT_COUNT(this->evaluationCacheHitsCount);
+		ZINC_INSTRUMENT_COUNT(instrumentationCounters.fieldEvaluationCacheHits);
+	}
 	return valueCache;
 }
 
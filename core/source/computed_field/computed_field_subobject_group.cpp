@@ -41,6 +41,43 @@ Computed_field_subobject_group::~Computed_field_subobject_group()
 			this->field ? this->field->name : "?");
 }
 
+DsLabelsGroup *Computed_field_subobject_group::getConditionalLabelsGroup(cmzn_field *conditionalField)
+{
+	DsLabelsGroup *labelsGroup = this->getConditionalGroupLabelsGroup(conditionalField);
+	if ((labelsGroup) || (conditionalField->number_of_components != 1))
+		return labelsGroup;
+	const cmzn_field_type type = conditionalField->core->get_type();
+	if ((type == CMZN_FIELD_TYPE_AND) || (type == CMZN_FIELD_TYPE_OR))
+	{
+		DsLabelsGroup *sourceLabelsGroup1 = this->getConditionalLabelsGroup(conditionalField->source_fields[0]);
+		if (!sourceLabelsGroup1)
+			return 0;
+		DsLabelsGroup *sourceLabelsGroup2 = this->getConditionalLabelsGroup(conditionalField->source_fields[1]);
+		if (sourceLabelsGroup2)
+		{
+			labelsGroup = DsLabelsGroup::create(sourceLabelsGroup1->getLabels());
+			if ((labelsGroup) && ((CMZN_OK != labelsGroup->addGroup(*sourceLabelsGroup1)) ||
+				(CMZN_OK != ((type == CMZN_FIELD_TYPE_AND) ?
+					labelsGroup->intersectGroup(*sourceLabelsGroup2) : labelsGroup->addGroup(*sourceLabelsGroup2)))))
+				cmzn::Deaccess(labelsGroup);
+			cmzn::Deaccess(sourceLabelsGroup2);
+		}
+		cmzn::Deaccess(sourceLabelsGroup1);
+	}
+	else if (type == CMZN_FIELD_TYPE_NOT)
+	{
+		DsLabelsGroup *sourceLabelsGroup = this->getConditionalLabelsGroup(conditionalField->source_fields[0]);
+		if (!sourceLabelsGroup)
+			return 0;
+		labelsGroup = DsLabelsGroup::create(sourceLabelsGroup->getLabels());
+		if ((labelsGroup) && ((CMZN_OK != labelsGroup->addAllLabels()) ||
+			(CMZN_OK != labelsGroup->removeGroup(*sourceLabelsGroup))))
+			cmzn::Deaccess(labelsGroup);
+		cmzn::Deaccess(sourceLabelsGroup);
+	}
+	return labelsGroup;
+}
+
 namespace {
 
 class Computed_field_sub_group_object_package : public Computed_field_type_package
@@ -171,30 +208,37 @@ int Computed_field_element_group::addElementsConditional(cmzn_field_id condition
 {
 	if ((!conditional_field) || (conditional_field->manager != this->field->manager))
 		return CMZN_ERROR_ARGUMENT;
-	bool isEmptyGroup;
-	Computed_field_element_group *otherElementGroup =
-		this->getConditionalElementGroup(conditional_field, isEmptyGroup);
-	if (isEmptyGroup)
+	DsLabelsGroup *conditionalLabelsGroup = this->getConditionalLabelsGroup(conditional_field);
+	if ((conditionalLabelsGroup) && (conditionalLabelsGroup->getSize() == 0))
+	{
+		cmzn::Deaccess(conditionalLabelsGroup);
 		return CMZN_OK;
+	}
 	int return_code = CMZN_OK;
 	this->beginChange();
 	cmzn_fieldcache *cache = 0;
 	const int oldSize = this->getSize();
 	const bool handleSubelements =
 		(this->getSubobjectHandlingMode() == CMZN_FIELD_GROUP_SUBELEMENT_HANDLING_MODE_FULL);
-	cmzn_elementiterator *iter;
-	if (otherElementGroup)
-		iter = otherElementGroup->createElementiterator(); // could handle this case very efficiently with logical OR
+	cmzn_elementiterator *iter = 0;
+	if (conditionalLabelsGroup)
+	{
+		return_code = this->labelsGroup->addGroup(*conditionalLabelsGroup);
+		if ((CMZN_OK == return_code) && handleSubelements)
+		{
+			iter = this->fe_mesh->createElementiterator(conditionalLabelsGroup);
+			if (!iter)
+				return_code = CMZN_ERROR_MEMORY;
+		}
+	}
 	else
 	{
 		iter = this->fe_mesh->createElementiterator();
 		cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_mesh->get_FE_region()));
-		if (!cache)
+		if ((!iter) || (!cache))
 			return_code = CMZN_ERROR_MEMORY;
 	}
-	if (!iter)
-		return_code = CMZN_ERROR_MEMORY;
-	if (CMZN_OK == return_code)
+	if ((CMZN_OK == return_code) && (iter))
 	{
 		cmzn_element_id element = 0;
 		while (0 != (element = iter->nextElement()))
@@ -204,12 +248,12 @@ int Computed_field_element_group::addElementsConditional(cmzn_field_id condition
 				cache->setElement(element);
 				if (!cmzn_field_evaluate_boolean(conditional_field, cache))
 					continue;
-			}
-			const int result = this->labelsGroup->setIndex(get_FE_element_index(element), true);
-			if ((result != CMZN_OK) && (result != CMZN_ERROR_ALREADY_EXISTS))
-			{
-				return_code = result;
-				break;
+				const int result = this->labelsGroup->setIndex(get_FE_element_index(element), true);
+				if ((result != CMZN_OK) && (result != CMZN_ERROR_ALREADY_EXISTS))
+				{
+					return_code = result;
+					break;
+				}
 			}
 			if (handleSubelements)
 			{
@@ -231,6 +275,7 @@ int Computed_field_element_group::addElementsConditional(cmzn_field_id condition
 		update();
 	}
 	cmzn_fieldcache_destroy(&cache);
+	cmzn::Deaccess(conditionalLabelsGroup);
 	this->endChange();
 	return return_code;
 }
@@ -267,51 +312,57 @@ int Computed_field_element_group::removeElementsConditional(cmzn_field_id condit
 {
 	if ((!conditional_field) || (conditional_field->manager != this->field->manager))
 		return CMZN_ERROR_ARGUMENT;
-	bool isEmptyGroup;
-	Computed_field_element_group *otherElementGroup =
-		this->getConditionalElementGroup(conditional_field, isEmptyGroup);
-	if (isEmptyGroup)
-		return CMZN_OK;
-	if (otherElementGroup == this)
-		return this->clear();
+	DsLabelsGroup *conditionalLabelsGroup = this->getConditionalLabelsGroup(conditional_field);
+	if (conditionalLabelsGroup)
+	{
+		const bool isSelf = (conditionalLabelsGroup == this->labelsGroup);
+		const bool isEmpty = (conditionalLabelsGroup->getSize() == 0);
+		if (isSelf || isEmpty)
+		{
+			cmzn::Deaccess(conditionalLabelsGroup);
+			return (isSelf) ? this->clear() : CMZN_OK;
+		}
+	}
 	const int oldSize = this->getSize();
 	if (oldSize == 0)
+	{
+		cmzn::Deaccess(conditionalLabelsGroup);
 		return CMZN_OK;
+	}
 	int return_code = CMZN_OK;
 	this->beginChange();
 	cmzn_fieldcache *cache = 0;
 	const bool handleSubelements =
 		(this->getSubobjectHandlingMode() == CMZN_FIELD_GROUP_SUBELEMENT_HANDLING_MODE_FULL);
-	cmzn_elementiterator *iter;
-	if (otherElementGroup)
-		iter = otherElementGroup->createElementiterator(); // could handle this case very efficiently with logical AND of complement
+	cmzn_elementiterator *iter = 0;
+	DsLabelsGroup *removedLabelsGroup = 0;
+	if (conditionalLabelsGroup)
+	{
+		return_code = this->labelsGroup->removeGroup(*conditionalLabelsGroup);
+		if (handleSubelements)
+			removedLabelsGroup = cmzn::Access(conditionalLabelsGroup);
+	}
 	else
 	{
 		iter = this->fe_mesh->createElementiterator();
 		cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_mesh->get_FE_region()));
-		if (!cache)
-			return_code = CMZN_ERROR_MEMORY;
-	}
-	if (!iter)
-		return_code = CMZN_ERROR_MEMORY;
-	DsLabelsGroup *removedLabelsGroup = 0;
-	if (handleSubelements)
-	{
-		removedLabelsGroup = this->fe_mesh->createLabelsGroup();
-		if (!removedLabelsGroup)
+		if ((!iter) || (!cache))
 			return_code = CMZN_ERROR_MEMORY;
+		if (handleSubelements)
+		{
+			removedLabelsGroup = this->fe_mesh->createLabelsGroup();
+			if (!removedLabelsGroup)
+				return_code = CMZN_ERROR_MEMORY;
+		}
 	}
-	if (CMZN_OK == return_code)
+	if ((CMZN_OK == return_code) && (iter))
 	{
 		cmzn_element_id element = 0;
 		while (0 != (element = iter->nextElement()))
 		{
-			if (cache)
-			{
-				cache->setElement(element);
-				if (!cmzn_field_evaluate_boolean(conditional_field, cache))
-					continue;
-			}
+			cache->setElement(element);
+			if (!cmzn_field_evaluate_boolean(conditional_field, cache))
+				continue;
 			const DsLabelIndex index = get_FE_element_index(element);
 			const int result = this->labelsGroup->setIndex(index, false);
 			if ((result != CMZN_OK) && (result != CMZN_ERROR_NOT_FOUND))
@@ -329,9 +380,9 @@ int Computed_field_element_group::removeElementsConditional(cmzn_field_id condit
 				}
 			}
 		}
-		if (handleSubelements && (CMZN_OK == return_code))
-			return_code = this->removeSubelementsList(*removedLabelsGroup);
 	}
+	if (handleSubelements && (CMZN_OK == return_code))
+		return_code = this->removeSubelementsList(*removedLabelsGroup);
 	cmzn::Deaccess(iter);
 	const int newSize = this->getSize();
 	if (newSize != oldSize)
@@ -342,6 +393,7 @@ int Computed_field_element_group::removeElementsConditional(cmzn_field_id condit
 	}
 	cmzn_fieldcache_destroy(&cache);
 	cmzn::Deaccess(removedLabelsGroup);
+	cmzn::Deaccess(conditionalLabelsGroup);
 	this->endChange();
 	return return_code;
 }
@@ -774,25 +826,31 @@ int Computed_field_element_group::check_dependency()
 	return MANAGER_CHANGE_NONE(Computed_field);
 }
 
-Computed_field_element_group *Computed_field_element_group::getConditionalElementGroup(
-	cmzn_field *conditionalField, bool &isEmptyGroup) const
+DsLabelsGroup *Computed_field_element_group::getConditionalGroupLabelsGroup(cmzn_field *conditionalField)
 {
-	isEmptyGroup = false;
 	Computed_field_element_group *otherElementGroup =
 		dynamic_cast<Computed_field_element_group *>(conditionalField->core);
-	if (!otherElementGroup)
+	if (otherElementGroup)
 	{
-		Computed_field_group *group = dynamic_cast<Computed_field_group *>(conditionalField->core);
-		if (group)
-		{
-			otherElementGroup = group->getElementGroupPrivate(this->fe_mesh);
-			if (!otherElementGroup)
-				isEmptyGroup = true;
-		}
+		// element group for another mesh is false for all elements in this mesh
+		if (otherElementGroup->fe_mesh == this->fe_mesh)
+			return cmzn::Access(otherElementGroup->labelsGroup);
+		return this->fe_mesh->createLabelsGroup();
+	}
+	Computed_field_group *group = dynamic_cast<Computed_field_group *>(conditionalField->core);
+	if (!group)
+		return 0;
+	if (group->containsLocalRegion())
+	{
+		DsLabelsGroup *labelsGroup = this->fe_mesh->createLabelsGroup();
+		if ((labelsGroup) && (CMZN_OK != labelsGroup->addAllLabels()))
+			cmzn::Deaccess(labelsGroup);
+		return labelsGroup;
 	}
-	if (otherElementGroup && (otherElementGroup->getSize() == 0))
-		isEmptyGroup = true;
-	return otherElementGroup;
+	otherElementGroup = group->getElementGroupPrivate(this->fe_mesh);
+	if (otherElementGroup)
+		return cmzn::Access(otherElementGroup->labelsGroup);
+	return this->fe_mesh->createLabelsGroup();
 }
 
 Computed_field_node_group *Computed_field_node_group::create(FE_nodeset *fe_nodeset_in)
@@ -876,35 +934,32 @@ int Computed_field_node_group::addNodesConditional(cmzn_field_id conditional_fie
 {
 	if ((!conditional_field) || (conditional_field->manager != this->field->manager))
 		return CMZN_ERROR_ARGUMENT;
-	bool isEmptyGroup;
-	Computed_field_node_group *otherNodeGroup =
-		this->getConditionalNodeGroup(conditional_field, isEmptyGroup);
-	if (isEmptyGroup)
-		return CMZN_OK;
-	int return_code = CMZN_OK;
-	cmzn_fieldcache *cache = 0;
-	const int oldSize = this->getSize();
-	cmzn_nodeiterator *iter;
-	if (otherNodeGroup)
-		iter = otherNodeGroup->createNodeiterator();
-	else
+	DsLabelsGroup *conditionalLabelsGroup = this->getConditionalLabelsGroup(conditional_field);
+	if (conditionalLabelsGroup)
 	{
-		iter = this->fe_nodeset->createNodeiterator();
-		cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_nodeset->get_FE_region()));
-		if (!cache)
-			return_code = CMZN_ERROR_MEMORY;
+		const int oldSize = this->getSize();
+		const int return_code = this->labelsGroup->addGroup(*conditionalLabelsGroup);
+		cmzn::Deaccess(conditionalLabelsGroup);
+		if (this->getSize() != oldSize)
+		{
+			this->invalidateIterators();
+			change_detail.changeAdd();
+			update();
+		}
+		return return_code;
 	}
-	if (!iter)
+	int return_code = CMZN_OK;
+	const int oldSize = this->getSize();
+	cmzn_nodeiterator *iter = this->fe_nodeset->createNodeiterator();
+	cmzn_fieldcache *cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_nodeset->get_FE_region()));
+	if ((!iter) || (!cache))
 		return_code = CMZN_ERROR_MEMORY;
 	cmzn_node_id node = 0;
 	while ((CMZN_OK == return_code) && (0 != (node = cmzn_nodeiterator_next_non_access(iter))))
 	{
-		if (cache)
-		{
-			cache->setNode(node);
-			if (!cmzn_field_evaluate_boolean(conditional_field, cache))
-				continue;
-		}
+		cache->setNode(node);
+		if (!cmzn_field_evaluate_boolean(conditional_field, cache))
+			continue;
 		const int result = this->labelsGroup->setIndex(get_FE_node_index(node), true);
 		if ((result != CMZN_OK) && (result != CMZN_ERROR_ALREADY_EXISTS))
 		{
@@ -942,39 +997,35 @@ int Computed_field_node_group::removeNodesConditional(cmzn_field_id conditional_
 {
 	if ((!conditional_field) || (conditional_field->manager != this->field->manager))
 		return CMZN_ERROR_ARGUMENT;
-	bool isEmptyGroup;
-	Computed_field_node_group *otherNodeGroup =
-		this->getConditionalNodeGroup(conditional_field, isEmptyGroup);
-	if (isEmptyGroup)
-		return CMZN_OK;
 	const int oldSize = this->getSize();
+	DsLabelsGroup *conditionalLabelsGroup = this->getConditionalLabelsGroup(conditional_field);
+	if (conditionalLabelsGroup)
+	{
+		const int return_code = this->labelsGroup->removeGroup(*conditionalLabelsGroup);
+		cmzn::Deaccess(conditionalLabelsGroup);
+		if (this->getSize() != oldSize)
+		{
+			this->invalidateIterators();
+			change_detail.changeRemove();
+			update();
+		}
+		return return_code;
+	}
 	if (oldSize == 0)
 		return CMZN_OK;
 	int return_code = CMZN_OK;
-	cmzn_fieldcache *cache = 0;
-	cmzn_nodeiterator *iter;
-	if (otherNodeGroup)
-		iter = otherNodeGroup->createNodeiterator(); // could handle this case very efficiently with logical AND of complement
-	else
-	{
-		iter = this->createNodeiterator();
-		cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_nodeset->get_FE_region()));
-		if (!cache)
-			return_code = CMZN_ERROR_MEMORY;
-	}
-	if (!iter)
+	cmzn_nodeiterator *iter = this->createNodeiterator();
+	cmzn_fieldcache *cache = new cmzn_fieldcache(FE_region_get_cmzn_region(this->fe_nodeset->get_FE_region()));
+	if ((!iter) || (!cache))
 		return_code = CMZN_ERROR_MEMORY;
 	if (CMZN_OK == return_code)
 	{
 		cmzn_node_id node = 0;
 		while (0 != (node = iter->nextNode()))
 		{
-			if (cache)
-			{
-				cache->setNode(node);
-				if (!cmzn_field_evaluate_boolean(conditional_field, cache))
-					continue;
-			}
+			cache->setNode(node);
+			if (!cmzn_field_evaluate_boolean(conditional_field, cache))
+				continue;
 			const DsLabelIndex index = get_FE_node_index(node);
 			const int result = this->labelsGroup->setIndex(index, false);
 			if ((result != CMZN_OK) && (result != CMZN_ERROR_NOT_FOUND))
@@ -992,6 +1043,7 @@ int Computed_field_node_group::removeNodesConditional(cmzn_field_id conditional_
 		change_detail.changeRemove();
 		update();
 	}
+	cmzn_fieldcache_destroy(&cache);
 	return return_code;
 }
 
@@ -1132,24 +1184,30 @@ int Computed_field_node_group::check_dependency()
 	return MANAGER_CHANGE_NONE(Computed_field);
 }
 
-Computed_field_node_group *Computed_field_node_group::getConditionalNodeGroup(
-	cmzn_field *conditionalField, bool &isEmptyGroup) const
+DsLabelsGroup *Computed_field_node_group::getConditionalGroupLabelsGroup(cmzn_field *conditionalField)
 {
-	isEmptyGroup = false;
 	Computed_field_node_group *otherNodeGroup = dynamic_cast<Computed_field_node_group *>(conditionalField->core);
-	if (!otherNodeGroup)
+	if (otherNodeGroup)
 	{
-		Computed_field_group *group = dynamic_cast<Computed_field_group *>(conditionalField->core);
-		if (group)
-		{
-			otherNodeGroup = group->getNodeGroupPrivate(this->fe_nodeset->getFieldDomainType());
-			if (!otherNodeGroup)
-				isEmptyGroup = true;
-		}
+		// node group for another nodeset is false for all nodes in this nodeset
+		if (otherNodeGroup->fe_nodeset == this->fe_nodeset)
+			return cmzn::Access(otherNodeGroup->labelsGroup);
+		return this->fe_nodeset->createLabelsGroup();
 	}
-	if (otherNodeGroup && (otherNodeGroup->getSize() == 0))
-		isEmptyGroup = true;
-	return otherNodeGroup;
+	Computed_field_group *group = dynamic_cast<Computed_field_group *>(conditionalField->core);
+	if (!group)
+		return 0;
+	if (group->containsLocalRegion())
+	{
+		DsLabelsGroup *labelsGroup = this->fe_nodeset->createLabelsGroup();
+		if ((labelsGroup) && (CMZN_OK != labelsGroup->addAllLabels()))
+			cmzn::Deaccess(labelsGroup);
+		return labelsGroup;
+	}
+	otherNodeGroup = group->getNodeGroupPrivate(this->fe_nodeset->getFieldDomainType());
+	if (otherNodeGroup)
+		return cmzn::Access(otherNodeGroup->labelsGroup);
+	return this->fe_nodeset->createLabelsGroup();
 }
 
 cmzn_field_node_group *cmzn_field_cast_node_group(cmzn_field_id field)
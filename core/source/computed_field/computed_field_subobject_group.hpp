@@ -118,6 +118,29 @@ public:
 		return CMZN_FIELD_GROUP_SUBELEMENT_HANDLING_MODE_NONE;
 	}
 
+protected:
+
+	/**
+	 * Override to get labels group of objects in a subobject group or group
+	 * conditional field, for the domain of this subobject group.
+	 * @return  Accessed labels group, or 0 if conditional field is not a group.
+	 */
+	virtual DsLabelsGroup *getConditionalGroupLabelsGroup(cmzn_field *conditionalField)
+	{
+		USE_PARAMETER(conditionalField);
+		return 0;
+	}
+
+	/**
+	 * Get labels group of objects for which conditional field is true, if it
+	 * is a group or a logical and, or, not of such conditionals, so it need
+	 * not be evaluated at each object. Logical operators are applied to whole
+	 * groups 32 labels at a time.
+	 * @return  Accessed labels group which must not be modified, or 0 if
+	 * conditional field must be evaluated at each object.
+	 */
+	DsLabelsGroup *getConditionalLabelsGroup(cmzn_field *conditionalField);
+
 };
 
 	template <typename T>
@@ -466,11 +489,7 @@ public:
 			return false;
 		}
 
-		/**
-		 * @param isEmptyGroup  True if there is a group, but the element group is empty.
-		 * @return  Non-empty element group, or 0 if not a group or empty.
-		 */
-		Computed_field_element_group *getConditionalElementGroup(cmzn_field *conditionalField, bool &isEmptyGroup) const;
+		virtual DsLabelsGroup *getConditionalGroupLabelsGroup(cmzn_field *conditionalField);
 
 		void invalidateIterators()
 		{
@@ -643,11 +662,7 @@ public:
 			return false;
 		}
 
-		/**
-		 * @param isEmptyGroup  True if there is a group, but the node group is empty.
-		 * @return  Non-empty node group, or 0 if not a group or empty.
-		 */
-		Computed_field_node_group *getConditionalNodeGroup(cmzn_field *conditionalField, bool &isEmptyGroup) const;
+		virtual DsLabelsGroup *getConditionalGroupLabelsGroup(cmzn_field *conditionalField);
 
 		void invalidateIterators()
 		{
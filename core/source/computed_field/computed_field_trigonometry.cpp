@@ -60,6 +60,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_SIN, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -248,6 +253,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_COS, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -437,6 +447,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_TAN, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -627,6 +642,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_ASIN, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -823,6 +843,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_ACOS, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -1019,6 +1044,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_ATAN, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
@@ -1208,6 +1238,11 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+	{
+		return compiler.compileComponentwise(this->field, FIELD_TAPE_OPERATION_ATAN2, componentRegisters);
+	}
+
 	int list();
 
 	char* get_command_string();
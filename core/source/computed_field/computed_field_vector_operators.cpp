@@ -64,6 +64,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -88,13 +90,23 @@ int Computed_field_normalise::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 		int number_of_xi = cache.getRequestedDerivatives();
 		if (number_of_xi && sourceCache->derivatives_valid)
 		{
-			FE_value *derivative = valueCache.derivatives;
-			FE_value *source_derivative = sourceCache->derivatives;
-			for (int i = 0 ; i < field->number_of_components * number_of_xi ; i++)
+			/* d(u/|u|)/dx = (du/dx * |u| - u * d|u|/dx) / |u|^2
+			 * where d|u|/dx = sum(u.du/dx) / |u| */
+			const FE_value *source_derivatives = sourceCache->derivatives;
+			for (int j = 0 ; j < number_of_xi ; j++)
 			{
-				*derivative = *source_derivative / size;
-				derivative++;
-				source_derivative++;
+				FE_value size_derivative = 0.0;
+				for (int i = 0 ; i < field->number_of_components ; i++)
+				{
+					size_derivative += sourceCache->values[i] * source_derivatives[i * number_of_xi + j];
+				}
+				size_derivative /= size;
+				for (int i = 0 ; i < field->number_of_components ; i++)
+				{
+					valueCache.derivatives[i * number_of_xi + j] =
+						(source_derivatives[i * number_of_xi + j] * size -
+						sourceCache->values[i] * size_derivative) / (size * size);
+				}
 			}
 			valueCache.derivatives_valid = 1;
 		}
@@ -107,6 +119,21 @@ int Computed_field_normalise::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 	return 0;
 }
 
+bool Computed_field_normalise::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	int sum = compiler.constant(0.0);
+	for (int i = 0; i < field->number_of_components; ++i)
+		sum = compiler.binary(FIELD_TAPE_OPERATION_ADD, sum,
+			compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, sourceRegisters[i], sourceRegisters[i]));
+	const int size = compiler.unary(FIELD_TAPE_OPERATION_SQRT, sum);
+	for (int i = 0; i < field->number_of_components; ++i)
+		componentRegisters[i] = compiler.binary(FIELD_TAPE_OPERATION_DIVIDE, sourceRegisters[i], size);
+	return true;
+}
+
 int Computed_field_normalise::list(
 	)
 /*******************************************************************************
@@ -631,6 +658,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -688,6 +717,21 @@ int Computed_field_dot_product::evaluate(cmzn_fieldcache& cache, FieldValueCache
 	return 0;
 }
 
+bool Computed_field_dot_product::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *source1Registers = compiler.compileField(getSourceField(0));
+	const int *source2Registers = compiler.compileField(getSourceField(1));
+	if (!(source1Registers && source2Registers))
+		return false;
+	int sum = compiler.constant(0.0);
+	const int vectorComponentCount = getSourceField(0)->number_of_components;
+	for (int i = 0; i < vectorComponentCount; ++i)
+		sum = compiler.binary(FIELD_TAPE_OPERATION_ADD, sum,
+			compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, source1Registers[i], source2Registers[i]));
+	componentRegisters[0] = sum;
+	return true;
+}
+
 int Computed_field_dot_product::list(
 	)
 /*******************************************************************************
@@ -860,6 +904,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -929,6 +975,20 @@ enum FieldAssignmentResult Computed_field_magnitude::assign(cmzn_fieldcache& cac
 	return getSourceField(0)->assign(cache, *sourceCache);
 }
 
+bool Computed_field_magnitude::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	int sum = compiler.constant(0.0);
+	const int sourceComponentCount = getSourceField(0)->number_of_components;
+	for (int i = 0; i < sourceComponentCount; ++i)
+		sum = compiler.binary(FIELD_TAPE_OPERATION_ADD, sum,
+			compiler.binary(FIELD_TAPE_OPERATION_MULTIPLY, sourceRegisters[i], sourceRegisters[i]));
+	componentRegisters[0] = compiler.unary(FIELD_TAPE_OPERATION_SQRT, sum);
+	return true;
+}
+
 int Computed_field_magnitude::list(
 	)
 /*******************************************************************************
@@ -1082,6 +1142,8 @@ private:
 
 	int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
+	virtual bool compileTape(FieldTapeCompiler& compiler, int *componentRegisters);
+
 	int list();
 
 	char* get_command_string();
@@ -1127,6 +1189,19 @@ int Computed_field_sum_components::evaluate(cmzn_fieldcache& cache, FieldValueCa
 	return 0;
 }
 
+bool Computed_field_sum_components::compileTape(FieldTapeCompiler& compiler, int *componentRegisters)
+{
+	const int *sourceRegisters = compiler.compileField(getSourceField(0));
+	if (!sourceRegisters)
+		return false;
+	int sum = compiler.constant(0.0);
+	const int sourceComponentCount = getSourceField(0)->number_of_components;
+	for (int i = 0; i < sourceComponentCount; ++i)
+		sum = compiler.binary(FIELD_TAPE_OPERATION_ADD, sum, sourceRegisters[i]);
+	componentRegisters[0] = sum;
+	return true;
+}
+
 int Computed_field_sum_components::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
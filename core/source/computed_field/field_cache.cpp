@@ -37,8 +37,10 @@ RealFieldValueCache::~RealFieldValueCache()
 		DESTROY(Computed_field_find_element_xi_cache)(&find_element_xi_cache);
 		find_element_xi_cache = 0;
 	}
-	delete[] values;
-	delete[] derivatives;
+	if (this->valueArena)
+		this->valueArena->release(this->values, this->getStorageCount());
+	else
+		delete[] this->values;
 }
 
 void RealFieldValueCache::clear()
@@ -107,6 +109,52 @@ char *MeshLocationFieldValueCache::getAsString()
 	return valueAsString;
 }
 
+namespace {
+
+/** Number of values in each arena block; larger requests get their own block */
+const int FieldValueArena_blockSize = 4096;
+
+}
+
+FieldValueArena::~FieldValueArena()
+{
+	for (std::vector<FE_value *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		delete[] (*iter);
+}
+
+FE_value *FieldValueArena::allocate(int count)
+{
+	std::map<int, std::vector<FE_value *> >::iterator iter = this->releasedValues.find(count);
+	if ((iter != this->releasedValues.end()) && (!iter->second.empty()))
+	{
+		FE_value *values = iter->second.back();
+		iter->second.pop_back();
+		return values;
+	}
+	if (count > this->blockRemaining)
+	{
+		if (count > FieldValueArena_blockSize/4)
+		{
+			FE_value *values = new FE_value[count];
+			this->blocks.push_back(values);
+			return values;
+		}
+		// remainder of previous block is abandoned
+		this->blockNext = new FE_value[FieldValueArena_blockSize];
+		this->blocks.push_back(this->blockNext);
+		this->blockRemaining = FieldValueArena_blockSize;
+	}
+	FE_value *values = this->blockNext;
+	this->blockNext += count;
+	this->blockRemaining -= count;
+	return values;
+}
+
+void FieldValueArena::release(FE_value *values, int count)
+{
+	this->releasedValues[count].push_back(values);
+}
+
 cmzn_fieldcache::~cmzn_fieldcache()
 {
 	for (ValueCacheVector::iterator iter = valueCaches.begin(); iter < valueCaches.end(); ++iter)
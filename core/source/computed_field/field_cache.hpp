@@ -20,9 +20,11 @@
 #include "general/debug.h"
 #include "region/cmiss_region.h"
 #include "computed_field/field_location.hpp"
+#include <map>
 #include <vector>
 
 struct Computed_field_find_element_xi_cache;
+class FE_region_changes;
 
 // dynamic_cast may make cache value type crashes more predictable.
 // Enable for spurious errors, but switching off for performance reasons, release and debug.
@@ -64,6 +66,14 @@ public:
 	/** override to clear type-specific buffer information & call this */
 	virtual void clear();
 
+	/** Clear after a partial change to the field's results caused by changes
+	 * to nodes and elements. Override to keep buffer information unaffected
+	 * by changes; default clears everything. */
+	virtual void clearChanges(FE_region_changes& /*changes*/)
+	{
+		this->clear();
+	}
+
 	void createExtraCache(cmzn_fieldcache& parentCache, cmzn_region *region);
 
 	cmzn_fieldcache *getExtraCache()
@@ -87,6 +97,43 @@ public:
 
 typedef std::vector<FieldValueCache*> ValueCacheVector;
 
+/**
+ * Allocates storage for real values and derivatives of the value caches in a
+ * field cache from large blocks, so caches for many fields need few heap
+ * allocations and are laid out contiguously. Storage released when value
+ * caches are destroyed is reused for new value caches of the same size; all
+ * blocks are freed with the arena.
+ */
+class FieldValueArena
+{
+	std::vector<FE_value *> blocks;
+	FE_value *blockNext;
+	int blockRemaining;
+	std::map<int, std::vector<FE_value *> > releasedValues; // by count
+
+	FieldValueArena(const FieldValueArena&); // not implemented
+	FieldValueArena& operator=(const FieldValueArena&); // not implemented
+
+public:
+
+	FieldValueArena() :
+		blockNext(0),
+		blockRemaining(0)
+	{
+	}
+
+	~FieldValueArena();
+
+	/** @return  Storage for count values, valid until released or the arena
+	 * is destroyed. Not initialised. */
+	FE_value *allocate(int count);
+
+	/** Return storage from allocate for reuse.
+	 * @param count  The count values were allocated with. */
+	void release(FE_value *values, int count);
+
+};
+
 struct cmzn_fieldcache
 {
 private:
@@ -95,6 +142,7 @@ private:
 	Field_location *location;
 	int requestedDerivatives;
 	ValueCacheVector valueCaches;
+	FieldValueArena valueArena; // must be destroyed after valueCaches are deleted
 	bool assignInCache;
 	int access_count;
 
@@ -119,6 +167,7 @@ public:
 		location(new Field_time_location()),
 		requestedDerivatives(0),
 		valueCaches(cmzn_region_get_field_cache_size(this->region), (FieldValueCache*)0),
+		valueArena(),
 		assignInCache(false),
 		access_count(1)
 	{
@@ -249,6 +298,12 @@ public:
 		return valueCaches[cacheIndex];
 	}
 
+	/** Get arena for allocating value storage of value caches owned by this cache */
+	FieldValueArena& getValueArena()
+	{
+		return this->valueArena;
+	}
+
 	/** call if new field added to initialise value cache, and when cache created for field */
 	// NOT THREAD SAFE
 	void setValueCache(int cacheIndex, FieldValueCache* valueCache)
@@ -308,6 +363,15 @@ inline cmzn_fieldcache *FieldValueCache::getOrCreateExtraCache(cmzn_fieldcache&
 
 class RealFieldValueCache : public FieldValueCache
 {
+private:
+	FieldValueArena *valueArena; // if set, values were allocated from it
+
+	/** @return  Number of values allocated for values and derivatives */
+	inline int getStorageCount() const
+	{
+		return this->componentCount*(1 + MAXIMUM_ELEMENT_XI_DIMENSIONS);
+	}
+
 public:
 	int componentCount;
 	FE_value *values, *derivatives;
@@ -315,9 +379,22 @@ public:
 
 	RealFieldValueCache(int componentCount) :
 		FieldValueCache(),
+		valueArena(0),
+		componentCount(componentCount),
+		values(new FE_value[this->getStorageCount()]),
+		derivatives(this->values + componentCount),
+		find_element_xi_cache(0)
+	{
+	}
+
+	/** Create value cache with storage from the arena of parentCache. Value
+	 * cache must be owned by parentCache. */
+	RealFieldValueCache(cmzn_fieldcache& parentCache, int componentCount) :
+		FieldValueCache(),
+		valueArena(&parentCache.getValueArena()),
 		componentCount(componentCount),
-		values(new FE_value[componentCount]),
-		derivatives(new FE_value[componentCount*MAXIMUM_ELEMENT_XI_DIMENSIONS]),
+		values(this->valueArena->allocate(this->getStorageCount())),
+		derivatives(this->values + componentCount),
 		find_element_xi_cache(0)
 	{
 	}
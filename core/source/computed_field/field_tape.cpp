@@ -0,0 +1,637 @@
+/***************************************************************************//**
+ * FILE : field_tape.cpp
+ *
+ * Compiles the real-valued expression graph of a field into a linear tape of
+ * register instructions, evaluated over blocks of locations at once.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "opencmiss/zinc/field.h"
+#include "computed_field/computed_field_private.hpp"
+#include "computed_field/field_cache.hpp"
+#include "computed_field/field_tape.hpp"
+#include <climits>
+#include <cmath>
+
+namespace {
+
+/** Applies operation to a single value or pair of values. Must match the
+ * evaluate functions of the field types compiled to operation. */
+inline FE_value FieldTapeOperation_apply(FieldTapeOperation operation,
+	FE_value value1, FE_value value2)
+{
+	switch (operation)
+	{
+	case FIELD_TAPE_OPERATION_ADD:
+		return value1 + value2;
+	case FIELD_TAPE_OPERATION_SUBTRACT:
+		return value1 - value2;
+	case FIELD_TAPE_OPERATION_MULTIPLY:
+		return value1*value2;
+	case FIELD_TAPE_OPERATION_DIVIDE:
+		return value1/value2;
+	case FIELD_TAPE_OPERATION_POWER:
+		return (FE_value)pow((double)value1, (double)value2);
+	case FIELD_TAPE_OPERATION_ATAN2:
+		return (FE_value)atan2((double)value1, (double)value2);
+	case FIELD_TAPE_OPERATION_MINIMUM:
+		return (value1 < value2) ? value1 : value2;
+	case FIELD_TAPE_OPERATION_MAXIMUM:
+		return (value1 > value2) ? value1 : value2;
+	case FIELD_TAPE_OPERATION_ABS:
+		return (FE_value)fabs((double)value1);
+	case FIELD_TAPE_OPERATION_SQRT:
+		return (FE_value)sqrt((double)value1);
+	case FIELD_TAPE_OPERATION_EXP:
+		return (FE_value)exp((double)value1);
+	case FIELD_TAPE_OPERATION_LOG:
+		return (FE_value)log((double)value1);
+	case FIELD_TAPE_OPERATION_SIN:
+		return (FE_value)sin((double)value1);
+	case FIELD_TAPE_OPERATION_COS:
+		return (FE_value)cos((double)value1);
+	case FIELD_TAPE_OPERATION_TAN:
+		return (FE_value)tan((double)value1);
+	case FIELD_TAPE_OPERATION_ASIN:
+		return (FE_value)asin((double)value1);
+	case FIELD_TAPE_OPERATION_ACOS:
+		return (FE_value)acos((double)value1);
+	case FIELD_TAPE_OPERATION_ATAN:
+		return (FE_value)atan((double)value1);
+	}
+	return 0.0;
+}
+
+inline bool FieldTapeOperation_is_unary(FieldTapeOperation operation)
+{
+	return (operation >= FIELD_TAPE_OPERATION_ABS);
+}
+
+inline bool FieldTapeOperation_is_commutative(FieldTapeOperation operation)
+{
+	return (operation == FIELD_TAPE_OPERATION_ADD) ||
+		(operation == FIELD_TAPE_OPERATION_MULTIPLY);
+}
+
+} // anonymous namespace
+
+FieldTape::FieldTape() :
+	registerCount(0),
+	workspaceStride(0),
+	dualDerivativeCount(-1)
+{
+}
+
+FieldTape::~FieldTape()
+{
+	for (std::vector<Input>::iterator iter = this->inputs.begin(); iter != this->inputs.end(); ++iter)
+		cmzn_field_destroy(&(iter->field));
+}
+
+FieldTape *FieldTape::create(cmzn_field *field)
+{
+	FieldTapeCompiler compiler;
+	return compiler.compile(field);
+}
+
+void FieldTape::setWorkspaceStride(int stride)
+{
+	if (stride != this->workspaceStride)
+	{
+		this->workspace.resize(this->registerCount*stride);
+		this->workspaceStride = stride;
+		// constants occupy the first registers and are never overwritten
+		const int constantCount = static_cast<int>(this->constants.size());
+		for (int r = 0; r < constantCount; ++r)
+		{
+			FE_value *registerValues = this->workspace.data() + r*stride;
+			for (int n = 0; n < stride; ++n)
+				registerValues[n] = this->constants[r];
+		}
+	}
+}
+
+void FieldTape::execute(int locationCount)
+{
+	const int stride = this->workspaceStride;
+	FE_value *workspaceValues = this->workspace.data();
+	const int instructionCount = static_cast<int>(this->instructions.size());
+	for (int i = 0; i < instructionCount; ++i)
+	{
+		const Instruction& instruction = this->instructions[i];
+		// result may share register with an operand not used later; safe as
+		// all operations are element-wise
+		FE_value *result = workspaceValues + instruction.result*stride;
+		const FE_value *a = workspaceValues + instruction.operand1*stride;
+		const FE_value *b = (instruction.operand2 >= 0) ? workspaceValues + instruction.operand2*stride : 0;
+		switch (instruction.operation)
+		{
+		case FIELD_TAPE_OPERATION_ADD:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = a[n] + b[n];
+			break;
+		case FIELD_TAPE_OPERATION_SUBTRACT:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = a[n] - b[n];
+			break;
+		case FIELD_TAPE_OPERATION_MULTIPLY:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = a[n]*b[n];
+			break;
+		case FIELD_TAPE_OPERATION_DIVIDE:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = a[n]/b[n];
+			break;
+		case FIELD_TAPE_OPERATION_MINIMUM:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = (a[n] < b[n]) ? a[n] : b[n];
+			break;
+		case FIELD_TAPE_OPERATION_MAXIMUM:
+			for (int n = 0; n < locationCount; ++n)
+				result[n] = (a[n] > b[n]) ? a[n] : b[n];
+			break;
+		default:
+			if (b)
+			{
+				for (int n = 0; n < locationCount; ++n)
+					result[n] = FieldTapeOperation_apply(instruction.operation, a[n], b[n]);
+			}
+			else
+			{
+				for (int n = 0; n < locationCount; ++n)
+					result[n] = FieldTapeOperation_apply(instruction.operation, a[n], 0.0);
+			}
+			break;
+		}
+	}
+}
+
+bool FieldTape::evaluateAtNodes(cmzn_fieldcache& cache, int nodeCount,
+	cmzn_node * const *nodes, FE_value *values, char *defined)
+{
+	this->setWorkspaceStride(nodeCount);
+	for (int n = 0; n < nodeCount; ++n)
+		defined[n] = 1;
+	const FE_value time = cache.getTime();
+	bool cacheInputs = false;
+	this->inputDefined.resize(nodeCount);
+	for (std::vector<Input>::iterator iter = this->inputs.begin(); iter != this->inputs.end(); ++iter)
+	{
+		if (iter->field->core->supportsEvaluateAtNodes())
+		{
+			if (!iter->field->core->evaluateAtNodes(time, nodeCount, nodes,
+				this->workspace.data() + iter->firstRegister*nodeCount, this->inputDefined.data()))
+				return false;
+			for (int n = 0; n < nodeCount; ++n)
+				defined[n] &= this->inputDefined[n];
+		}
+		else
+			cacheInputs = true;
+	}
+	if (cacheInputs)
+	{
+		// evaluate remaining inputs node-by-node so location is set once per node
+		for (int n = 0; n < nodeCount; ++n)
+		{
+			cache.setNode(nodes[n]);
+			for (std::vector<Input>::iterator iter = this->inputs.begin(); iter != this->inputs.end(); ++iter)
+			{
+				if (iter->field->core->supportsEvaluateAtNodes())
+					continue;
+				const int componentCount = iter->field->number_of_components;
+				FE_value *inputValues = this->workspace.data() + iter->firstRegister*nodeCount + n;
+				RealFieldValueCache *valueCache = RealFieldValueCache::cast(iter->field->evaluateNoDerivatives(cache));
+				if (valueCache)
+				{
+					for (int c = 0; c < componentCount; ++c)
+						inputValues[c*nodeCount] = valueCache->values[c];
+				}
+				else
+				{
+					defined[n] = 0;
+					for (int c = 0; c < componentCount; ++c)
+						inputValues[c*nodeCount] = 0.0;
+				}
+			}
+		}
+	}
+	this->execute(nodeCount);
+	const int componentCount = static_cast<int>(this->outputRegisters.size());
+	for (int c = 0; c < componentCount; ++c)
+	{
+		const FE_value *registerValues = this->workspace.data() + this->outputRegisters[c]*nodeCount;
+		FE_value *componentValues = values + c*nodeCount;
+		for (int n = 0; n < nodeCount; ++n)
+			componentValues[n] = registerValues[n];
+	}
+	return true;
+}
+
+void FieldTape::setDualDerivativeCount(int derivativeCount)
+{
+	if (derivativeCount != this->dualDerivativeCount)
+	{
+		const int dualSize = 1 + derivativeCount;
+		this->dualWorkspace.assign(this->registerCount*dualSize, 0.0);
+		this->dualDerivativeCount = derivativeCount;
+		// constants have zero derivatives and are never overwritten
+		const int constantCount = static_cast<int>(this->constants.size());
+		for (int r = 0; r < constantCount; ++r)
+			this->dualWorkspace[r*dualSize] = this->constants[r];
+	}
+}
+
+/**
+ * Forward-mode differentiation of each instruction. Derivative formulas match
+ * the evaluate functions of the field types compiled to each operation.
+ */
+void FieldTape::executeWithDerivatives()
+{
+	const int derivativeCount = this->dualDerivativeCount;
+	const int dualSize = 1 + derivativeCount;
+	FE_value *workspaceValues = this->dualWorkspace.data();
+	const int instructionCount = static_cast<int>(this->instructions.size());
+	for (int i = 0; i < instructionCount; ++i)
+	{
+		const Instruction& instruction = this->instructions[i];
+		FE_value *result = workspaceValues + instruction.result*dualSize;
+		FE_value *dr = result + 1;
+		const FE_value *a = workspaceValues + instruction.operand1*dualSize;
+		const FE_value *da = a + 1;
+		const FE_value *b = (instruction.operand2 >= 0) ? workspaceValues + instruction.operand2*dualSize : 0;
+		const FE_value *db = (b) ? b + 1 : 0;
+		// copy operand values as result may share register with an operand;
+		// each derivative is read before it is written so may share too
+		const FE_value u = a[0];
+		const FE_value v = (b) ? b[0] : 0.0;
+		const FE_value r = FieldTapeOperation_apply(instruction.operation, u, v);
+		switch (instruction.operation)
+		{
+		case FIELD_TAPE_OPERATION_ADD:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = da[d] + db[d];
+			break;
+		case FIELD_TAPE_OPERATION_SUBTRACT:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = da[d] - db[d];
+			break;
+		case FIELD_TAPE_OPERATION_MULTIPLY:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = da[d]*v + db[d]*u;
+			break;
+		case FIELD_TAPE_OPERATION_DIVIDE:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (da[d]*v - db[d]*u)/(v*v);
+			break;
+		case FIELD_TAPE_OPERATION_POWER:
+		{
+			/* d(u^v)/dx = v * u^(v-1) * du/dx + u^v * ln(u) * dv/dx
+			 * omitting second term for constant exponent so negative u is valid */
+			const FE_value dr_du = v*(FE_value)pow((double)u, (double)(v - 1));
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = dr_du*da[d] + ((db[d] != 0.0) ? r*(FE_value)log((double)u)*db[d] : 0.0);
+		} break;
+		case FIELD_TAPE_OPERATION_ATAN2:
+		{
+			const FE_value denominator = u*u + v*v;
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (v*da[d] - u*db[d])/denominator;
+		} break;
+		case FIELD_TAPE_OPERATION_MINIMUM:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (u < v) ? da[d] : db[d];
+			break;
+		case FIELD_TAPE_OPERATION_MAXIMUM:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (u > v) ? da[d] : db[d];
+			break;
+		case FIELD_TAPE_OPERATION_ABS:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (u > 0.0) ? da[d] : ((u < 0.0) ? -da[d] : 0.0);
+			break;
+		case FIELD_TAPE_OPERATION_SQRT:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = da[d]/(2*r);
+			break;
+		case FIELD_TAPE_OPERATION_EXP:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = da[d]*r;
+			break;
+		case FIELD_TAPE_OPERATION_LOG:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = 1.0/u*da[d];
+			break;
+		case FIELD_TAPE_OPERATION_SIN:
+		{
+			const FE_value dr_du = (FE_value)cos((double)u);
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = dr_du*da[d];
+		} break;
+		case FIELD_TAPE_OPERATION_COS:
+		{
+			const FE_value dr_du = -(FE_value)sin((double)u);
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = dr_du*da[d];
+		} break;
+		case FIELD_TAPE_OPERATION_TAN:
+		{
+			const double cosu = cos((double)u);
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (FE_value)(da[d]/(cosu*cosu));
+		} break;
+		case FIELD_TAPE_OPERATION_ASIN:
+		case FIELD_TAPE_OPERATION_ACOS:
+		{
+			// d(asin u)/dx = -d(acos u)/dx = 1.0/sqrt(1.0 - u^2) * du/dx
+			FE_value dr_du = 0.0;
+			if (u != 1.0)
+			{
+				dr_du = (FE_value)(1.0/sqrt(1.0 - (double)u*(double)u));
+				if (instruction.operation == FIELD_TAPE_OPERATION_ACOS)
+					dr_du = -dr_du;
+			}
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = dr_du*da[d];
+		} break;
+		case FIELD_TAPE_OPERATION_ATAN:
+			for (int d = 0; d < derivativeCount; ++d)
+				dr[d] = (FE_value)(da[d]/(1.0 + (double)u*(double)u));
+			break;
+		}
+		result[0] = r;
+	}
+}
+
+bool FieldTape::evaluateWithDerivatives(cmzn_fieldcache& cache, FE_value *values,
+	FE_value *derivatives)
+{
+	const int derivativeCount = cache.getRequestedDerivatives();
+	if (derivativeCount < 1)
+		return false;
+	this->setDualDerivativeCount(derivativeCount);
+	const int dualSize = 1 + derivativeCount;
+	for (std::vector<Input>::iterator iter = this->inputs.begin(); iter != this->inputs.end(); ++iter)
+	{
+		RealFieldValueCache *valueCache = iter->field->evaluateWithDerivatives(cache, derivativeCount);
+		if (!valueCache)
+			return false;
+		const int componentCount = iter->field->number_of_components;
+		FE_value *inputValues = this->dualWorkspace.data() + iter->firstRegister*dualSize;
+		for (int c = 0; c < componentCount; ++c)
+		{
+			inputValues[0] = valueCache->values[c];
+			const FE_value *sourceDerivatives = valueCache->derivatives + c*derivativeCount;
+			for (int d = 0; d < derivativeCount; ++d)
+				inputValues[1 + d] = sourceDerivatives[d];
+			inputValues += dualSize;
+		}
+	}
+	this->executeWithDerivatives();
+	const int componentCount = static_cast<int>(this->outputRegisters.size());
+	for (int c = 0; c < componentCount; ++c)
+	{
+		const FE_value *registerValues = this->dualWorkspace.data() + this->outputRegisters[c]*dualSize;
+		values[c] = registerValues[0];
+		FE_value *componentDerivatives = derivatives + c*derivativeCount;
+		for (int d = 0; d < derivativeCount; ++d)
+			componentDerivatives[d] = registerValues[1 + d];
+	}
+	return true;
+}
+
+FieldTapeCompiler::FieldTapeCompiler() :
+	tape(new FieldTape())
+{
+}
+
+FieldTapeCompiler::~FieldTapeCompiler()
+{
+	delete this->tape;
+}
+
+const int *FieldTapeCompiler::compileField(cmzn_field *field)
+{
+	std::map<cmzn_field *, std::vector<int> >::iterator iter = this->fieldRegisters.find(field);
+	if (iter != this->fieldRegisters.end())
+		return iter->second.data();
+	if ((field->core->get_value_type() != CMZN_FIELD_VALUE_TYPE_REAL) || (!field->isNumerical()))
+		return 0;
+	const int componentCount = field->number_of_components;
+	std::vector<int> componentRegisters(componentCount);
+	if (!field->core->compileTape(*this, componentRegisters.data()))
+	{
+		// evaluate by usual means as an input to the tape
+		const int inputIndex = static_cast<int>(this->inputs.size());
+		FieldTape::Input input = { field, -1 };
+		this->inputs.push_back(input);
+		for (int c = 0; c < componentCount; ++c)
+		{
+			Register inputRegister = { REGISTER_INPUT, inputIndex, c };
+			componentRegisters[c] = static_cast<int>(this->registers.size());
+			this->registers.push_back(inputRegister);
+		}
+	}
+	std::vector<int>& storedRegisters = this->fieldRegisters[field];
+	storedRegisters.swap(componentRegisters);
+	return storedRegisters.data();
+}
+
+int FieldTapeCompiler::constant(FE_value value)
+{
+	std::map<FE_value, int, ConstantLess>::iterator iter = this->constantRegisters.find(value);
+	if (iter != this->constantRegisters.end())
+		return iter->second;
+	Register constantRegister = { REGISTER_CONSTANT, static_cast<int>(this->constants.size()), 0 };
+	const int registerNumber = static_cast<int>(this->registers.size());
+	this->registers.push_back(constantRegister);
+	this->constants.push_back(value);
+	this->constantRegisters[value] = registerNumber;
+	return registerNumber;
+}
+
+bool FieldTapeCompiler::isConstant(int registerNumber, FE_value& value) const
+{
+	const Register& reg = this->registers[registerNumber];
+	if (reg.type != REGISTER_CONSTANT)
+		return false;
+	value = this->constants[reg.index];
+	return true;
+}
+
+int FieldTapeCompiler::unary(FieldTapeOperation operation, int operand)
+{
+	FE_value value;
+	if (this->isConstant(operand, value))
+		return this->constant(FieldTapeOperation_apply(operation, value, 0.0));
+	InstructionKey key = { operation, operand, -1 };
+	std::map<InstructionKey, int>::iterator iter = this->instructionRegisters.find(key);
+	if (iter != this->instructionRegisters.end())
+		return iter->second;
+	const int registerNumber = static_cast<int>(this->registers.size());
+	Register instructionRegister = { REGISTER_INSTRUCTION, static_cast<int>(this->instructions.size()), 0 };
+	this->registers.push_back(instructionRegister);
+	FieldTape::Instruction instruction = { operation, registerNumber, operand, -1 };
+	this->instructions.push_back(instruction);
+	this->instructionRegisters[key] = registerNumber;
+	return registerNumber;
+}
+
+int FieldTapeCompiler::binary(FieldTapeOperation operation, int operand1, int operand2)
+{
+	FE_value value1, value2;
+	const bool constant1 = this->isConstant(operand1, value1);
+	const bool constant2 = this->isConstant(operand2, value2);
+	if (constant1 && constant2)
+		return this->constant(FieldTapeOperation_apply(operation, value1, value2));
+	// multiplying by exactly one leaves every value unchanged, including NaN
+	if (operation == FIELD_TAPE_OPERATION_MULTIPLY)
+	{
+		if (constant1 && (value1 == 1.0))
+			return operand2;
+		if (constant2 && (value2 == 1.0))
+			return operand1;
+	}
+	if (FieldTapeOperation_is_commutative(operation) && (operand2 < operand1))
+	{
+		const int tmp = operand1;
+		operand1 = operand2;
+		operand2 = tmp;
+	}
+	InstructionKey key = { operation, operand1, operand2 };
+	std::map<InstructionKey, int>::iterator iter = this->instructionRegisters.find(key);
+	if (iter != this->instructionRegisters.end())
+		return iter->second;
+	const int registerNumber = static_cast<int>(this->registers.size());
+	Register instructionRegister = { REGISTER_INSTRUCTION, static_cast<int>(this->instructions.size()), 0 };
+	this->registers.push_back(instructionRegister);
+	FieldTape::Instruction instruction = { operation, registerNumber, operand1, operand2 };
+	this->instructions.push_back(instruction);
+	this->instructionRegisters[key] = registerNumber;
+	return registerNumber;
+}
+
+bool FieldTapeCompiler::compileComponentwise(cmzn_field *field,
+	FieldTapeOperation operation, int *componentRegisters)
+{
+	const int componentCount = field->number_of_components;
+	const int sourceCount = FieldTapeOperation_is_unary(operation) ? 1 : 2;
+	if (field->number_of_source_fields != sourceCount)
+		return false;
+	const int *sourceRegisters[2] = { 0, 0 };
+	for (int s = 0; s < sourceCount; ++s)
+	{
+		if (field->source_fields[s]->number_of_components != componentCount)
+			return false;
+		sourceRegisters[s] = this->compileField(field->source_fields[s]);
+		if (!sourceRegisters[s])
+			return false;
+	}
+	for (int c = 0; c < componentCount; ++c)
+	{
+		componentRegisters[c] = (sourceCount == 1) ?
+			this->unary(operation, sourceRegisters[0][c]) :
+			this->binary(operation, sourceRegisters[0][c], sourceRegisters[1][c]);
+	}
+	return true;
+}
+
+/**
+ * Removes instructions not needed for outputs, and assigns tape registers:
+ * constants first, then consecutive registers for each input field, then
+ * instruction results reusing registers after their last use. All inputs are
+ * kept even if no output uses them, as the field is only defined where all
+ * its compiled source fields are, as for evaluate().
+ */
+bool FieldTapeCompiler::finish(const std::vector<int>& outputRegisters)
+{
+	const int registerCount = static_cast<int>(this->registers.size());
+	const int instructionCount = static_cast<int>(this->instructions.size());
+	// last instruction using each register; INT_MAX for outputs, -1 if unused
+	std::vector<int> lastUse(registerCount, -1);
+	for (std::vector<int>::const_iterator iter = outputRegisters.begin(); iter != outputRegisters.end(); ++iter)
+		lastUse[*iter] = INT_MAX;
+	for (int i = instructionCount - 1; i >= 0; --i)
+	{
+		const FieldTape::Instruction& instruction = this->instructions[i];
+		if (lastUse[instruction.result] < 0)
+			continue; // dead
+		if (lastUse[instruction.operand1] < 0)
+			lastUse[instruction.operand1] = i;
+		if ((instruction.operand2 >= 0) && (lastUse[instruction.operand2] < 0))
+			lastUse[instruction.operand2] = i;
+	}
+	std::vector<int> tapeRegisters(registerCount, -1);
+	int tapeRegisterCount = 0;
+	for (int r = 0; r < registerCount; ++r)
+	{
+		if ((this->registers[r].type == REGISTER_CONSTANT) && (lastUse[r] >= 0))
+		{
+			tapeRegisters[r] = tapeRegisterCount++;
+			this->tape->constants.push_back(this->constants[this->registers[r].index]);
+		}
+	}
+	const int inputCount = static_cast<int>(this->inputs.size());
+	std::vector<int> inputFirstRegisters(inputCount, -1);
+	for (int i = 0; i < inputCount; ++i)
+	{
+		FieldTape::Input input = { cmzn_field_access(this->inputs[i].field), tapeRegisterCount };
+		this->tape->inputs.push_back(input);
+		inputFirstRegisters[i] = tapeRegisterCount;
+		tapeRegisterCount += input.field->number_of_components;
+	}
+	for (int r = 0; r < registerCount; ++r)
+	{
+		if (this->registers[r].type == REGISTER_INPUT)
+			tapeRegisters[r] = inputFirstRegisters[this->registers[r].index] + this->registers[r].component;
+	}
+	std::vector<int> freeRegisters;
+	for (int i = 0; i < instructionCount; ++i)
+	{
+		FieldTape::Instruction instruction = this->instructions[i];
+		if (lastUse[instruction.result] < 0)
+			continue;
+		// release operand registers at their last use before allocating result
+		for (int o = 0; o < 2; ++o)
+		{
+			const int operand = (o == 0) ? instruction.operand1 : instruction.operand2;
+			if ((operand >= 0) && (lastUse[operand] == i) &&
+				(this->registers[operand].type == REGISTER_INSTRUCTION) &&
+				((o == 0) || (operand != instruction.operand1)))
+				freeRegisters.push_back(tapeRegisters[operand]);
+		}
+		if (freeRegisters.empty())
+			tapeRegisters[instruction.result] = tapeRegisterCount++;
+		else
+		{
+			tapeRegisters[instruction.result] = freeRegisters.back();
+			freeRegisters.pop_back();
+		}
+		instruction.result = tapeRegisters[instruction.result];
+		instruction.operand1 = tapeRegisters[instruction.operand1];
+		if (instruction.operand2 >= 0)
+			instruction.operand2 = tapeRegisters[instruction.operand2];
+		this->tape->instructions.push_back(instruction);
+	}
+	for (std::vector<int>::const_iterator iter = outputRegisters.begin(); iter != outputRegisters.end(); ++iter)
+		this->tape->outputRegisters.push_back(tapeRegisters[*iter]);
+	this->tape->registerCount = tapeRegisterCount;
+	return true;
+}
+
+FieldTape *FieldTapeCompiler::compile(cmzn_field *field)
+{
+	if ((!this->tape) || (field->core->get_value_type() != CMZN_FIELD_VALUE_TYPE_REAL) ||
+		(!field->isNumerical()))
+		return 0;
+	std::vector<int> componentRegisters(field->number_of_components);
+	if (!(field->core->compileTape(*this, componentRegisters.data()) &&
+		this->finish(componentRegisters)))
+		return 0;
+	FieldTape *result = this->tape;
+	this->tape = 0;
+	return result;
+}
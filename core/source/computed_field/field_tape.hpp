@@ -0,0 +1,253 @@
+/***************************************************************************//**
+ * FILE : field_tape.hpp
+ *
+ * Compiles the real-valued expression graph of a field into a linear tape of
+ * register instructions, evaluated over blocks of locations at once.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (FIELD_TAPE_HPP)
+#define FIELD_TAPE_HPP
+
+#include "opencmiss/zinc/types/fieldid.h"
+#include "opencmiss/zinc/types/nodeid.h"
+#include "opencmiss/zinc/zincconfigure.h"
+#include <cstring>
+#include <map>
+#include <vector>
+
+struct cmzn_fieldcache;
+
+/** Operations performed element-wise by tape instructions */
+enum FieldTapeOperation
+{
+	FIELD_TAPE_OPERATION_ADD,
+	FIELD_TAPE_OPERATION_SUBTRACT,
+	FIELD_TAPE_OPERATION_MULTIPLY,
+	FIELD_TAPE_OPERATION_DIVIDE,
+	FIELD_TAPE_OPERATION_POWER,
+	FIELD_TAPE_OPERATION_ATAN2,
+	FIELD_TAPE_OPERATION_MINIMUM, // (a < b) ? a : b, as for clamp maximum
+	FIELD_TAPE_OPERATION_MAXIMUM, // (a > b) ? a : b, as for clamp minimum
+	FIELD_TAPE_OPERATION_ABS,
+	FIELD_TAPE_OPERATION_SQRT,
+	FIELD_TAPE_OPERATION_EXP,
+	FIELD_TAPE_OPERATION_LOG,
+	FIELD_TAPE_OPERATION_SIN,
+	FIELD_TAPE_OPERATION_COS,
+	FIELD_TAPE_OPERATION_TAN,
+	FIELD_TAPE_OPERATION_ASIN,
+	FIELD_TAPE_OPERATION_ACOS,
+	FIELD_TAPE_OPERATION_ATAN
+};
+
+/**
+ * Linear sequence of element-wise instructions computing the values of a
+ * field from its input fields, i.e. source fields whose types cannot be
+ * compiled, e.g. finite element fields. Registers hold a value for each
+ * location in a block. Created by FieldTapeCompiler; owned by the field.
+ */
+class FieldTape
+{
+	friend class FieldTapeCompiler;
+
+	struct Instruction
+	{
+		FieldTapeOperation operation;
+		int result;
+		int operand1;
+		int operand2; // -1 for unary operations
+	};
+
+	struct Input
+	{
+		cmzn_field *field; // accessed
+		int firstRegister; // registers for components are consecutive
+	};
+
+	std::vector<Instruction> instructions;
+	std::vector<Input> inputs;
+	std::vector<FE_value> constants; // value of constant register i
+	std::vector<int> outputRegisters; // register for each field component
+	int registerCount;
+	// registers stored in component-major order with stride of block size
+	std::vector<FE_value> workspace;
+	std::vector<char> inputDefined;
+	int workspaceStride;
+	// register r holds value then derivatives at r*(1 + dualDerivativeCount)
+	std::vector<FE_value> dualWorkspace;
+	int dualDerivativeCount;
+
+	FieldTape();
+
+	FieldTape(const FieldTape&); // not implemented
+	FieldTape& operator=(const FieldTape&); // not implemented
+
+	void setWorkspaceStride(int stride);
+
+	void execute(int locationCount);
+
+	void setDualDerivativeCount(int derivativeCount);
+
+	void executeWithDerivatives();
+
+public:
+
+	~FieldTape();
+
+	/**
+	 * Compile tape for evaluating the values of field.
+	 * @return  New tape, or 0 if field type is not compilable.
+	 */
+	static FieldTape *create(cmzn_field *field);
+
+	/** @return  Number of instructions, after elimination of common and
+	 * constant subexpressions */
+	int getInstructionCount() const
+	{
+		return static_cast<int>(this->instructions.size());
+	}
+
+	/**
+	 * Evaluate field at a block of nodes. Inputs supporting evaluateAtNodes
+	 * are evaluated directly from node parameters, others through cache.
+	 * @param cache  Field cache supplying time; its location is changed if
+	 * any inputs do not support evaluateAtNodes.
+	 * @param nodeCount  The number of nodes in the block.
+	 * @param nodes  Array of nodeCount nodes.
+	 * @param values  Array of size components*nodeCount to receive values in
+	 * component-major order as for Computed_field_core::evaluateAtNodes.
+	 * @param defined  Array of size nodeCount to receive 1 for nodes at which
+	 * the field is defined, 0 otherwise.
+	 * @return  True on success, false on failure.
+	 */
+	bool evaluateAtNodes(cmzn_fieldcache& cache, int nodeCount,
+		cmzn_node * const *nodes, FE_value *values, char *defined);
+
+	/**
+	 * Evaluate field and its first derivatives at the location in cache by
+	 * forward-mode automatic differentiation: each register carries its
+	 * derivatives with respect to the element chart alongside its value, so
+	 * intermediate fields are not evaluated or cached.
+	 * @param cache  Field cache with element location and requested number of
+	 * derivatives set.
+	 * @param values  Array of size components to receive values.
+	 * @param derivatives  Array of size components*derivatives to receive
+	 * derivatives in the layout of RealFieldValueCache.
+	 * @return  True on success, false if any input is not defined or has no
+	 * derivatives at location.
+	 */
+	bool evaluateWithDerivatives(cmzn_fieldcache& cache, FE_value *values,
+		FE_value *derivatives);
+
+};
+
+/**
+ * Builds a FieldTape by visiting the expression graph of a field. Instructions
+ * with only constant operands are folded, and identical instructions and
+ * constants are shared. Used by Computed_field_core::compileTape overrides.
+ */
+class FieldTapeCompiler
+{
+	struct InstructionKey
+	{
+		FieldTapeOperation operation;
+		int operand1;
+		int operand2;
+
+		bool operator<(const InstructionKey& other) const
+		{
+			if (this->operation != other.operation)
+				return this->operation < other.operation;
+			if (this->operand1 != other.operand1)
+				return this->operand1 < other.operand1;
+			return this->operand2 < other.operand2;
+		}
+	};
+
+	/** Orders constants by bit pattern so -0.0 and NaNs are kept distinct */
+	struct ConstantLess
+	{
+		bool operator()(FE_value value1, FE_value value2) const
+		{
+			return memcmp(&value1, &value2, sizeof(FE_value)) < 0;
+		}
+	};
+
+	enum RegisterType
+	{
+		REGISTER_CONSTANT,
+		REGISTER_INPUT,
+		REGISTER_INSTRUCTION
+	};
+
+	// register numbers are in order of creation; renumbered in finish()
+	struct Register
+	{
+		RegisterType type;
+		int index; // into constants, inputs or instructions
+		int component; // for inputs only
+	};
+
+	FieldTape *tape;
+	std::vector<Register> registers;
+	std::vector<FieldTape::Instruction> instructions;
+	std::vector<FieldTape::Input> inputs;
+	std::vector<FE_value> constants;
+	std::map<cmzn_field *, std::vector<int> > fieldRegisters;
+	std::map<FE_value, int, ConstantLess> constantRegisters;
+	std::map<InstructionKey, int> instructionRegisters;
+
+	bool finish(const std::vector<int>& outputRegisters);
+
+public:
+
+	FieldTapeCompiler();
+
+	~FieldTapeCompiler();
+
+	/**
+	 * Compile field into the tape, or add it as an input if its type is not
+	 * compilable. Results are shared by all fields using this field.
+	 * @return  Pointer to registers for each component, or 0 if field is not
+	 * real-valued. Valid for the lifetime of the compiler.
+	 */
+	const int *compileField(cmzn_field *field);
+
+	/** @return  Register holding constant value */
+	int constant(FE_value value);
+
+	/** @return  True if register holds a constant, with its value in value */
+	bool isConstant(int registerNumber, FE_value& value) const;
+
+	/** @return  Register holding result of unary operation on operand */
+	int unary(FieldTapeOperation operation, int operand);
+
+	/** @return  Register holding result of binary operation on operands */
+	int binary(FieldTapeOperation operation, int operand1, int operand2);
+
+	/**
+	 * Convenience function for compiling field types which apply operation to
+	 * each component of one source field, or of two source fields with the
+	 * same number of components.
+	 * @param componentRegisters  Array to receive register for each
+	 * component of field.
+	 * @return  True on success, false on failure.
+	 */
+	bool compileComponentwise(cmzn_field *field, FieldTapeOperation operation,
+		int *componentRegisters);
+
+	/**
+	 * Finish compiling field as the tape result.
+	 * @return  New tape, or 0 if field is not compilable. Caller takes
+	 * ownership.
+	 */
+	FieldTape *compile(cmzn_field *field);
+
+};
+
+#endif /* !defined (FIELD_TAPE_HPP) */
@@ -40,6 +40,7 @@
 #cmakedefine MEMORY_CHECKING
 #cmakedefine ZINC_NO_STDOUT
 #cmakedefine HAVE_HEAPSORT
+#cmakedefine ZINC_BUILD_INSTRUMENTATION
 
 typedef @FE_value@ FE_value;
 #cmakedefine FE_VALUE_INPUT_STRING @FE_VALUE_INPUT_STRING@
@@ -12,14 +12,22 @@
 #include <algorithm>
 #include <cstdlib>
 #include "opencmiss/zinc/fieldgroup.h"
+#include "opencmiss/zinc/fieldmodule.h"
+#include "opencmiss/zinc/graphics.h"
+#include "opencmiss/zinc/scene.h"
 #include "configure/version.h"
 #include "context/context.h"
+#include "computed_field/computed_field_private.hpp"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
+#include "general/message.h"
 #include "general/mystring.h"
 #include "general/object.h"
 #include "graphics/scene_viewer.h"
+#include "graphics/graphics.h"
 #include "graphics/graphics_module.h"
 #include "graphics/scene.h"
+#include "jsoncpp/json.h"
 #include "region/cmiss_region.h"
 #include "opencmiss/zinc/timekeeper.h"
 //-- #include "user_interface/event_dispatcher.h"
@@ -112,6 +120,110 @@ cmzn_graphics_module *cmzn_context::getGraphicsmodule()
 	return this->graphics_module;
 }
 
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+
+void cmzn_context::resetStatistics()
+{
+	instrumentationCounters.reset();
+	for (std::list<cmzn_region*>::iterator iter = this->allRegions.begin(); iter != this->allRegions.end(); ++iter)
+	{
+		cmzn_fieldmodule *fieldmodule = cmzn_region_get_fieldmodule(*iter);
+		cmzn_fielditerator *fielditerator = cmzn_fieldmodule_create_fielditerator(fieldmodule);
+		cmzn_field *field;
+		while ((field = cmzn_fielditerator_next_non_access(fielditerator)))
+		{
+			field->evaluationsCount = 0;
+			field->evaluationCacheHitsCount = 0;
+		}
+		cmzn_fielditerator_destroy(&fielditerator);
+		cmzn_fieldmodule_destroy(&fieldmodule);
+		cmzn_scene *scene = cmzn_region_get_scene(*iter);
+		cmzn_graphics *graphics = cmzn_scene_get_first_graphics(scene);
+		while (graphics)
+		{
+			graphics->buildsCount = 0;
+			graphics->buildTime = 0.0;
+			cmzn_graphics *nextGraphics = cmzn_scene_get_next_graphics(scene, graphics);
+			cmzn_graphics_destroy(&graphics);
+			graphics = nextGraphics;
+		}
+		cmzn_scene_destroy(&scene);
+	}
+}
+
+std::string cmzn_context::getStatisticsDescription()
+{
+	const InstrumentationCounters& counters = instrumentationCounters;
+	Json::Value root;
+	root["FieldEvaluations"] = static_cast<Json::UInt64>(counters.fieldEvaluations);
+	root["FieldEvaluationCacheHits"] = static_cast<Json::UInt64>(counters.fieldEvaluationCacheHits);
+	root["ElementFieldValuesCacheHits"] = static_cast<Json::UInt64>(counters.elementFieldValuesCacheHits);
+	root["ElementFieldValuesCacheMisses"] = static_cast<Json::UInt64>(counters.elementFieldValuesCacheMisses);
+	root["FindXiSearches"] = static_cast<Json::UInt64>(counters.findXiSearches);
+	root["FindXiIterations"] = static_cast<Json::UInt64>(counters.findXiIterations);
+	root["GraphicsBuilds"] = static_cast<Json::UInt64>(counters.graphicsBuilds);
+	root["GraphicsBuildTime"] = counters.graphicsBuildTime;
+	root["StreamReadBytes"] = static_cast<Json::UInt64>(counters.streamReadBytes);
+	root["StreamReadTime"] = counters.streamReadTime;
+	root["StreamReadBytesPerSecond"] = (counters.streamReadTime > 0.0) ?
+		(static_cast<double>(counters.streamReadBytes)/counters.streamReadTime) : 0.0;
+	root["StreamWriteBytes"] = static_cast<Json::UInt64>(counters.streamWriteBytes);
+	root["StreamWriteTime"] = counters.streamWriteTime;
+	root["StreamWriteBytesPerSecond"] = (counters.streamWriteTime > 0.0) ?
+		(static_cast<double>(counters.streamWriteBytes)/counters.streamWriteTime) : 0.0;
+	for (std::list<cmzn_region*>::iterator iter = this->allRegions.begin(); iter != this->allRegions.end(); ++iter)
+	{
+		Json::Value regionSettings;
+		cmzn_fieldmodule *fieldmodule = cmzn_region_get_fieldmodule(*iter);
+		cmzn_fielditerator *fielditerator = cmzn_fieldmodule_create_fielditerator(fieldmodule);
+		cmzn_field *field;
+		while ((field = cmzn_fielditerator_next_non_access(fielditerator)))
+		{
+			if (field->evaluationsCount > 0)
+			{
+				Json::Value fieldSettings;
+				fieldSettings["Name"] = field->name;
+				fieldSettings["Evaluations"] = static_cast<Json::UInt64>(field->evaluationsCount);
+				fieldSettings["EvaluationCacheHits"] = static_cast<Json::UInt64>(field->evaluationCacheHitsCount);
+				regionSettings["Fields"].append(fieldSettings);
+			}
+		}
+		cmzn_fielditerator_destroy(&fielditerator);
+		cmzn_fieldmodule_destroy(&fieldmodule);
+		cmzn_scene *scene = cmzn_region_get_scene(*iter);
+		cmzn_graphics *graphics = cmzn_scene_get_first_graphics(scene);
+		while (graphics)
+		{
+			if (graphics->buildsCount > 0)
+			{
+				Json::Value graphicsSettings;
+				if (graphics->name)
+					graphicsSettings["Name"] = graphics->name;
+				char *typeName = cmzn_graphics_type_enum_to_string(graphics->graphics_type);
+				graphicsSettings["Type"] = typeName;
+				DEALLOCATE(typeName);
+				graphicsSettings["Builds"] = static_cast<Json::UInt64>(graphics->buildsCount);
+				graphicsSettings["BuildTime"] = graphics->buildTime;
+				regionSettings["Graphics"].append(graphicsSettings);
+			}
+			cmzn_graphics *nextGraphics = cmzn_scene_get_next_graphics(scene, graphics);
+			cmzn_graphics_destroy(&graphics);
+			graphics = nextGraphics;
+		}
+		cmzn_scene_destroy(&scene);
+		if (!regionSettings.isNull())
+		{
+			char *path = cmzn_region_get_path(*iter);
+			regionSettings["Path"] = path;
+			DEALLOCATE(path);
+			root["Regions"].append(regionSettings);
+		}
+	}
+	return Json::StyledWriter().write(root);
+}
+
+#endif // defined (ZINC_BUILD_INSTRUMENTATION)
+
 cmzn_context *cmzn_context_create(const char *id)
 {
 	return cmzn_context::create(id);
@@ -361,3 +473,128 @@ cmzn_logger_id cmzn_context_get_logger(cmzn_context_id context)
 
 	return 0;
 }
+
+bool cmzn_context_is_instrumented(cmzn_context_id context)
+{
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	return (0 != context);
+#else
+	USE_PARAMETER(context);
+	return false;
+#endif
+}
+
+int cmzn_context_get_statistic(cmzn_context_id context,
+	enum cmzn_context_statistic_type statistic_type, double *value_out)
+{
+	if (!((context) && (value_out)))
+		return CMZN_ERROR_ARGUMENT;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	const InstrumentationCounters& counters = instrumentationCounters;
+	switch (statistic_type)
+	{
+	case CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATIONS:
+		*value_out = static_cast<double>(counters.fieldEvaluations);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_FIELD_EVALUATION_CACHE_HITS:
+		*value_out = static_cast<double>(counters.fieldEvaluationCacheHits);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_HITS:
+		*value_out = static_cast<double>(counters.elementFieldValuesCacheHits);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_MISSES:
+		*value_out = static_cast<double>(counters.elementFieldValuesCacheMisses);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_SEARCHES:
+		*value_out = static_cast<double>(counters.findXiSearches);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_FIND_XI_ITERATIONS:
+		*value_out = static_cast<double>(counters.findXiIterations);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILDS:
+		*value_out = static_cast<double>(counters.graphicsBuilds);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_GRAPHICS_BUILD_TIME:
+		*value_out = counters.graphicsBuildTime;
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_BYTES:
+		*value_out = static_cast<double>(counters.streamReadBytes);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_STREAM_READ_TIME:
+		*value_out = counters.streamReadTime;
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_BYTES:
+		*value_out = static_cast<double>(counters.streamWriteBytes);
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_STREAM_WRITE_TIME:
+		*value_out = counters.streamWriteTime;
+		break;
+	case CMZN_CONTEXT_STATISTIC_TYPE_INVALID:
+	default:
+		display_message(ERROR_MESSAGE, "Zinc Context getStatistic():  Invalid statistic type");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	return CMZN_OK;
+#else
+	USE_PARAMETER(statistic_type);
+	return CMZN_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+int cmzn_context_reset_statistics(cmzn_context_id context)
+{
+	if (!context)
+		return CMZN_ERROR_ARGUMENT;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	context->resetStatistics();
+	return CMZN_OK;
+#else
+	return CMZN_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+char *cmzn_context_get_statistics_description(cmzn_context_id context)
+{
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	if (context)
+		return duplicate_string(context->getStatisticsDescription().c_str());
+#else
+	USE_PARAMETER(context);
+#endif
+	return 0;
+}
+
+int cmzn_context_log_statistics(cmzn_context_id context)
+{
+	if (!context)
+		return CMZN_ERROR_ARGUMENT;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	const std::string description = context->getStatisticsDescription();
+	display_message_string(INFORMATION_MESSAGE, description.c_str());
+	return CMZN_OK;
+#else
+	return CMZN_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+int cmzn_context_begin_trace(cmzn_context_id context, const char *file_name)
+{
+	if (!((context) && (file_name)))
+		return CMZN_ERROR_ARGUMENT;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	return instrumentationTrace.begin(file_name);
+#else
+	return CMZN_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+int cmzn_context_end_trace(cmzn_context_id context)
+{
+	if (!context)
+		return CMZN_ERROR_ARGUMENT;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	return instrumentationTrace.end();
+#else
+	return CMZN_ERROR_NOT_IMPLEMENTED;
+#endif
+}
@@ -13,8 +13,10 @@
 #define CONTEXT_H
 
 #include <list>
+#include <string>
 #include "opencmiss/zinc/context.h"
 #include "opencmiss/zinc/status.h"
+#include "opencmiss/zinc/zincconfigure.h"
 #include "general/message_log.hpp"
 #include "general/manager.h"
 
@@ -65,6 +67,16 @@ public:
 	void removeRegion(cmzn_region *region);
 
 	cmzn_graphics_module *getGraphicsmodule();
+
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	/** Reset library-wide statistics and those of fields and graphics in all
+	 * regions of this context */
+	void resetStatistics();
+
+	/** @return  JSON string describing library-wide statistics and non-zero
+	 * statistics for fields and graphics in all regions of this context */
+	std::string getStatisticsDescription();
+#endif
 };
 
 /***************************************************************************//**
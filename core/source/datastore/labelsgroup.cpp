@@ -81,6 +81,81 @@ int DsLabelsGroup::setIndex(DsLabelIndex index, bool inGroup)
 	return CMZN_ERROR_MEMORY;
 }
 
+int DsLabelsGroup::addGroup(const DsLabelsGroup& otherGroup)
+{
+	if (otherGroup.labels != this->labels)
+	{
+		display_message(ERROR_MESSAGE, "DsLabelsGroup::addGroup.  Group is for different labels");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	DsLabelIndex addedCount = 0;
+	const bool success = this->values.unionWith(otherGroup.values, addedCount);
+	this->labelsCount += addedCount;
+	if (otherGroup.indexLimit > this->indexLimit)
+		this->indexLimit = otherGroup.indexLimit;
+	if (!success)
+	{
+		display_message(ERROR_MESSAGE, "DsLabelsGroup::addGroup.  Failed to set bools");
+		return CMZN_ERROR_MEMORY;
+	}
+	return CMZN_OK;
+}
+
+int DsLabelsGroup::removeGroup(const DsLabelsGroup& otherGroup)
+{
+	if (otherGroup.labels != this->labels)
+	{
+		display_message(ERROR_MESSAGE, "DsLabelsGroup::removeGroup.  Group is for different labels");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	DsLabelIndex removedCount = 0;
+	this->values.subtract(otherGroup.values, removedCount);
+	this->labelsCount -= removedCount;
+	return CMZN_OK;
+}
+
+int DsLabelsGroup::intersectGroup(const DsLabelsGroup& otherGroup)
+{
+	if (otherGroup.labels != this->labels)
+	{
+		display_message(ERROR_MESSAGE, "DsLabelsGroup::intersectGroup.  Group is for different labels");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	DsLabelIndex removedCount = 0;
+	this->values.intersectWith(otherGroup.values, removedCount);
+	this->labelsCount -= removedCount;
+	return CMZN_OK;
+}
+
+int DsLabelsGroup::addAllLabels()
+{
+	const DsLabelIndex indexSize = this->labels->getIndexSize();
+	if (!this->labels->hasUnusedIndexes())
+	{
+		// all indexes are in use: set bits in bulk
+		if (!this->values.setAllTrue(indexSize))
+		{
+			this->labelsCount = this->values.getTrueCount();
+			display_message(ERROR_MESSAGE, "DsLabelsGroup::addAllLabels.  Failed to set bools");
+			return CMZN_ERROR_MEMORY;
+		}
+		this->labelsCount = indexSize;
+		if (indexSize > this->indexLimit)
+			this->indexLimit = indexSize;
+		return CMZN_OK;
+	}
+	for (DsLabelIndex index = 0; index < indexSize; ++index)
+	{
+		if (this->labels->hasIndex(index))
+		{
+			const int result = this->setIndex(index, true);
+			if ((result != CMZN_OK) && (result != CMZN_ERROR_ALREADY_EXISTS))
+				return result;
+		}
+	}
+	return CMZN_OK;
+}
+
 /**
  * Get first label index in group or DS_LABEL_INDEX_INVALID if none.
  * Currently returns index with the lowest identifier in set.
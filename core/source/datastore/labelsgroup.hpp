@@ -93,6 +93,33 @@ public:
 	 */
 	int setIndex(DsLabelIndex index, bool inGroup);
 
+	/**
+	 * Add all labels in other group to this group, processing 32 labels at a
+	 * time. Other group must be for the same labels.
+	 * @return  CMZN_OK on success, any other error code on failure.
+	 */
+	int addGroup(const DsLabelsGroup& otherGroup);
+
+	/**
+	 * Remove all labels in other group from this group, processing 32 labels
+	 * at a time. Other group must be for the same labels.
+	 * @return  CMZN_OK on success, any other error code on failure.
+	 */
+	int removeGroup(const DsLabelsGroup& otherGroup);
+
+	/**
+	 * Remove all labels not in other group from this group, processing 32
+	 * labels at a time. Other group must be for the same labels.
+	 * @return  CMZN_OK on success, any other error code on failure.
+	 */
+	int intersectGroup(const DsLabelsGroup& otherGroup);
+
+	/**
+	 * Add all labels currently in the labels set to this group.
+	 * @return  CMZN_OK on success, any other error code on failure.
+	 */
+	int addAllLabels();
+
 	DsLabelIndex getFirstIndex(DsLabelIterator &iterator);
 
 	/**
@@ -205,8 +205,18 @@ OpenCMISS::Zinc::Field importGenericTwoSourcesField(enum cmzn_field_type type,
 				field = fieldmodule.createFieldDivergence(sourcefields[0], sourcefields[1]);
 				break;
 			case CMZN_FIELD_TYPE_GRADIENT:
-				field = fieldmodule.createFieldGradient(sourcefields[0], sourcefields[1]);
-				break;
+			{
+				OpenCMISS::Zinc::FieldGradient fieldGradient =
+					fieldmodule.createFieldGradient(sourcefields[0], sourcefields[1]);
+				// node mode is absent from older descriptions
+				if (typeSettings["NodeMode"].isString())
+				{
+					enum cmzn_field_gradient_node_mode nodeMode =
+						cmzn_field_gradient_node_mode_enum_from_string(typeSettings["NodeMode"].asCString());
+					fieldGradient.setNodeMode(static_cast<OpenCMISS::Zinc::FieldGradient::NodeMode>(nodeMode));
+				}
+				field = fieldGradient;
+			} break;
 			case CMZN_FIELD_TYPE_FIBRE_AXES:
 				field = fieldmodule.createFieldFibreAxes(sourcefields[0], sourcefields[1]);
 				break;
@@ -804,6 +814,14 @@ void FieldJsonIO::exportTypeSpecificParameters(Json::Value &fieldSettings)
 			const FE_mesh *mesh = cmzn_field_get_host_FE_mesh(field.getId());
 			typeSettings["Mesh"] = (mesh) ? mesh->getName() : "unknown";
 		} break;
+		case CMZN_FIELD_TYPE_GRADIENT:
+		{
+			enum cmzn_field_gradient_node_mode nodeMode =
+				static_cast<cmzn_field_gradient_node_mode>(field.castGradient().getNodeMode());
+			char *modeName = cmzn_field_gradient_node_mode_enum_to_string(nodeMode);
+			typeSettings["NodeMode"] = modeName;
+			DEALLOCATE(modeName);
+		} break;
 		case CMZN_FIELD_TYPE_FIND_MESH_LOCATION:
 		{
 			OpenCMISS::Zinc::Mesh mesh = field.castFindMeshLocation().getMesh();
@@ -652,6 +652,7 @@ void GraphicsJsonIO::ioContoursEntries(Json::Value &graphicsSettings)
 				num = contours.getRangeNumberOfIsovalues();
 				attributesSettings["RangeNumberOfIsovalues"] = num;
 			}
+			attributesSettings["Welded"] = contours.isWelded();
 			graphicsSettings["Contours"] = attributesSettings;
 		}
 		else if (graphicsSettings["Contours"].isObject())
@@ -683,6 +684,8 @@ void GraphicsJsonIO::ioContoursEntries(Json::Value &graphicsSettings)
 					attributesSettings["RangeFirstIsovalue"].asDouble(),
 					attributesSettings["RangeLastIsovalue"].asDouble());
 			}
+			if (attributesSettings["Welded"].isBool())
+				contours.setWelded(attributesSettings["Welded"].asBool());
 		}
 	}
 }
@@ -738,6 +741,17 @@ void GraphicsJsonIO::ioStreamlinesEntries(Json::Value &graphicsSettings)
 			{
 				attributesSettings["TrackDirection"] = "";
 			}
+			enumString = cmzn_graphics_streamlines_integration_method_enum_to_string(
+				(enum cmzn_graphics_streamlines_integration_method)streamlines.getIntegrationMethod());
+			if (enumString)
+			{
+				attributesSettings["IntegrationMethod"] = enumString;
+				DEALLOCATE(enumString);
+			}
+			else
+			{
+				attributesSettings["IntegrationMethod"] = "";
+			}
 			enumString = cmzn_graphics_streamlines_colour_data_type_enum_to_string(
 				(enum cmzn_graphics_streamlines_colour_data_type)streamlines.getColourDataType());
 			if (enumString)
@@ -764,6 +778,11 @@ void GraphicsJsonIO::ioStreamlinesEntries(Json::Value &graphicsSettings)
 					static_cast<OpenCMISS::Zinc::GraphicsStreamlines::TrackDirection>(
 						cmzn_graphics_streamlines_track_direction_enum_from_string(
 							attributesSettings["TrackDirection"].asCString())));
+			if (attributesSettings["IntegrationMethod"].isString())
+				streamlines.setIntegrationMethod(
+					static_cast<OpenCMISS::Zinc::GraphicsStreamlines::IntegrationMethod>(
+						cmzn_graphics_streamlines_integration_method_enum_from_string(
+							attributesSettings["IntegrationMethod"].asCString())));
 			if (attributesSettings["ColourDataType"].isString())
 				streamlines.setColourDataType(
 					static_cast<OpenCMISS::Zinc::GraphicsStreamlines::ColourDataType>(
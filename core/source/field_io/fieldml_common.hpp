@@ -22,6 +22,9 @@
 
 const FmlObjectHandle FML_INVALID_OBJECT_HANDLE = (const FmlObjectHandle)FML_INVALID_HANDLE;
 
+// maximum number of values buffered for reading or writing as a single slab
+const int FieldML_maximumSlabValuesCount = 1 << 20;
+
 struct FE_basis;
 
 struct ShapeType
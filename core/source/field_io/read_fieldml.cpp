@@ -1243,11 +1243,23 @@ template <typename VALUETYPE, class PARAMETERCONSUMER> bool FieldMLReader::readP
 		return false;
 	}
 
-	std::vector<int> keyVector(sparseIndexCount);
-	int *keyBuffer = keyVector.data();
+	// read records in blocks to minimise the number of slab reads, which is
+	// significant for large models particularly from HDF5. Consumers supply
+	// records consecutively along the first array index.
+	const int recordCount = parameterConsumer.getRecordCount();
+	const int *denseRecordSizes = parameterConsumer.getDenseRecordSizes();
 	const int valueBufferSize = parameterConsumer.getDenseRecordBufferSize();
-	std::vector<VALUETYPE> valueVector(valueBufferSize);
+	int blockRecordsCount = (0 < valueBufferSize) ? FieldML_maximumSlabValuesCount/valueBufferSize : 1;
+	if (blockRecordsCount > recordCount)
+		blockRecordsCount = recordCount;
+	if (blockRecordsCount < 1)
+		blockRecordsCount = 1;
+	std::vector<int> keyVector(blockRecordsCount*sparseIndexCount);
+	int *keyBuffer = keyVector.data();
+	std::vector<VALUETYPE> valueVector(blockRecordsCount*valueBufferSize);
 	VALUETYPE *valueBuffer = valueVector.data();
+	std::vector<int> denseBlockSizes(denseRecordSizes, denseRecordSizes + arrayRank);
+	int sparseBlockSizes[2] = { 0, sparseIndexCount };
 
 	FmlReaderHandle fmlValueReader = Fieldml_OpenReader(fmlSession, fmlDataSource);
 	if (fmlValueReader == FML_INVALID_HANDLE)
@@ -1270,71 +1282,53 @@ template <typename VALUETYPE, class PARAMETERCONSUMER> bool FieldMLReader::readP
 	}
 
 	bool result = true;
-	const int recordCount = parameterConsumer.getRecordCount();
-	const int *denseRecordSizes = parameterConsumer.getDenseRecordSizes();
 	FmlIoErrorNumber ioResult;
-	if (dataDescription == FML_DATA_DESCRIPTION_DENSE_ARRAY)
+	const bool isDense = (dataDescription == FML_DATA_DESCRIPTION_DENSE_ARRAY);
+	for (int r = 0; r < recordCount; ++r)
 	{
-		for (int r = 0; r < recordCount; ++r)
+		if (!parameterConsumer.nextRecord())
 		{
-			if (!parameterConsumer.nextRecord())
-			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Unexpected end of records when reading dense parameter evaluator %s", name.c_str());
-				result = false;
-				break;
-			}
-			ioResult = FieldML_ReadSlab(fmlValueReader, parameterConsumer.getDenseRecordOffsets(), denseRecordSizes, valueBuffer);
-			if (ioResult != FML_IOERR_NO_ERROR)
-			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to read values data source %s for dense parameters %s",
-					getName(fmlDataSource).c_str(), name.c_str());
-				result = false;
-				break;
-			}
-			if (!parameterConsumer.setDenseValues(valueBuffer))
-			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to set dense values read from data source %s for parameters %s",
-					getName(fmlDataSource).c_str(), name.c_str());
-				result = false;
-				break;
-			}
+			display_message(ERROR_MESSAGE, "FieldML Reader:  Unexpected end of records when reading %s parameter evaluator %s",
+				isDense ? "dense" : "sparse", name.c_str());
+			result = false;
+			break;
 		}
-	}
-	else
-	{
-		const int *sparseRecordSizes = parameterConsumer.getSparseRecordSizes();
-		for (int r = 0; r < recordCount; ++r)
+		const int blockRecord = r % blockRecordsCount;
+		if (0 == blockRecord)
 		{
-			if (!parameterConsumer.nextRecord())
-			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Unexpected end of records when reading sparse parameter evaluator %s", name.c_str());
-				result = false;
-				break;
-			}
-			ioResult = Fieldml_ReadIntSlab(fmlKeyReader, parameterConsumer.getSparseRecordOffsets(), sparseRecordSizes, keyBuffer);
-			if (ioResult != FML_IOERR_NO_ERROR)
+			const int blockRecordsUsed = ((recordCount - r) < blockRecordsCount) ? (recordCount - r) : blockRecordsCount;
+			if (!isDense)
 			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to read key data source %s for parameters %s",
-					getName(fmlKeyDataSource).c_str(), name.c_str());
-				result = false;
-				break;
+				sparseBlockSizes[0] = blockRecordsUsed;
+				ioResult = Fieldml_ReadIntSlab(fmlKeyReader, parameterConsumer.getSparseRecordOffsets(), sparseBlockSizes, keyBuffer);
+				if (ioResult != FML_IOERR_NO_ERROR)
+				{
+					display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to read key data source %s for parameters %s",
+						getName(fmlKeyDataSource).c_str(), name.c_str());
+					result = false;
+					break;
+				}
 			}
-			ioResult = FieldML_ReadSlab(fmlValueReader, parameterConsumer.getDenseRecordOffsets(), denseRecordSizes, valueBuffer);
+			if (0 < arrayRank)
+				denseBlockSizes[0] = blockRecordsUsed*denseRecordSizes[0];
+			ioResult = FieldML_ReadSlab(fmlValueReader, parameterConsumer.getDenseRecordOffsets(), denseBlockSizes.data(), valueBuffer);
 			if (ioResult != FML_IOERR_NO_ERROR)
 			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to read values data source %s for sparse parameters %s",
-					getName(fmlDataSource).c_str(), name.c_str());
-				result = false;
-				break;
-			}
-			if (!parameterConsumer.setSparseValues(keyBuffer, valueBuffer))
-			{
-				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to set sparse values read from data source %s for parameters %s",
-					getName(fmlDataSource).c_str(), name.c_str());
+				display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to read values data source %s for %s parameters %s",
+					getName(fmlDataSource).c_str(), isDense ? "dense" : "sparse", name.c_str());
 				result = false;
 				break;
 			}
 		}
+		VALUETYPE *recordValues = valueBuffer + blockRecord*valueBufferSize;
+		if (!((isDense) ? parameterConsumer.setDenseValues(recordValues) :
+			parameterConsumer.setSparseValues(keyBuffer + blockRecord*sparseIndexCount, recordValues)))
+		{
+			display_message(ERROR_MESSAGE, "FieldML Reader:  Failed to set %s values read from data source %s for parameters %s",
+				isDense ? "dense" : "sparse", getName(fmlDataSource).c_str(), name.c_str());
+			result = false;
+			break;
+		}
 	}
 
 	if (dataDescription == FML_DATA_DESCRIPTION_DOK_ARRAY)
@@ -9,6 +9,8 @@
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -417,6 +419,9 @@ class FieldMLWriter
 	const char *filename;
 	char *regionName;
 	FmlSessionHandle fmlSession;
+	cmzn_streaminformation_region_fieldml_data_format dataFormat;
+	std::string hdf5Filename; // external file name for HDF5 data format
+	FmlObjectHandle fmlHdf5DataResource;
 	bool verbose;
 	int libraryImportSourceIndex;
 	std::map<cmzn_field_domain_type,FmlObjectHandle> fmlNodesTypes;
@@ -434,12 +439,16 @@ class FieldMLWriter
 	std::map<FmlObjectHandle,FmlObjectHandle> typeArgument;
 
 public:
-	FieldMLWriter(struct cmzn_region *region, const char *locationIn, const char *filenameIn) :
+	FieldMLWriter(struct cmzn_region *region, const char *locationIn, const char *filenameIn,
+			cmzn_streaminformation_region_fieldml_data_format dataFormatIn) :
 		region(cmzn_region_access(region)),
 		fe_region(cmzn_region_get_FE_region(this->region)),
 		location(locationIn),
 		filename(filenameIn),
 		fmlSession(Fieldml_Create(location, /*regionName*/"/")),
+		dataFormat(dataFormatIn),
+		hdf5Filename(filenameIn),
+		fmlHdf5DataResource(FML_INVALID_OBJECT_HANDLE),
 		verbose(false),
 		libraryImportSourceIndex(-1),
 		fmlNodeDerivativesType(FML_INVALID_OBJECT_HANDLE),
@@ -452,6 +461,10 @@ public:
 		fmlHermiteNodeValueLabels(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1)
 	{
 		Fieldml_SetDebug(fmlSession, /*debug*/verbose);
+		const size_t extensionPosition = this->hdf5Filename.rfind('.');
+		if (extensionPosition != std::string::npos)
+			this->hdf5Filename.erase(extensionPosition);
+		this->hdf5Filename += ".h5";
 		for (int i = 0; i < 4; ++i)
 		{
 			fmlMeshElementsType[i] = FML_INVALID_OBJECT_HANDLE;
@@ -483,13 +496,23 @@ private:
 	FmlObjectHandle getBasisEvaluator(FE_basis *basis,
 		FmlObjectHandle &fmlBasisParametersType, FmlObjectHandle &fmlBasisParametersArgument,
 		FmlObjectHandle &fmlBasisParametersComponentType, FmlObjectHandle &fmlBasisParametersComponentArgument);
+	FmlObjectHandle getDataResource(const std::string& name);
+	FmlObjectHandle createArrayDataSource(const std::string& dataSourceName,
+		FmlObjectHandle fmlDataResource, const char *inlineLocation, int rank);
+	template <typename VALUETYPE> bool writeArray(FmlObjectHandle fmlDataSource,
+		FmlObjectHandle fmlType, int rank, const int *sizes, const VALUETYPE *values);
+	template <typename VALUETYPE> bool writeKeyAndValueArrays(const std::string& name,
+		FmlObjectHandle fmlDataResource, FmlObjectHandle fmlKeyType, FmlObjectHandle fmlValueType,
+		int recordCount, int sparseIndexCount, const std::vector<int>& keys,
+		int denseSize, const std::vector<VALUETYPE>& values,
+		FmlObjectHandle& fmlKeyDataSource, FmlObjectHandle& fmlDataSource);
 	int defineEnsembleFromLabels(FmlObjectHandle fmlEnsembleType, const DsLabels& labels);
 	template <typename VALUETYPE, class PARAMETERGENERATOR>
 	FmlObjectHandle writeDenseParameters(const std::string& name,
-		FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator) const;
+		FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator);
 	template <typename VALUETYPE, class PARAMETERGENERATOR>
 	FmlObjectHandle writeSparseParameters(const std::string& name,
-		FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator) const;
+		FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator);
 	template <typename VALUETYPE> FmlObjectHandle defineParametersFromMap(
 		DsMap<VALUETYPE>& parameterMap, FmlObjectHandle fmlValueType);
 
@@ -614,6 +637,50 @@ FmlObjectHandle FieldMLWriter::getBasisEvaluator(FE_basis *basis,
 	return fmlBasisEvaluator;
 }
 
+/** Get data resource to hold array data sources for the named object. For
+  * inline text a new resource is created for each; for HDF5 all array data
+  * sources are datasets in a single external file, replaced on first use.
+  * @return  Handle to data resource. */
+FmlObjectHandle FieldMLWriter::getDataResource(const std::string& name)
+{
+	if (this->dataFormat == CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5)
+	{
+		if (FML_INVALID_OBJECT_HANDLE == this->fmlHdf5DataResource)
+		{
+			// HDF5 writer adds datasets to an existing file so remove any old one
+			std::string pathandfilename(this->location);
+			if (!pathandfilename.empty())
+				pathandfilename += "/";
+			pathandfilename += this->hdf5Filename;
+			remove(pathandfilename.c_str());
+			this->fmlHdf5DataResource = Fieldml_CreateHrefDataResource(this->fmlSession,
+				this->hdf5Filename.c_str(), "HDF5", this->hdf5Filename.c_str());
+		}
+		return this->fmlHdf5DataResource;
+	}
+	std::string dataResourceName(name + ".data.resource");
+	return Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
+}
+
+/** Create array data source in data resource from getDataResource. For HDF5
+  * its location is a dataset named after the data source.
+  * @param inlineLocation  Location of array in inline text resource.
+  * @return  Handle to array data source. */
+FmlObjectHandle FieldMLWriter::createArrayDataSource(const std::string& dataSourceName,
+	FmlObjectHandle fmlDataResource, const char *inlineLocation, int rank)
+{
+	if (this->dataFormat == CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5)
+	{
+		// slash separates HDF5 group names
+		std::string datasetName(dataSourceName);
+		std::replace(datasetName.begin(), datasetName.end(), '/', '_');
+		return Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
+			fmlDataResource, datasetName.c_str(), rank);
+	}
+	return Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
+		fmlDataResource, inlineLocation, rank);
+}
+
 int FieldMLWriter::defineEnsembleFromLabels(FmlObjectHandle fmlEnsembleType, const DsLabels& labels)
 {
 	if (fmlEnsembleType == FML_INVALID_OBJECT_HANDLE)
@@ -647,13 +714,11 @@ int FieldMLWriter::defineEnsembleFromLabels(FmlObjectHandle fmlEnsembleType, con
 	}
 	else
 	{
-		// for non-contiguous use inline range data source
-		std::string dataResourceName(labels.getName());
-		dataResourceName += ".data.resource";
-		FmlObjectHandle fmlDataResource = Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
+		// for non-contiguous use range data source
+		FmlObjectHandle fmlDataResource = this->getDataResource(labels.getName());
 		std::string dataSourceName(labels.getName());
 		dataSourceName += ".data.source";
-		FmlObjectHandle fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(), fmlDataResource, /*location*/"0", /*rank*/2);
+		FmlObjectHandle fmlDataSource = this->createArrayDataSource(dataSourceName, fmlDataResource, /*location*/"0", /*rank*/2);
 		int sizes[2] = { static_cast<int>(ranges.size()), 2 };
 		Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, sizes);
 		Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlDataSource, sizes);
@@ -668,19 +733,18 @@ int FieldMLWriter::defineEnsembleFromLabels(FmlObjectHandle fmlEnsembleType, con
 			return_code = CMZN_ERROR_GENERAL;
 		if (CMZN_OK == return_code)
 		{
-			int numberOfRanges = static_cast<int>(ranges.size());
+			// write all ranges in one slab
+			const int numberOfRanges = static_cast<int>(ranges.size());
+			std::vector<int> rangeValues(2*numberOfRanges);
 			for (int i = 0; i < numberOfRanges; ++i)
 			{
-				const int slabOffsets[] = { i, 0 };
-				const int slabSizes[] = { 1, 2 };
-				const int range[2] = { ranges[i].first, ranges[i].last };
-				FmlIoErrorNumber fmlIoError = Fieldml_WriteIntSlab(fmlArrayWriter, slabOffsets, slabSizes, range);
-				if (FML_IOERR_NO_ERROR != fmlIoError)
-				{
-					return_code = CMZN_ERROR_GENERAL;
-					break;
-				}
+				rangeValues[i*2] = ranges[i].first;
+				rangeValues[i*2 + 1] = ranges[i].last;
 			}
+			const int slabOffsets[] = { 0, 0 };
+			FmlIoErrorNumber fmlIoError = Fieldml_WriteIntSlab(fmlArrayWriter, slabOffsets, sizes, rangeValues.data());
+			if (FML_IOERR_NO_ERROR != fmlIoError)
+				return_code = CMZN_ERROR_GENERAL;
 		}
 		Fieldml_CloseWriter(fmlArrayWriter);
 		if (CMZN_OK == return_code)
@@ -722,8 +786,65 @@ template <>	inline const char *FieldML_valueFormat(const int *)
 	return " %d";
 }
 
+/** Write complete array of values to array data source in a single slab.
+  * @param fmlType  Continuous type for real values, ensemble type for integers.
+  * @return  True on success, false on failure. */
+template <typename VALUETYPE> bool FieldMLWriter::writeArray(FmlObjectHandle fmlDataSource,
+	FmlObjectHandle fmlType, int rank, const int *sizes, const VALUETYPE *values)
+{
+	if (FML_INVALID_OBJECT_HANDLE == fmlDataSource)
+		return false;
+	Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, const_cast<int *>(sizes));
+	Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlDataSource, const_cast<int *>(sizes));
+	FmlWriterHandle fmlArrayWriter = Fieldml_OpenArrayWriter(this->fmlSession,
+		fmlDataSource, fmlType, /*append*/false, const_cast<int *>(sizes), rank);
+	if (fmlArrayWriter == FML_INVALID_OBJECT_HANDLE)
+		return false;
+	bool result = true;
+	int valuesCount = 1;
+	for (int d = 0; d < rank; ++d)
+		valuesCount *= sizes[d];
+	if (0 < valuesCount)
+	{
+		const std::vector<int> offsets(rank, 0);
+		if (FML_IOERR_NO_ERROR != FieldML_WriteSlab(fmlArrayWriter, offsets.data(), sizes, values))
+			result = false;
+	}
+	Fieldml_CloseWriter(fmlArrayWriter);
+	return result;
+}
+
+/** Write sparse parameter keys and dense values to separate rank 2 arrays, as
+  * needed for binary formats where they have different types.
+  * @param keys  Record keys, sparseIndexCount per record.
+  * @param values  Record values, denseSize per record.
+  * @param fmlKeyDataSource  On success set to handle to new key data source.
+  * @param fmlDataSource  On success set to handle to new values data source.
+  * @return  True on success, false on failure. */
+template <typename VALUETYPE> bool FieldMLWriter::writeKeyAndValueArrays(const std::string& name,
+	FmlObjectHandle fmlDataResource, FmlObjectHandle fmlKeyType, FmlObjectHandle fmlValueType,
+	int recordCount, int sparseIndexCount, const std::vector<int>& keys,
+	int denseSize, const std::vector<VALUETYPE>& values,
+	FmlObjectHandle& fmlKeyDataSource, FmlObjectHandle& fmlDataSource)
+{
+	fmlKeyDataSource = this->createArrayDataSource(name + ".key.data.source",
+		fmlDataResource, /*location*/"1", /*rank*/2);
+	fmlDataSource = this->createArrayDataSource(name + ".data.source",
+		fmlDataResource, /*location*/"1", /*rank*/2);
+	const int keySizes[2] = { recordCount, sparseIndexCount };
+	const int sizes[2] = { recordCount, denseSize };
+	if ((!this->writeArray(fmlKeyDataSource, fmlKeyType, /*rank*/2, keySizes, keys.data())) ||
+		(!this->writeArray(fmlDataSource, fmlValueType, /*rank*/2, sizes, values.data())))
+	{
+		display_message(ERROR_MESSAGE, "FieldML Writer:  Failed to write key and value arrays for parameters %s", name.c_str());
+		return false;
+	}
+	return true;
+}
+
 /** Write parameters in dense format, where parameters exist for all
-  * permutations of all indexes. Currently only writes to inline text format.
+  * permutations of all indexes. Records from the generator are consecutive
+  * along the first index, and are written in blocks of many records.
   * @param name  The name of the parameter evaluator to return. Other
   * FieldML objects use this as a base name and append extra text.
   * @param denseIndexCount  Size of fmlDenseIndexArguments, equals rank of array.
@@ -733,15 +854,14 @@ template <>	inline const char *FieldML_valueFormat(const int *)
   * @return  Handle to parameters object. */
 template <typename VALUETYPE, class PARAMETERGENERATOR>
 FmlObjectHandle FieldMLWriter::writeDenseParameters(const std::string& name,
-	FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator) const
+	FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator)
 {
 	int denseIndexCount;
 	const FmlObjectHandle *fmlDenseIndexArguments = parameterGenerator.getDenseArguments(denseIndexCount);
 
-	std::string dataResourceName(name + ".data.resource");
-	FmlObjectHandle fmlDataResource = Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
+	FmlObjectHandle fmlDataResource = this->getDataResource(name);
 	std::string dataSourceName(name + ".data.source");
-	FmlObjectHandle fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
+	FmlObjectHandle fmlDataSource = this->createArrayDataSource(dataSourceName,
 		fmlDataResource, /*location*/"1", /*rank*/denseIndexCount);
 	std::vector<int> sizes(denseIndexCount);
 	std::vector<int> offsets(denseIndexCount);
@@ -760,7 +880,19 @@ FmlObjectHandle FieldMLWriter::writeDenseParameters(const std::string& name,
 
 	bool failed = false;
 	const int *recordSizes = parameterGenerator.getDenseRecordSizes();
-	for (int r = parameterGenerator.getRecordCount(); 0 < r; --r)
+	int recordValuesCount = 1;
+	for (int d = 0; d < denseIndexCount; ++d)
+		recordValuesCount *= recordSizes[d];
+	const int recordCount = parameterGenerator.getRecordCount();
+	int blockRecordsCount = (0 < recordValuesCount) ? FieldML_maximumSlabValuesCount/recordValuesCount : 1;
+	if (blockRecordsCount > recordCount)
+		blockRecordsCount = recordCount;
+	if (blockRecordsCount < 1)
+		blockRecordsCount = 1;
+	std::vector<VALUETYPE> blockValues(blockRecordsCount*recordValuesCount);
+	std::vector<int> blockSizes(recordSizes, recordSizes + denseIndexCount);
+	int blockRecordsUsed = 0;
+	for (int r = 0; r < recordCount; ++r)
 	{
 		if (!parameterGenerator.nextRecord())
 		{
@@ -768,12 +900,22 @@ FmlObjectHandle FieldMLWriter::writeDenseParameters(const std::string& name,
 			failed = true;
 			break;
 		}
-		FmlIoErrorNumber fmlIoError = FieldML_WriteSlab(fmlArrayWriter,
-			parameterGenerator.getRecordOffsets(), recordSizes, parameterGenerator.getRecordValues());
-		if (FML_IOERR_NO_ERROR != fmlIoError)
-		{
-			failed = true;
-			break;
+		if (0 == blockRecordsUsed)
+			offsets.assign(parameterGenerator.getRecordOffsets(), parameterGenerator.getRecordOffsets() + denseIndexCount);
+		const VALUETYPE *recordValues = parameterGenerator.getRecordValues();
+		std::copy(recordValues, recordValues + recordValuesCount, blockValues.begin() + blockRecordsUsed*recordValuesCount);
+		++blockRecordsUsed;
+		if ((blockRecordsUsed == blockRecordsCount) || (r == (recordCount - 1)))
+		{
+			blockSizes[0] = blockRecordsUsed*recordSizes[0];
+			FmlIoErrorNumber fmlIoError = FieldML_WriteSlab(fmlArrayWriter,
+				offsets.data(), blockSizes.data(), blockValues.data());
+			if (FML_IOERR_NO_ERROR != fmlIoError)
+			{
+				failed = true;
+				break;
+			}
+			blockRecordsUsed = 0;
 		}
 	}
 	Fieldml_CloseWriter(fmlArrayWriter);
@@ -801,8 +943,8 @@ FmlObjectHandle FieldMLWriter::writeDenseParameters(const std::string& name,
 
 /** Write parameters in sparse format, where sparse indexes are written
   * 1:1 with the dense parameters they label, and which have a parameter for
-  * all permutations of the dense indexes. Currently writes to inline text
-  * format with indexes followed by dense parameters.
+  * all permutations of the dense indexes. Inline text has indexes followed by
+  * dense parameters on each line; HDF5 has separate key and value arrays.
   * @param name  The name of the parameter evaluator to return. Other
   * FieldML objects use this as a base name and append extra text.
   * @param sparseIndexCount  Size of fmlDenseIndexArguments
@@ -815,28 +957,13 @@ FmlObjectHandle FieldMLWriter::writeDenseParameters(const std::string& name,
   */
 template <typename VALUETYPE, class PARAMETERGENERATOR>
 FmlObjectHandle FieldMLWriter::writeSparseParameters(const std::string& name,
-	FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator) const
+	FmlObjectHandle fmlValueType, PARAMETERGENERATOR& parameterGenerator)
 {
 	int sparseIndexCount;
 	const FmlObjectHandle *fmlSparseIndexArguments = parameterGenerator.getSparseArguments(sparseIndexCount);
 	int denseIndexCount;
 	const FmlObjectHandle *fmlDenseIndexArguments = parameterGenerator.getDenseArguments(denseIndexCount);
-	std::string dataResourceName(name + ".data.resource");
-	FmlObjectHandle fmlDataResource = Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
-	// when writing to a text bulk data format we want the sparse labels to
-	// precede the dense data under those labels (so kept together). This can only
-	// be done if both are rank 2. Must confirm than the FieldML API can accept a
-	// rank 2 data source for sparse data with more than 1 dense indexes.
-	// This requires the second size to match product of dense index sizes.
-	// Later: With HDF5 we need separate integer key and real data arrays.
-	std::string keyDataSourceName(name + ".key.data.source");
-	FmlObjectHandle fmlKeyDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, keyDataSourceName.c_str(),
-		fmlDataResource, /*location*/"1", /*rank*/2);
-	std::string dataSourceName(name + ".data.source");
-	FmlObjectHandle fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
-		fmlDataResource, /*location*/"1", /*rank*/2);
-	if ((fmlKeyDataSource == FML_INVALID_OBJECT_HANDLE) || (fmlDataSource == FML_INVALID_OBJECT_HANDLE))
-		return FML_INVALID_OBJECT_HANDLE;
+	FmlObjectHandle fmlDataResource = this->getDataResource(name);
 
 	const int *recordSizes = parameterGenerator.getDenseRecordSizes();
 	int denseSize = 1;
@@ -845,56 +972,95 @@ FmlObjectHandle FieldMLWriter::writeSparseParameters(const std::string& name,
 
 	const int recordCount = parameterGenerator.getRecordCount();
 
-	const int rawSizes[2] = { recordCount, sparseIndexCount + denseSize };
-	const int keySizes[2] = { recordCount, sparseIndexCount };
-	const int keyOffsets[2] = { 0, 0 };
-	const int sizes[2] = { recordCount, denseSize };
-	const int offsets[2] = { 0, sparseIndexCount };
-	Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlKeyDataSource, const_cast<int*>(rawSizes));
-	Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlKeyDataSource, const_cast<int*>(keySizes));
-	Fieldml_SetArrayDataSourceOffsets(this->fmlSession, fmlKeyDataSource, const_cast<int*>(keyOffsets));
-	Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, const_cast<int*>(rawSizes));
-	Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlDataSource, const_cast<int*>(sizes));
-	Fieldml_SetArrayDataSourceOffsets(this->fmlSession, fmlDataSource, const_cast<int*>(offsets));
-
-	std::ostringstream stringStream;
-	stringStream << "\n";
-	// Future: configurable numerical format for reals
-	const VALUETYPE *values = 0;
-	const char *valueFormat = FieldML_valueFormat(values);
-	char tmpValueString[50];
+	FmlErrorNumber fmlError;
+	FmlObjectHandle fmlKeyDataSource = FML_INVALID_OBJECT_HANDLE;
+	FmlObjectHandle fmlDataSource = FML_INVALID_OBJECT_HANDLE;
 	const int *indexes;
-	bool failed = false;
-	for (int r = 0; r < recordCount; ++r)
+	const VALUETYPE *values = 0;
+	if (this->dataFormat == CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5)
 	{
-		if (!parameterGenerator.nextRecord())
+		std::vector<int> keys;
+		keys.reserve(recordCount*sparseIndexCount);
+		std::vector<VALUETYPE> denseValues;
+		denseValues.reserve(recordCount*denseSize);
+		for (int r = 0; r < recordCount; ++r)
 		{
-			display_message(ERROR_MESSAGE, "FieldML Writer:  Too few parameters for evaluator %s", name.c_str());
-			failed = true;
-			break;
+			if (!parameterGenerator.nextRecord())
+			{
+				display_message(ERROR_MESSAGE, "FieldML Writer:  Too few parameters for evaluator %s", name.c_str());
+				return FML_INVALID_OBJECT_HANDLE;
+			}
+			indexes = parameterGenerator.getRecordIndexes();
+			keys.insert(keys.end(), indexes, indexes + sparseIndexCount);
+			values = parameterGenerator.getRecordValues();
+			denseValues.insert(denseValues.end(), values, values + denseSize);
+		}
+		const FmlObjectHandle fmlKeyType = (0 < sparseIndexCount) ?
+			Fieldml_GetValueType(this->fmlSession, fmlSparseIndexArguments[0]) : FML_INVALID_OBJECT_HANDLE;
+		if (!this->writeKeyAndValueArrays(name, fmlDataResource, fmlKeyType, fmlValueType,
+				recordCount, sparseIndexCount, keys, denseSize, denseValues, fmlKeyDataSource, fmlDataSource))
+			return FML_INVALID_OBJECT_HANDLE;
+	}
+	else
+	{
+		// when writing to a text bulk data format we want the sparse labels to
+		// precede the dense data under those labels (so kept together). This can only
+		// be done if both are rank 2. Must confirm than the FieldML API can accept a
+		// rank 2 data source for sparse data with more than 1 dense indexes.
+		// This requires the second size to match product of dense index sizes.
+		std::string keyDataSourceName(name + ".key.data.source");
+		fmlKeyDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, keyDataSourceName.c_str(),
+			fmlDataResource, /*location*/"1", /*rank*/2);
+		std::string dataSourceName(name + ".data.source");
+		fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
+			fmlDataResource, /*location*/"1", /*rank*/2);
+		if ((fmlKeyDataSource == FML_INVALID_OBJECT_HANDLE) || (fmlDataSource == FML_INVALID_OBJECT_HANDLE))
+			return FML_INVALID_OBJECT_HANDLE;
+
+		const int rawSizes[2] = { recordCount, sparseIndexCount + denseSize };
+		const int keySizes[2] = { recordCount, sparseIndexCount };
+		const int keyOffsets[2] = { 0, 0 };
+		const int sizes[2] = { recordCount, denseSize };
+		const int offsets[2] = { 0, sparseIndexCount };
+		Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlKeyDataSource, const_cast<int*>(rawSizes));
+		Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlKeyDataSource, const_cast<int*>(keySizes));
+		Fieldml_SetArrayDataSourceOffsets(this->fmlSession, fmlKeyDataSource, const_cast<int*>(keyOffsets));
+		Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, const_cast<int*>(rawSizes));
+		Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlDataSource, const_cast<int*>(sizes));
+		Fieldml_SetArrayDataSourceOffsets(this->fmlSession, fmlDataSource, const_cast<int*>(offsets));
+
+		std::ostringstream stringStream;
+		stringStream << "\n";
+		// Future: configurable numerical format for reals
+		const char *valueFormat = FieldML_valueFormat(values);
+		char tmpValueString[50];
+		for (int r = 0; r < recordCount; ++r)
+		{
+			if (!parameterGenerator.nextRecord())
+			{
+				display_message(ERROR_MESSAGE, "FieldML Writer:  Too few parameters for evaluator %s", name.c_str());
+				return FML_INVALID_OBJECT_HANDLE;
+			}
+			indexes = parameterGenerator.getRecordIndexes();
+			for (int s = 0; s < sparseIndexCount; ++s)
+				stringStream << " " << indexes[s];
+			values = parameterGenerator.getRecordValues();
+			for (int d = 0; d < denseSize; ++d)
+			{
+				sprintf(tmpValueString, valueFormat, values[d]);
+				stringStream << tmpValueString;
+			}
+			stringStream << "\n";
 		}
-		indexes = parameterGenerator.getRecordIndexes();
-		for (int s = 0; s < sparseIndexCount; ++s)
-			stringStream << " " << indexes[s];
-		values = parameterGenerator.getRecordValues();
-		for (int d = 0; d < denseSize; ++d)
+		// following call copies all the data so expensive; best solution is to not use inline data,
+		// but could implement own memory stream, or do so within the FieldML API
+		std::string sstring = stringStream.str();
+		int sstringSize = static_cast<int>(sstring.size());
+		if (FML_OK != (fmlError = Fieldml_SetInlineData(this->fmlSession, fmlDataResource, sstring.c_str(), sstringSize)))
 		{
-			sprintf(tmpValueString, valueFormat, values[d]);
-			stringStream << tmpValueString;
+			display_message(ERROR_MESSAGE, "FieldML Writer:  Failed to set inline data for parameters %s", name.c_str());
+			return FML_INVALID_OBJECT_HANDLE;
 		}
-		stringStream << "\n";
-	}
-	if (failed)
-		return FML_INVALID_OBJECT_HANDLE;
-	// following call copies all the data so expensive; best solution is to not use inline data,
-	// but could implement own memory stream, or do so within the FieldML API
-	std::string sstring = stringStream.str();
-	int sstringSize = static_cast<int>(sstring.size());
-	FmlErrorNumber fmlError;
-	if (FML_OK != (fmlError = Fieldml_SetInlineData(this->fmlSession, fmlDataResource, sstring.c_str(), sstringSize)))
-	{
-		display_message(ERROR_MESSAGE, "FieldML Writer:  Failed to set inline data for parameters %s", name.c_str());
-		return FML_INVALID_OBJECT_HANDLE;
 	}
 	FmlObjectHandle fmlParameters = FML_INVALID_OBJECT_HANDLE;
 	fmlParameters = Fieldml_CreateParameterEvaluator(this->fmlSession, name.c_str(), fmlValueType);
@@ -932,8 +1098,7 @@ template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFro
 	std::vector<HCDsLabels> sparseLabelsArray;
 	std::vector<HCDsLabels> denseLabelsArray;
 	parameterMap.getSparsity(sparseLabelsArray, denseLabelsArray);
-	std::string dataResourceName(name + ".data.resource");
-	FmlObjectHandle fmlDataResource = Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
+	FmlObjectHandle fmlDataResource = this->getDataResource(name);
 	const int denseLabelsCount = static_cast<int>(denseLabelsArray.size());
 	const int sparseLabelsCount = static_cast<int>(sparseLabelsArray.size());
 	std::string dataSourceName(name + ".data.source");
@@ -941,14 +1106,49 @@ template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFro
 	FmlErrorNumber fmlError;
 	FmlObjectHandle fmlDataSource = FML_INVALID_OBJECT_HANDLE;
 	FmlObjectHandle fmlKeyDataSource = FML_INVALID_OBJECT_HANDLE;
-	if (sparseLabelsCount > 0)
+	if ((sparseLabelsCount > 0) && (this->dataFormat == CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_HDF5))
+	{
+		// HDF5 needs separate integer key and real data arrays
+		int denseSize = 1;
+		for (int i = 0; i < denseLabelsCount; ++i)
+			denseSize *= denseLabelsArray[i]->getSize();
+		HDsMapIndexing mapIndexing(parameterMap.createIndexing());
+		for (int i = 0; i < sparseLabelsCount; ++i)
+			mapIndexing->setEntryIndex(*sparseLabelsArray[i], DS_LABEL_INDEX_INVALID);
+		mapIndexing->resetSparseIterators();
+		std::vector<int> keys;
+		std::vector<VALUETYPE> values;
+		std::vector<VALUETYPE> denseValues(denseSize);
+		int numberOfRecords = 0;
+		while (parameterMap.incrementSparseIterators(*mapIndexing))
+		{
+			if (!parameterMap.getValues(*mapIndexing, denseSize, denseValues.data()))
+			{
+				display_message(ERROR_MESSAGE, "FieldML Writer:  "
+					"Failed to get sparsely indexed values from map %s", parameterMap.getName().c_str());
+				return_code = CMZN_ERROR_GENERAL;
+				break;
+			}
+			++numberOfRecords;
+			for (int i = 0; i < sparseLabelsCount; ++i)
+				keys.push_back(mapIndexing->getSparseIdentifier(i));
+			values.insert(values.end(), denseValues.begin(), denseValues.end());
+		}
+		if (CMZN_OK == return_code)
+		{
+			FmlObjectHandle fmlKeyType = Fieldml_GetObjectByName(this->fmlSession, sparseLabelsArray[0]->getName().c_str());
+			if (!this->writeKeyAndValueArrays(name, fmlDataResource, fmlKeyType, fmlValueType,
+					numberOfRecords, sparseLabelsCount, keys, denseSize, values, fmlKeyDataSource, fmlDataSource))
+				return_code = CMZN_ERROR_GENERAL;
+		}
+	}
+	else if (sparseLabelsCount > 0)
 	{
 		// when writing to a text bulk data format we want the sparse labels to
 		// precede the dense data under those labels (so kept together). This can only
 		// be done if both are rank 2. Must confirm than the FieldML API can accept a
 		// rank 2 data source for sparse data with more than 1 dense indexes.
 		// This requires the second size to match product of dense index sizes.
-		// Later: With HDF5 we need separate integer key and real data arrays.
 		fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
 			fmlDataResource, /*location*/"1", /*rank*/2);
 		std::string indexDataSourceName(name + ".key.data.source");
@@ -1029,7 +1229,7 @@ template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFro
 	}
 	else
 	{
-		fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession, dataSourceName.c_str(),
+		fmlDataSource = this->createArrayDataSource(dataSourceName,
 			fmlDataResource, /*location*/"0", /*rank*/denseLabelsCount);
 		int *sizes = new int[denseLabelsCount];
 		int *offsets = new int[denseLabelsCount];
@@ -2137,10 +2337,12 @@ int FieldMLWriter::writeFile(const char *pathandfilename)
 	return CMZN_ERROR_GENERAL;
 }
 
-int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename)
+int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename,
+	cmzn_streaminformation_region_fieldml_data_format dataFormat)
 {
 	int return_code = CMZN_OK;
-	if (region && pathandfilename && (*pathandfilename != '\0'))
+	if (region && pathandfilename && (*pathandfilename != '\0') &&
+		(dataFormat != CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INVALID))
 	{
 		char *location = duplicate_string(pathandfilename);
 		char *lastDirSep = strrchr(location, '/');
@@ -2158,7 +2360,7 @@ int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename)
 			location[0] = '\0';
 			filename = pathandfilename;
 		}
-		FieldMLWriter fmlWriter(region, location, filename);
+		FieldMLWriter fmlWriter(region, location, filename, dataFormat);
 		if (CMZN_OK == return_code)
 			return_code = fmlWriter.writeNodesets();
 		// Currently only writes highest dimension mesh
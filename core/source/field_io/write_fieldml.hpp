@@ -12,11 +12,14 @@
 #if !defined (CMZN_WRITE_FIELDML_HPP)
 #define CMZN_WRITE_FIELDML_HPP
 
-struct cmzn_region;
+#include "opencmiss/zinc/types/regionid.h"
 
 /**
  * Write model in region in FieldML 0.5 format.
+ * @param dataFormat  How bulk array data is written: inline text or in an
+ * external HDF5 file.
  */
-int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename);
+int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename,
+	cmzn_streaminformation_region_fieldml_data_format dataFormat);
 
 #endif /* !defined (CMZN_WRITE_FIELDML_HPP) */
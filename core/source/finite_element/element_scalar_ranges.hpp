@@ -0,0 +1,140 @@
+/**
+ * FILE : element_scalar_ranges.hpp
+ *
+ * Cache of the range of a scalar field sampled over each element, used to
+ * skip elements which cannot contain a contour at an iso-value.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#if !defined (CMZN_ELEMENT_SCALAR_RANGES_HPP)
+#define CMZN_ELEMENT_SCALAR_RANGES_HPP
+
+#include "opencmiss/zinc/types/fieldid.h"
+#include "datastore/labelschangelog.hpp"
+#include "general/value.h"
+#include <vector>
+
+/**
+ * Minimum and maximum of a scalar field over the grid of points at which it
+ * is sampled by contouring each element, indexed by element index. Since
+ * contouring only finds crossings between sampled points, an element whose
+ * range does not cross an iso-value produces no contours for it, so the range
+ * can be used to cull elements without re-evaluating the field, e.g. when
+ * only the iso-values change. Ranges are recorded for a given scalar field
+ * and time, and for the number of sampling divisions in each element.
+ */
+class Element_scalar_ranges
+{
+	struct Range
+	{
+		double minimum, maximum;
+		int dimension; // 0 if not set
+		int numberInXi[3];
+	};
+
+	cmzn_field *scalarField; // not accessed; only compared
+	FE_value time;
+	std::vector<Range> ranges;
+
+public:
+
+	Element_scalar_ranges() :
+		scalarField(0),
+		time(0.0)
+	{
+	}
+
+	/** Discard all ranges */
+	void clear()
+	{
+		this->ranges.clear();
+	}
+
+	/**
+	 * Discard ranges if scalar field or time differ from those they were
+	 * recorded for. Call before each build.
+	 */
+	void setScalarFieldAndTime(cmzn_field *scalarFieldIn, FE_value timeIn)
+	{
+		if ((scalarFieldIn != this->scalarField) || (timeIn != this->time))
+		{
+			this->clear();
+			this->scalarField = scalarFieldIn;
+			this->time = timeIn;
+		}
+	}
+
+	/**
+	 * Discard ranges for elements with changes in the change log. Caller must
+	 * have propagated changes to the dimension of the change log.
+	 */
+	void clearChanged(DsLabelsChangeLog& changeLog)
+	{
+		if (changeLog.isAllChange())
+		{
+			this->clear();
+			return;
+		}
+		const DsLabelIndex indexLimit = static_cast<DsLabelIndex>(this->ranges.size());
+		for (DsLabelIndex index = 0; index < indexLimit; ++index)
+		{
+			if ((this->ranges[index].dimension) && changeLog.isIndexChange(index))
+				this->ranges[index].dimension = 0;
+		}
+	}
+
+	/**
+	 * Get recorded range of scalar over element, if any.
+	 * @param numberInXi  Number of sampling divisions on each of dimension
+	 * axes. Range is only returned if recorded for the same divisions.
+	 * @return  True if range recorded, false if not.
+	 */
+	bool getRange(DsLabelIndex elementIndex, int dimension, const int *numberInXi,
+		double& minimum, double& maximum) const
+	{
+		if ((elementIndex < 0) || (elementIndex >= static_cast<DsLabelIndex>(this->ranges.size())))
+			return false;
+		const Range& range = this->ranges[elementIndex];
+		if (range.dimension != dimension)
+			return false;
+		for (int i = 0; i < dimension; ++i)
+			if (range.numberInXi[i] != numberInXi[i])
+				return false;
+		minimum = range.minimum;
+		maximum = range.maximum;
+		return true;
+	}
+
+	void setRange(DsLabelIndex elementIndex, int dimension, const int *numberInXi,
+		double minimum, double maximum)
+	{
+		if ((elementIndex < 0) || (dimension < 1) || (dimension > 3))
+			return;
+		if (elementIndex >= static_cast<DsLabelIndex>(this->ranges.size()))
+		{
+			Range unset = { 0.0, 0.0, 0, { 0, 0, 0 } };
+			this->ranges.resize(elementIndex + 1, unset);
+		}
+		Range& range = this->ranges[elementIndex];
+		range.minimum = minimum;
+		range.maximum = maximum;
+		range.dimension = dimension;
+		for (int i = 0; i < 3; ++i)
+			range.numberInXi[i] = (i < dimension) ? numberInXi[i] : 0;
+	}
+
+	/**
+	 * @return  True if sampled scalars in range can cross isoValue. Contouring
+	 * requires samples both above and not above the iso-value.
+	 */
+	static bool rangeCrosses(double minimum, double maximum, double isoValue)
+	{
+		return (minimum <= isoValue) && (isoValue < maximum);
+	}
+
+};
+
+#endif /* !defined (CMZN_ELEMENT_SCALAR_RANGES_HPP) */
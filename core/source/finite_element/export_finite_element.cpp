@@ -26,6 +26,7 @@
 #include "finite_element/export_finite_element.h"
 #include "general/compare.h"
 #include "general/debug.h"
+#include "general/block_gzip_stream.hpp"
 #include "general/enumerator_private.hpp"
 #include "general/list.h"
 #include "general/indexed_list_private.h"
@@ -2381,20 +2382,41 @@ int write_exregion_file_of_name(const char *file_name,
 	enum FE_write_fields_mode write_fields_mode,
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
-	enum cmzn_streaminformation_region_recursion_mode recursion_mode)
+	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
+	enum cmzn_streaminformation_data_compression_type data_compression_type,
+	int compression_level)
 {
 	int return_code;
 
 	if (file_name)
 	{
+		const bool gzip = (data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP);
 		ofstream output_file;
-		output_file.open(file_name, ios::out);
+		output_file.open(file_name, gzip ? (ios::out | ios::binary) : ios::out);
 		if (output_file.is_open())
 		{
-			return_code = write_exregion_to_stream(&output_file, region, group_name, root_region,
-				write_elements, write_nodes, write_data,
-				write_fields_mode, number_of_field_names, field_names, time,
-				write_criterion, recursion_mode);
+			if (gzip)
+			{
+				BlockGzipStreambuf gzip_buffer(output_file, compression_level);
+				ostream gzip_stream(&gzip_buffer);
+				return_code = write_exregion_to_stream(&gzip_stream, region, group_name, root_region,
+					write_elements, write_nodes, write_data,
+					write_fields_mode, number_of_field_names, field_names, time,
+					write_criterion, recursion_mode);
+				if (!gzip_buffer.close())
+				{
+					display_message(ERROR_MESSAGE,
+						"Could not compress exregion file: %s", file_name);
+					return_code = 0;
+				}
+			}
+			else
+			{
+				return_code = write_exregion_to_stream(&output_file, region, group_name, root_region,
+					write_elements, write_nodes, write_data,
+					write_fields_mode, number_of_field_names, field_names, time,
+					write_criterion, recursion_mode);
+			}
 			output_file.close();
 		}
 		else
@@ -17,6 +17,7 @@
 #include "general/enumerator.h"
 #include "region/cmiss_region.h"
 #include "opencmiss/zinc/types/regionid.h"
+#include "opencmiss/zinc/types/streamid.h"
 
 /*
 Global/Public types
@@ -71,6 +72,9 @@ PROTOTYPE_ENUMERATOR_FUNCTIONS(FE_write_recursion);
  * @param group  Optional subgroup to output.
  * @param root_region  The root region output paths are relative to.
  * @param file_name  Name of file. 
+ * @param data_compression_type  If GZIP, file is written as a series of gzip
+ * members compressed in parallel. Other types are written uncompressed.
+ * @param compression_level  zlib compression level 0 to 9, or -1 for default.
  * @see write_exregion_to_stream.
  */
 int write_exregion_file_of_name(const char *file_name,
@@ -80,7 +84,9 @@ int write_exregion_file_of_name(const char *file_name,
 	enum FE_write_fields_mode write_fields_mode,
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
-	enum cmzn_streaminformation_region_recursion_mode recursion_mode);
+	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
+	enum cmzn_streaminformation_data_compression_type data_compression_type,
+	int compression_level);
 
 int write_exregion_file_to_memory_block(
 	struct cmzn_region *region, const char *group_name,
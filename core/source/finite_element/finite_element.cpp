@@ -10373,6 +10373,79 @@ int cmzn_node_set_field_component_int_values(cmzn_node *node,
 	return cmzn_node_set_field_component_values(node, field, componentNumber, time, valuesCount, valuesIn);
 }
 
+int FE_field_get_nodes_FE_value_values(FE_field *field, FE_value time,
+	int nodeCount, cmzn_node * const *nodes, FE_value *valuesOut, char *definedOut)
+{
+	if (!(field && (field->value_type == FE_VALUE_VALUE) && (GENERAL_FE_FIELD == field->fe_field_type)
+		&& (0 <= nodeCount) && ((0 == nodeCount) || (nodes && valuesOut && definedOut))))
+	{
+		display_message(ERROR_MESSAGE, "FE_field_get_nodes_FE_value_values.  Invalid arguments");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const int componentCount = field->number_of_components;
+	// consecutive nodes usually share node field info, so cache storage offsets
+	// of the VALUE parameters and only look them up again when it changes
+	const FE_node_field_info *lastFields = 0;
+	const FE_node_field *node_field = 0;
+	bool allComponentsHaveValue = false;
+	std::vector<int> valueOffsets(componentCount, 0);
+	std::vector<FE_value> timeValues(componentCount);
+	for (int n = 0; n < nodeCount; ++n)
+	{
+		cmzn_node *node = nodes[n];
+		if (!((node) && (node->fields) && (node->values_storage)))
+		{
+			definedOut[n] = 0;
+			continue;
+		}
+		if (node->fields != lastFields)
+		{
+			lastFields = node->fields;
+			node_field = FIND_BY_IDENTIFIER_IN_LIST(FE_node_field, field)(
+				field, node->fields->node_field_list);
+			allComponentsHaveValue = (0 != node_field);
+			if (node_field)
+			{
+				const int valueTypeSize = get_Value_storage_size(field->value_type, node_field->time_sequence);
+				for (int c = 0; c < componentCount; ++c)
+				{
+					const FE_node_field_template *nft = node_field->getComponent(c);
+					const int valueIndex = nft->getValueIndex(CMZN_NODE_VALUE_LABEL_VALUE, /*version*/0);
+					if (valueIndex < 0)
+					{
+						allComponentsHaveValue = false;
+						break;
+					}
+					valueOffsets[c] = nft->getValuesOffset() + valueIndex*valueTypeSize;
+				}
+			}
+		}
+		if (!allComponentsHaveValue)
+		{
+			definedOut[n] = 0;
+			continue;
+		}
+		if (node_field->time_sequence)
+		{
+			if (CMZN_OK != cmzn_node_get_field_parameters(node, field, /*componentNumber*/-1,
+				CMZN_NODE_VALUE_LABEL_VALUE, /*version*/0, time, timeValues.data()))
+			{
+				definedOut[n] = 0;
+				continue;
+			}
+			for (int c = 0; c < componentCount; ++c)
+				valuesOut[c*nodeCount + n] = timeValues[c];
+		}
+		else
+		{
+			for (int c = 0; c < componentCount; ++c)
+				valuesOut[c*nodeCount + n] = *((const FE_value *)(node->values_storage + valueOffsets[c]));
+		}
+		definedOut[n] = 1;
+	}
+	return CMZN_OK;
+}
+
 int FE_field_assign_node_parameters_sparse_FE_value(FE_field *field, FE_node *node,
 	int arraySize, const FE_value *values, const int *valueExists, int valuesCount,
 	int componentsSize, int componentsOffset,
@@ -13735,6 +13808,50 @@ DECLARE_INDEXED_LIST_FUNCTIONS(FE_element_field_values)
 DECLARE_FIND_BY_IDENTIFIER_IN_INDEXED_LIST_FUNCTION(FE_element_field_values, element, \
 	struct FE_element *, compare_pointer)
 
+/**
+ * List conditional function returning true if element_field_values are for an
+ * element, or inherited from a field element, which has been removed or is
+ * marked as changed in the FE_region_changes.
+ * @param changes_void  Void pointer to FE_region_changes.
+ */
+static int FE_element_field_values_has_changed_element(
+	struct FE_element_field_values *element_field_values, void *changes_void)
+{
+	FE_region_changes *changes = static_cast<FE_region_changes *>(changes_void);
+	FE_element *elements[2] = { element_field_values->element, element_field_values->field_element };
+	for (int i = 0; i < 2; ++i)
+	{
+		FE_element *element = elements[i];
+		if (!element)
+			continue;
+		const DsLabelIndex elementIndex = element->getIndex();
+		if (elementIndex < 0)
+			return 1; // removed
+		const int dimension = element->getDimension();
+		// propagate node and parent element changes to this dimension, once only
+		changes->propagateToDimension(dimension);
+		DsLabelsChangeLog *changeLog = changes->getElementChangeLog(dimension);
+		if ((!changeLog) || changeLog->isIndexChange(elementIndex))
+			return 1;
+	}
+	return 0;
+}
+
+int FE_element_field_values_list_remove_changed(
+	struct LIST(FE_element_field_values) *element_field_values_list,
+	FE_region_changes *changes)
+{
+	if (element_field_values_list && changes)
+	{
+		return REMOVE_OBJECTS_FROM_LIST_THAT(FE_element_field_values)(
+			FE_element_field_values_has_changed_element, static_cast<void *>(changes),
+			element_field_values_list);
+	}
+	display_message(ERROR_MESSAGE,
+		"FE_element_field_values_list_remove_changed.  Invalid argument(s)");
+	return 0;
+}
+
 int FE_element_field_values_get_component_values(
 	struct FE_element_field_values *element_field_values,int component_number,
 	int *number_of_component_values_address,FE_value **component_values_address)
@@ -50,6 +50,7 @@ class FE_mesh;
  * FE_field and FE_element haves pointers to owning FE_region in shared field info.
  */
 struct FE_region;
+class FE_region_changes;
 
 enum CM_field_type
 /*******************************************************************************
@@ -511,6 +512,26 @@ int cmzn_node_set_field_component_int_values(cmzn_node *node,
 	FE_field *field, int componentNumber, FE_value time, int valuesCount,
 	const int *valuesIn);
 
+/**
+ * Get the VALUE parameters of a real field at a block of nodes, reading node
+ * storage directly. Much faster than getting values node-by-node as storage
+ * offsets are only looked up when the node field layout changes.
+ * Field must be a general FE_value field.
+ *
+ * @param field  The field whose values are to be returned.
+ * @param time  The time to get values at; only used for time-varying nodes.
+ * @param nodeCount  The number of nodes in the block.
+ * @param nodes  Array of nodeCount nodes.
+ * @param valuesOut  Array of size nodeCount*components to receive values in
+ * component-major order i.e. value of component c at node n is at
+ * valuesOut[c*nodeCount + n]. Not set for nodes where not defined.
+ * @param definedOut  Array of size nodeCount to receive 1 if the field VALUE
+ * is defined for all components at the node, otherwise 0.
+ * @return  Result OK on success, any other value on failure.
+ */
+int FE_field_get_nodes_FE_value_values(FE_field *field, FE_value time,
+	int nodeCount, cmzn_node * const *nodes, FE_value *valuesOut, char *definedOut);
+
 /**
  * Assigns all parameters for the field at the node, taken from sparse arrays.
  * Works around current limitations of node fields (that they must have VALUE
@@ -665,6 +686,18 @@ PROTOTYPE_LIST_FUNCTIONS(FE_element_field_values);
 
 PROTOTYPE_FIND_BY_IDENTIFIER_IN_LIST_FUNCTION(FE_element_field_values,element,struct FE_element *);
 
+/**
+ * Removes from list the element field values for elements which have changed
+ * or been removed, directly or through their nodes or parent elements, or whose
+ * values are inherited from such an element. Used to keep element field values
+ * for unchanged elements after partial changes to a field.
+ * @param changes  Changes to the FE_region owning the elements.
+ * @return  1 on success, 0 on failure.
+ */
+int FE_element_field_values_list_remove_changed(
+	struct LIST(FE_element_field_values) *element_field_values_list,
+	FE_region_changes *changes);
+
 int FE_element_field_values_get_component_values(
 	struct FE_element_field_values *element_field_values, int component_number,
 	int *number_of_component_values_address, FE_value **component_values_address);
@@ -35,10 +35,10 @@ Functions for converting one finite_element representation to another.
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_conversion.h"
 #include "general/debug.h"
-#include "general/octree.h"
 #include "general/enumerator_private.hpp"
 #include "general/message.h"
 #include "general/mystring.h"
+#include "general/point_grid.hpp"
 
 /*
 Module types
@@ -119,8 +119,7 @@ struct Convert_finite_elements_data
 	cmzn_fieldcache_id source_fieldcache;
 	Element_refinement refinement;
 	FE_value tolerance;
-	struct Octree *octree;
-	struct LIST(Octree_object) *nearby_nodes;
+	PointGrid<cmzn_node_id> nodeGrid; // not accessed
 	cmzn_region_id destination_region;
 	cmzn_fieldmodule_id destination_fieldmodule;
 	cmzn_nodeset_id destination_nodeset;
@@ -151,8 +150,7 @@ struct Convert_finite_elements_data
 		source_fieldcache(cmzn_fieldmodule_create_fieldcache(source_fieldmodule)),
 		refinement(refinementIn),
 		tolerance(toleranceIn),
-		octree(CREATE(Octree)()),
-		nearby_nodes(CREATE(LIST(Octree_object))()),
+		nodeGrid(/*dimension*/3, toleranceIn),
 		destination_region(cmzn_region_access(destination_regionIn)),
 		destination_fieldmodule(cmzn_region_get_fieldmodule(destination_region)),
 		destination_nodeset(cmzn_fieldmodule_find_nodeset_by_field_domain_type(destination_fieldmodule, CMZN_FIELD_DOMAIN_TYPE_NODES)),
@@ -210,8 +208,6 @@ struct Convert_finite_elements_data
 		cmzn_nodetemplate_destroy(&this->nodetemplate);
 		if (this->temporary_values)
 			DEALLOCATE(this->temporary_values);
-		DESTROY(LIST(Octree_object))(&this->nearby_nodes);
-		DESTROY(Octree)(&this->octree);
 		if (this->destination_fields)
 		{
 			for (int i = 0; i < this->number_of_fields; i++)
@@ -231,25 +227,19 @@ struct Convert_finite_elements_data
 
 	int setFields(int sourceFieldsCount, cmzn_field_id *sourceFieldsIn);
 
+	/** @return  Non-accessed node within tolerance of coordinates, or 0 if none */
 	cmzn_node_id getNearestNode(FE_value *coordinates)
 	{
-		Octree_add_objects_near_coordinate_to_list(octree,
-			/*dimension*/3, coordinates, tolerance, nearby_nodes);
-		if (0 == NUMBER_IN_LIST(Octree_object)(nearby_nodes))
-		{
-			return NULL;
-		}
-		struct Octree_object *nearest_octree_object =
-			Octree_object_list_get_nearest(nearby_nodes, coordinates);
-		REMOVE_ALL_OBJECTS_FROM_LIST(Octree_object)(nearby_nodes);
-		return static_cast<cmzn_node_id>(Octree_object_get_user_data(nearest_octree_object));
+		cmzn_node_id node = 0;
+		double distance;
+		if (this->nodeGrid.findNearest(coordinates, this->tolerance, node, distance))
+			return node;
+		return 0;
 	}
 
-	int addNode(FE_value *coordinates, cmzn_node_id node)
+	void addNode(FE_value *coordinates, cmzn_node_id node)
 	{
-		Octree_object *octree_node = CREATE(Octree_object)(/*dimension*/3, coordinates);
-		Octree_object_set_user_data(octree_node, static_cast<void *>(node));
-		return Octree_add_object(octree, octree_node);
+		this->nodeGrid.add(coordinates, node);
 	}
 
 	int convertSubelement(cmzn_element_id element, int subelement_number);
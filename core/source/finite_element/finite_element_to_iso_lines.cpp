@@ -13,10 +13,12 @@ value over 2-D elements.
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <cfloat>
 #include <math.h>
 
 #include "opencmiss/zinc/status.h"
 #include "computed_field/computed_field.h"
+#include "finite_element/element_scalar_ranges.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_to_iso_lines.h"
 #include "finite_element/finite_element_to_graphics_object.h"
@@ -857,7 +859,7 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 	struct Computed_field *isoscalar_field, FE_value iso_value,
 	struct Computed_field *data_field,int number_of_segments_in_xi1_requested,
 	int number_of_segments_in_xi2_requested,struct FE_element *top_level_element,
-	struct Graphics_vertex_array *array)
+	struct Graphics_vertex_array *array, Element_scalar_ranges *scalar_ranges)
 {
 	enum Collapsed_element_type collapsed_element;
 	enum FE_element_shape_type shape_type1;
@@ -870,6 +872,18 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 	struct Contour_lines *contour_lines;
 	Triple *point,*points;
 
+	const int number_of_segments_in_xi[2] =
+		{ number_of_segments_in_xi1_requested, number_of_segments_in_xi2_requested };
+	double scalar_minimum, scalar_maximum;
+	if ((scalar_ranges) && (element) && scalar_ranges->getRange(get_FE_element_index(element),
+			2, number_of_segments_in_xi, scalar_minimum, scalar_maximum) &&
+		(!Element_scalar_ranges::rangeCrosses(scalar_minimum, scalar_maximum, iso_value)))
+	{
+		/* sampled scalars do not cross iso_value so there are no contours */
+		return 1;
+	}
+	scalar_minimum = DBL_MAX;
+	scalar_maximum = -DBL_MAX;
 	if (element && field_cache && (2==get_FE_element_dimension(element))&&
 		(0<number_of_segments_in_xi1_requested)&&
 		(0<number_of_segments_in_xi2_requested)&&coordinate_field&&
@@ -928,6 +942,10 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 						(CMZN_OK == cmzn_field_evaluate_real(isoscalar_field, field_cache, 1, scalar)) &&
 						((!data_field) || (CMZN_OK == cmzn_field_evaluate_real(data_field, field_cache, n_data_components, datum))))
 					{
+						if (*scalar < scalar_minimum)
+							scalar_minimum = *scalar;
+						if (*scalar > scalar_maximum)
+							scalar_maximum = *scalar;
 						(*point)[0]=GLfloat(coordinates[0]);
 						(*point)[1]=GLfloat(coordinates[1]);
 						(*point)[2]=GLfloat(coordinates[2]);
@@ -943,6 +961,11 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 					}
 				}
 			}
+			if (return_code && scalar_ranges)
+			{
+				scalar_ranges->setRange(get_FE_element_index(element), 2,
+					number_of_segments_in_xi, scalar_minimum, scalar_maximum);
+			}
 			/* perform contouring on the squares joining the points */
 			point=points;
 			scalar=scalars;
@@ -20,17 +20,22 @@ value over 2-D elements.
 #include "graphics/auxiliary_graphics_types.h"
 #include "graphics/graphics_object.h"
 
+class Element_scalar_ranges;
+
 /**
  * Fills <graphics_object> (of type g_POLYLINE_VERTEX_BUFFERS) with polyline contours of
  * <isoscalar_field> at <iso_value>.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param scalar_ranges  Optional cache of isoscalar ranges over elements. If
+ * supplied, the element is skipped without evaluating fields if its recorded
+ * range does not cross iso_value, otherwise its range is recorded.
  */
 int create_iso_lines_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *isoscalar_field, FE_value iso_value,
 	struct Computed_field *data_field,int number_of_segments_in_xi1_requested,
 	int number_of_segments_in_xi2_requested,struct FE_element *top_level_element,
-	struct Graphics_vertex_array *array);
+	struct Graphics_vertex_array *array, Element_scalar_ranges *scalar_ranges = 0);
 
 #endif /* !defined (FINITE_ELEMENT_TO_ISO_LINES_H) */
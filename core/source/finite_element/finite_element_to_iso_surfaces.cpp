@@ -8,14 +8,18 @@
 * This Source Code Form is subject to the terms of the Mozilla Public
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include <cfloat>
+#include <cmath>
 #include <list>
 #include <map>
+#include <vector>
 #include "opencmiss/zinc/differentialoperator.h"
 #include "opencmiss/zinc/fieldcache.h"
 #include "opencmiss/zinc/mesh.h"
 #include "opencmiss/zinc/status.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_wrappers.h"
+#include "finite_element/element_scalar_ranges.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_discretization.h"
 #include "finite_element/finite_element_to_graphics_object.h"
@@ -41,6 +45,85 @@ public:
 
 public:
 	double get_iso_value(int iso_value_number) const;
+
+	/** @return  True if any iso-value can be crossed by scalars in range */
+	bool range_crosses_iso_values(double minimum, double maximum) const
+	{
+		for (int v = 0; v < number_of_iso_values; v++)
+		{
+			if (Element_scalar_ranges::rangeCrosses(minimum, maximum, get_iso_value(v)))
+				return true;
+		}
+		return false;
+	}
+};
+
+/**
+ * Records vertices on element boundaries already added to a welded iso-surface
+ * so neighbouring elements can share them rather than adding coincident
+ * vertices, and accumulates their normals over all elements using them.
+ */
+struct Iso_surface_welder
+{
+	struct Boundary_vertex
+	{
+		FE_value coordinates[3];
+		FE_value normal_sum[3]; // area-weighted
+		unsigned int array_index;
+		int iso_value_number;
+	};
+
+	std::vector<Boundary_vertex> boundary_vertices;
+	// boundary vertex numbers ordered by first coordinate for range searches
+	std::multimap<FE_value, int> x_vertex_map;
+
+	void clear()
+	{
+		this->boundary_vertices.clear();
+		this->x_vertex_map.clear();
+	}
+
+	/**
+	 * @return  Number of boundary vertex on iso-value within tolerance of
+	 * coordinates on each axis, or -1 if none.
+	 */
+	int find_boundary_vertex(const FE_value *coordinates, int iso_value_number,
+		FE_value tolerance) const
+	{
+		std::multimap<FE_value, int>::const_iterator iter =
+			this->x_vertex_map.lower_bound(coordinates[0] - tolerance);
+		const std::multimap<FE_value, int>::const_iterator end_iter =
+			this->x_vertex_map.upper_bound(coordinates[0] + tolerance);
+		for (; iter != end_iter; ++iter)
+		{
+			const Boundary_vertex& vertex = this->boundary_vertices[iter->second];
+			if ((vertex.iso_value_number == iso_value_number) &&
+				(fabs(vertex.coordinates[1] - coordinates[1]) <= tolerance) &&
+				(fabs(vertex.coordinates[2] - coordinates[2]) <= tolerance))
+			{
+				return iter->second;
+			}
+		}
+		return -1;
+	}
+
+	/** @return  Number of new boundary vertex */
+	int add_boundary_vertex(const FE_value *coordinates, int iso_value_number,
+		unsigned int array_index)
+	{
+		Boundary_vertex vertex;
+		for (int c = 0; c < 3; ++c)
+		{
+			vertex.coordinates[c] = coordinates[c];
+			vertex.normal_sum[c] = 0.0;
+		}
+		vertex.array_index = array_index;
+		vertex.iso_value_number = iso_value_number;
+		const int number = static_cast<int>(this->boundary_vertices.size());
+		this->boundary_vertices.push_back(vertex);
+		this->x_vertex_map.insert(std::make_pair(coordinates[0], number));
+		return number;
+	}
 };
 
 /*
@@ -585,6 +668,7 @@ private:
 	const int number_of_data_components;
 	int plane_size;
 	double *plane_scalars;
+	double scalar_minimum, scalar_maximum; // over all sampled grid points
 	bool cube, polygon12, polygon13, polygon23, simplex12, simplex13, simplex23,
 		tetrahedron;
 	Iso_mesh_map mesh_map;
@@ -600,8 +684,23 @@ public:
 
 	int sweep();
 
+	/** Get range of scalar over grid points sampled by sweep */
+	void get_scalar_range(double& minimum, double& maximum) const
+	{
+		minimum = scalar_minimum;
+		maximum = scalar_maximum;
+	}
+
 	int fill_graphics(struct Graphics_vertex_array *array);
 
+	/**
+	 * Add iso-surfaces to array as a single triangle strip indexing vertices
+	 * shared with neighbouring elements through welder, with averaged normals.
+	 * Not for partial rebuilds.
+	 */
+	int fill_welded_graphics(struct Graphics_vertex_array *array,
+		Iso_surface_welder& welder);
+
 	void add_vertex_array_entries(struct Graphics_vertex_array *array,
 		enum Graphics_vertex_array_attribute_type type, int number_of_components,
 		const FE_value *values1, const FE_value *values2, const FE_value *values3);
@@ -644,7 +743,29 @@ private:
 		return (vertex);
 	}
 
-	bool reverse_winding();
+	/**
+	 * @param element_size  Optional address to receive the largest magnitude
+	 * of coordinate derivatives w.r.t. xi at the element centre, or 0 if not
+	 * evaluated.
+	 */
+	bool reverse_winding(FE_value *element_size = 0);
+
+	/** @return  True if xi is on a face of the element within tolerance */
+	bool is_boundary_xi(const FE_value *xi) const
+	{
+		const FE_value tolerance = 1.0E-6;
+		const FE_value limit = 1.0 - tolerance;
+		for (int i = 0; i < 3; ++i)
+		{
+			if ((xi[i] < tolerance) || (xi[i] > limit))
+				return true;
+		}
+		if (tetrahedron)
+			return (xi[0] + xi[1] + xi[2]) > limit;
+		return (simplex12 && ((xi[0] + xi[1]) > limit)) ||
+			(simplex13 && ((xi[0] + xi[2]) > limit)) ||
+			(simplex23 && ((xi[1] + xi[2]) > limit));
+	}
 
 	double get_scalar(const Point_index& p) const
 	{
@@ -739,6 +860,8 @@ Isosurface_builder::Isosurface_builder(FE_element *element, cmzn_fieldcache_id f
 		scalar_field(specification.scalar_field),
 		texture_coordinate_field(specification.texture_coordinate_field),
 		number_of_data_components(specification.number_of_data_components),
+		scalar_minimum(DBL_MAX),
+		scalar_maximum(-DBL_MAX),
 		last_mesh_number(-1)
 {
 	enum FE_element_shape_type shape_type1, shape_type2, shape_type3;
@@ -1688,6 +1811,10 @@ int Isosurface_builder::sweep()
 				{
 					scalar_value = static_cast<double>(scalar_FE_value);
 					set_scalar(i, j, k, scalar_value);
+					if (scalar_value < scalar_minimum)
+						scalar_minimum = scalar_value;
+					if (scalar_value > scalar_maximum)
+						scalar_maximum = scalar_value;
 
 					for (int v = 0; v < number_of_iso_values; v++)
 					{
@@ -1773,7 +1900,7 @@ int Isosurface_builder::sweep()
 	return (return_code);
 }
 
-bool Isosurface_builder::reverse_winding()
+bool Isosurface_builder::reverse_winding(FE_value *element_size)
 {
 	FE_value result[3], winding_coordinate_derivative1[3],
 		winding_coordinate_derivative2[3], winding_coordinate_derivative3[3];
@@ -1782,6 +1909,8 @@ bool Isosurface_builder::reverse_winding()
 
 	/* Determine whether xi forms a LH or RH coordinate system in this element */
 	bool reverse_winding = false;
+	if (element_size)
+		*element_size = 0.0;
 	FE_element_shape *shape = get_FE_element_shape(element);
 	number_in_xi[0] = 1;
 	number_in_xi[1] = 1;
@@ -1804,6 +1933,14 @@ bool Isosurface_builder::reverse_winding()
 			{
 				reverse_winding = true;
 			}
+			if (element_size)
+			{
+				const FE_value size1 = norm3(winding_coordinate_derivative1);
+				const FE_value size2 = norm3(winding_coordinate_derivative2);
+				const FE_value size3 = norm3(winding_coordinate_derivative3);
+				*element_size = (size1 > size2) ? ((size1 > size3) ? size1 : size3) :
+					((size2 > size3) ? size2 : size3);
+			}
 		}
 		DEALLOCATE(xi_points);
 		cmzn_differentialoperator_destroy(&d_dxi1);
@@ -2022,6 +2159,182 @@ int Isosurface_builder::fill_graphics(struct Graphics_vertex_array *array)
 	return (return_code);
 }
 
+/** Vertex of an element's iso-surfaces, possibly shared with other elements */
+struct Welded_vertex
+{
+	unsigned int array_index;
+	int boundary_number; // in welder, or -1 if interior
+	bool added; // true if added to array by this element
+	FE_value normal_sum[3]; // area-weighted over this element's triangles
+};
+
+int Isosurface_builder::fill_welded_graphics(struct Graphics_vertex_array *array,
+	Iso_surface_welder& welder)
+{
+	FE_value element_size = 0.0;
+	const bool reverse = reverse_winding(&element_size);
+	const FE_value tolerance = 1.0E-6*element_size;
+	const unsigned int vertex_start = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	std::map<const Iso_vertex *, Welded_vertex> vertex_map;
+	std::vector<const Iso_vertex *> added_vertices;
+	std::vector<Welded_vertex *> added_welded_vertices;
+	std::vector<unsigned int> strip;
+	unsigned int number_of_triangles = 0;
+	for (Iso_mesh_map_const_iterator mesh_iter = mesh_map.begin();
+		mesh_iter != mesh_map.end(); mesh_iter++)
+	{
+		const int iso_value_number = mesh_iter->first;
+		const Iso_triangle_list& triangle_list = mesh_iter->second->triangle_list;
+		for (Iso_triangle_list_const_iterator triangle_iter = triangle_list.begin();
+			triangle_iter != triangle_list.end(); triangle_iter++)
+		{
+			const Iso_triangle *triangle = *triangle_iter;
+			const Iso_vertex *v[3];
+			v[0] = triangle->v1;
+			v[1] = reverse ? triangle->v3 : triangle->v2;
+			v[2] = reverse ? triangle->v2 : triangle->v3;
+			// area-weighted facet normal
+			FE_value axis1[3], axis2[3], facet_normal[3];
+			for (int c = 0; c < 3; ++c)
+			{
+				axis1[c] = v[1]->coordinates[c] - v[0]->coordinates[c];
+				axis2[c] = v[2]->coordinates[c] - v[0]->coordinates[c];
+			}
+			cross_product_FE_value_vector3(axis1, axis2, facet_normal);
+			unsigned int indices[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				std::map<const Iso_vertex *, Welded_vertex>::iterator iter = vertex_map.find(v[i]);
+				if (iter == vertex_map.end())
+				{
+					Welded_vertex welded_vertex;
+					welded_vertex.boundary_number = -1;
+					welded_vertex.added = true;
+					for (int c = 0; c < 3; ++c)
+						welded_vertex.normal_sum[c] = 0.0;
+					const bool boundary = is_boundary_xi(v[i]->xi);
+					if (boundary)
+						welded_vertex.boundary_number = welder.find_boundary_vertex(
+							v[i]->coordinates, iso_value_number, tolerance);
+					if (welded_vertex.boundary_number >= 0)
+					{
+						welded_vertex.added = false;
+						welded_vertex.array_index =
+							welder.boundary_vertices[welded_vertex.boundary_number].array_index;
+					}
+					else
+					{
+						welded_vertex.array_index = vertex_start +
+							static_cast<unsigned int>(added_vertices.size());
+						if (boundary)
+							welded_vertex.boundary_number = welder.add_boundary_vertex(
+								v[i]->coordinates, iso_value_number, welded_vertex.array_index);
+						added_vertices.push_back(v[i]);
+					}
+					iter = vertex_map.insert(std::make_pair(v[i], welded_vertex)).first;
+					if (iter->second.added)
+						added_welded_vertices.push_back(&(iter->second));
+				}
+				for (int c = 0; c < 3; ++c)
+					iter->second.normal_sum[c] += facet_normal[c];
+				indices[i] = iter->second.array_index;
+			}
+			// join triangles into one strip with degenerate triangles, keeping
+			// each triangle at an even position to preserve its winding
+			if (!strip.empty())
+			{
+				const unsigned int last_index = strip.back();
+				strip.push_back(last_index);
+				if (0 == (strip.size() & 1))
+					strip.push_back(last_index);
+				strip.push_back(indices[0]);
+			}
+			strip.push_back(indices[0]);
+			strip.push_back(indices[1]);
+			strip.push_back(indices[2]);
+			++number_of_triangles;
+		}
+	}
+	if (0 == number_of_triangles)
+		return 1;
+	GLfloat float_values[3];
+	FE_value normal[3];
+	/* accumulate normals of vertices shared with earlier elements */
+	for (std::map<const Iso_vertex *, Welded_vertex>::iterator iter = vertex_map.begin();
+		iter != vertex_map.end(); ++iter)
+	{
+		Welded_vertex& welded_vertex = iter->second;
+		if (welded_vertex.boundary_number < 0)
+			continue;
+		Iso_surface_welder::Boundary_vertex& boundary_vertex =
+			welder.boundary_vertices[welded_vertex.boundary_number];
+		for (int c = 0; c < 3; ++c)
+		{
+			boundary_vertex.normal_sum[c] += welded_vertex.normal_sum[c];
+			welded_vertex.normal_sum[c] = boundary_vertex.normal_sum[c];
+		}
+		if (!welded_vertex.added)
+		{
+			for (int c = 0; c < 3; ++c)
+				normal[c] = welded_vertex.normal_sum[c];
+			normalize_FE_value3(normal);
+			CAST_TO_OTHER(float_values, normal, GLfloat, 3);
+			array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+				welded_vertex.array_index, 3, 1, float_values);
+		}
+	}
+	const unsigned int number_of_added_vertices = static_cast<unsigned int>(added_vertices.size());
+	for (unsigned int i = 0; i < number_of_added_vertices; ++i)
+	{
+		const Iso_vertex *vertex = added_vertices[i];
+		CAST_TO_OTHER(float_values, vertex->coordinates, GLfloat, 3);
+		array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION, 3, 1, float_values);
+		for (int c = 0; c < 3; ++c)
+			normal[c] = added_welded_vertices[i]->normal_sum[c];
+		normalize_FE_value3(normal);
+		CAST_TO_OTHER(float_values, normal, GLfloat, 3);
+		array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL, 3, 1, float_values);
+		if (0 != texture_coordinate_field)
+		{
+			CAST_TO_OTHER(float_values, vertex->texture_coordinates, GLfloat, 3);
+			array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_TEXTURE_COORDINATE_ZERO,
+				3, 1, float_values);
+		}
+		if (0 != data_field)
+		{
+			GLfloat *float_data = new GLfloat[number_of_data_components];
+			CAST_TO_OTHER(float_data, vertex->data, GLfloat, number_of_data_components);
+			array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+				number_of_data_components, 1, float_data);
+			delete[] float_data;
+		}
+	}
+	const DsLabelIndex index = get_FE_element_index(element);
+	array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+		1, 1, &index);
+	array->add_fast_search_id(index);
+	int modificationRequired = 0;
+	array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
+		1, 1, &modificationRequired);
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+		1, 1, &number_of_added_vertices);
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+		1, 1, &vertex_start);
+	int polygonType = (int)g_TRIANGLE;
+	array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POLYGON,
+		1, 1, &polygonType);
+	unsigned int number_of_xi2 = 3;
+	array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI1,
+		1, 1, &number_of_triangles);
+	array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI2,
+		1, 1, &number_of_xi2);
+	array->fill_element_strip(static_cast<unsigned int>(strip.size()), &(strip[0]));
+	return 1;
+}
+
 } // anonymous namespace
 
 /*
@@ -2114,10 +2427,27 @@ int Iso_surface_specification_destroy(
 	return (return_code);
 }
 
+struct Iso_surface_welder *Iso_surface_welder_create()
+{
+	return new Iso_surface_welder();
+}
+
+int Iso_surface_welder_destroy(struct Iso_surface_welder **welder_address)
+{
+	if (welder_address)
+	{
+		delete *welder_address;
+		*welder_address = 0;
+		return 1;
+	}
+	return 0;
+}
+
 int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
 	struct Graphics_vertex_array *array,
-	int *number_in_xi, struct Iso_surface_specification *specification)
+	int *number_in_xi, struct Iso_surface_specification *specification,
+	Element_scalar_ranges *scalar_ranges, struct Iso_surface_welder *welder)
 {
 	ENTER(create_iso_surfaces_from_FE_element);
 	int return_code = 0;
@@ -2138,12 +2468,37 @@ int create_iso_surfaces_from_FE_element(struct FE_element *element,
 		/* Vertices not available or should be repalced/expanded */
 		if (vertex_location < 0 || replaceRequired)
 		{
-			Isosurface_builder iso_builder(element, field_cache, mesh,
-				number_in_xi[0], number_in_xi[1], number_in_xi[2], *specification);
-			return_code = iso_builder.sweep();
-			if (return_code)
+			const DsLabelIndex element_index = get_FE_element_index(element);
+			double minimum, maximum;
+			if ((scalar_ranges) && scalar_ranges->getRange(element_index, 3, number_in_xi, minimum, maximum) &&
+				(!specification->range_crosses_iso_values(minimum, maximum)))
+			{
+				/* no iso-surfaces in element; only need to clear existing vertices */
+				return_code = 1;
+				if ((vertex_location >= 0) && (!welder))
+				{
+					Isosurface_builder iso_builder(element, field_cache, mesh,
+						number_in_xi[0], number_in_xi[1], number_in_xi[2], *specification);
+					return_code = iso_builder.fill_graphics(array);
+				}
+			}
+			else
 			{
-				return_code = iso_builder.fill_graphics(array);
+				Isosurface_builder iso_builder(element, field_cache, mesh,
+					number_in_xi[0], number_in_xi[1], number_in_xi[2], *specification);
+				return_code = iso_builder.sweep();
+				if (return_code)
+				{
+					if (scalar_ranges)
+					{
+						iso_builder.get_scalar_range(minimum, maximum);
+						scalar_ranges->setRange(element_index, 3, number_in_xi, minimum, maximum);
+					}
+					if (welder)
+						return_code = iso_builder.fill_welded_graphics(array, *welder);
+					else
+						return_code = iso_builder.fill_graphics(array);
+				}
 			}
 		}
 		else /* do not waste time calculating existing valid graphics */
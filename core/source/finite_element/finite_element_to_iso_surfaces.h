@@ -14,6 +14,8 @@
 #include "graphics/graphics_object.h"
 
 struct Iso_surface_specification;
+struct Iso_surface_welder;
+class Element_scalar_ranges;
 
 /***************************************************************************//**
  * Creates sharable specification of iso-surfaces are to be generated.
@@ -40,12 +42,35 @@ struct Iso_surface_specification *Iso_surface_specification_create(
 int Iso_surface_specification_destroy(
 	struct Iso_surface_specification **specification_address);
 
+/**
+ * Creates object recording iso-surface vertices on element boundaries so they
+ * can be shared by neighbouring elements. Use for one build of one graphics
+ * vertex array only.
+ */
+struct Iso_surface_welder *Iso_surface_welder_create();
+
+/**
+ * Destroys iso-surface welder. Clears pointer to object.
+ * @return  Non-zero on success.
+ */
+int Iso_surface_welder_destroy(struct Iso_surface_welder **welder_address);
+
 /***************************************************************************//**
  * Converts a 3-D element into an iso_surface as a GT_surface_vertex_buffer
+ * @param scalar_ranges  Optional cache of scalar ranges over elements. If
+ * supplied, elements whose recorded range crosses no iso-values are skipped
+ * without evaluating the scalar field, and ranges of swept elements are
+ * recorded.
+ * @param welder  Optional welder for sharing vertices with iso-surfaces of
+ * elements previously added to array. If supplied, the iso-surfaces are
+ * added as a triangle strip of indexed vertices with normals averaged over
+ * all triangles using them, for a g_SHADED_TEXMAP surface vertex buffer.
+ * Welded surfaces cannot be partially rebuilt.
  */
 int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
 	struct Graphics_vertex_array *array,
-	int *number_in_xi, struct Iso_surface_specification *specification);
+	int *number_in_xi, struct Iso_surface_specification *specification,
+	Element_scalar_ranges *scalar_ranges = 0, struct Iso_surface_welder *welder = 0);
 
 #endif /* !defined (FINITE_ELEMENT_TO_ISO_SURFACES_H) */
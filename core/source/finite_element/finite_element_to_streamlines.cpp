@@ -60,6 +60,59 @@ struct Streampoint
 	struct Streampoint *next;
 }; /* struct Streampoint */
 
+Streamline_buffers::Streamline_buffers() :
+	allocated_number_of_points(0),
+	points(0),
+	vectors(0),
+	normals(0),
+	data(0)
+{
+}
+
+Streamline_buffers::~Streamline_buffers()
+{
+	DEALLOCATE(this->points);
+	DEALLOCATE(this->vectors);
+	DEALLOCATE(this->normals);
+	DEALLOCATE(this->data);
+}
+
+bool Streamline_buffers::reserve(int number_of_points, bool has_data)
+{
+	int new_number_of_points = this->allocated_number_of_points;
+	if (number_of_points > new_number_of_points)
+	{
+		// grow geometrically so long streamlines are not repeatedly copied
+		new_number_of_points *= 2;
+		if (number_of_points > new_number_of_points)
+			new_number_of_points = number_of_points;
+		Triple *tmp_triples;
+		if (!REALLOCATE(tmp_triples, this->points, Triple, new_number_of_points))
+			return false;
+		this->points = tmp_triples;
+		if (!REALLOCATE(tmp_triples, this->vectors, Triple, new_number_of_points))
+			return false;
+		this->vectors = tmp_triples;
+		if (!REALLOCATE(tmp_triples, this->normals, Triple, new_number_of_points))
+			return false;
+		this->normals = tmp_triples;
+		if (this->data)
+		{
+			GLfloat *tmp_data;
+			if (!REALLOCATE(tmp_data, this->data, GLfloat, new_number_of_points))
+				return false;
+			this->data = tmp_data;
+		}
+		this->allocated_number_of_points = new_number_of_points;
+	}
+	if (has_data && (!this->data) && (0 < this->allocated_number_of_points))
+	{
+		if (!ALLOCATE(this->data, GLfloat, this->allocated_number_of_points))
+			return false;
+	}
+	return true;
+}
+
 /*
 Module functions
 ----------------
@@ -166,6 +219,89 @@ calculating the inverse of the Jacobian matrix <dxdxi> and multiplying.
 	return (return_code);
 } /* calculate_delta_xi */
 
+/**
+ * Changes to the element adjacent to <*element> across <face_number>, converting
+ * <xi> on that face to the adjacent element. If the coordinates there do not
+ * match <point> on the face of the original element, other permutations of the
+ * face xi are tried.
+ * If there is no adjacent element or coordinates can't be matched, clears
+ * <*keep_tracking> and leaves <*element> and <xi> unchanged.
+ * @param xi_face  Face xi as calculated by FE_element_shape_xi_increment.
+ * @param coordinate_length  Length scale of element for normalising error.
+ * @param coordinate_tolerance  Maximum normalised coordinate mismatch.
+ */
+static int change_to_adjacent_streamline_element(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field, struct FE_element **element,
+	FE_value *xi, int face_number, FE_value *xi_face, const FE_value *point,
+	FE_value coordinate_length, FE_value coordinate_tolerance, int *keep_tracking)
+{
+	const int element_dimension = get_FE_element_dimension(*element);
+	const int vector_dimension = Computed_field_get_number_of_components(coordinate_field);
+	struct FE_element *initial_element = *element;
+	const int initial_face_number = face_number;
+	FE_value initial_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	FE_value new_point[3] = { 0.0, 0.0, 0.0 };
+	int i;
+	for (i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+		initial_xi[i] = xi[i];
+	int return_code = FE_element_change_to_adjacent_element(element,
+		xi, (FE_value *)NULL, &face_number, xi_face, /*permutation*/0);
+	if (face_number == -1)
+	{
+		/* There is no adjacent element */
+		*keep_tracking = 0;
+		return return_code;
+	}
+	/* Check the new xi coordinates are correct for our
+		coordinate field and if not try rotating them */
+	FE_value coordinate_point_error = 0.0;
+	int number_of_permutations = 0;
+	int permutation = 0;
+	while (true)
+	{
+		return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xi)) &&
+			(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, new_point));
+		coordinate_point_error = 0.0;
+		for (i = 0 ; i < vector_dimension ; i++)
+		{
+			coordinate_point_error += (new_point[i] - point[i]) * (new_point[i] - point[i]);
+		}
+		coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
+		if (0 == permutation)
+		{
+			number_of_permutations =
+				FE_element_get_number_of_change_to_adjacent_element_permutations(
+					*element, xi, face_number);
+		}
+		/* We have already tried permutation 0 */
+		++permutation;
+		if ((permutation >= number_of_permutations) ||
+			(coordinate_point_error <= coordinate_tolerance))
+			break;
+		*element = initial_element;
+		face_number = initial_face_number;
+		for (i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+			xi[i] = initial_xi[i];
+		return_code = FE_element_change_to_adjacent_element(element,
+			xi, (FE_value *)NULL, &face_number, xi_face, permutation);
+	}
+	if (!get_FE_element_shape(*element))
+	{
+		display_message(ERROR_MESSAGE, "track_streamline_from_FE_element.  Missing shape.");
+		*keep_tracking = 0;
+	}
+	if (coordinate_point_error > coordinate_tolerance)
+	{
+		display_message(ERROR_MESSAGE,"track_streamline_from_FE_element.  "
+			"Coordinates don't match after changing elements.");
+		*keep_tracking = 0;
+		*element = initial_element;
+		for (i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+			xi[i] = initial_xi[i];
+	}
+	return return_code;
+}
+
 static int update_adaptive_imp_euler(cmzn_fieldcache_id field_cache,
 	struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
@@ -181,8 +317,7 @@ size control and the improved euler method.  The function updates the <total_ste
 If <reverse_track> is true, the reverse of vector field is tracked.
 ==============================================================================*/
 {
-	int element_dimension,face_number,i,initial_face_number,j,
-		number_of_permutations, permutation, return_code,vector_dimension, face_numberB = 0;
+	int element_dimension,face_number,i,j,return_code,vector_dimension, face_numberB = 0;
 	FE_value coordinate_length, coordinate_point_error, coordinate_point_vector, coordinate_tolerance,
 		deltaxi[MAXIMUM_ELEMENT_XI_DIMENSIONS],deltaxiA[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		deltaxiC[MAXIMUM_ELEMENT_XI_DIMENSIONS], deltaxiD[MAXIMUM_ELEMENT_XI_DIMENSIONS],
@@ -195,7 +330,6 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 		xiC[MAXIMUM_ELEMENT_XI_DIMENSIONS], xiD[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		xiE[MAXIMUM_ELEMENT_XI_DIMENSIONS], xiF[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-	struct FE_element *initial_element;
 
 	ENTER(update_adaptive_imp_euler);
 	/* clear coordinates in case fewer than 3 components */
@@ -514,78 +648,11 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 			*total_stepped += local_step_size;
 			if (face_number != -1)
 			{
-				initial_element = *element;
-				initial_face_number = face_number;
-				xiD[0]=xiF[0];
-				xiD[1]=xiF[1];
-				xiD[2]=xiF[2];
 				/* The last increment should have been the most accurate, if
 				it wants to change then change element if we can */
-				return_code = FE_element_change_to_adjacent_element(element,
-					xiF, (FE_value *)NULL, &face_number, xi_face, /*permutation*/0);
-				if (face_number == -1)
-				{
-					/* There is no adjacent element */
-					*keep_tracking = 0;
-				}
-				else
-				{
-					/* Check the new xi coordinates are correct for our
-					coordinate field and if not try rotating them */
-
-					return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xiF)) &&
-						(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-					coordinate_point_error = 0.0;
-					for (i = 0 ; i < vector_dimension ; i++)
-					{
-						coordinate_point_error += (point1[i] - point3[i]) * 
-							(point1[i] - point3[i]);
-					}
-					coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-					// this permutation loop is inefficient; should extract common adjacent element code
-					number_of_permutations =
-						FE_element_get_number_of_change_to_adjacent_element_permutations(
-							*element, xiF, face_number);
-					/* We have already tried permutation 0 */
-					permutation = 1;
-					while ((permutation < number_of_permutations) &&
-						(coordinate_point_error > coordinate_tolerance))
-					{
-						*element = initial_element;
-						face_number = initial_face_number;
-						xiF[0]=xiD[0];
-						xiF[1]=xiD[1];
-						xiF[2]=xiD[2];
-						return_code = FE_element_change_to_adjacent_element(element,
-							xiF, (FE_value *)NULL, &face_number, xi_face, permutation);
-						return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xiF)) &&
-							(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-						coordinate_point_error = 0.0;
-						for (i = 0 ; i < vector_dimension ; i++)
-						{
-							coordinate_point_error += (point1[i] - point3[i]) *
-								(point1[i] - point3[i]);
-						}
-						coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-						permutation++;
-					}
-					element_shape = get_FE_element_shape(*element);
-					if (!element_shape)
-					{
-						display_message(ERROR_MESSAGE, "track_streamline_from_FE_element.  Missing shape.");
-						*keep_tracking = 0;
-					}
-					if (coordinate_point_error > coordinate_tolerance)
-					{
-						display_message(ERROR_MESSAGE,"track_streamline_from_FE_element.  "
-							"Coordinates don't match after changing elements.");
-						*keep_tracking = 0;
-						*element = initial_element;
-						xiF[0]=xiD[0];
-						xiF[1]=xiD[1];
-						xiF[2]=xiD[2];
-					}
-				}
+				return_code = change_to_adjacent_streamline_element(field_cache,
+					coordinate_field, element, xiF, face_number, xi_face, point3,
+					coordinate_length, coordinate_tolerance, keep_tracking);
 			}
 			else
 			{
@@ -611,6 +678,277 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 	return (return_code);
 } /* update_adaptive_imp_euler */
 
+/**
+ * Evaluates the coordinates at <xi> in <element> and the rate of change of xi
+ * following the <stream_vector_field>, or its reverse if <reverse_track>.
+ * @param point  Array of size 3 to receive coordinates.
+ * @param dxdxi  Array of size 9 to receive coordinate derivatives w.r.t. xi.
+ * @param deltaxi  Array of size MAXIMUM_ELEMENT_XI_DIMENSIONS to receive the
+ * stream vector converted to xi space.
+ */
+static int evaluate_streamline_delta_xi(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field,
+	struct Computed_field *stream_vector_field, int reverse_track,
+	struct FE_element *element, int element_dimension, int vector_dimension,
+	const FE_value *xi, FE_value *point, FE_value *dxdxi, FE_value *deltaxi)
+{
+	FE_value vector[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	if (!((CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, element, element_dimension, xi)) &&
+		(CMZN_OK == cmzn_field_evaluate_real_with_derivatives(coordinate_field, field_cache,
+			vector_dimension, point, /*number_of_derivatives*/element_dimension, dxdxi)) &&
+		(CMZN_OK == cmzn_field_evaluate_real(stream_vector_field, field_cache,
+			MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS, vector))))
+		return 0;
+	if (reverse_track)
+	{
+		for (int i = 0 ; i < vector_dimension ; i++)
+		{
+			vector[i] = -vector[i];
+		}
+	}
+	return calculate_delta_xi(vector_dimension, vector, element_dimension, dxdxi, deltaxi);
+}
+
+/**
+ * Update the xi coordinates using the <stream_vector_field> by one step of the
+ * embedded 5(4) Runge-Kutta method of Dormand and Prince, integrating the
+ * stream vector converted to xi space. The step size is controlled by the
+ * difference between the 5th and embedded 4th order solutions; a rejected step
+ * is retried with a smaller step, and the size for the next step is predicted
+ * from the error of an accepted step.
+ * If the step leaves the element, the boundary is located on the continuous
+ * (dense output) extension of the step, only the fraction of the step to the
+ * boundary is taken, and tracking changes to the adjacent element across that
+ * face. The function updates the <total_stepped>, <point> and <step_size>.
+ * If <reverse_track> is true, the reverse of vector field is tracked.
+ */
+static int update_adaptive_dormand_prince(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field,
+	struct Computed_field *stream_vector_field, int reverse_track,
+	struct FE_element **element, FE_value *xi,
+	FE_value *point, FE_value *step_size,
+	FE_value *total_stepped, int *keep_tracking)
+{
+	/* Butcher tableau; the 5th order weights are the final row, so the last
+		stage is evaluated at the end of the step */
+	static const FE_value a[7][6] =
+	{
+		{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0 },
+		{ 19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0 },
+		{ 9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0, 0.0 },
+		{ 35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0 }
+	};
+	/* difference between 5th and 4th order weights */
+	static const FE_value e[7] =
+	{
+		71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0
+	};
+	/* coefficients of the continuous extension (Shampine) */
+	static const FE_value d[7] =
+	{
+		-12715105075.0/11282082432.0, 0.0, 87487479700.0/32700410799.0,
+		-10690763975.0/1880347072.0, 701980252875.0/199316789632.0,
+		-1453857185.0/822651844.0, 69997945.0/29380423.0
+	};
+	const FE_value tolerance = 1.0e-4;
+	const FE_value coordinate_tolerance = 1.0e-2;
+	FE_value coordinate_length, dxdxi[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		error = 0.0, fraction, increment_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		k[7][MAXIMUM_ELEMENT_XI_DIMENSIONS], local_step_size, magnitude,
+		point1[3] = { 0.0, 0.0, 0.0 }, point2[3] = { 0.0, 0.0, 0.0 },
+		stage_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS], xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		xi_new[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	int face_number, i, j, s;
+
+	FE_element_shape *element_shape = get_FE_element_shape(*element);
+	const int element_dimension = get_FE_element_shape_dimension(element_shape);
+	const int vector_dimension = Computed_field_get_number_of_components(coordinate_field);
+	int return_code = evaluate_streamline_delta_xi(field_cache, coordinate_field,
+		stream_vector_field, reverse_track, *element, element_dimension, vector_dimension,
+		xi, point1, dxdxi, k[0]);
+	if (!return_code)
+		return 0;
+	/* Get a length scale estimate */
+	coordinate_length = 0.0;
+	for (i = 0 ; i < vector_dimension * element_dimension ; i++)
+	{
+		coordinate_length += dxdxi[i] * dxdxi[i];
+	}
+	coordinate_length = sqrt(coordinate_length / (FE_value)element_dimension);
+	magnitude = 0.0;
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		magnitude += k[0][i] * k[0][i];
+	}
+	magnitude = sqrt(magnitude);
+	if (0.0 >= magnitude)
+	{
+		/* streamline is not going anywhere */
+		*keep_tracking = 0;
+		return 1;
+	}
+	local_step_size = *step_size;
+	if (local_step_size == 0.0)
+	{
+		/* This is the first step, set the step_size to make the
+			magnitude of the xi increment 0.1 */
+		local_step_size = 1.0e-1 / magnitude;
+	}
+	/* Limit the step to a little beyond where its tangent leaves the element
+		so stages are evaluated close to the element */
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		stage_xi[i] = xi[i];
+		increment_xi[i] = local_step_size * k[0][i];
+	}
+	return_code = FE_element_shape_xi_increment(element_shape, stage_xi, increment_xi,
+		&fraction, &face_number, xi_face);
+	if (return_code && (face_number != -1))
+	{
+		if (0.0 >= fraction)
+		{
+			/* On the boundary heading out of the element */
+			return change_to_adjacent_streamline_element(field_cache, coordinate_field,
+				element, xi, face_number, xi_face, point1, coordinate_length,
+				coordinate_tolerance, keep_tracking);
+		}
+		local_step_size *= (fraction + 0.01);
+	}
+	while (return_code)
+	{
+		for (s = 1 ; (s < 7) && return_code ; s++)
+		{
+			for (i = 0 ; i < element_dimension ; i++)
+			{
+				stage_xi[i] = xi[i];
+				for (j = 0 ; j < s ; j++)
+				{
+					stage_xi[i] += local_step_size * a[s][j] * k[j][i];
+				}
+			}
+			return_code = evaluate_streamline_delta_xi(field_cache, coordinate_field,
+				stream_vector_field, reverse_track, *element, element_dimension, vector_dimension,
+				stage_xi, point2, dxdxi, k[s]);
+		}
+		if (!return_code)
+			break;
+		/* last stage is at the 5th order solution */
+		error = 0.0;
+		for (i = 0 ; i < element_dimension ; i++)
+		{
+			xi_new[i] = stage_xi[i];
+			FE_value error_component = 0.0;
+			for (s = 0 ; s < 7 ; s++)
+			{
+				error_component += e[s] * k[s][i];
+			}
+			error_component *= local_step_size;
+			error += error_component * error_component;
+		}
+		error = sqrt(error);
+		if ((error <= tolerance) || (local_step_size * magnitude < 1.0e-6))
+			break;
+		local_step_size *= ((error > tolerance*1.0E+5) ? 0.1 : 0.9*pow(tolerance/error, 0.2));
+	}
+	if (!return_code)
+		return 0;
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		stage_xi[i] = xi[i];
+		increment_xi[i] = xi_new[i] - xi[i];
+	}
+	return_code = FE_element_shape_xi_increment(element_shape, stage_xi, increment_xi,
+		&fraction, &face_number, xi_face);
+	if (!return_code)
+		return 0;
+	if (face_number == -1)
+	{
+		*total_stepped += local_step_size;
+		for (i = 0 ; i < element_dimension ; i++)
+		{
+			xi[i] = xi_new[i];
+		}
+		point[0] = point2[0];
+		point[1] = point2[1];
+		point[2] = point2[2];
+		/* predict next step size from error, limiting growth */
+		*step_size = local_step_size * ((error < tolerance*1.0E-4) ? 5.0 : 0.9*pow(tolerance/error, 0.2));
+		return 1;
+	}
+	/* Step leaves the element: bisect the continuous extension of the step
+		xi(theta) = xi + theta*(r1 + (1 - theta)*(r2 + theta*(r3 + (1 - theta)*r4)))
+		for where it crosses the element boundary */
+	FE_value r[4][MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		r[0][i] = xi_new[i] - xi[i];
+		r[1][i] = local_step_size * k[0][i] - r[0][i];
+		r[2][i] = r[0][i] - local_step_size * k[6][i] - r[1][i];
+		r[3][i] = 0.0;
+		for (s = 0 ; s < 7 ; s++)
+		{
+			r[3][i] += d[s] * k[s][i];
+		}
+		r[3][i] *= local_step_size;
+	}
+	FE_value theta_inside = 0.0;
+	FE_value theta_outside = 1.0;
+	FE_value theta = 1.0;
+	for (int iteration = 0 ; iteration < 30 ; iteration++)
+	{
+		theta = 0.5*(theta_inside + theta_outside);
+		for (i = 0 ; i < element_dimension ; i++)
+		{
+			stage_xi[i] = xi[i];
+			increment_xi[i] = theta*(r[0][i] + (1.0 - theta)*(r[1][i] +
+				theta*(r[2][i] + (1.0 - theta)*r[3][i])));
+		}
+		return_code = FE_element_shape_xi_increment(element_shape, stage_xi, increment_xi,
+			&fraction, &face_number, xi_face);
+		if (!return_code)
+			return 0;
+		if (face_number == -1)
+			theta_inside = theta;
+		else
+			theta_outside = theta;
+	}
+	/* take the step to the boundary */
+	theta = theta_outside;
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		stage_xi[i] = xi[i];
+		increment_xi[i] = theta*(r[0][i] + (1.0 - theta)*(r[1][i] +
+			theta*(r[2][i] + (1.0 - theta)*r[3][i])));
+	}
+	return_code = FE_element_shape_xi_increment(element_shape, stage_xi, increment_xi,
+		&fraction, &face_number, xi_face);
+	if (!return_code)
+		return 0;
+	*total_stepped += theta * local_step_size;
+	*step_size = local_step_size;
+	for (i = 0 ; i < element_dimension ; i++)
+	{
+		xi[i] = stage_xi[i];
+	}
+	return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xi)) &&
+		(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point2));
+	if (!return_code)
+		return 0;
+	point[0] = point2[0];
+	point[1] = point2[1];
+	point[2] = point2[2];
+	if (face_number != -1)
+	{
+		return_code = change_to_adjacent_streamline_element(field_cache, coordinate_field,
+			element, xi, face_number, xi_face, point2, coordinate_length,
+			coordinate_tolerance, keep_tracking);
+	}
+	return return_code;
+}
+
 static int update_interactive_streampoint(FE_value *point_coordinates,
 	struct FE_element **element, cmzn_fieldcache_id field_cache,
 	struct Computed_field *coordinate_field, FE_value *xi, FE_value *translate)
@@ -693,28 +1031,29 @@ accurate if small), also ensuring that the element is updated.
 static int track_streamline_from_FE_element(struct FE_element **element,
 	FE_value *xi, cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,int *number_of_points,
-	Triple **stream_points,Triple **stream_vectors,Triple **stream_normals,
-	GLfloat **stream_data)
+	Streamline_buffers& buffers)
 /*******************************************************************************
 LAST MODIFIED : 23 June 2004
 
 DESCRIPTION :
 Tracks the stream following <stream_vector_field> starting in the <*element> at
 the supplied <xi> coordinates. The streamline is returned in the following
-dynamically allocated and reallocated arrays:
-<*stream_points> = points along the streamline;
-<*stream_vectors> = stream vectors at each point on the streamline;
-<*stream_normals> = unit normals to the vectors, appropriate to field tracked;
-<*stream_data> = streamline data along the streamlines according to colour_data_type
+arrays of <buffers>, which are grown as needed:
+points = points along the streamline;
+vectors = stream vectors at each point on the streamline;
+normals = unit normals to the vectors, appropriate to field tracked;
+data = streamline data along the streamlines according to colour_data_type
 and data_field.
 The <*element> and <xi> values are updated to where the stream is tracked to, so
 that tracking can be continued.
-On unsuccessful return the above arrays are deallocated.
+On unsuccessful return <*number_of_points> is zero.
 
 If <reverse_track> is true, the reverse of <stream_vector_field> is tracked, and
 the negative travel_scalar is recorded, if requested.
+The <integration_method> chooses the scheme used to step along the streamline.
 
 The <stream_vector_field> may have 3, 6 or 9 components, the first 3 components
 of which returns the vector along which the streamline is tracked. Additional
@@ -734,12 +1073,12 @@ following way:
 		previous_curl_component = 0.0,previous_total_stepped_A,
 		previous_total_stepped_B,sin_angle,step_size,stream_vector_values[9],
 		temp,total_stepped,vector[3],vector_magnitude;
-	GLfloat *stream_datum,*tmp_stream_data;
+	GLfloat *stream_datum;
 	int add_point,allocated_number_of_points,calculate_curl,element_dimension,
 		i,keep_tracking,number_of_coordinate_components,
 		number_of_stream_vector_components,return_code;
 	struct FE_element *previous_element_A = NULL, *previous_element_B = NULL;
-	Triple *stream_point,*stream_vector,*stream_normal,*tmp_triples = NULL;
+	Triple *stream_point,*stream_vector,*stream_normal;
 
 	ENTER(track_streamline_from_FE_element);
 	const bool hasData =
@@ -760,8 +1099,7 @@ following way:
 		(2==number_of_stream_vector_components)))&&
 		(0.0<length) && ((colour_data_type != CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD) ||
 		(0 == data_field) || (1 == cmzn_field_get_number_of_components(data_field))) &&
-		number_of_points&&stream_points&&stream_vectors&&stream_normals&&
-		((!hasData) || stream_data))
+		number_of_points)
 	{
 		/*	step_size of zero indicates first step */
 		step_size = 0;
@@ -774,21 +1112,14 @@ following way:
 		coordinates[0]=0.0;
 		coordinates[1]=0.0;
 		coordinates[2]=0.0;
-		*stream_points=(Triple *)NULL;
-		*stream_vectors=(Triple *)NULL;
-		*stream_normals=(Triple *)NULL;
-		*stream_data=0;
 		*number_of_points=0;
-		allocated_number_of_points=100;
-		if (ALLOCATE(*stream_points,Triple,allocated_number_of_points)&&
-			ALLOCATE(*stream_vectors,Triple,allocated_number_of_points)&&
-			ALLOCATE(*stream_normals,Triple,allocated_number_of_points)&&
-			((!hasData) || ALLOCATE(*stream_data, GLfloat, allocated_number_of_points)))
+		if (buffers.reserve(100, hasData))
 		{
-			stream_point= *stream_points;
-			stream_vector= *stream_vectors;
-			stream_normal= *stream_normals;
-			stream_datum= *stream_data;
+			allocated_number_of_points = buffers.allocated_number_of_points;
+			stream_point = buffers.points;
+			stream_vector = buffers.vectors;
+			stream_normal = buffers.normals;
+			stream_datum = buffers.data;
 			i=0;
 			add_point = 1;
 			keep_tracking = 1;
@@ -1207,9 +1538,18 @@ following way:
 							previous_total_stepped_A = total_stepped;
 							previous_element_B = previous_element_A;
 							previous_element_A = *element;
-							return_code=update_adaptive_imp_euler(field_cache,coordinate_field,
-								stream_vector_field,reverse_track,element,xi,
-								coordinates,&step_size,&total_stepped,&keep_tracking);
+							if (integration_method == CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_DORMAND_PRINCE)
+							{
+								return_code=update_adaptive_dormand_prince(field_cache,coordinate_field,
+									stream_vector_field,reverse_track,element,xi,
+									coordinates,&step_size,&total_stepped,&keep_tracking);
+							}
+							else
+							{
+								return_code=update_adaptive_imp_euler(field_cache,coordinate_field,
+									stream_vector_field,reverse_track,element,xi,
+									coordinates,&step_size,&total_stepped,&keep_tracking);
+							}
 							/* If we haven't gone anywhere and are changing back to the previous
 								element then we are stuck */
 							if (total_stepped == previous_total_stepped_B)
@@ -1237,73 +1577,22 @@ following way:
 						}
 					}
 				}
-				if (add_point||(i<allocated_number_of_points))
+				if (add_point)
 				{
-					if (add_point)
+					/* grow arrays for more points */
+					if (buffers.reserve(i + 1, hasData))
 					{
-						/* allocate 100 more spaces for points, normals and data */
-						allocated_number_of_points += 100;
+						allocated_number_of_points = buffers.allocated_number_of_points;
+						stream_point = buffers.points + i;
+						stream_vector = buffers.vectors + i;
+						stream_normal = buffers.normals + i;
+						stream_datum = (hasData) ? (buffers.data + i) : 0;
 					}
 					else
 					{
-						/* free unused space in arrays */
-						allocated_number_of_points = i;
-					}
-					if (allocated_number_of_points != 0)
-					{
-						if (REALLOCATE(tmp_triples,*stream_points,Triple,
-							allocated_number_of_points))
-						{
-							*stream_points = tmp_triples;
-							stream_point = (*stream_points) + i;
-						}
-						else
-						{
-							return_code = 0;
-						}
-						if (REALLOCATE(tmp_triples,*stream_vectors,Triple,
-							allocated_number_of_points))
-						{
-							*stream_vectors = tmp_triples;
-							stream_vector = (*stream_vectors) + i;
-						}
-						else
-						{
-							return_code = 0;
-						}
-						if (REALLOCATE(tmp_triples,*stream_normals,Triple,
-							allocated_number_of_points))
-						{
-							*stream_normals = tmp_triples;
-							stream_normal = (*stream_normals) + i;
-						}
-						else
-						{
-							return_code = 0;
-						}
-						if (hasData)
-						{
-							if (REALLOCATE(tmp_stream_data,*stream_data,GLfloat,
-								allocated_number_of_points))
-							{
-								*stream_data=tmp_stream_data;
-								stream_datum = (*stream_data) + i;
-							}
-							else
-							{
-								return_code=0;
-							}
-						}
-						if (!return_code)
-						{
-							display_message(ERROR_MESSAGE,
-								"track_streamline_from_FE_element.  Could not reallocate");
-							return_code=0;
-						}
-					}
-					else
-					{
-						return_code = 0;
+						display_message(ERROR_MESSAGE,
+							"track_streamline_from_FE_element.  Could not reallocate");
+						return_code=0;
 					}
 				}
 			}
@@ -1317,23 +1606,6 @@ following way:
 		}
 		if (!return_code)
 		{
-			/* free up any space allocated for the streamline */
-			if (*stream_points)
-			{
-				DEALLOCATE(*stream_points);
-			}
-			if (*stream_vectors)
-			{
-				DEALLOCATE(*stream_vectors);
-			}
-			if (*stream_normals)
-			{
-				DEALLOCATE(*stream_normals);
-			}
-			if (*stream_data)
-			{
-				DEALLOCATE(*stream_data);
-			}
 			*number_of_points=0;
 		}
 	}
@@ -1357,14 +1629,13 @@ int create_polyline_streamline_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,
-	struct Graphics_vertex_array *array)
+	struct Graphics_vertex_array *array, Streamline_buffers *buffers)
 {
-	GLfloat *stream_data;
 	int element_dimension,number_of_stream_points,number_of_coordinate_components,
 		number_of_stream_vector_components, return_code = 1;
-	Triple *stream_points,*stream_normals,*stream_vectors;
 
 	if (stream_vector_field)
 	{
@@ -1382,11 +1653,14 @@ int create_polyline_streamline_FE_element_vertex_array(
 			(2==number_of_stream_vector_components)))&&
 			(0.0<length) && array)
 		{
+			const bool hasData =
+				(colour_data_type != CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD) || (data_field);
+			Streamline_buffers local_buffers;
+			Streamline_buffers& stream_buffers = (buffers) ? *buffers : local_buffers;
 			/* track points and normals on streamline, and data if requested */
 			if (track_streamline_from_FE_element(&element,start_xi,
 				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
-					&stream_vectors,&stream_normals,&stream_data))
+				integration_method,colour_data_type,data_field,&number_of_stream_points,stream_buffers))
 			{
 				if (0<number_of_stream_points)
 				{
@@ -1395,20 +1669,16 @@ int create_polyline_streamline_FE_element_vertex_array(
 						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
 
 					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-						3, number_of_stream_points, &(stream_points[0][0]));
-					if (stream_data)
+						3, number_of_stream_points, &(stream_buffers.points[0][0]));
+					if (hasData)
 						array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-							1, number_of_stream_points, stream_data);
+							1, number_of_stream_points, stream_buffers.data);
 					array->add_unsigned_integer_attribute(
 						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
 						1, 1, &total_number_of_vertices);
 					array->add_unsigned_integer_attribute(
 						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
 						1, 1, &vertex_start);
-					DEALLOCATE(stream_points);
-					DEALLOCATE(stream_data);
-					DEALLOCATE(stream_vectors);
-					DEALLOCATE(stream_normals);
 				}
 				else
 				{
@@ -1437,11 +1707,12 @@ int create_surface_streamribbon_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track, FE_value length,
+	enum cmzn_graphics_streamlines_integration_method integration_method,
 	enum cmzn_graphicslineattributes_shape_type line_shape, int circleDivisions,
 	FE_value *line_base_size, FE_value *line_scale_factors,
 	struct Computed_field *line_orientation_scale_field,
 	enum cmzn_graphics_streamlines_colour_data_type colour_data_type, struct Computed_field *data_field,
-	struct Graphics_vertex_array *array)
+	struct Graphics_vertex_array *array, Streamline_buffers *buffers)
 {
 	double cosw,magnitude,sinw;
 	GLfloat *stream_data,stream_datum= 0.0;
@@ -1475,12 +1746,17 @@ int create_surface_streamribbon_FE_element_vertex_array(
 			const FE_value width = line_base_size[0];
 			const FE_value thickness = line_base_size[1];
 
+			Streamline_buffers local_buffers;
+			Streamline_buffers& stream_buffers = (buffers) ? *buffers : local_buffers;
 			/* track points and normals on streamline, and data if requested */
 			if (track_streamline_from_FE_element(&element,start_xi,
 				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
-				&stream_vectors,&stream_normals,&stream_data))
+				integration_method,colour_data_type,data_field,&number_of_stream_points,stream_buffers))
 			{
+				stream_points = stream_buffers.points;
+				stream_vectors = stream_buffers.vectors;
+				stream_normals = stream_buffers.normals;
+				stream_data = (hasData) ? stream_buffers.data : 0;
 				if (0<number_of_stream_points)
 				{
 					switch (line_shape)
@@ -1780,11 +2056,6 @@ int create_surface_streamribbon_FE_element_vertex_array(
 						1, 1, &number_of_xi2);
 					array->fill_element_index(vertex_start, number_of_xi1, number_of_xi2,
 						ARRAY_SHAPE_TYPE_UNSPECIFIED);
-					/* no longer need original streamline */
-					DEALLOCATE(stream_points);
-					DEALLOCATE(stream_vectors);
-					DEALLOCATE(stream_normals);
-					DEALLOCATE(stream_data);
 				}
 				else
 				{
@@ -19,6 +19,7 @@ Functions for calculating streamlines in finite elements.
 #include "general/list.h"
 #include "general/manager.h"
 #include "general/object.h"
+#include "graphics/auxiliary_graphics_types.h"
 
 /*
 Global types
@@ -52,6 +53,34 @@ Data for converting a 3-D element into an array of particles.
 	Triple **pointlist;
 }; /* struct Element_to_particle_data */
 
+/**
+ * Arrays receiving the points, vectors, normals and data along a streamline.
+ * Reuse for tracing from many seed points so arrays are only reallocated when
+ * a longer streamline is traced, and then grown geometrically.
+ */
+class Streamline_buffers
+{
+public:
+	int allocated_number_of_points;
+	Triple *points, *vectors, *normals;
+	GLfloat *data;
+
+	Streamline_buffers();
+
+	~Streamline_buffers();
+
+	/**
+	 * Ensure arrays hold at least number_of_points, preserving existing values.
+	 * @param has_data  True if data array is needed.
+	 * @return  True on success, false if could not allocate.
+	 */
+	bool reserve(int number_of_points, bool has_data);
+
+private:
+	Streamline_buffers(const Streamline_buffers&); // not implemented
+	Streamline_buffers& operator=(const Streamline_buffers&); // not implemented
+};
+
 /*
 Global functions
 ----------------
@@ -65,14 +94,18 @@ Global functions
  * stream vector is tracked, and the travel_scalar is made negative.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param integration_method  Scheme for integrating streamline path.
+ * @param buffers  Optional buffers to trace streamline into, reused between
+ * calls. If not supplied, temporary buffers are allocated.
  */
 int create_polyline_streamline_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,
-	struct Graphics_vertex_array *array);
+	struct Graphics_vertex_array *array, Streamline_buffers *buffers = 0);
 
 /**
  * Fills the array with coordinates of the streamline from the <coordinate_field> following
@@ -81,20 +114,24 @@ int create_polyline_streamline_FE_element_vertex_array(
  * stream vector is tracked, and the travel_scalar is made negative.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param integration_method  Scheme for integrating streamline path.
  * @param line_shape  LINE, RIBBON, CIRCLE_EXTRUSION or SQUARE_EXTRUSION.
  * @param line_base_size  width and thickness of line, use depends on shape.
  * @param line_scale_factors  Ignored. For future use.
  * @param line_orientation_scale_field  Ignored. For future use.
+ * @param buffers  Optional buffers to trace streamline into, reused between
+ * calls. If not supplied, temporary buffers are allocated.
  */
 int create_surface_streamribbon_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track, FE_value length,
+	enum cmzn_graphics_streamlines_integration_method integration_method,
 	enum cmzn_graphicslineattributes_shape_type line_shape, int circleDivisions,
 	FE_value *line_base_size, FE_value *line_scale_factors,
 	struct Computed_field *line_orientation_scale_field,
 	enum cmzn_graphics_streamlines_colour_data_type colour_data_type, struct Computed_field *data_field,
-	struct Graphics_vertex_array *array);
+	struct Graphics_vertex_array *array, Streamline_buffers *buffers = 0);
 
 int add_flow_particle(struct Streampoint **list,FE_value *xi,
 	struct FE_element *element,Triple **pointlist,int index,
@@ -516,6 +516,147 @@ public:
 		return true;
 	}
 
+	/** @return  Number of bits set in 32-bit value */
+	static IndexType countBits(unsigned int value)
+	{
+		// parallel bit count; portable alternative to compiler popcount builtins
+		value = value - ((value >> 1) & 0x55555555);
+		value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+		return static_cast<IndexType>((((value + (value >> 4)) & 0x0F0F0F0F)*0x01010101) >> 24);
+	}
+
+	/** @return  Number of true values in array */
+	IndexType getTrueCount() const
+	{
+		IndexType trueCount = 0;
+		for (IndexType blockIndex = 0; blockIndex < this->blockCount; ++blockIndex)
+		{
+			const unsigned int *block = this->blocks[blockIndex];
+			if (block)
+				for (IndexType i = 0; i < this->blockLength; ++i)
+					trueCount += countBits(block[i]);
+		}
+		return trueCount;
+	}
+
+	/**
+	 * Set values to true where they are true in other array, i.e. logical OR.
+	 * Works on 32 values at a time, skipping blocks absent from other array.
+	 * @param changeCount  Incremented by the number of values changed to true.
+	 * @return  True on success, false if failed to allocate memory.
+	 */
+	bool unionWith(const bool_array& other, IndexType& changeCount)
+	{
+		const IndexType otherBlockLength = other.getBlockLength();
+		for (IndexType otherBlockIndex = 0; otherBlockIndex < other.blockCount; ++otherBlockIndex)
+		{
+			const unsigned int *otherBlock = other.blocks[otherBlockIndex];
+			if (!otherBlock)
+				continue;
+			if (otherBlockLength == this->blockLength)
+			{
+				unsigned int *block = this->getOrCreateBlock(otherBlockIndex);
+				if (!block)
+					return false;
+				for (IndexType i = 0; i < otherBlockLength; ++i)
+				{
+					const unsigned int addValue = otherBlock[i] & ~block[i];
+					if (addValue)
+					{
+						changeCount += countBits(addValue);
+						block[i] |= addValue;
+					}
+				}
+			}
+			else
+			{
+				const IndexType intIndexStart = otherBlockIndex*otherBlockLength;
+				for (IndexType i = 0; i < otherBlockLength; ++i)
+				{
+					unsigned int intValue = 0;
+					this->getValue(intIndexStart + i, intValue);
+					const unsigned int addValue = otherBlock[i] & ~intValue;
+					if (addValue)
+					{
+						if (!this->setValue(intIndexStart + i, intValue | addValue))
+							return false;
+						changeCount += countBits(addValue);
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Set values to false where they are false in other array, i.e. logical
+	 * AND. Works on 32 values at a time.
+	 * @param changeCount  Incremented by the number of values changed to false.
+	 */
+	void intersectWith(const bool_array& other, IndexType& changeCount)
+	{
+		const bool sameBlockLength = (other.getBlockLength() == this->blockLength);
+		for (IndexType blockIndex = 0; blockIndex < this->blockCount; ++blockIndex)
+		{
+			unsigned int *block = this->blocks[blockIndex];
+			if (!block)
+				continue;
+			const unsigned int *otherBlock = (sameBlockLength && (blockIndex < other.blockCount)) ?
+				other.blocks[blockIndex] : 0;
+			const IndexType intIndexStart = blockIndex*this->blockLength;
+			for (IndexType i = 0; i < this->blockLength; ++i)
+			{
+				unsigned int otherValue = 0;
+				if (otherBlock)
+					otherValue = otherBlock[i];
+				else if (!sameBlockLength)
+					other.getValue(intIndexStart + i, otherValue);
+				const unsigned int removeValue = block[i] & ~otherValue;
+				if (removeValue)
+				{
+					changeCount += countBits(removeValue);
+					block[i] &= ~removeValue;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Set values to false where they are true in other array, i.e. logical
+	 * AND NOT. Works on 32 values at a time, skipping blocks absent from
+	 * either array.
+	 * @param changeCount  Incremented by the number of values changed to false.
+	 */
+	void subtract(const bool_array& other, IndexType& changeCount)
+	{
+		const bool sameBlockLength = (other.getBlockLength() == this->blockLength);
+		for (IndexType blockIndex = 0; blockIndex < this->blockCount; ++blockIndex)
+		{
+			unsigned int *block = this->blocks[blockIndex];
+			if (!block)
+				continue;
+			const unsigned int *otherBlock = (sameBlockLength && (blockIndex < other.blockCount)) ?
+				other.blocks[blockIndex] : 0;
+			if (sameBlockLength && (!otherBlock))
+				continue;
+			const IndexType intIndexStart = blockIndex*this->blockLength;
+			for (IndexType i = 0; i < this->blockLength; ++i)
+			{
+				unsigned int otherValue = 0;
+				if (otherBlock)
+					otherValue = otherBlock[i];
+				else
+					other.getValue(intIndexStart + i, otherValue);
+				const unsigned int removeValue = block[i] & otherValue;
+				if (removeValue)
+				{
+					changeCount += countBits(removeValue);
+					block[i] &= ~removeValue;
+				}
+			}
+		}
+	}
+
 	/**
 	 * @return  true if all bits in bool array are either all on or all off over
 	 * all consecutive subarrays of the given size, otherwise false. Used to
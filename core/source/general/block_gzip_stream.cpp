@@ -0,0 +1,134 @@
+/**
+ * FILE : block_gzip_stream.cpp
+ *
+ * Output stream buffer writing gzip format as a series of independently
+ * compressed members, compressed in parallel on worker threads.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <system_error>
+#include <thread>
+#include <zlib.h>
+#include "general/block_gzip_stream.hpp"
+
+void BlockGzipStreambuf::compressBlock(Block *block, int compressionLevel)
+{
+	block->success = false;
+	z_stream stream;
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+	// window bits + 16 writes a gzip header and trailer
+	if (Z_OK != deflateInit2(&stream, compressionLevel, Z_DEFLATED, MAX_WBITS + 16,
+		/*memLevel*/8, Z_DEFAULT_STRATEGY))
+		return;
+	const uLong inputLength = static_cast<uLong>(block->input.size());
+	block->output.resize(deflateBound(&stream, inputLength));
+	stream.next_in = (inputLength > 0) ? reinterpret_cast<Bytef *>(&block->input[0]) : Z_NULL;
+	stream.avail_in = static_cast<uInt>(inputLength);
+	stream.next_out = reinterpret_cast<Bytef *>(&block->output[0]);
+	stream.avail_out = static_cast<uInt>(block->output.size());
+	if (Z_STREAM_END == deflate(&stream, Z_FINISH))
+	{
+		block->output.resize(stream.total_out);
+		block->success = true;
+	}
+	deflateEnd(&stream);
+	std::vector<char>().swap(block->input);
+}
+
+BlockGzipStreambuf::BlockGzipStreambuf(std::ostream& outputIn, int compressionLevelIn) :
+	output(outputIn),
+	compressionLevel(((compressionLevelIn >= 0) && (compressionLevelIn <= 9)) ?
+		compressionLevelIn : Z_DEFAULT_COMPRESSION),
+	maximumPendingBlocksCount(2*std::thread::hardware_concurrency()),
+	buffer(blockSize),
+	blockSubmitted(false),
+	success(true),
+	closed(false)
+{
+	if (this->maximumPendingBlocksCount < 2)
+		this->maximumPendingBlocksCount = 2;
+	this->setp(&this->buffer[0], &this->buffer[0] + this->buffer.size());
+}
+
+BlockGzipStreambuf::~BlockGzipStreambuf()
+{
+	this->close();
+}
+
+void BlockGzipStreambuf::submitBuffer()
+{
+	Block *block = new Block();
+	block->input.assign(this->pbase(), this->pptr());
+	this->setp(&this->buffer[0], &this->buffer[0] + this->buffer.size());
+	if (this->pendingBlocks.size() >= this->maximumPendingBlocksCount)
+		this->writeFirstPendingBlock();
+	this->pendingBlocks.push_back(block);
+	try
+	{
+		this->pendingResults.push_back(std::async(std::launch::async,
+			BlockGzipStreambuf::compressBlock, block, this->compressionLevel));
+	}
+	catch (const std::system_error&)
+	{
+		// could not start thread: compress on this thread
+		BlockGzipStreambuf::compressBlock(block, this->compressionLevel);
+		this->pendingResults.push_back(std::future<void>());
+	}
+	this->blockSubmitted = true;
+}
+
+void BlockGzipStreambuf::writeFirstPendingBlock()
+{
+	Block *block = this->pendingBlocks.front();
+	if (this->pendingResults.front().valid())
+		this->pendingResults.front().get();
+	if (block->success)
+		this->output.write(block->output.data(), static_cast<std::streamsize>(block->output.size()));
+	else
+		this->success = false;
+	delete block;
+	this->pendingBlocks.pop_front();
+	this->pendingResults.pop_front();
+}
+
+BlockGzipStreambuf::int_type BlockGzipStreambuf::overflow(int_type c)
+{
+	if (this->closed)
+		return traits_type::eof();
+	this->submitBuffer();
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+	{
+		*this->pptr() = traits_type::to_char_type(c);
+		this->pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+int BlockGzipStreambuf::sync()
+{
+	// blocks are only ended when full or closed
+	return 0;
+}
+
+bool BlockGzipStreambuf::close()
+{
+	if (!this->closed)
+	{
+		if ((this->pptr() > this->pbase()) || (!this->blockSubmitted))
+			this->submitBuffer();
+		while (!this->pendingBlocks.empty())
+			this->writeFirstPendingBlock();
+		this->output.flush();
+		if (!this->output)
+			this->success = false;
+		this->closed = true;
+		this->setp(0, 0);
+	}
+	return this->success;
+}
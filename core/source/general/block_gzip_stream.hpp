@@ -0,0 +1,90 @@
+/**
+ * FILE : block_gzip_stream.hpp
+ *
+ * Output stream buffer writing gzip format as a series of independently
+ * compressed members, compressed in parallel on worker threads.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (BLOCK_GZIP_STREAM_HPP)
+#define BLOCK_GZIP_STREAM_HPP
+
+#include <deque>
+#include <future>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * Compresses output in fixed size blocks, each written as a complete gzip
+ * member so blocks compress independently on worker threads while the caller
+ * continues writing. Concatenated members are a valid gzip file readable by
+ * gzip and zlib's gzread. Compressed blocks are written to the output stream
+ * in order. Flushing does not end a block, so writing std::endl does not
+ * degrade compression; call close() to finish.
+ * Only the compression runs on worker threads; the caller must write from one
+ * thread.
+ */
+class BlockGzipStreambuf : public std::streambuf
+{
+	struct Block
+	{
+		std::vector<char> input;
+		std::string output;
+		bool success;
+	};
+
+	std::ostream& output;
+	const int compressionLevel;
+	size_t maximumPendingBlocksCount;
+	std::vector<char> buffer;
+	// blocks being compressed, in output order
+	std::deque<Block *> pendingBlocks;
+	std::deque<std::future<void> > pendingResults;
+	bool blockSubmitted;
+	bool success;
+	bool closed;
+
+	static void compressBlock(Block *block, int compressionLevel);
+
+	void submitBuffer();
+
+	void writeFirstPendingBlock();
+
+protected:
+
+	virtual int_type overflow(int_type c);
+
+	virtual int sync();
+
+public:
+
+	/** Uncompressed size of each gzip member */
+	static const size_t blockSize = 1048576;
+
+	/**
+	 * @param outputIn  Stream to write compressed data to, opened in binary
+	 * mode. Must exist until closed.
+	 * @param compressionLevelIn  zlib compression level from 0 to 9, or -1
+	 * for the default.
+	 */
+	BlockGzipStreambuf(std::ostream& outputIn, int compressionLevelIn = -1);
+
+	/** Closes if not already closed */
+	virtual ~BlockGzipStreambuf();
+
+	/**
+	 * Compress remaining data and write all blocks to the output stream. A file
+	 * with no data is written as one empty gzip member.
+	 * @return  True on success, false if any block failed to compress or the
+	 * output stream is in error.
+	 */
+	bool close();
+};
+
+#endif /* !defined (BLOCK_GZIP_STREAM_HPP) */
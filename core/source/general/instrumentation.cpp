@@ -0,0 +1,80 @@
+/**
+ * FILE : instrumentation.cpp
+ *
+ * Optional counters, timers and trace spans on hot evaluation, graphics and
+ * I/O paths.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "general/instrumentation.hpp"
+
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+
+#include <cstdio>
+#include <fstream>
+#include "opencmiss/zinc/status.h"
+#include "general/message.h"
+
+InstrumentationCounters instrumentationCounters;
+
+InstrumentationTrace instrumentationTrace;
+
+unsigned long long Instrumentation_get_file_size(const char *fileName)
+{
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file)
+		return 0;
+	const std::streamoff size = file.tellg();
+	return (size > 0) ? static_cast<unsigned long long>(size) : 0;
+}
+
+int InstrumentationTrace::begin(const char *fileNameIn)
+{
+	if (this->active)
+		return CMZN_ERROR_IN_USE;
+	this->fileName = fileNameIn;
+	this->events.clear();
+	this->startTime = std::chrono::steady_clock::now();
+	this->active = true;
+	return CMZN_OK;
+}
+
+int InstrumentationTrace::end()
+{
+	if (!this->active)
+		return CMZN_ERROR_NOT_FOUND;
+	this->active = false;
+	FILE *file = fopen(this->fileName.c_str(), "w");
+	if (!file)
+	{
+		display_message(ERROR_MESSAGE, "InstrumentationTrace::end.  Could not open file %s",
+			this->fileName.c_str());
+		this->events.clear();
+		return CMZN_ERROR_GENERAL;
+	}
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	const size_t eventsCount = this->events.size();
+	for (size_t i = 0; i < eventsCount; ++i)
+	{
+		const Event& event = this->events[i];
+		fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}",
+			(i > 0) ? "," : "", event.name, event.category, event.beginTime, event.duration);
+	}
+	fprintf(file, "\n]}\n");
+	const bool success = (0 == ferror(file));
+	fclose(file);
+	this->events.clear();
+	if (!success)
+	{
+		display_message(ERROR_MESSAGE, "InstrumentationTrace::end.  Failed to write file %s",
+			this->fileName.c_str());
+		return CMZN_ERROR_GENERAL;
+	}
+	return CMZN_OK;
+}
+
+#endif // defined (ZINC_BUILD_INSTRUMENTATION)
@@ -0,0 +1,194 @@
+/**
+ * FILE : instrumentation.hpp
+ *
+ * Optional counters, timers and trace spans on hot evaluation, graphics and
+ * I/O paths. Only compiled in with the ZINC_BUILD_INSTRUMENTATION build option;
+ * otherwise the ZINC_INSTRUMENT macros expand to nothing.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (INSTRUMENTATION_HPP)
+#define INSTRUMENTATION_HPP
+
+#include "opencmiss/zinc/zincconfigure.h"
+
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Library-wide statistics. Like the rest of the library these are not
+ * thread safe; they are accumulated over all contexts in the process.
+ */
+struct InstrumentationCounters
+{
+	/* calls to evaluate any field, and those satisfied from the value cache */
+	unsigned long long fieldEvaluations;
+	unsigned long long fieldEvaluationCacheHits;
+	/* finite element field values per element reused or calculated */
+	unsigned long long elementFieldValuesCacheHits;
+	unsigned long long elementFieldValuesCacheMisses;
+	/* element xi searches and Newton iterations performed in them */
+	unsigned long long findXiSearches;
+	unsigned long long findXiIterations;
+	/* graphics object builds and total build time in seconds */
+	unsigned long long graphicsBuilds;
+	double graphicsBuildTime;
+	/* bytes and time in seconds reading and writing regions */
+	unsigned long long streamReadBytes;
+	double streamReadTime;
+	unsigned long long streamWriteBytes;
+	double streamWriteTime;
+
+	InstrumentationCounters()
+	{
+		this->reset();
+	}
+
+	void reset()
+	{
+		this->fieldEvaluations = 0;
+		this->fieldEvaluationCacheHits = 0;
+		this->elementFieldValuesCacheHits = 0;
+		this->elementFieldValuesCacheMisses = 0;
+		this->findXiSearches = 0;
+		this->findXiIterations = 0;
+		this->graphicsBuilds = 0;
+		this->graphicsBuildTime = 0.0;
+		this->streamReadBytes = 0;
+		this->streamReadTime = 0.0;
+		this->streamWriteBytes = 0;
+		this->streamWriteTime = 0.0;
+	}
+};
+
+extern InstrumentationCounters instrumentationCounters;
+
+/** Adds the wall clock time in seconds for which it is in scope to a total */
+class InstrumentationTimer
+{
+	double& totalTime;
+	std::chrono::steady_clock::time_point startTime;
+
+public:
+	explicit InstrumentationTimer(double& totalTimeIn) :
+		totalTime(totalTimeIn),
+		startTime(std::chrono::steady_clock::now())
+	{
+	}
+
+	~InstrumentationTimer()
+	{
+		this->totalTime += std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - this->startTime).count();
+	}
+};
+
+/** @return  Size of file in bytes, or 0 if it cannot be opened */
+unsigned long long Instrumentation_get_file_size(const char *fileName);
+
+/**
+ * Records timed spans of library phases while active, for writing to a file
+ * in Chrome trace event format. Spans are complete events on a single
+ * thread, so nesting follows from their times.
+ */
+class InstrumentationTrace
+{
+	struct Event
+	{
+		const char *name;
+		const char *category;
+		double beginTime; // microseconds since trace began
+		double duration; // microseconds
+	};
+
+	std::vector<Event> events;
+	std::string fileName;
+	std::chrono::steady_clock::time_point startTime;
+	bool active;
+
+public:
+	InstrumentationTrace() :
+		active(false)
+	{
+	}
+
+	bool isActive() const
+	{
+		return this->active;
+	}
+
+	/** @return  Microseconds since trace began */
+	double getTime() const
+	{
+		return std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - this->startTime).count();
+	}
+
+	/** @param name, category  Static strings not needing JSON escapes */
+	void addEvent(const char *name, const char *category, double beginTime, double duration)
+	{
+		Event event = { name, category, beginTime, duration };
+		this->events.push_back(event);
+	}
+
+	/**
+	 * Start recording spans, to be written to file on end.
+	 * @return  CMZN_OK on success, CMZN_ERROR_IN_USE if already active.
+	 */
+	int begin(const char *fileNameIn);
+
+	/**
+	 * Stop recording spans and write them to the file.
+	 * @return  CMZN_OK on success, CMZN_ERROR_NOT_FOUND if not active,
+	 * CMZN_ERROR_GENERAL if file could not be written.
+	 */
+	int end();
+};
+
+extern InstrumentationTrace instrumentationTrace;
+
+/** Records a trace span for the time it is in scope, if trace is active */
+class InstrumentationTraceSpan
+{
+	const char *name;
+	const char *category;
+	double beginTime;
+
+public:
+	InstrumentationTraceSpan(const char *nameIn, const char *categoryIn) :
+		name(nameIn),
+		category(categoryIn),
+		beginTime(instrumentationTrace.isActive() ? instrumentationTrace.getTime() : -1.0)
+	{
+	}
+
+	~InstrumentationTraceSpan()
+	{
+		if ((this->beginTime >= 0.0) && instrumentationTrace.isActive())
+			instrumentationTrace.addEvent(this->name, this->category, this->beginTime,
+				instrumentationTrace.getTime() - this->beginTime);
+	}
+};
+
+#define ZINC_INSTRUMENT_COUNT(counter) (++(counter))
+#define ZINC_INSTRUMENT_ADD(counter, value) ((counter) += (value))
+#define ZINC_INSTRUMENT_TIME_SCOPE(name, totalTime) InstrumentationTimer name(totalTime)
+#define ZINC_INSTRUMENT_TRACE_SCOPE(name, spanName, category) InstrumentationTraceSpan name(spanName, category)
+
+#else // !defined (ZINC_BUILD_INSTRUMENTATION)
+
+#define ZINC_INSTRUMENT_COUNT(counter) ((void)0)
+#define ZINC_INSTRUMENT_ADD(counter, value) ((void)0)
+#define ZINC_INSTRUMENT_TIME_SCOPE(name, totalTime)
+#define ZINC_INSTRUMENT_TRACE_SCOPE(name, spanName, category)
+
+#endif // defined (ZINC_BUILD_INSTRUMENTATION)
+
+#endif /* !defined (INSTRUMENTATION_HPP) */
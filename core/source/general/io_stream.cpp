@@ -25,6 +25,19 @@ streams.
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined (UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* defined (UNIX) */
 #define HAVE_ZLIB
 #include <zlib.h>
 #define HAVE_BZLIB
@@ -49,6 +62,11 @@ streams.
 	guarantees a NULL delimiter. */
 #define IO_STREAM_SPEED_UP_SSCANF
 
+/* Amount of a memory mapped file read past before releasing its pages */
+#define IO_STREAM_MAPPED_RELEASE_SIZE 4194304
+/* Smallest file memory mapped; smaller files are read through stdio */
+#define IO_STREAM_MAPPED_MIN_SIZE 1048576
+
 /*
 Module types
 ------------
@@ -67,7 +85,8 @@ DESCRIPTION :
 	IO_STREAM_BZ2_FILE_TYPE,
 	IO_STREAM_MEMORY_TYPE,
 	IO_STREAM_GZIP_MEMORY_TYPE,
-	IO_STREAM_BZ2_MEMORY_TYPE
+	IO_STREAM_BZ2_MEMORY_TYPE,
+	IO_STREAM_MAPPED_FILE_TYPE
 }; /*  enum IO_stream_type */
 
 struct IO_memory_block
@@ -125,6 +144,10 @@ DESCRIPTION :
 	/* IO_STREAM_FILE_TYPE */
 	FILE *file_handle;
 
+	/* IO_STREAM_MAPPED_FILE_TYPE: whole file is the buffer */
+	size_t mapped_length;
+	int mapped_released_index;
+
 #if defined (HAVE_ZLIB)
 	/* IO_STREAM_GZIP_FILE_TYPE */
 	gzFile *gzip_file_handle;
@@ -137,6 +160,10 @@ DESCRIPTION :
 	BZFILE *bz2_file_handle;
 #endif /* defined (HAVE_BZLIB) */
 
+	/* IO_STREAM_GZIP_FILE_TYPE and IO_STREAM_BZ2_FILE_TYPE: decompresses on
+		a worker thread when not NULL */
+	class IO_stream_pipelined_reader *pipelined_reader;
+
 	/* IO_STREAM_MEMORY_TYPE */
 	struct IO_memory_block *memory_block;
 	int memory_block_index;
@@ -149,6 +176,152 @@ DESCRIPTION :
 
 }; /* struct IO_stream */
 
+/**
+ * Read decompressed data from compressed file stream handle.
+ * @return  Number of characters read, 0 at end of file, negative on error.
+ */
+static int IO_stream_read_compressed_file(struct IO_stream *stream, char *buffer, int length)
+{
+	switch (stream->type)
+	{
+#if defined (HAVE_ZLIB)
+		case IO_STREAM_GZIP_FILE_TYPE:
+			return gzread(stream->gzip_file_handle, buffer, length);
+#endif /* defined (HAVE_ZLIB) */
+#if defined (HAVE_BZLIB)
+		case IO_STREAM_BZ2_FILE_TYPE:
+			return BZ2_bzread(stream->bz2_file_handle, buffer, length);
+#endif /* defined (HAVE_BZLIB) */
+		default:
+			break;
+	}
+	return -1;
+}
+
+/**
+ * Decompresses a gzip or bzip2 file stream on a worker thread into a ring of
+ * chunk buffers, so decompression overlaps parsing on the calling thread.
+ * While it exists the worker thread has sole use of the stream's compressed
+ * file handle; destroy before closing the handle.
+ */
+class IO_stream_pipelined_reader
+{
+	static const int slotsCount = 4;
+
+	struct IO_stream *stream;
+	const int chunkSize;
+	std::vector<char> slots[slotsCount];
+	// number of characters in slot, 0 at end of file, negative on error
+	int slotLengths[slotsCount];
+	int readSlot, writeSlot, filledCount;
+	bool stopRequested;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::thread thread;
+
+	IO_stream_pipelined_reader(struct IO_stream *streamIn, int chunkSizeIn) :
+		stream(streamIn),
+		chunkSize(chunkSizeIn),
+		readSlot(0),
+		writeSlot(0),
+		filledCount(0),
+		stopRequested(false)
+	{
+		for (int i = 0; i < slotsCount; ++i)
+		{
+			this->slots[i].resize(chunkSizeIn);
+			this->slotLengths[i] = 0;
+		}
+	}
+
+	static void run(IO_stream_pipelined_reader *reader)
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(reader->mutex);
+				while ((reader->filledCount == slotsCount) && (!reader->stopRequested))
+					reader->condition.wait(lock);
+				if (reader->stopRequested)
+					return;
+			}
+			// consumer does not use unfilled slots so no lock while reading
+			const int slot = reader->writeSlot;
+			int length = IO_stream_read_compressed_file(reader->stream,
+				&(reader->slots[slot][0]), reader->chunkSize);
+			{
+				std::lock_guard<std::mutex> lock(reader->mutex);
+				reader->slotLengths[slot] = length;
+				reader->writeSlot = (slot + 1) % slotsCount;
+				++(reader->filledCount);
+			}
+			reader->condition.notify_all();
+			if (length <= 0)
+				return;
+		}
+	}
+
+public:
+
+	~IO_stream_pipelined_reader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopRequested = true;
+		}
+		this->condition.notify_all();
+		if (this->thread.joinable())
+			this->thread.join();
+	}
+
+	/**
+	 * Start decompressing stream on a worker thread.
+	 * @return  New reader, or NULL if thread could not be started, in which
+	 * case the caller should read the stream directly.
+	 */
+	static IO_stream_pipelined_reader *create(struct IO_stream *streamIn, int chunkSizeIn)
+	{
+		IO_stream_pipelined_reader *reader = new IO_stream_pipelined_reader(streamIn, chunkSizeIn);
+		try
+		{
+			reader->thread = std::thread(IO_stream_pipelined_reader::run, reader);
+		}
+		catch (const std::system_error&)
+		{
+			delete reader;
+			reader = NULL;
+		}
+		return reader;
+	}
+
+	/**
+	 * Copy the next chunk of decompressed data to buffer, waiting for it.
+	 * @param buffer  Buffer with space for at least chunk size characters.
+	 * @return  Number of characters read, 0 at end of file, negative on error.
+	 */
+	int read(char *buffer)
+	{
+		int length;
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			while (0 == this->filledCount)
+				this->condition.wait(lock);
+			length = this->slotLengths[this->readSlot];
+			// keep end of file or error slot for subsequent reads
+			if (length <= 0)
+				return length;
+		}
+		memcpy(buffer, &(this->slots[this->readSlot][0]), length);
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->readSlot = (this->readSlot + 1) % slotsCount;
+			--(this->filledCount);
+		}
+		this->condition.notify_all();
+		return length;
+	}
+};
+
 
 /*
 Global functions
@@ -443,6 +616,10 @@ DESCRIPTION :
 			/* IO_STREAM_FILE_TYPE */
 			io_stream->file_handle = (FILE *)NULL;
 
+			/* IO_STREAM_MAPPED_FILE_TYPE */
+			io_stream->mapped_length = 0;
+			io_stream->mapped_released_index = 0;
+
 #if defined (HAVE_ZLIB)
 			/* IO_STREAM_GZIP_FILE_TYPE */
 			io_stream->gzip_file_handle = (gzFile *)NULL;
@@ -454,6 +631,8 @@ DESCRIPTION :
 			io_stream->bz2_file_handle = (BZFILE *)NULL;
 #endif /* defined (HAVE_BZLIB) */
 
+			io_stream->pipelined_reader = (IO_stream_pipelined_reader *)NULL;
+
 			/* IO_STREAM_MEMORY_TYPE */
 			io_stream->memory_block = (struct IO_memory_block *)NULL;
 			io_stream->memory_block_index = 0;
@@ -483,6 +662,65 @@ DESCRIPTION :
 	return (io_stream);
 } /* CREATE(IO_stream) */
 
+#if defined (UNIX)
+/**
+ * Maps the whole of an uncompressed file into memory so it is scanned in place
+ * without copying it through stdio or internal buffers. Pages are private so
+ * the scanner's temporary null termination of lookahead does not modify the
+ * file, and a zero-filled byte always follows the data.
+ * Only regular files of at least IO_STREAM_MAPPED_MIN_SIZE are mapped.
+ * Note that if the file is truncated while it is read, accessing pages past
+ * its new end raises SIGBUS, so files must not be modified while reading.
+ * @return  1 on success, 0 if the file could not be mapped, in which case the
+ * caller should open it with stdio.
+ */
+static int IO_stream_open_mapped_file(struct IO_stream *stream, const char *filename)
+{
+	int file_descriptor = open(filename, O_RDONLY);
+	if (file_descriptor < 0)
+		return 0;
+	int return_code = 0;
+	struct stat file_stat;
+	if ((0 == fstat(file_descriptor, &file_stat)) && S_ISREG(file_stat.st_mode) &&
+		(file_stat.st_size >= IO_STREAM_MAPPED_MIN_SIZE) && (file_stat.st_size < INT_MAX))
+	{
+		const size_t data_length = static_cast<size_t>(file_stat.st_size);
+		const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		const size_t mapped_length = ((data_length + page_size)/page_size)*page_size;
+		/* reserve zero-filled space for the data plus terminating null, then
+			map the file over its start */
+		void *address = mmap(NULL, mapped_length, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANON, -1, 0);
+		if (MAP_FAILED != address)
+		{
+			if (MAP_FAILED != mmap(address, data_length, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_FIXED, file_descriptor, 0))
+			{
+#if defined (MADV_SEQUENTIAL)
+				madvise(address, data_length, MADV_SEQUENTIAL);
+#endif /* defined (MADV_SEQUENTIAL) */
+				stream->type = IO_STREAM_MAPPED_FILE_TYPE;
+				stream->buffer = static_cast<char *>(address);
+				stream->buffer_index = 0;
+				stream->buffer_valid_index = static_cast<int>(data_length);
+				stream->mapped_length = mapped_length;
+				stream->mapped_released_index = 0;
+#if defined IO_STREAM_SPEED_UP_SSCANF
+				stream->buffer_lookahead = 100;
+#endif /* defined IO_STREAM_SPEED_UP_SSCANF */
+				return_code = 1;
+			}
+			else
+			{
+				munmap(address, mapped_length);
+			}
+		}
+	}
+	close(file_descriptor);
+	return return_code;
+}
+#endif /* defined (UNIX) */
+
 int IO_stream_open_for_read_compression_specified(struct IO_stream *stream, const char *stream_uri,
 	enum cmzn_streaminformation_data_compression_type data_compression_type)
 {
@@ -585,6 +823,8 @@ int IO_stream_open_for_read_compression_specified(struct IO_stream *stream, cons
 #if defined IO_STREAM_SPEED_UP_SSCANF
 						stream->buffer_lookahead = 100;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
+						stream->pipelined_reader = IO_stream_pipelined_reader::create(
+							stream, stream->buffer_chunk_size);
 						return_code = 1;
 					}
 				}
@@ -602,11 +842,20 @@ int IO_stream_open_for_read_compression_specified(struct IO_stream *stream, cons
 #if defined IO_STREAM_SPEED_UP_SSCANF
 							stream->buffer_lookahead = 100;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
+							stream->pipelined_reader = IO_stream_pipelined_reader::create(
+								stream, stream->buffer_chunk_size);
 							return_code = 1;
 						}
 					}
 					else
 #endif /* defined (HAVE_BZLIB) */
+#if defined (UNIX)
+					if (IO_stream_open_mapped_file(stream, filename))
+					{
+						return_code = 1;
+					}
+					else
+#endif /* defined (UNIX) */
 					{
 						stream->file_handle = fopen(filename, "r");
 						if (NULL != stream->file_handle)
@@ -749,6 +998,8 @@ DESCRIPTION :
 #if defined IO_STREAM_SPEED_UP_SSCANF
 						stream->buffer_lookahead = 100;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
+						stream->pipelined_reader = IO_stream_pipelined_reader::create(
+							stream, stream->buffer_chunk_size);
 						return_code = 1;
 					}
 				}
@@ -766,11 +1017,20 @@ DESCRIPTION :
 #if defined IO_STREAM_SPEED_UP_SSCANF
 						stream->buffer_lookahead = 100;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
+						stream->pipelined_reader = IO_stream_pipelined_reader::create(
+							stream, stream->buffer_chunk_size);
 						return_code = 1;
 					}
 				}
 				else
 #endif /* defined (HAVE_BZLIB) */
+#if defined (UNIX)
+				if (IO_stream_open_mapped_file(stream, filename))
+				{
+					return_code = 1;
+				}
+				else
+#endif /* defined (UNIX) */
 				{
 					stream->file_handle = fopen(filename, "r");
 					if (NULL != stream->file_handle)
@@ -867,47 +1127,65 @@ DESCRIPTION :
 
 				switch (stream->type)
 				{
-#if defined (HAVE_ZLIB)
 					case IO_STREAM_GZIP_FILE_TYPE:
-					{
-						read_characters = gzread(stream->gzip_file_handle, stream->buffer + stream->buffer_valid_index,
-							stream->buffer_chunk_size);
-					} break;
-#endif /* defined (HAVE_ZLIB) */
-#if defined (HAVE_BZLIB)
 					case IO_STREAM_BZ2_FILE_TYPE:
 					{
-						read_characters = BZ2_bzread(stream->bz2_file_handle, stream->buffer + stream->buffer_valid_index,
-							stream->buffer_chunk_size);
-
+						if (stream->pipelined_reader)
+						{
+							read_characters = stream->pipelined_reader->read(
+								stream->buffer + stream->buffer_valid_index);
+						}
+						else
+						{
+							read_characters = IO_stream_read_compressed_file(stream,
+								stream->buffer + stream->buffer_valid_index, stream->buffer_chunk_size);
+						}
+						if (read_characters < 0)
+						{
+							display_message(ERROR_MESSAGE,
+								"IO_stream_read_to_internal_buffer.  Error uncompressing file.");
+							read_characters = 0;
+							return_code = 0;
+						}
 					} break;
+#if defined (HAVE_ZLIB)
 					case IO_STREAM_GZIP_MEMORY_TYPE:
 					{
+						/* inflate only one chunk at a time, resuming from the unconsumed
+							compressed input on the next call */
 						if (stream->last_gzip_return == Z_STREAM_END)
 						{
 							read_characters = 0;
 						}
 						else
 						{
-							int read_characters_here = 0;
 							stream->gzStream.avail_in = stream->memory_block->data_length -
 								stream->memory_block_index;
 							stream->gzStream.next_in =	((Bytef *)stream->memory_block->memory_ptr) +
 								stream->memory_block_index;
-							do
+							stream->gzStream.next_out =
+								(Bytef *)stream->buffer + stream->buffer_valid_index;
+							stream->gzStream.avail_out = stream->buffer_chunk_size;
+							stream->last_gzip_return = inflate(&stream->gzStream, Z_NO_FLUSH);
+							read_characters = stream->buffer_chunk_size - stream->gzStream.avail_out;
+							stream->memory_block_index = stream->memory_block->data_length -
+								stream->gzStream.avail_in;
+							/* continue with following member of a multi-member gzip */
+							if ((stream->last_gzip_return == Z_STREAM_END) &&
+								(stream->memory_block_index < stream->memory_block->data_length))
 							{
-								stream->gzStream.next_out =
-									(Bytef *)stream->buffer + stream->buffer_valid_index + read_characters;
-								stream->gzStream.avail_out = stream->buffer_chunk_size;
-								stream->last_gzip_return = inflate(&stream->gzStream, Z_NO_FLUSH);
-								read_characters_here = stream->buffer_chunk_size -	stream->gzStream.avail_out;
-								if ((stream->last_gzip_return != Z_STREAM_END ) &&	(stream->last_gzip_return != Z_OK))
-								{
-									return_code = 0;
-								}
-								read_characters += read_characters_here;
-							} while (return_code && stream->gzStream.avail_out == 0);
-							stream->memory_block_index = stream->memory_block->data_length;
+								stream->last_gzip_return = inflateReset(&stream->gzStream);
+							}
+							if ((stream->last_gzip_return != Z_STREAM_END) &&
+								(stream->last_gzip_return != Z_OK))
+							{
+								display_message(ERROR_MESSAGE,
+									"IO_stream_read_to_internal_buffer.  "
+									"Error uncompressing gzip memory buffer.");
+								/* stop further reads */
+								stream->last_gzip_return = Z_STREAM_END;
+								return_code = 0;
+							}
 						}
 					} break;
 #endif /* defined (HAVE_ZLIB) */
@@ -955,7 +1233,8 @@ DESCRIPTION :
 
 							read_characters = stream->buffer_chunk_size -
 								stream->bz2_memory_stream->avail_out;
-							stream->memory_block_index = stream->memory_block->data_length;
+							stream->memory_block_index = stream->memory_block->data_length -
+								stream->bz2_memory_stream->avail_in;
 							if ((stream->last_bz2_return != BZ_STREAM_END) &&
 								(stream->last_bz2_return != BZ_OK))
 							{
@@ -990,6 +1269,26 @@ DESCRIPTION :
 			}
 		} break;
 #endif /* ! defined (IO_STREAM_SPEED_UP_SSCANF) */
+		case IO_STREAM_MAPPED_FILE_TYPE:
+		{
+#if defined (UNIX) && defined (MADV_DONTNEED)
+			/* Temporary null termination makes private copies of pages read
+				through. Since their content is restored, drop them once well
+				behind the read position so memory use does not grow with file
+				size; they are re-read from the file if needed again. */
+			if (stream->buffer_index - stream->mapped_released_index > IO_STREAM_MAPPED_RELEASE_SIZE)
+			{
+				const int release_index = (stream->buffer_index / IO_STREAM_MAPPED_RELEASE_SIZE - 1)
+					*IO_STREAM_MAPPED_RELEASE_SIZE;
+				if (release_index > stream->mapped_released_index)
+				{
+					madvise(stream->buffer + stream->mapped_released_index,
+						release_index - stream->mapped_released_index, MADV_DONTNEED);
+					stream->mapped_released_index = release_index;
+				}
+			}
+#endif /* defined (UNIX) && defined (MADV_DONTNEED) */
+		} break;
 		default:
 		{
 			display_message(ERROR_MESSAGE,
@@ -1029,6 +1328,7 @@ DESCRIPTION :
 			case IO_STREAM_MEMORY_TYPE:
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
+			case IO_STREAM_MAPPED_FILE_TYPE:
 			{
 				IO_stream_read_to_internal_buffer(stream);
 				return_code = (stream->buffer_index >= stream->buffer_valid_index);
@@ -1091,6 +1391,7 @@ Equivalent to a standard C fscanf or sscanf on the stream.
 			case IO_STREAM_MEMORY_TYPE:
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
+			case IO_STREAM_MAPPED_FILE_TYPE:
 			{
 				IO_stream_read_to_internal_buffer(stream);
 				/* Start at 0 and increment for each sucessful value read to be
@@ -1123,6 +1424,8 @@ Equivalent to a standard C fscanf or sscanf on the stream.
 						scan = 0;
 
 						temp_offset = stream->buffer_index + stream->buffer_lookahead;
+						if (temp_offset > stream->buffer_valid_index)
+							temp_offset = stream->buffer_valid_index;
 						temp = stream->buffer[temp_offset];
 						stream->buffer[temp_offset] = 0;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
@@ -1186,6 +1489,8 @@ Equivalent to a standard C fscanf or sscanf on the stream.
 							scan = 0;
 
 							temp_offset = stream->buffer_index + stream->buffer_lookahead;
+							if (temp_offset > stream->buffer_valid_index)
+								temp_offset = stream->buffer_valid_index;
 							temp = stream->buffer[temp_offset];
 							stream->buffer[temp_offset] = 0;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
@@ -1224,6 +1529,8 @@ Equivalent to a standard C fscanf or sscanf on the stream.
 							scan = 0;
 
 							temp_offset = stream->buffer_index + stream->buffer_lookahead;
+							if (temp_offset > stream->buffer_valid_index)
+								temp_offset = stream->buffer_valid_index;
 							temp = stream->buffer[temp_offset];
 							stream->buffer[temp_offset] = 0;
 #endif /* defined IO_STREAM_SPEED_UP_SSCANF */
@@ -1325,6 +1632,7 @@ Equivalent to a standard C fgetc on the stream.
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_FILE_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
+			case IO_STREAM_MAPPED_FILE_TYPE:
 			{
 				IO_stream_read_to_internal_buffer(stream);
 				return_code = stream->buffer[stream->buffer_index];
@@ -1368,6 +1676,7 @@ int IO_stream_peekc(struct IO_stream *stream)
 		case IO_STREAM_GZIP_MEMORY_TYPE:
 		case IO_STREAM_BZ2_FILE_TYPE:
 		case IO_STREAM_BZ2_MEMORY_TYPE:
+		case IO_STREAM_MAPPED_FILE_TYPE:
 		{
 			IO_stream_read_to_internal_buffer(stream);
 			return_code = static_cast<int>(stream->buffer[stream->buffer_index]);
@@ -1418,6 +1727,7 @@ parameters so the stream is first).
 			case IO_STREAM_BZ2_FILE_TYPE:
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
+			case IO_STREAM_MAPPED_FILE_TYPE:
 			{
 				eof = 0;
 				items_to_read = nmemb;
@@ -1501,6 +1811,7 @@ string.  It uses fscanf:
 			case IO_STREAM_MEMORY_TYPE:
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
+			case IO_STREAM_MAPPED_FILE_TYPE:
 			{
 				format_len=strlen(format);
 				if (!strcmp(format,"s"))
@@ -1644,6 +1955,21 @@ suitable for use in diagnostic messages.
 					sprintf(string, "%s line %d", stream->uri, line_number);
 				}
 			} break;
+			case IO_STREAM_MAPPED_FILE_TYPE:
+			{
+				line_number = 1;
+				for (int i = 0; i < stream->buffer_index; ++i)
+				{
+					if ('\n' == stream->buffer[i])
+					{
+						line_number++;
+					}
+				}
+				if (ALLOCATE(string, char, strlen(stream->uri) + 30))
+				{
+					sprintf(string, "%s line %d", stream->uri, line_number);
+				}
+			} break;
 			default:
 			{
 				display_message(ERROR_MESSAGE,
@@ -1678,15 +2004,6 @@ DESCRIPTION :
 	if (stream)
 	{
 		return_code = 1;
-		if (!stream->data)
-		{
-			if (!(ALLOCATE(stream->data, char, read_to_memory_chunk)))
-			{
-				display_message(ERROR_MESSAGE,
-					"IO_stream_read_to_memory. Unable to allocate stream memory data.");
-			}
-			stream->data_length = read_to_memory_chunk;
-		}
 		switch (stream->type)
 		{
 			case IO_STREAM_FILE_TYPE:
@@ -1695,15 +2012,31 @@ DESCRIPTION :
 			case IO_STREAM_GZIP_MEMORY_TYPE:
 			case IO_STREAM_BZ2_MEMORY_TYPE:
 			{
+				/* pipelined reader returns whole chunks */
+				if (stream->pipelined_reader)
+					read_to_memory_chunk = stream->buffer_chunk_size;
+				if (!stream->data)
+				{
+					if (!(ALLOCATE(stream->data, char, read_to_memory_chunk)))
+					{
+						display_message(ERROR_MESSAGE,
+							"IO_stream_read_to_memory. Unable to allocate stream memory data.");
+						return_code = 0;
+					}
+					stream->data_length = read_to_memory_chunk;
+				}
 				total_read = 0;
-				while (return_code && !IO_stream_end_of_stream(stream))
+				bool stream_ended = false;
+				while (return_code && (!stream_ended) && !IO_stream_end_of_stream(stream))
 				{
 					if (total_read + read_to_memory_chunk > stream->data_length)
 					{
-						if (REALLOCATE(new_data, stream->data, char, stream->data_length + read_to_memory_chunk))
+						/* grow geometrically so large streams are not copied repeatedly */
+						const int new_data_length = 2*stream->data_length + read_to_memory_chunk;
+						if (REALLOCATE(new_data, stream->data, char, new_data_length))
 						{
 							stream->data = new_data;
-							stream->data_length += read_to_memory_chunk;
+							stream->data_length = new_data_length;
 						}
 						else
 						{
@@ -1721,12 +2054,32 @@ DESCRIPTION :
 								bytes_read = fread(stream->data + total_read, 1, read_to_memory_chunk,
 									stream->file_handle);
 							} break;
-#if defined (HAVE_ZLIB)
 							case IO_STREAM_GZIP_FILE_TYPE:
+							case IO_STREAM_BZ2_FILE_TYPE:
 							{
-								bytes_read = gzread(stream->gzip_file_handle, stream->data + total_read,
-									read_to_memory_chunk);
+								if (stream->pipelined_reader)
+								{
+									bytes_read = stream->pipelined_reader->read(stream->data + total_read);
+								}
+								else
+								{
+									bytes_read = IO_stream_read_compressed_file(stream,
+										stream->data + total_read, read_to_memory_chunk);
+								}
+								/* compressed file streams do not report end of stream */
+								if (bytes_read <= 0)
+								{
+									if (bytes_read < 0)
+									{
+										display_message(ERROR_MESSAGE,
+											"IO_stream_read_to_memory.  Error uncompressing file.");
+										return_code = 0;
+									}
+									bytes_read = 0;
+									stream_ended = true;
+								}
 							} break;
+#if defined (HAVE_ZLIB)
 							case IO_STREAM_GZIP_MEMORY_TYPE:
 							{
 								stream->gzStream.avail_in = stream->memory_block->data_length -
@@ -1738,16 +2091,11 @@ DESCRIPTION :
 								stream->gzStream.avail_out = read_to_memory_chunk;
 								inflate(&stream->gzStream, Z_NO_FLUSH);
 								bytes_read = read_to_memory_chunk -	stream->gzStream.avail_out;
-								stream->memory_block_index += stream->memory_block->data_length -
+								stream->memory_block_index = stream->memory_block->data_length -
 									stream->gzStream.avail_in;
 							} break;
 #endif /* defined (HAVE_ZLIB) */
 #if defined (HAVE_BZLIB)
-							case IO_STREAM_BZ2_FILE_TYPE:
-							{
-								bytes_read = BZ2_bzread(stream->bz2_file_handle, stream->data + total_read,
-									read_to_memory_chunk);
-							} break;
 							case IO_STREAM_BZ2_MEMORY_TYPE:
 							{
 								stream->bz2_memory_stream->next_in =
@@ -1763,7 +2111,7 @@ DESCRIPTION :
 
 								bytes_read = read_to_memory_chunk -
 									stream->bz2_memory_stream->avail_out;
-								stream->memory_block_index += stream->memory_block->data_length -
+								stream->memory_block_index = stream->memory_block->data_length -
 									stream->bz2_memory_stream->avail_in;
 							} break;
 #endif /* defined (HAVE_BZLIB) */
@@ -1793,6 +2141,11 @@ DESCRIPTION :
 				*stream_data = stream->memory_block->memory_ptr;
 				*stream_data_length = stream->memory_block->data_length;
 			} break;
+			case IO_STREAM_MAPPED_FILE_TYPE:
+			{
+				*stream_data = stream->buffer;
+				*stream_data_length = stream->buffer_valid_index;
+			} break;
 			default:
 			{
 				display_message(ERROR_MESSAGE,
@@ -1846,6 +2199,10 @@ DESCRIPTION :
 				/* Memory is allocated by memory block, don't free until the
 					memory block is removed or the IO_stream_package is DESTROYed */
 			} break;
+			case IO_STREAM_MAPPED_FILE_TYPE:
+			{
+				/* Memory is the file mapping, unmapped on close */
+			} break;
 			default:
 			{
 				display_message(ERROR_MESSAGE,
@@ -1941,6 +2298,43 @@ Implements the stdio function fseek on stream where possible.
 					}
 				}
 			} break;
+			case IO_STREAM_MAPPED_FILE_TYPE:
+			{
+				switch (whence)
+				{
+					case SEEK_SET:
+					{
+						location = offset;
+					} break;
+					case SEEK_CUR:
+					{
+						location = stream->buffer_index + offset;
+					} break;
+					case SEEK_END:
+					{
+						location = stream->buffer_valid_index + offset;
+					} break;
+					default:
+					{
+						display_message(ERROR_MESSAGE,
+							"IO_stream_seek. Unknown seek type.");
+						return_code = 0;
+					}
+				}
+				if (return_code)
+				{
+					if ((location >= 0) && (location <= stream->buffer_valid_index))
+					{
+						stream->buffer_index = location;
+					}
+					else
+					{
+						display_message(ERROR_MESSAGE,
+							"IO_stream_seek. Attempt to seek out of file.");
+						return_code = 0;
+					}
+				}
+			} break;
 			default:
 			{
 				display_message(ERROR_MESSAGE,
@@ -1975,6 +2369,11 @@ DESCRIPTION :
 	if (stream)
 	{
 		IO_stream_deallocate_read_to_memory(stream);
+		if (stream->pipelined_reader)
+		{
+			delete stream->pipelined_reader;
+			stream->pipelined_reader = (IO_stream_pipelined_reader *)NULL;
+		}
 		switch (stream->type)
 		{
 			case IO_STREAM_FILE_TYPE:
@@ -1983,6 +2382,20 @@ DESCRIPTION :
 				stream->type = IO_STREAM_UNKNOWN_TYPE;
 				return_code = 1;
 			} break;
+#if defined (UNIX)
+			case IO_STREAM_MAPPED_FILE_TYPE:
+			{
+				munmap(stream->buffer, stream->mapped_length);
+				/* buffer is not to be deallocated */
+				stream->buffer = (char *)NULL;
+				stream->buffer_index = 0;
+				stream->buffer_valid_index = 0;
+				stream->mapped_length = 0;
+				stream->mapped_released_index = 0;
+				stream->type = IO_STREAM_UNKNOWN_TYPE;
+				return_code = 1;
+			} break;
+#endif /* defined (UNIX) */
 #if defined (HAVE_ZLIB)
 			case IO_STREAM_GZIP_FILE_TYPE:
 			{
@@ -2100,70 +2513,80 @@ DESCRIPTION :
 	return (return_code);
 } /* DESTROY(IO_stream) */
 
+/**
+ * Ensure output buffer has at least chunk_size bytes free after used bytes,
+ * growing it geometrically.
+ * @return  1 on success, 0 on failure.
+ */
+static int reserve_uncompressed_buffer(char **output_buffer, int *data_length,
+	int used_length, int chunk_size)
+{
+	if (used_length + chunk_size <= *data_length)
+		return 1;
+	const int new_data_length = 2*(*data_length) + chunk_size;
+	char *new_data;
+	if (!REALLOCATE(new_data, *output_buffer, char, new_data_length))
+		return 0;
+	*output_buffer = new_data;
+	*data_length = new_data_length;
+	return 1;
+}
+
 int open_gzip_stream(void *buffer, unsigned int length, char **bufferOut)
 {
 	if (buffer && length > 0 && bufferOut)
 	{
-	   int ret;
-	   z_stream strm;
-		int buffer_chunk_size = 10000;
-	   strm.zalloc = Z_NULL;
-	   strm.zfree = Z_NULL;
-	   strm.opaque = Z_NULL;
-	   strm.avail_in = 0;
-	   strm.next_in = Z_NULL;
-	   ret = inflateInit2(&strm, MAX_WBITS+16);
-
-	   if (ret != Z_OK)
-	   	return 0;
-	   int remaining = length;
-	   char *output_buffer = 0;
-	   int data_length = buffer_chunk_size;
-	   ALLOCATE(output_buffer, char, buffer_chunk_size);
-	   int characters_read = 0;
-   	int return_code = 1;
-	   do
-	   {
-	   	strm.avail_in = buffer_chunk_size;
-	   	strm.next_in = ((Bytef *)buffer + length - remaining);
-	   	remaining -= buffer_chunk_size;
-	   	/* run inflate() on input until output buffer not full */
-	   	do
-	   	{
-	   		char *new_data = 0;
-	   		if (characters_read + buffer_chunk_size > data_length)
-	   		{
-	   			if (REALLOCATE(new_data, output_buffer, char, data_length + buffer_chunk_size))
-	   			{
-	   				output_buffer = new_data;
-	   				data_length += buffer_chunk_size;
-	   			}
-	   		}
-	   		strm.avail_out = buffer_chunk_size;
-	   		strm.next_out = (Bytef *)output_buffer + characters_read;
-	   		ret = inflate(&strm, Z_NO_FLUSH);
-	   		int read_characters_here = buffer_chunk_size - strm.avail_out;
-	   		if ((ret != Z_STREAM_END ) &&	(ret != Z_OK))
-	   		{
-	   			return_code = 0;
-	   		}
-	   		characters_read += read_characters_here;
-	   	} while (strm.avail_out == 0 && return_code == 1);
-	   } while (remaining > 0 && return_code == 1);
-	   /* done when inflate() says it's done */
-	   inflateEnd(&strm);
-	   if (data_length != characters_read)
+		z_stream strm;
+		const int buffer_chunk_size = 131072;
+		strm.zalloc = Z_NULL;
+		strm.zfree = Z_NULL;
+		strm.opaque = Z_NULL;
+		strm.avail_in = 0;
+		strm.next_in = Z_NULL;
+		if (inflateInit2(&strm, MAX_WBITS+16) != Z_OK)
+			return 0;
+		/* all input is available, so inflate one output chunk at a time */
+		strm.avail_in = length;
+		strm.next_in = (Bytef *)buffer;
+		char *output_buffer = 0;
+		int data_length = 0;
+		int characters_read = 0;
+		int return_code = 1;
+		int ret = Z_OK;
+		while (ret != Z_STREAM_END)
+		{
+			if (!reserve_uncompressed_buffer(&output_buffer, &data_length, characters_read, buffer_chunk_size))
+			{
+				return_code = 0;
+				break;
+			}
+			strm.avail_out = buffer_chunk_size;
+			strm.next_out = (Bytef *)output_buffer + characters_read;
+			ret = inflate(&strm, Z_NO_FLUSH);
+			characters_read += buffer_chunk_size - strm.avail_out;
+			/* continue with following member of a multi-member gzip */
+			if ((ret == Z_STREAM_END) && (strm.avail_in > 0))
+				ret = inflateReset(&strm);
+			/* Z_BUF_ERROR means no progress is possible: input is truncated */
+			if ((ret != Z_STREAM_END) && (ret != Z_OK))
+			{
+				return_code = 0;
+				break;
+			}
+		}
+		inflateEnd(&strm);
+		if (return_code && (data_length != characters_read))
 		{
 			REALLOCATE(output_buffer, output_buffer, char, characters_read);
 		}
-	   if (return_code == 0)
-	   {
-	   	characters_read = 0;
-	   	DEALLOCATE(output_buffer);
-	   	output_buffer = 0;
-	   }
-		*bufferOut =  output_buffer;
-	   return characters_read;
+		if (return_code == 0)
+		{
+			characters_read = 0;
+			if (output_buffer)
+				DEALLOCATE(output_buffer);
+		}
+		*bufferOut = output_buffer;
+		return characters_read;
 	}
 	return 0;
 }
@@ -2172,9 +2595,8 @@ int open_bzip2_stream(void *buffer, unsigned int length, char **bufferOut)
 {
 	if (buffer && length > 0 && bufferOut)
 	{
-	   int ret = 0;
-	   bz_stream bz2_memory_stream;
-		int buffer_chunk_size = 10000;
+		bz_stream bz2_memory_stream;
+		const int buffer_chunk_size = 131072;
 		bz2_memory_stream.next_in = (char *)NULL;
 		bz2_memory_stream.avail_in = 0;
 		bz2_memory_stream.total_in_lo32 = 0;
@@ -2192,53 +2614,47 @@ int open_bzip2_stream(void *buffer, unsigned int length, char **bufferOut)
 		{
 			return 0;
 		}
-	   int remaining = length;
-	   char *output_buffer = 0;
-	   int data_length = buffer_chunk_size;
-	   ALLOCATE(output_buffer, char, buffer_chunk_size);
-	   int characters_read = 0;
-   	int return_code = 1;
-	   do
-	   {
-	   	bz2_memory_stream.avail_in = buffer_chunk_size;
-	   	bz2_memory_stream.next_in = ((char *)buffer + length - remaining);
-	   	remaining -= buffer_chunk_size;
-	   	/* run inflate() on input until output buffer not full */
-	   	do
-	   	{
-	   		char *new_data = 0;
-	   		if (characters_read + buffer_chunk_size > data_length)
-	   		{
-	   			if (REALLOCATE(new_data, output_buffer, char, data_length + buffer_chunk_size))
-	   			{
-	   				output_buffer = new_data;
-	   				data_length += buffer_chunk_size;
-	   			}
-	   		}
-	   		bz2_memory_stream.avail_out = buffer_chunk_size;
-	   		bz2_memory_stream.next_out = output_buffer + characters_read;
-	   		ret = BZ2_bzDecompress(&bz2_memory_stream);
-	   		int read_characters_here = buffer_chunk_size - bz2_memory_stream.avail_out;
-	   		if ((ret != BZ_STREAM_END ) &&	(ret != BZ_OK))
-	   		{
-	   			return_code = 0;
-	   		}
-	   		characters_read += read_characters_here;
-	   	} while (bz2_memory_stream.avail_out == 0 && return_code == 1);
-	   } while (remaining > 0 && return_code == 1);
-	   BZ2_bzDecompressEnd(&bz2_memory_stream);
-	   if (data_length != characters_read)
+		/* all input is available, so decompress one output chunk at a time */
+		bz2_memory_stream.avail_in = length;
+		bz2_memory_stream.next_in = (char *)buffer;
+		char *output_buffer = 0;
+		int data_length = 0;
+		int characters_read = 0;
+		int return_code = 1;
+		int ret = BZ_OK;
+		while (ret != BZ_STREAM_END)
+		{
+			if (!reserve_uncompressed_buffer(&output_buffer, &data_length, characters_read, buffer_chunk_size))
+			{
+				return_code = 0;
+				break;
+			}
+			bz2_memory_stream.avail_out = buffer_chunk_size;
+			bz2_memory_stream.next_out = output_buffer + characters_read;
+			ret = BZ2_bzDecompress(&bz2_memory_stream);
+			const int read_characters_here = buffer_chunk_size - bz2_memory_stream.avail_out;
+			characters_read += read_characters_here;
+			/* no output with input exhausted means input is truncated */
+			if (((ret != BZ_STREAM_END) && (ret != BZ_OK)) ||
+				((ret == BZ_OK) && (0 == read_characters_here) && (0 == bz2_memory_stream.avail_in)))
+			{
+				return_code = 0;
+				break;
+			}
+		}
+		BZ2_bzDecompressEnd(&bz2_memory_stream);
+		if (return_code && (data_length != characters_read))
 		{
 			REALLOCATE(output_buffer, output_buffer, char, characters_read);
 		}
-	   if (return_code == 0)
-	   {
-	   	characters_read = 0;
-	   	DEALLOCATE(output_buffer);
-	   	output_buffer = 0;
-	   }
-		*bufferOut =  output_buffer;
-	   return characters_read;
+		if (return_code == 0)
+		{
+			characters_read = 0;
+			if (output_buffer)
+				DEALLOCATE(output_buffer);
+		}
+		*bufferOut = output_buffer;
+		return characters_read;
 	}
 	return 0;
 }
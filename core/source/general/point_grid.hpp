@@ -0,0 +1,352 @@
+/**
+ * FILE : point_grid.hpp
+ *
+ * Uniform grid index of objects at points in 1 to 3 dimensions, for finding
+ * the nearest object to a point or all objects within a distance of it.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (POINT_GRID_HPP)
+#define POINT_GRID_HPP
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Hashes points into cubic cells of a fixed size, storing only occupied cells.
+ * Points may be added at any time. Searches visit cells outward from the
+ * query point and stop once no unvisited cell can hold a nearer point, falling
+ * back to scanning all points when the query is so far from them that visiting
+ * cells would cost more.
+ * ObjectType is copied so should be a handle or index; the grid does not
+ * maintain access counts.
+ */
+template <typename ObjectType> class PointGrid
+{
+	struct Cell
+	{
+		long long index[3];
+
+		bool operator==(const Cell& other) const
+		{
+			return (this->index[0] == other.index[0]) && (this->index[1] == other.index[1])
+				&& (this->index[2] == other.index[2]);
+		}
+	};
+
+	struct CellHash
+	{
+		size_t operator()(const Cell& cell) const
+		{
+			return static_cast<size_t>(cell.index[0]*73856093LL ^ cell.index[1]*19349663LL
+				^ cell.index[2]*83492791LL);
+		}
+	};
+
+	struct Point
+	{
+		double x[3];
+		ObjectType object;
+	};
+
+	typedef std::unordered_map<Cell, std::vector<int>, CellHash> CellMap;
+
+	const int dimension;
+	const double cellSize;
+	std::vector<Point> points;
+	CellMap cells;
+	// range of occupied cells
+	Cell minimumCell, maximumCell;
+
+	void getCell(const double *x, Cell& cell) const
+	{
+		for (int d = 0; d < 3; ++d)
+			cell.index[d] = (d < this->dimension) ?
+				static_cast<long long>(std::floor(x[d]/this->cellSize)) : 0;
+	}
+
+	double getDistanceSquared(const Point& point, const double *x) const
+	{
+		double distanceSquared = 0.0;
+		for (int d = 0; d < this->dimension; ++d)
+		{
+			const double delta = point.x[d] - x[d];
+			distanceSquared += delta*delta;
+		}
+		return distanceSquared;
+	}
+
+	/** Get range of cells within ring cells of centre, limited to occupied range.
+	 * @return  Number of cells in range, or 0 if none occupied. */
+	double getCellRange(const Cell& centre, long long ring, Cell& start, Cell& end) const
+	{
+		double count = 1.0;
+		for (int d = 0; d < 3; ++d)
+		{
+			start.index[d] = centre.index[d] - ring;
+			if (start.index[d] < this->minimumCell.index[d])
+				start.index[d] = this->minimumCell.index[d];
+			end.index[d] = centre.index[d] + ring;
+			if (end.index[d] > this->maximumCell.index[d])
+				end.index[d] = this->maximumCell.index[d];
+			if (end.index[d] < start.index[d])
+				return 0.0;
+			count *= static_cast<double>(end.index[d] - start.index[d] + 1);
+		}
+		return count;
+	}
+
+	/** @return  Number of cells from centre to nearest occupied cell, per axis maximum. */
+	long long getRingToOccupiedCells(const Cell& centre) const
+	{
+		long long ring = 0;
+		for (int d = 0; d < this->dimension; ++d)
+		{
+			long long offset = 0;
+			if (centre.index[d] < this->minimumCell.index[d])
+				offset = this->minimumCell.index[d] - centre.index[d];
+			else if (centre.index[d] > this->maximumCell.index[d])
+				offset = centre.index[d] - this->maximumCell.index[d];
+			if (offset > ring)
+				ring = offset;
+		}
+		return ring;
+	}
+
+	bool ringCoversOccupiedCells(const Cell& centre, long long ring) const
+	{
+		for (int d = 0; d < this->dimension; ++d)
+			if ((centre.index[d] - ring > this->minimumCell.index[d])
+				|| (centre.index[d] + ring < this->maximumCell.index[d]))
+				return false;
+		return true;
+	}
+
+	void findNearestInPoints(const std::vector<int>& pointIndexes, const double *x,
+		int& nearestIndex, double& nearestDistanceSquared) const
+	{
+		const size_t count = pointIndexes.size();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const double distanceSquared = this->getDistanceSquared(this->points[pointIndexes[i]], x);
+			if ((nearestIndex < 0) || (distanceSquared < nearestDistanceSquared))
+			{
+				nearestIndex = pointIndexes[i];
+				nearestDistanceSquared = distanceSquared;
+			}
+		}
+	}
+
+public:
+
+	/**
+	 * @param dimensionIn  Number of coordinates of points from 1 to 3.
+	 * @param cellSizeIn  Positive size of grid cells. For fastest searches this
+	 * should be comparable to search distances or the spacing of points.
+	 */
+	PointGrid(int dimensionIn, double cellSizeIn) :
+		dimension((dimensionIn < 1) ? 1 : ((dimensionIn > 3) ? 3 : dimensionIn)),
+		cellSize((cellSizeIn > 0.0) ? cellSizeIn : 1.0)
+	{
+	}
+
+	int getDimension() const
+	{
+		return this->dimension;
+	}
+
+	size_t size() const
+	{
+		return this->points.size();
+	}
+
+	void clear()
+	{
+		this->points.clear();
+		this->cells.clear();
+	}
+
+	/** @param x  Point coordinates, of the grid dimension. */
+	void add(const double *x, ObjectType object)
+	{
+		Point point;
+		for (int d = 0; d < 3; ++d)
+			point.x[d] = (d < this->dimension) ? x[d] : 0.0;
+		point.object = object;
+		Cell cell;
+		this->getCell(point.x, cell);
+		if (this->points.empty())
+		{
+			this->minimumCell = cell;
+			this->maximumCell = cell;
+		}
+		else
+		{
+			for (int d = 0; d < 3; ++d)
+			{
+				if (cell.index[d] < this->minimumCell.index[d])
+					this->minimumCell.index[d] = cell.index[d];
+				else if (cell.index[d] > this->maximumCell.index[d])
+					this->maximumCell.index[d] = cell.index[d];
+			}
+		}
+		this->cells[cell].push_back(static_cast<int>(this->points.size()));
+		this->points.push_back(point);
+	}
+
+	/**
+	 * Find object at point nearest to x.
+	 * @param maximumDistance  If non-negative, only find objects within this
+	 * distance of x.
+	 * @param object  On success set to the nearest object.
+	 * @param distance  On success set to the distance to the nearest object.
+	 * @return  True if found, false if none in range.
+	 */
+	bool findNearest(const double *x, double maximumDistance, ObjectType& object,
+		double& distance) const
+	{
+		if (this->points.empty())
+			return false;
+		double px[3];
+		for (int d = 0; d < 3; ++d)
+			px[d] = (d < this->dimension) ? x[d] : 0.0;
+		Cell centre;
+		this->getCell(px, centre);
+		int nearestIndex = -1;
+		double nearestDistanceSquared = 0.0;
+		const double occupiedCellsCount = static_cast<double>(this->cells.size());
+		long long ring = this->getRingToOccupiedCells(centre);
+		bool scanAll = false;
+		while (true)
+		{
+			// cells beyond this ring are at least this distance from x
+			const double ringDistance = (ring > 0) ? (ring - 1)*this->cellSize : 0.0;
+			if ((maximumDistance >= 0.0) && (ringDistance > maximumDistance))
+				break;
+			if ((nearestIndex >= 0) && (nearestDistanceSquared <= ringDistance*ringDistance))
+				break;
+			Cell start, end;
+			if (this->getCellRange(centre, ring, start, end) > occupiedCellsCount)
+			{
+				scanAll = true;
+				break;
+			}
+			Cell cell;
+			for (cell.index[2] = start.index[2]; cell.index[2] <= end.index[2]; ++cell.index[2])
+			{
+				const bool onRing2 = (cell.index[2] == centre.index[2] - ring) || (cell.index[2] == centre.index[2] + ring);
+				for (cell.index[1] = start.index[1]; cell.index[1] <= end.index[1]; ++cell.index[1])
+				{
+					const bool onRing1 = onRing2 || (cell.index[1] == centre.index[1] - ring) || (cell.index[1] == centre.index[1] + ring);
+					for (cell.index[0] = start.index[0]; cell.index[0] <= end.index[0]; ++cell.index[0])
+					{
+						// skip cells inside ring, already visited
+						if (!(onRing1 || (cell.index[0] == centre.index[0] - ring) || (cell.index[0] == centre.index[0] + ring)))
+						{
+							if (centre.index[0] + ring <= end.index[0])
+								cell.index[0] = centre.index[0] + ring - 1;
+							else
+								break;
+							continue;
+						}
+						typename CellMap::const_iterator iter = this->cells.find(cell);
+						if (iter != this->cells.end())
+							this->findNearestInPoints(iter->second, px, nearestIndex, nearestDistanceSquared);
+					}
+				}
+			}
+			if (this->ringCoversOccupiedCells(centre, ring))
+				break;
+			++ring;
+		}
+		if (scanAll)
+		{
+			nearestIndex = -1;
+			const int pointsCount = static_cast<int>(this->points.size());
+			for (int i = 0; i < pointsCount; ++i)
+			{
+				const double distanceSquared = this->getDistanceSquared(this->points[i], px);
+				if ((nearestIndex < 0) || (distanceSquared < nearestDistanceSquared))
+				{
+					nearestIndex = i;
+					nearestDistanceSquared = distanceSquared;
+				}
+			}
+		}
+		if (nearestIndex < 0)
+			return false;
+		const double nearestDistance = std::sqrt(nearestDistanceSquared);
+		if ((maximumDistance >= 0.0) && (nearestDistance > maximumDistance))
+			return false;
+		object = this->points[nearestIndex].object;
+		distance = nearestDistance;
+		return true;
+	}
+
+	/**
+	 * Append objects at points within distance of x to objects, in no
+	 * particular order.
+	 */
+	void findWithinDistance(const double *x, double distance, std::vector<ObjectType>& objects) const
+	{
+		if (this->points.empty() || (distance < 0.0))
+			return;
+		double px[3];
+		for (int d = 0; d < 3; ++d)
+			px[d] = (d < this->dimension) ? x[d] : 0.0;
+		const double distanceSquared = distance*distance;
+		Cell start, end;
+		double lowerX[3], upperX[3];
+		for (int d = 0; d < 3; ++d)
+		{
+			lowerX[d] = px[d] - distance;
+			upperX[d] = px[d] + distance;
+		}
+		this->getCell(lowerX, start);
+		this->getCell(upperX, end);
+		double rangeCellsCount = 1.0;
+		for (int d = 0; d < 3; ++d)
+		{
+			if (start.index[d] < this->minimumCell.index[d])
+				start.index[d] = this->minimumCell.index[d];
+			if (end.index[d] > this->maximumCell.index[d])
+				end.index[d] = this->maximumCell.index[d];
+			if (end.index[d] < start.index[d])
+				return;
+			rangeCellsCount *= static_cast<double>(end.index[d] - start.index[d] + 1);
+		}
+		if (rangeCellsCount > static_cast<double>(this->cells.size()))
+		{
+			const size_t pointsCount = this->points.size();
+			for (size_t i = 0; i < pointsCount; ++i)
+				if (this->getDistanceSquared(this->points[i], px) <= distanceSquared)
+					objects.push_back(this->points[i].object);
+			return;
+		}
+		Cell cell;
+		for (cell.index[2] = start.index[2]; cell.index[2] <= end.index[2]; ++cell.index[2])
+			for (cell.index[1] = start.index[1]; cell.index[1] <= end.index[1]; ++cell.index[1])
+				for (cell.index[0] = start.index[0]; cell.index[0] <= end.index[0]; ++cell.index[0])
+				{
+					typename CellMap::const_iterator iter = this->cells.find(cell);
+					if (iter == this->cells.end())
+						continue;
+					const std::vector<int>& pointIndexes = iter->second;
+					const size_t count = pointIndexes.size();
+					for (size_t i = 0; i < count; ++i)
+					{
+						const Point& point = this->points[pointIndexes[i]];
+						if (this->getDistanceSquared(point, px) <= distanceSquared)
+							objects.push_back(point.object);
+					}
+				}
+	}
+
+};
+
+#endif /* !defined (POINT_GRID_HPP) */
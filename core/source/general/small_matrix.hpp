@@ -0,0 +1,337 @@
+/**
+ * FILE : small_matrix.hpp
+ *
+ * Closed-form determinant, inverse and symmetric eigenanalysis of square
+ * matrices of fixed size up to 4x4, and their derivatives.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (SMALL_MATRIX_HPP)
+#define SMALL_MATRIX_HPP
+
+#include <cmath>
+#include "opencmiss/zinc/zincconfigure.h"
+
+/**
+ * Kernels for N*N matrices with values in row-major order, as in
+ * matrix_vector.h. Sizes are compile-time constants so loops are unrolled or
+ * vectorised by the compiler. Derivatives are in the layout of
+ * RealFieldValueCache: derivativeCount derivatives of each matrix value.
+ */
+template <int N> class SmallMatrix
+{
+public:
+
+	/**
+	 * Calculate the adjugate, the transpose of the cofactor matrix.
+	 * Specialised for sizes 1 to 4.
+	 * @param adjugate  N*N array to receive adjugate.
+	 * @return  Determinant of a.
+	 */
+	static FE_value adjugate(const FE_value *a, FE_value *adjugate);
+
+	static FE_value determinant(const FE_value *a)
+	{
+		FE_value adjugate[N*N];
+		return SmallMatrix<N>::adjugate(a, adjugate);
+	}
+
+	/**
+	 * Invert a as adjugate over determinant.
+	 * @param inverse  N*N array to receive inverse.
+	 * @param singularTolerance  Fails if the magnitude of the determinant
+	 * relative to that of the product of the row norms is not greater.
+	 * @return  True on success, false if a is singular.
+	 */
+	static bool invert(const FE_value *a, FE_value *inverse, FE_value singularTolerance)
+	{
+		const FE_value det = SmallMatrix<N>::adjugate(a, inverse);
+		FE_value scale = 1.0;
+		for (int i = 0; i < N; ++i)
+		{
+			FE_value rowNormSquared = 0.0;
+			for (int j = 0; j < N; ++j)
+				rowNormSquared += a[i*N + j]*a[i*N + j];
+			scale *= std::sqrt(rowNormSquared);
+		}
+		if (!(std::fabs(det) > singularTolerance*scale))
+			return false;
+		const FE_value reciprocalDet = 1.0/det;
+		for (int i = 0; i < N*N; ++i)
+			inverse[i] *= reciprocalDet;
+		return true;
+	}
+
+	/**
+	 * Calculate derivatives of the determinant by Jacobi's formula:
+	 * d(det A) = trace(adj(A) dA).
+	 * @param adjugate  Adjugate of the matrix.
+	 * @param derivatives  Derivatives of matrix values.
+	 * @param determinantDerivatives  Array of derivativeCount to receive
+	 * derivatives of the determinant.
+	 */
+	static void determinantDerivatives(const FE_value *adjugate, const FE_value *derivatives,
+		int derivativeCount, FE_value *determinantDerivatives)
+	{
+		for (int d = 0; d < derivativeCount; ++d)
+			determinantDerivatives[d] = 0.0;
+		for (int i = 0; i < N; ++i)
+			for (int j = 0; j < N; ++j)
+			{
+				const FE_value adjugateValue = adjugate[j*N + i];
+				const FE_value *matrixDerivatives = derivatives + (i*N + j)*derivativeCount;
+				for (int d = 0; d < derivativeCount; ++d)
+					determinantDerivatives[d] += adjugateValue*matrixDerivatives[d];
+			}
+	}
+
+	/**
+	 * Calculate derivatives of the inverse: d(A^-1) = -A^-1 dA A^-1.
+	 * @param inverse  Inverse of the matrix.
+	 * @param derivatives  Derivatives of matrix values.
+	 * @param inverseDerivatives  Array of N*N*derivativeCount to receive
+	 * derivatives of the inverse.
+	 */
+	static void inverseDerivatives(const FE_value *inverse, const FE_value *derivatives,
+		int derivativeCount, FE_value *inverseDerivatives)
+	{
+		for (int i = 0; i < N*N*derivativeCount; ++i)
+			inverseDerivatives[i] = 0.0;
+		for (int k = 0; k < N; ++k)
+			for (int l = 0; l < N; ++l)
+			{
+				const FE_value *matrixDerivatives = derivatives + (k*N + l)*derivativeCount;
+				for (int i = 0; i < N; ++i)
+				{
+					const FE_value inverseIK = inverse[i*N + k];
+					for (int j = 0; j < N; ++j)
+					{
+						const FE_value factor = -inverseIK*inverse[l*N + j];
+						FE_value *result = inverseDerivatives + (i*N + j)*derivativeCount;
+						for (int d = 0; d < derivativeCount; ++d)
+							result[d] += factor*matrixDerivatives[d];
+					}
+				}
+			}
+	}
+
+	/**
+	 * Eigenanalysis of symmetric matrix a, using values on and above the
+	 * diagonal. Specialised for sizes 2 and 3; fails for other sizes.
+	 * @param values  Array of N to receive eigenvalues, unsorted.
+	 * @param vectors  N*N array to receive unit eigenvectors in columns.
+	 * @return  True on success, false if eigenvectors cannot be found
+	 * accurately in closed form, e.g. for close but unequal eigenvalues.
+	 */
+	static bool symmetricEigenanalysis(const FE_value * /*a*/, FE_value * /*values*/,
+		FE_value * /*vectors*/)
+	{
+		return false;
+	}
+
+	/**
+	 * Calculate derivatives of distinct eigenvalues of a symmetric matrix:
+	 * d(lambda_i) = v_i . dA v_i.
+	 * @param vectors  Unit eigenvectors in columns.
+	 * @param derivatives  Derivatives of matrix values.
+	 * @param valueDerivatives  Array of N*derivativeCount to receive
+	 * derivatives of the eigenvalues.
+	 */
+	static void eigenvalueDerivatives(const FE_value *vectors, const FE_value *derivatives,
+		int derivativeCount, FE_value *valueDerivatives)
+	{
+		for (int i = 0; i < N*derivativeCount; ++i)
+			valueDerivatives[i] = 0.0;
+		for (int j = 0; j < N; ++j)
+			for (int k = 0; k < N; ++k)
+			{
+				const FE_value *matrixDerivatives = derivatives + (j*N + k)*derivativeCount;
+				for (int i = 0; i < N; ++i)
+				{
+					const FE_value factor = vectors[j*N + i]*vectors[k*N + i];
+					FE_value *result = valueDerivatives + i*derivativeCount;
+					for (int d = 0; d < derivativeCount; ++d)
+						result[d] += factor*matrixDerivatives[d];
+				}
+			}
+	}
+
+};
+
+template <> inline FE_value SmallMatrix<1>::adjugate(const FE_value *a, FE_value *adjugate)
+{
+	adjugate[0] = 1.0;
+	return a[0];
+}
+
+template <> inline FE_value SmallMatrix<2>::adjugate(const FE_value *a, FE_value *adjugate)
+{
+	adjugate[0] = a[3];
+	adjugate[1] = -a[1];
+	adjugate[2] = -a[2];
+	adjugate[3] = a[0];
+	return a[0]*a[3] - a[1]*a[2];
+}
+
+template <> inline FE_value SmallMatrix<3>::adjugate(const FE_value *a, FE_value *adjugate)
+{
+	adjugate[0] = a[4]*a[8] - a[5]*a[7];
+	adjugate[1] = a[2]*a[7] - a[1]*a[8];
+	adjugate[2] = a[1]*a[5] - a[2]*a[4];
+	adjugate[3] = a[5]*a[6] - a[3]*a[8];
+	adjugate[4] = a[0]*a[8] - a[2]*a[6];
+	adjugate[5] = a[2]*a[3] - a[0]*a[5];
+	adjugate[6] = a[3]*a[7] - a[4]*a[6];
+	adjugate[7] = a[1]*a[6] - a[0]*a[7];
+	adjugate[8] = a[0]*a[4] - a[1]*a[3];
+	return a[0]*adjugate[0] + a[1]*adjugate[3] + a[2]*adjugate[6];
+}
+
+/** Uses 2x2 minors of the first two and last two rows */
+template <> inline FE_value SmallMatrix<4>::adjugate(const FE_value *a, FE_value *adjugate)
+{
+	const FE_value s0 = a[0]*a[5] - a[4]*a[1];
+	const FE_value s1 = a[0]*a[6] - a[4]*a[2];
+	const FE_value s2 = a[0]*a[7] - a[4]*a[3];
+	const FE_value s3 = a[1]*a[6] - a[5]*a[2];
+	const FE_value s4 = a[1]*a[7] - a[5]*a[3];
+	const FE_value s5 = a[2]*a[7] - a[6]*a[3];
+	const FE_value c5 = a[10]*a[15] - a[14]*a[11];
+	const FE_value c4 = a[9]*a[15] - a[13]*a[11];
+	const FE_value c3 = a[9]*a[14] - a[13]*a[10];
+	const FE_value c2 = a[8]*a[15] - a[12]*a[11];
+	const FE_value c1 = a[8]*a[14] - a[12]*a[10];
+	const FE_value c0 = a[8]*a[13] - a[12]*a[9];
+	adjugate[0] = a[5]*c5 - a[6]*c4 + a[7]*c3;
+	adjugate[1] = -a[1]*c5 + a[2]*c4 - a[3]*c3;
+	adjugate[2] = a[13]*s5 - a[14]*s4 + a[15]*s3;
+	adjugate[3] = -a[9]*s5 + a[10]*s4 - a[11]*s3;
+	adjugate[4] = -a[4]*c5 + a[6]*c2 - a[7]*c1;
+	adjugate[5] = a[0]*c5 - a[2]*c2 + a[3]*c1;
+	adjugate[6] = -a[12]*s5 + a[14]*s2 - a[15]*s1;
+	adjugate[7] = a[8]*s5 - a[10]*s2 + a[11]*s1;
+	adjugate[8] = a[4]*c4 - a[5]*c2 + a[7]*c0;
+	adjugate[9] = -a[0]*c4 + a[1]*c2 - a[3]*c0;
+	adjugate[10] = a[12]*s4 - a[13]*s2 + a[15]*s0;
+	adjugate[11] = -a[8]*s4 + a[9]*s2 - a[11]*s0;
+	adjugate[12] = -a[4]*c3 + a[5]*c1 - a[6]*c0;
+	adjugate[13] = a[0]*c3 - a[1]*c1 + a[2]*c0;
+	adjugate[14] = -a[12]*s3 + a[13]*s1 - a[14]*s0;
+	adjugate[15] = a[8]*s3 - a[9]*s1 + a[10]*s0;
+	return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+}
+
+template <> inline bool SmallMatrix<2>::symmetricEigenanalysis(const FE_value *a,
+	FE_value *values, FE_value *vectors)
+{
+	const FE_value mean = 0.5*(a[0] + a[3]);
+	const FE_value halfDifference = 0.5*(a[0] - a[3]);
+	const FE_value radius = std::sqrt(halfDifference*halfDifference + a[1]*a[1]);
+	values[0] = mean + radius;
+	values[1] = mean - radius;
+	// vector for larger eigenvalue at angle theta where tan(2*theta) = a01/halfDifference
+	const FE_value theta = 0.5*std::atan2(a[1], halfDifference);
+	const FE_value c = std::cos(theta);
+	const FE_value s = std::sin(theta);
+	vectors[0] = c;
+	vectors[1] = -s;
+	vectors[2] = s;
+	vectors[3] = c;
+	return true;
+}
+
+/**
+ * Eigenvalues by the trigonometric solution of the characteristic equation.
+ * Eigenvectors of the outer eigenvalues are the largest cross product of rows
+ * of A - lambda I; the middle eigenvector completes the orthonormal set.
+ */
+template <> inline bool SmallMatrix<3>::symmetricEigenanalysis(const FE_value *a,
+	FE_value *values, FE_value *vectors)
+{
+	const FE_value offDiagonalSquared = a[1]*a[1] + a[2]*a[2] + a[5]*a[5];
+	const FE_value diagonalSquared = a[0]*a[0] + a[4]*a[4] + a[8]*a[8];
+	if (offDiagonalSquared <= 1.0E-30*diagonalSquared)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			values[i] = a[i*4];
+			for (int j = 0; j < 3; ++j)
+				vectors[i*3 + j] = (i == j) ? 1.0 : 0.0;
+		}
+		return true;
+	}
+	const FE_value q = (a[0] + a[4] + a[8])/3.0;
+	const FE_value d0 = a[0] - q, d1 = a[4] - q, d2 = a[8] - q;
+	const FE_value p = std::sqrt((d0*d0 + d1*d1 + d2*d2 + 2.0*offDiagonalSquared)/6.0);
+	// r = det((A - qI)/p)/2
+	FE_value r = (d0*(d1*d2 - a[5]*a[5]) - a[1]*(a[1]*d2 - a[5]*a[2]) +
+		a[2]*(a[1]*a[5] - d1*a[2]))/(2.0*p*p*p);
+	if (r < -1.0)
+		r = -1.0;
+	else if (r > 1.0)
+		r = 1.0;
+	const FE_value phi = std::acos(r)/3.0;
+	const FE_value twoPiOn3 = 2.0943951023931955;
+	values[0] = q + 2.0*p*std::cos(phi);
+	values[2] = q + 2.0*p*std::cos(phi + twoPiOn3);
+	values[1] = 3.0*q - values[0] - values[2];
+	// cross products lose accuracy as eigenvalues approach each other
+	const FE_value separationTolerance = 1.0E-4*p;
+	if (((values[0] - values[1]) <= separationTolerance) || ((values[1] - values[2]) <= separationTolerance))
+		return false;
+	FE_value v[2][3];
+	for (int e = 0; e < 2; ++e)
+	{
+		const FE_value lambda = values[e*2];
+		const FE_value row[3][3] =
+		{
+			{ a[0] - lambda, a[1], a[2] },
+			{ a[1], a[4] - lambda, a[5] },
+			{ a[2], a[5], a[8] - lambda }
+		};
+		FE_value bestNormSquared = 0.0;
+		for (int i = 0; i < 2; ++i)
+			for (int j = i + 1; j < 3; ++j)
+			{
+				const FE_value cross[3] =
+				{
+					row[i][1]*row[j][2] - row[i][2]*row[j][1],
+					row[i][2]*row[j][0] - row[i][0]*row[j][2],
+					row[i][0]*row[j][1] - row[i][1]*row[j][0]
+				};
+				const FE_value normSquared = cross[0]*cross[0] + cross[1]*cross[1] + cross[2]*cross[2];
+				if (normSquared > bestNormSquared)
+				{
+					bestNormSquared = normSquared;
+					v[e][0] = cross[0];
+					v[e][1] = cross[1];
+					v[e][2] = cross[2];
+				}
+			}
+		if (!(bestNormSquared > 0.0))
+			return false;
+		const FE_value scale = 1.0/std::sqrt(bestNormSquared);
+		v[e][0] *= scale;
+		v[e][1] *= scale;
+		v[e][2] *= scale;
+	}
+	const FE_value middle[3] =
+	{
+		v[1][1]*v[0][2] - v[1][2]*v[0][1],
+		v[1][2]*v[0][0] - v[1][0]*v[0][2],
+		v[1][0]*v[0][1] - v[1][1]*v[0][0]
+	};
+	for (int i = 0; i < 3; ++i)
+	{
+		vectors[i*3] = v[0][i];
+		vectors[i*3 + 1] = middle[i];
+		vectors[i*3 + 2] = v[1][i];
+	}
+	return true;
+}
+
+#endif /* !defined (SMALL_MATRIX_HPP) */
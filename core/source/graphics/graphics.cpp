@@ -39,6 +39,7 @@
 #include "computed_field/computed_field_set.h"
 #include "computed_field/computed_field_wrappers.h"
 #include "computed_field/field_module.hpp"
+#include "finite_element/element_scalar_ranges.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_discretization.h"
 #include "finite_element/finite_element_region.h"
@@ -209,6 +210,9 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->first_isovalue=0.0;
 			graphics->last_isovalue=0.0;
 			graphics->decimation_threshold = 0.0;
+			graphics->isoscalar_ranges = 0;
+			graphics->contours_welded = false;
+			graphics->iso_surface_welder = 0;
 
 			/* point attributes */
 			graphics->glyph = 0;
@@ -258,6 +262,7 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			/* for streamlines only */
 			graphics->stream_vector_field=(struct Computed_field *)NULL;
 			graphics->streamlines_track_direction = CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_FORWARD;
+			graphics->streamlines_integration_method = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER;
 			graphics->streamline_length=1.0;
 			graphics->seed_nodeset = (cmzn_nodeset_id)0;
 			graphics->seed_node_mesh_location_field = (struct Computed_field *)NULL;
@@ -288,6 +293,10 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
 			graphics->selected_graphics_changed = 0;
 			graphics->timeDependent = false;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+			graphics->buildsCount = 0;
+			graphics->buildTime = 0.0;
+#endif
 
 			graphics->access_count=1;
 		}
@@ -344,6 +353,8 @@ int DESTROY(cmzn_graphics)(
 		{
 			DEALLOCATE(graphics->isovalues);
 		}
+		delete graphics->isoscalar_ranges;
+		Iso_surface_welder_destroy(&(graphics->iso_surface_welder));
 		if (graphics->glyph)
 		{
 			cmzn_glyph_destroy(&(graphics->glyph));
@@ -631,7 +642,8 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 									graphics_to_object_data->field_cache,
 									graphics_to_object_data->master_mesh,
 									GT_object_get_vertex_set(graphics->graphics_object),
-									number_in_xi, graphics_to_object_data->iso_surface_specification);
+									number_in_xi, graphics_to_object_data->iso_surface_specification,
+									graphics->isoscalar_ranges, graphics->iso_surface_welder);
 							}
 						} break;
 						case g_POLYLINE_VERTEX_BUFFERS:
@@ -647,7 +659,8 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 											graphics_to_object_data->rc_coordinate_field,
 											graphics->isoscalar_field, graphics->isovalues[i],
 											graphics->data_field, number_in_xi[0], number_in_xi[1],
-											top_level_element, GT_object_get_vertex_set(graphics->graphics_object));
+											top_level_element, GT_object_get_vertex_set(graphics->graphics_object),
+											graphics->isoscalar_ranges);
 									}
 								}
 								else
@@ -673,7 +686,8 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 											graphics_to_object_data->rc_coordinate_field,
 											graphics->isoscalar_field, isovalue,
 											graphics->data_field, number_in_xi[0], number_in_xi[1],
-											top_level_element, GT_object_get_vertex_set(graphics->graphics_object));
+											top_level_element, GT_object_get_vertex_set(graphics->graphics_object),
+											graphics->isoscalar_ranges);
 									}
 								}
 							}
@@ -759,8 +773,10 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 										graphics_to_object_data->wrapper_stream_vector_field,
 										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 										graphics->streamline_length,
+										graphics->streamlines_integration_method,
 										graphics->streamlines_colour_data_type, graphics->data_field,
-										GT_object_get_vertex_set(graphics->graphics_object));
+										GT_object_get_vertex_set(graphics->graphics_object),
+										graphics_to_object_data->streamline_buffers);
 								}
 							} break;
 						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
@@ -778,11 +794,13 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 										graphics_to_object_data->wrapper_stream_vector_field,
 										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 										graphics->streamline_length,
+										graphics->streamlines_integration_method,
 										graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
 										graphics->line_base_size, graphics->line_scale_factors,
 										graphics->line_orientation_scale_field,
 										graphics->streamlines_colour_data_type, graphics->data_field,
-										GT_object_get_vertex_set(graphics->graphics_object));
+										GT_object_get_vertex_set(graphics->graphics_object),
+										graphics_to_object_data->streamline_buffers);
 								}
 							} break;
 						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID:
@@ -861,8 +879,10 @@ static int cmzn_node_to_streamline(struct FE_node *node,
 							graphics_to_object_data->wrapper_stream_vector_field,
 							static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 							graphics->streamline_length,
+							graphics->streamlines_integration_method,
 							graphics->streamlines_colour_data_type, graphics->data_field,
-							GT_object_get_vertex_set(graphics->graphics_object));
+							GT_object_get_vertex_set(graphics->graphics_object),
+							graphics_to_object_data->streamline_buffers);
 				} break;
 			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
 			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
@@ -874,11 +894,13 @@ static int cmzn_node_to_streamline(struct FE_node *node,
 						graphics_to_object_data->wrapper_stream_vector_field,
 						static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 						graphics->streamline_length,
+						graphics->streamlines_integration_method,
 						graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
 						graphics->line_base_size, graphics->line_scale_factors,
 						graphics->line_orientation_scale_field,
 						graphics->streamlines_colour_data_type, graphics->data_field,
-						GT_object_get_vertex_set(graphics->graphics_object));
+						GT_object_get_vertex_set(graphics->graphics_object),
+						graphics_to_object_data->streamline_buffers);
 				} break;
 			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID:
 				{
@@ -1744,6 +1766,10 @@ char *cmzn_graphics_string(struct cmzn_graphics *graphics,
 					graphics->decimation_threshold);
 				append_string(&graphics_string,temp_string,&error);
 			}
+			if (graphics->contours_welded)
+			{
+				append_string(&graphics_string, " welded", &error);
+			}
 		}
 
 		// line attributes
@@ -1999,6 +2025,10 @@ char *cmzn_graphics_string(struct cmzn_graphics *graphics,
 			append_string(&graphics_string, " ", &error);
 			append_string(&graphics_string,
 				ENUMERATOR_STRING(cmzn_graphics_streamlines_track_direction)(graphics->streamlines_track_direction), &error);
+			if (graphics->streamlines_integration_method == CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_DORMAND_PRINCE)
+			{
+				append_string(&graphics_string, " dormand_prince", &error);
+			}
 			sprintf(temp_string," length %g ", graphics->streamline_length);
 			append_string(&graphics_string,temp_string,&error);
 			append_string(&graphics_string,
@@ -2690,6 +2720,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 				}
 		if (buildNow)
 		{
+			ZINC_INSTRUMENT_COUNT(graphics->buildsCount);
+			ZINC_INSTRUMENT_COUNT(instrumentationCounters.graphicsBuilds);
+			ZINC_INSTRUMENT_TIME_SCOPE(buildTimer, graphics->buildTime);
+			ZINC_INSTRUMENT_TIME_SCOPE(totalBuildTimer, instrumentationCounters.graphicsBuildTime);
 			cmzn_fieldcache_clear_location(graphics_to_object_data->field_cache);
 			cmzn_fieldcache_set_time(graphics_to_object_data->field_cache, graphics_to_object_data->time);
 			Computed_field *coordinate_field = graphics->coordinate_field;
@@ -3039,13 +3073,21 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								{
 									if (g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
+										// welded iso-surfaces are indexed triangle strips
 										GT_surface_vertex_buffers *surfaces =
-											CREATE(GT_surface_vertex_buffers)(g_SH_DISCONTINUOUS_TEXMAP, graphics->render_polygon_mode);
+											CREATE(GT_surface_vertex_buffers)(graphics->contours_welded ?
+												g_SHADED_TEXMAP : g_SH_DISCONTINUOUS_TEXMAP, graphics->render_polygon_mode);
 										if (!GT_OBJECT_ADD(GT_surface_vertex_buffers)(graphics->graphics_object, surfaces))
 										{
 											DESTROY(GT_surface_vertex_buffers)(&surfaces);
 											return_code = 0;
 										}
+										if (graphics->contours_welded)
+										{
+											// start welding vertices into new buffers
+											Iso_surface_welder_destroy(&(graphics->iso_surface_welder));
+											graphics->iso_surface_welder = Iso_surface_welder_create();
+										}
 									}
 									else if (g_POLYLINE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
@@ -3062,6 +3104,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 									GT_object_reset_buffer_binding(graphics->graphics_object);
 								if (return_code && (graphics_to_object_data->iteration_mesh))
 								{
+									if (!graphics->isoscalar_ranges)
+										graphics->isoscalar_ranges = new Element_scalar_ranges();
+									graphics->isoscalar_ranges->setScalarFieldAndTime(
+										graphics->isoscalar_field, graphics_to_object_data->time);
 									if (g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
 										graphics_to_object_data->iso_surface_specification =
@@ -3078,6 +3124,9 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 									{
 										Iso_surface_specification_destroy(&graphics_to_object_data->iso_surface_specification);
 									}
+									// welder is kept between steps of an incremental build only
+									if (DS_LABEL_INDEX_INVALID == graphics->incrementalBuildIndex)
+										Iso_surface_welder_destroy(&(graphics->iso_surface_welder));
 								}
 							}
 						} break;
@@ -3100,6 +3149,8 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 							}
 							else
 								GT_object_reset_buffer_binding(graphics->graphics_object);
+							Streamline_buffers streamline_buffers;
+							graphics_to_object_data->streamline_buffers = &streamline_buffers;
 							if (graphics->seed_element)
 							{
 								return_code = FE_element_to_graphics_object(
@@ -3127,6 +3178,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 									return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
 								}
 							}
+							graphics_to_object_data->streamline_buffers = 0;
 						} break;
 						default:
 						{
@@ -3408,6 +3460,47 @@ cmzn_field_change_flags cmzn_graphics_get_most_significant_field_change(
 	return change;
 }
 
+/**
+ * Discard cached ranges of isoscalar field for elements affected by changes
+ * to it. Elements added or removed are always discarded as their indexes may
+ * be reused.
+ */
+void cmzn_graphics_isoscalar_ranges_field_change(cmzn_graphics *graphics,
+	cmzn_fieldmoduleevent *event)
+{
+	Element_scalar_ranges *ranges = graphics->isoscalar_ranges;
+	if (!ranges)
+		return;
+	if (!graphics->isoscalar_field)
+	{
+		ranges->clear();
+		return;
+	}
+	const cmzn_field_change_flags fieldChange =
+		cmzn_fieldmoduleevent_get_field_change_flags(event, graphics->isoscalar_field);
+	if (fieldChange & (CMZN_FIELD_CHANGE_FLAG_DEFINITION | CMZN_FIELD_CHANGE_FLAG_FULL_RESULT))
+	{
+		ranges->clear();
+		return;
+	}
+	const int domainDimension = cmzn_graphics_get_domain_dimension(graphics);
+	FE_region_changes *feRegionChanges = event->getFeRegionChanges();
+	DsLabelsChangeLog *elementChangeLog = ((feRegionChanges) && (0 < domainDimension)) ?
+		feRegionChanges->getElementChangeLog(domainDimension) : 0;
+	if (!elementChangeLog)
+	{
+		if (fieldChange & CMZN_FIELD_CHANGE_FLAG_PARTIAL_RESULT)
+			ranges->clear();
+		return;
+	}
+	if ((fieldChange & CMZN_FIELD_CHANGE_FLAG_PARTIAL_RESULT) ||
+		(elementChangeLog->getChangeSummary() & (DS_LABEL_CHANGE_TYPE_ADD | DS_LABEL_CHANGE_TYPE_REMOVE)))
+	{
+		feRegionChanges->propagateToDimension(domainDimension);
+		ranges->clearChanged(*elementChangeLog);
+	}
+}
+
 } // namespace anonymous
 
 int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
@@ -3415,6 +3508,7 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 {
 	cmzn_graphics_field_change_data *change_data =
 		static_cast<cmzn_graphics_field_change_data *>(change_data_void);
+	cmzn_graphics_isoscalar_ranges_field_change(graphics, change_data->event);
 	if (change_data->selection_changed && (CMZN_GRAPHICS_TYPE_STREAMLINES != graphics->graphics_type))
 		cmzn_graphics_update_selected(graphics, (void *)NULL);
 	if (0 == graphics->graphics_object)
@@ -3473,8 +3567,10 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 			}
 			if (partialUpdate)
 			{
+				// welded contours share vertices between elements so cannot be partially rebuilt
 				if (graphics->graphics_type == CMZN_GRAPHICS_TYPE_STREAMLINES ||
-					graphics->graphics_type == CMZN_GRAPHICS_TYPE_POINTS)
+					graphics->graphics_type == CMZN_GRAPHICS_TYPE_POINTS ||
+					((graphics->graphics_type == CMZN_GRAPHICS_TYPE_CONTOURS) && graphics->contours_welded))
 				{
 					cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 					return 1;
@@ -3677,6 +3773,7 @@ int cmzn_graphics_copy_without_graphics_object(
 					source->first_isovalue, source->last_isovalue);
 			}
 			cmzn_graphics_contours_set_decimation_threshold(contours, source->decimation_threshold);
+			cmzn_graphics_contours_set_welded(contours, source->contours_welded);
 			cmzn_graphics_contours_destroy(&contours);
 		}
 		else
@@ -3755,6 +3852,7 @@ int cmzn_graphics_copy_without_graphics_object(
 		REACCESS(Computed_field)(&(destination->stream_vector_field),
 			source->stream_vector_field);
 		destination->streamlines_track_direction = source->streamlines_track_direction;
+		destination->streamlines_integration_method = source->streamlines_integration_method;
 		destination->streamline_length=source->streamline_length;
 		if (destination->seed_nodeset)
 		{
@@ -3917,7 +4015,8 @@ int cmzn_graphics_same_non_trivial(cmzn_graphics *graphics,
 			return_code=(graphics->number_of_isovalues==
 				second_graphics->number_of_isovalues)&&
 				(graphics->decimation_threshold==second_graphics->decimation_threshold)&&
-				(graphics->isoscalar_field==second_graphics->isoscalar_field);
+				(graphics->isoscalar_field==second_graphics->isoscalar_field)&&
+				(graphics->contours_welded==second_graphics->contours_welded);
 			if (return_code)
 			{
 				if (graphics->isovalues)
@@ -3998,6 +4097,7 @@ int cmzn_graphics_same_non_trivial(cmzn_graphics *graphics,
 			return_code=
 				(graphics->stream_vector_field==second_graphics->stream_vector_field)&&
 				(graphics->streamlines_track_direction == second_graphics->streamlines_track_direction) &&
+				(graphics->streamlines_integration_method == second_graphics->streamlines_integration_method) &&
 				(graphics->streamline_length==second_graphics->streamline_length)&&
 				(((graphics->seed_nodeset==0) && (second_graphics->seed_nodeset==0)) ||
 					((graphics->seed_nodeset) && (second_graphics->seed_nodeset) &&
@@ -4897,6 +4997,10 @@ int cmzn_graphics_detach_fields(struct cmzn_graphics *graphics, void *dummy_void
 		{
 			DEACCESS(Computed_field)(&(graphics->isoscalar_field));
 		}
+		if (graphics->isoscalar_ranges)
+		{
+			graphics->isoscalar_ranges->clear();
+		}
 		if (graphics->point_orientation_scale_field)
 		{
 			DEACCESS(Computed_field)(&(graphics->point_orientation_scale_field));
@@ -5244,6 +5348,41 @@ char *cmzn_graphics_streamlines_track_direction_enum_to_string(
 	return (string ? duplicate_string(string) : 0);
 }
 
+class cmzn_graphics_streamlines_integration_method_conversion
+{
+public:
+	static const char *to_string(enum cmzn_graphics_streamlines_integration_method method)
+	{
+		const char *enum_string = 0;
+		switch (method)
+		{
+		case CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER:
+			enum_string = "IMPROVED_EULER";
+			break;
+		case CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_DORMAND_PRINCE:
+			enum_string = "DORMAND_PRINCE";
+			break;
+		default:
+			break;
+		}
+		return enum_string;
+	}
+};
+
+enum cmzn_graphics_streamlines_integration_method cmzn_graphics_streamlines_integration_method_enum_from_string(
+	const char *string)
+{
+	return string_to_enum<enum cmzn_graphics_streamlines_integration_method,
+		cmzn_graphics_streamlines_integration_method_conversion>(string);
+}
+
+char *cmzn_graphics_streamlines_integration_method_enum_to_string(
+	enum cmzn_graphics_streamlines_integration_method method)
+{
+	const char *string = cmzn_graphics_streamlines_integration_method_conversion::to_string(method);
+	return (string ? duplicate_string(string) : 0);
+}
+
 class cmzn_graphics_streamlines_colour_data_type_conversion
 {
 public:
@@ -5375,6 +5514,8 @@ int cmzn_graphics_contours_set_isoscalar_field(
 		cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
 		if (isoscalar_field != graphics->isoscalar_field)
 		{
+			if (graphics->isoscalar_ranges)
+				graphics->isoscalar_ranges->clear();
 			REACCESS(Computed_field)(&(graphics->isoscalar_field), isoscalar_field);
 			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 		}
@@ -5537,6 +5678,29 @@ int cmzn_graphics_contours_set_range_isovalues(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+bool cmzn_graphics_contours_is_welded(cmzn_graphics_contours_id contours)
+{
+	if (contours)
+		return reinterpret_cast<cmzn_graphics_id>(contours)->contours_welded;
+	return false;
+}
+
+int cmzn_graphics_contours_set_welded(cmzn_graphics_contours_id contours,
+	bool welded)
+{
+	if (contours)
+	{
+		cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
+		if (welded != graphics->contours_welded)
+		{
+			graphics->contours_welded = welded;
+			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_graphics_lines_id cmzn_graphics_cast_lines(cmzn_graphics_id graphics)
 {
 	if (graphics && (graphics->graphics_type == CMZN_GRAPHICS_TYPE_LINES))
@@ -5674,6 +5838,33 @@ int cmzn_graphics_streamlines_set_track_direction(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+enum cmzn_graphics_streamlines_integration_method
+	cmzn_graphics_streamlines_get_integration_method(
+		cmzn_graphics_streamlines_id streamlines)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics)
+		return graphics->streamlines_integration_method;
+	return CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID;
+}
+
+int cmzn_graphics_streamlines_set_integration_method(
+	cmzn_graphics_streamlines_id streamlines,
+	enum cmzn_graphics_streamlines_integration_method integration_method)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics && (integration_method != CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID))
+	{
+		if (integration_method != graphics->streamlines_integration_method)
+		{
+			graphics->streamlines_integration_method = integration_method;
+			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 double cmzn_graphics_streamlines_get_track_length(
 	cmzn_graphics_streamlines_id streamlines)
 {
@@ -6637,6 +6828,7 @@ struct GT_object *cmzn_graphics_copy_graphics_object(struct cmzn_graphics *graph
 				graphics_to_object_data.selection_group_field = cmzn_scene_get_selection_field(
 					graphics->scene);
 				graphics_to_object_data.iso_surface_specification = 0;
+				graphics_to_object_data.streamline_buffers = 0;
 				for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
 				{
 					graphics_to_object_data.top_level_number_in_xi[i] = 0;
@@ -23,12 +23,16 @@
 #include "graphics/font.h"
 #include "graphics/graphics_object.h"
 #include "general/enumerator.h"
+#include "general/instrumentation.hpp"
 #include "general/list.h"
 #include "graphics/material.h"
 #include "graphics/spectrum.h"
 
 struct cmzn_graphicspointattributes;
 struct cmzn_graphicslineattributes;
+class Element_scalar_ranges;
+struct Iso_surface_welder;
+class Streamline_buffers;
 
 struct cmzn_graphics
 /*******************************************************************************
@@ -78,6 +82,12 @@ finite element group scene.
 		first_isovalue to last_isovalue including these values for n>1 */
 	double *isovalues, first_isovalue, last_isovalue,
 		decimation_threshold;
+	/* cached ranges of isoscalar_field over elements for culling */
+	Element_scalar_ranges *isoscalar_ranges;
+	/* flag to share vertices of iso-surfaces between elements */
+	bool contours_welded;
+	/* shared iso-surface vertices, for duration of a welded build only */
+	Iso_surface_welder *iso_surface_welder;
 
 	/* point attributes */
 	cmzn_glyph *glyph;
@@ -109,6 +119,7 @@ finite element group scene.
 	/* streamlines */
 	struct Computed_field *stream_vector_field;
 	enum cmzn_graphics_streamlines_track_direction streamlines_track_direction;
+	enum cmzn_graphics_streamlines_integration_method streamlines_integration_method;
 	FE_value streamline_length;
 	enum cmzn_graphics_streamlines_colour_data_type streamlines_colour_data_type;
 	/* streamline seed nodeset and field giving mesh location */
@@ -144,6 +155,11 @@ finite element group scene.
 	/* flag indicating that this settings needs to be regenerated when time changes */
 	bool timeDependent;
 	enum cmzn_scenecoordinatesystem coordinate_system;
+#if defined (ZINC_BUILD_INSTRUMENTATION)
+	/* number of builds of the graphics_object and total time in seconds */
+	unsigned long long buildsCount;
+	double buildTime;
+#endif
 // 	/* for accessing objects */
 	int access_count;
 
@@ -318,6 +334,8 @@ struct cmzn_graphics_to_graphics_object_data
 	FE_value *data_copy_buffer;
 
 	struct Iso_surface_specification *iso_surface_specification;
+	/* reused for tracing all streamlines in a build */
+	Streamline_buffers *streamline_buffers;
 	struct cmzn_scenefilter *scenefilter;
 	/* additional values for passing to element_to_graphics_object */
 	struct cmzn_graphics *graphics;
@@ -715,6 +733,12 @@ enum cmzn_graphics_streamlines_track_direction cmzn_graphics_streamlines_track_d
 char *cmzn_graphics_streamlines_track_direction_enum_to_string(
 	enum cmzn_graphics_streamlines_track_direction direction);
 
+enum cmzn_graphics_streamlines_integration_method cmzn_graphics_streamlines_integration_method_enum_from_string(
+	const char *string);
+
+char *cmzn_graphics_streamlines_integration_method_enum_to_string(
+	enum cmzn_graphics_streamlines_integration_method method);
+
 enum cmzn_graphics_streamlines_colour_data_type cmzn_graphics_streamlines_colour_data_type_enum_from_string(
 	const char *string);
 
@@ -878,6 +878,56 @@ void Graphics_vertex_array::fill_element_index(
 	}
 }
 
+void Graphics_vertex_array::fill_element_strip(unsigned int number_of_indices,
+	const unsigned int *indices)
+{
+	unsigned int last_entry = get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START);
+	unsigned int last_count = 0;
+	if (last_entry > 0)
+	{
+		unsigned int count_before_last = 0;
+		unsigned int last_number_of_strips = 0;
+		get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+			last_entry - 1,	1, &count_before_last);
+		get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+			last_entry - 1,	1, &last_number_of_strips);
+		last_count = count_before_last + last_number_of_strips;
+	}
+	add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+		1, 1, &last_count);
+	unsigned int number_of_strips = (number_of_indices > 0) ? 1 : 0;
+	add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+		1, 1, &number_of_strips);
+	if (0 == number_of_strips)
+		return;
+	unsigned int number_of_strip_index_entries = get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START);
+	unsigned int index_start_for_strip = 0;
+	if (number_of_strip_index_entries > 0)
+	{
+		unsigned int points_per_strip = 0;
+		get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+			number_of_strip_index_entries - 1,	1, &index_start_for_strip);
+		get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+			number_of_strip_index_entries - 1,	1, &points_per_strip);
+		index_start_for_strip += points_per_strip;
+	}
+	add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_ARRAY,
+		1, number_of_indices, indices);
+	add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+		1, 1, &index_start_for_strip);
+	add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+		1, 1, &number_of_indices);
+}
+
 
 /*****************************************************************************//**
  * Resets the number of vertices defined in the buffer to zero.  Does not actually
@@ -332,8 +332,40 @@ public:
 	void fill_element_index(unsigned vertex_start, unsigned int number_of_xi1, unsigned int number_of_xi2,
 		enum Graphics_vertex_array_shape_type shape_type);
 
+	/* add a single triangle strip through the supplied global vertex indices
+	 * for the last surface entry, e.g. for surfaces sharing vertices */
+	void fill_element_strip(unsigned int number_of_indices, const unsigned int *indices);
+
 };
 
+/**
+ * Get the vertex indices of a triangle in a triangle strip, swapping the first
+ * two for odd triangles so all have the same winding. Exporters converting
+ * strips to triangles should use this so they all skip the same triangles.
+ * @param indices  Vertex indices of the strip.
+ * @param position  Triangle number from 0 to points in strip - 3.
+ * @param triangle_indices  On return, the vertex indices of the triangle.
+ * @return  True if the triangle is valid, false if it repeats a vertex, e.g. a
+ * degenerate triangle joining strips, and should be skipped.
+ */
+inline bool Graphics_vertex_array_get_strip_triangle(const unsigned int *indices,
+	unsigned int position, unsigned int triangle_indices[3])
+{
+	if (0 == (position % 2))
+	{
+		triangle_indices[0] = indices[position];
+		triangle_indices[1] = indices[position + 1];
+	}
+	else
+	{
+		triangle_indices[0] = indices[position + 1];
+		triangle_indices[1] = indices[position];
+	}
+	triangle_indices[2] = indices[position + 2];
+	return (triangle_indices[0] != triangle_indices[1]) && (triangle_indices[1] != triangle_indices[2])
+		&& (triangle_indices[2] != triangle_indices[0]);
+}
+
 int fill_glyph_graphics_vertex_array(struct Graphics_vertex_array *array, int vertex_location,
 	unsigned int number_of_points, Triple *point_list, Triple *axis1_list, Triple *axis2_list,
 	Triple *axis3_list, Triple *scale_list,	int n_data_components, GLfloat *data,
@@ -1124,45 +1124,31 @@ int Graphics_object_create_colour_buffer_from_data(GT_object *object,
 		{
 			if (ALLOCATE(*colour_buffer, GLfloat, 4 * data_vertex_count))
 			{
-				GLfloat *data_vertex;
-				GLfloat *colour_vertex;
-				unsigned int i;
-				ZnReal colData[4];
+				GLfloat material_rgba[4] = { 0.0, 0.0, 0.0, 1.0 };
 				if (!cmzn_spectrum_is_material_overwrite(spectrum))
 				{
 					Colour diffuse_colour;
 					Graphical_material_get_diffuse(material, &diffuse_colour);
 					MATERIAL_PRECISION prec;
 					Graphical_material_get_alpha(material, &prec);
-					GLfloat alpha = prec;
-					for (i = 0 ; i < data_vertex_count ; i++)
-					{
-						colData[0] = diffuse_colour.red;
-						colData[1] = diffuse_colour.green;
-						colData[2] = diffuse_colour.blue;
-						colData[3] = alpha;
-					}
+					material_rgba[0] = diffuse_colour.red;
+					material_rgba[1] = diffuse_colour.green;
+					material_rgba[2] = diffuse_colour.blue;
+					material_rgba[3] = prec;
 				}
-				colour_vertex = *colour_buffer;
-				data_vertex = data_buffer;
-				FE_value *feData = new FE_value[data_values_per_vertex];
-				for (i = 0 ; i < data_vertex_count ; i++)
+				Spectrum_colour_mapper colour_mapper(spectrum);
+				if (colour_mapper.mapValues(data_values_per_vertex, data_vertex_count,
+					data_buffer, material_rgba, *colour_buffer))
 				{
-					CAST_TO_FE_VALUE(feData,data_vertex,(int)data_values_per_vertex);
-					Spectrum_value_to_rgba(spectrum, data_values_per_vertex,
-							feData, colData);
-					for (unsigned int j = 0 ; j < 4 ; j++)
-					{
-						colour_vertex[j] = (GLfloat)colData[j];
-					}
-					colour_vertex += 4;
-					data_vertex += data_values_per_vertex;
+					*colour_vertex_count = data_vertex_count;
+					*colour_values_per_vertex = 4;
+				}
+				else
+				{
+					DEALLOCATE(*colour_buffer);
+					return_code = 0;
 				}
 				Spectrum_end_value_to_rgba(spectrum);
-
-				*colour_vertex_count = data_vertex_count;
-				*colour_values_per_vertex = 4;
-				delete[] feData;
 			}
 			else
 			{
@@ -391,28 +391,19 @@ int draw_surface_stl(Stl_context& stl_context, gtObject *object)
 								unsigned int *indices = &index_vertex_buffer[index_start_for_strip];
 								Triple point1 = {0.0, 0.0, 0.0}, point2 = {0.0, 0.0, 0.0},
 									point3 = {0.0, 0.0, 0.0};
+								unsigned int triangle[3];
 								for (unsigned int j =0; j<points_per_strip - 2; j++)
 								{
+									if (!Graphics_vertex_array_get_strip_triangle(indices, j, triangle))
+										continue;
 									point1[2] = 0.0;
 									point2[2] = 0.0;
 									point3[2] = 0.0;
-									if (0 == (j % 2))
+									for (unsigned int num = 0; num < position_values_per_vertex; num++)
 									{
-										for (unsigned int num = 0; num < position_values_per_vertex; num++)
-										{
-											point1[num] = position_buffer[indices[j]*position_values_per_vertex + num];
-											point2[num] = position_buffer[indices[j + 1]*position_values_per_vertex + num];
-											point3[num] = position_buffer[indices[j + 2]*position_values_per_vertex + num];
-										}
-									}
-									else
-									{
-										for (unsigned int num = 0; num < position_values_per_vertex; num++)
-										{
-											point1[num] = position_buffer[indices[j + 1]*position_values_per_vertex + num];
-											point2[num] = position_buffer[indices[j]*position_values_per_vertex + num];
-											point3[num] = position_buffer[indices[j + 2]*position_values_per_vertex + num];
-										}
+										point1[num] = position_buffer[triangle[0]*position_values_per_vertex + num];
+										point2[num] = position_buffer[triangle[1]*position_values_per_vertex + num];
+										point3[num] = position_buffer[triangle[2]*position_values_per_vertex + num];
 									}
 									stl_context.write_triangle(point1, point2, point3);
 								}
@@ -703,17 +703,13 @@ static int render_surface_vertex_buffer_to_finite_elements(struct Render_to_fini
 										object->vertex_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 											strip_start+i, 1, &points_per_strip);
 										unsigned int *indices = &index_vertex_buffer[index_start_for_strip];
+										unsigned int triangle[3];
 										for (unsigned int j =0; j<points_per_strip - 2; j++)
 										{
-											if (0 == (j % 2))
+											if (Graphics_vertex_array_get_strip_triangle(indices, j, triangle))
 											{
 												data->addTriangle(data_values_per_vertex,
-													&nodes[indices[j]], &nodes[indices[j + 1]], &nodes[indices[j + 2]]);
-											}
-											else
-											{
-												data->addTriangle(data_values_per_vertex,
-													&nodes[indices[j + 1]], &nodes[indices[j]], &nodes[indices[j + 2]]);
+													&nodes[triangle[0]], &nodes[triangle[1]], &nodes[triangle[2]]);
 											}
 										}
 									}
@@ -12,6 +12,7 @@
 #include "general/debug.h"
 #include "graphics/auxiliary_graphics_types.h"
 #include "graphics/scene.h"
+#include "graphics/scene.hpp"
 #include "graphics/graphics_object.h"
 #include "graphics/triangle_mesh.hpp"
 #include "graphics/graphics_object_private.hpp"
@@ -93,19 +94,14 @@ int draw_surface_triangle_mesh(Triangle_mesh& trimesh,
 						vertex_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 							strip_start+i, 1, &points_per_strip);
 						unsigned int *indices = &index_vertex_buffer[index_start_for_strip];
+						unsigned int triangle[3];
 						for (unsigned int j = 0; j < points_per_strip - 2; j++)
 						{
-							if (0 == (j % 2))
+							if (Graphics_vertex_array_get_strip_triangle(indices, j, triangle))
 							{
-								trimesh.add_triangle(tri_vertex[indices[j]],
-									tri_vertex[indices[j+1]],
-									tri_vertex[indices[j+2]]);
-							}
-							else
-							{
-								trimesh.add_triangle(tri_vertex[indices[j+1]],
-									tri_vertex[indices[j]],
-									tri_vertex[indices[j+2]]);
+								trimesh.add_triangle(tri_vertex[triangle[0]],
+									tri_vertex[triangle[1]],
+									tri_vertex[triangle[2]]);
 							}
 						}
 					}
@@ -207,6 +203,42 @@ int render_scene_triangularisation(cmzn_scene_id scene,
 	return return_code;
 }
 
+int export_scene_triangle_mesh(cmzn_scene_id scene, cmzn_scenefilter_id filter,
+	enum Triangle_mesh_file_format format, std::string& output)
+{
+	if (!scene)
+	{
+		display_message(ERROR_MESSAGE, "export_scene_triangle_mesh.  Invalid argument(s)");
+		return 0;
+	}
+	build_Scene(scene, filter);
+	double minimums[3], maximums[3];
+	ZnReal tolerance = 0.0;
+	if (CMZN_OK == cmzn_scene_get_coordinates_range(scene, filter, minimums, maximums))
+	{
+		for (int c = 0; c < 3; ++c)
+			if (maximums[c] - minimums[c] > tolerance)
+				tolerance = static_cast<ZnReal>(maximums[c] - minimums[c]);
+		tolerance *= 1.0E-6;
+	}
+	Triangle_mesh trimesh(tolerance);
+	int return_code = render_scene_triangularisation(scene, filter, &trimesh);
+	if (return_code)
+	{
+		if (format == TRIANGLE_MESH_FILE_FORMAT_BINARY_PLY)
+		{
+			trimesh.write_binary_ply(output);
+		}
+		else
+		{
+			char *solid_name = cmzn_region_get_name(cmzn_scene_get_region_internal(scene));
+			trimesh.write_binary_stl(output, solid_name);
+			DEALLOCATE(solid_name);
+		}
+	}
+	return return_code;
+}
+
 Render_graphics_triangularisation::~Render_graphics_triangularisation()
 {
 	delete trimesh;
@@ -14,6 +14,7 @@
 #include "graphics/render.hpp"
 #include "graphics/scene_coordinate_system.hpp"
 #include "graphics/triangle_mesh.hpp"
+#include <string>
 
 struct Graphics_buffer;
 
@@ -158,4 +159,24 @@ public:
 int render_scene_triangularisation(cmzn_scene_id scene,
 	cmzn_scenefilter_id filter, Triangle_mesh *trimesh);
 
+enum Triangle_mesh_file_format
+{
+	TRIANGLE_MESH_FILE_FORMAT_BINARY_STL,
+	TRIANGLE_MESH_FILE_FORMAT_BINARY_PLY
+};
+
+/***************************************************************************//**
+ * Welds the visible surfaces in the scene tree into a triangle mesh and appends
+ * it in a binary format to output. Vertices are merged within a tolerance of
+ * 1.0E-6 of the size of the scene. Unlike export_to_stl, glyphs are not output.
+ *
+ * @param scene  The scene to output.
+ * @param filter  Optional filter on scene.
+ * @param format  Binary STL or PLY.
+ * @param output  String to append binary data to.
+ * @return  1 on success, 0 on failure.
+ */
+int export_scene_triangle_mesh(cmzn_scene_id scene, cmzn_scenefilter_id filter,
+	enum Triangle_mesh_file_format format, std::string& output);
+
 #endif /* !defined (RENDER_TRIANGULARISATION_HPP) */
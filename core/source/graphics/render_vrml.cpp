@@ -1788,33 +1788,20 @@ DESCRIPTION :
 						vertex_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 							strip_start+i, 1, &points_per_strip);
 						unsigned int *indices = &index_vertex_buffer[index_start_for_strip];
+						unsigned int triangle[3];
 						for (unsigned int j = 0; j < points_per_strip - 2; j++)
 						{
-							if (0 == (j % 2))
+							if (!Graphics_vertex_array_get_strip_triangle(indices, j, triangle))
+								continue;
+							if (CMZN_GRAPHICS_RENDER_POLYGON_MODE_WIREFRAME == render_polygon_mode)
 							{
-								if (CMZN_GRAPHICS_RENDER_POLYGON_MODE_WIREFRAME == render_polygon_mode)
-								{
-									fprintf(vrml_file,"      %d,%d,%d,%d,-1\n",
-										indices[j],indices[j+1], indices[j+2], indices[j]);
-								}
-								else
-								{
-									fprintf(vrml_file,"      %d,%d,%d,-1\n",
-										indices[j], indices[j+1], indices[j+2]);
-								}
+								fprintf(vrml_file,"      %d,%d,%d,%d,-1\n",
+									triangle[0], triangle[1], triangle[2], triangle[0]);
 							}
 							else
 							{
-								if (CMZN_GRAPHICS_RENDER_POLYGON_MODE_WIREFRAME == render_polygon_mode)
-								{
-									fprintf(vrml_file,"      %d,%d,%d,%d,-1\n",
-										indices[j+1],indices[j], indices[j+2], indices[j+1]);
-								}
-								else
-								{
-									fprintf(vrml_file,"      %d,%d,%d,-1\n",
-										indices[j+1], indices[j], indices[j+2]);
-								}
+								fprintf(vrml_file,"      %d,%d,%d,-1\n",
+									triangle[0], triangle[1], triangle[2]);
 							}
 						}
 					}
@@ -431,37 +431,22 @@ DESCRIPTION :
 						vertex_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 							strip_start+i, 1, &points_per_strip);
 						unsigned int *indices = &index_vertex_buffer[index_start_for_strip];
+						unsigned int triangle[3];
 						for (j =0; j<points_per_strip - 2; j++)
 						{
-							if (0 == (j % 2))
+							if (!Graphics_vertex_array_get_strip_triangle(indices, j, triangle))
+								continue;
+							if (texture_coordinate0_buffer)
 							{
-								if (texture_coordinate0_buffer)
-								{
-									fprintf(file, "f %d/%d %d/%d %d/%d\n",
-										indices[j]+1, indices[j]+1,
-										indices[j+1]+1, indices[j+1]+1,
-										indices[j+2]+1, indices[j+2]+1);
-								}
-								else
-								{
-									fprintf(file, "f %d %d %d\n",
-										indices[j]+1,indices[j+1]+1,indices[j+2]+1);
-								}
+								fprintf(file, "f %d/%d %d/%d %d/%d\n",
+									triangle[0]+1, triangle[0]+1,
+									triangle[1]+1, triangle[1]+1,
+									triangle[2]+1, triangle[2]+1);
 							}
 							else
 							{
-								if (texture_coordinate0_buffer)
-								{
-									fprintf(file, "f %d/%d %d/%d %d/%d\n",
-										indices[j+1]+1, indices[j+1]+1,
-										indices[j]+1, indices[j]+1,
-										indices[j+2]+1, indices[j+2]+1);
-								}
-								else
-								{
-									fprintf(file, "f %d %d %d\n",
-										indices[j+1]+1,indices[j]+1,indices[j+2]+1);
-								}
+								fprintf(file, "f %d %d %d\n",
+									triangle[0]+1,triangle[1]+1,triangle[2]+1);
 							}
 						}
 					}
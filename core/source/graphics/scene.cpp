@@ -44,6 +44,7 @@ FILE : scene.cpp
 #include "general/callback_private.h"
 #include "general/debug.h"
 #include "general/enumerator_conversion.hpp"
+#include "general/instrumentation.hpp"
 #include "general/matrix_vector.h"
 #include "general/mystring.h"
 #include "mesh/cmiss_node_private.hpp"
@@ -1020,6 +1021,7 @@ static int cmzn_scene_build_graphics_objects(
 	{
 		if ((cmzn_scene_get_number_of_graphics(scene) > 0))
 		{
+			ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_scene_build_graphics_objects", "graphics");
 			graphics_to_object_data.name_prefix = renderer->name_prefix;
 			graphics_to_object_data.graphics = 0;
 			graphics_to_object_data.glyph_gt_object = 0;
@@ -1042,6 +1044,7 @@ static int cmzn_scene_build_graphics_objects(
 			graphics_to_object_data.incrementalBuild = renderer->getIncrementalBuild();
 			graphics_to_object_data.selection_group_field = cmzn_scene_get_selection_field(scene);
 			graphics_to_object_data.iso_surface_specification = 0;
+			graphics_to_object_data.streamline_buffers = 0;
 			for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
 			{
 				graphics_to_object_data.top_level_number_in_xi[i] = 0;
@@ -40,6 +40,7 @@ November 97 Created from rendering part of Drawing.
 #include "general/enumerator_private.hpp"
 #include "general/geometry.h"
 #include "general/image_utilities.h"
+#include "general/instrumentation.hpp"
 #include "general/list.h"
 #include "general/list_private.h"
 #include "general/indexed_list_private.h"
@@ -1923,6 +1924,7 @@ Scene_viewer_render_scene_in_viewport to access this function.
 	ENTER(Scene_viewer_render_scene_private);
 	if (scene_viewer)
 	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "Scene_viewer_render_scene", "render");
 		return_code=1;
 		if ((!left) && (!bottom) && (!right) && (!top))
 		{
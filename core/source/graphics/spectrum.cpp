@@ -1893,7 +1893,9 @@ Uses the <spectrum> to calculate RGBA components to represent the
 		GLfloat frgba[4];
 		CAST_TO_OTHER(frgba,rgba,GLfloat,4);
 		render_data.rgba = frgba;
-		GLfloat *fData = new GLfloat[number_of_data_components];
+		GLfloat fDataBuffer[16];
+		GLfloat *fData = (number_of_data_components <= 16) ? fDataBuffer :
+			new GLfloat[number_of_data_components];
 		CAST_TO_OTHER(fData,data,GLfloat,number_of_data_components);
 		render_data.data = fData;
 		render_data.number_of_data_components = number_of_data_components;
@@ -1902,7 +1904,8 @@ Uses the <spectrum> to calculate RGBA components to represent the
 			spectrum->list_of_components);
 		CAST_TO_OTHER(rgba, frgba, ZnReal, 4);
 
-		delete[] fData;
+		if (fData != fDataBuffer)
+			delete[] fData;
 	}
 	else
 	{
@@ -1946,6 +1949,238 @@ Resets the caches and graphics state after rendering values.
 	return (return_code);
 } /* Spectrum_end_value_to_rgba */
 
+static int Spectrum_colour_mapper_get_component(
+	struct cmzn_spectrumcomponent *component, void *components_void)
+{
+	static_cast<std::vector<cmzn_spectrumcomponent *> *>(components_void)->push_back(component);
+	return 1;
+}
+
+Spectrum_colour_mapper::Spectrum_colour_mapper(cmzn_spectrum *spectrumIn) :
+	spectrum(spectrumIn),
+	field_lookup(false)
+{
+	if (this->spectrum)
+	{
+		std::vector<cmzn_spectrumcomponent *> list_components;
+		FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
+			Spectrum_colour_mapper_get_component, (void *)&list_components,
+			this->spectrum->list_of_components);
+		const size_t number_of_components = list_components.size();
+		for (size_t i = 0; i < number_of_components; ++i)
+		{
+			cmzn_spectrumcomponent *list_component = list_components[i];
+			if (!list_component->active)
+				continue;
+			if ((list_component->component_scale == CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_INVALID) &&
+				(list_component->is_field_lookup))
+			{
+				this->field_lookup = true;
+				continue;
+			}
+			if ((list_component->colour_mapping_type == CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BANDED) ||
+				(list_component->colour_mapping_type == CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_STEP))
+				continue;
+			Component component;
+			component.component_number = list_component->component_number;
+			component.minimum = list_component->minimum;
+			component.maximum = list_component->maximum;
+			component.extend_above = list_component->extend_above;
+			component.extend_below = list_component->extend_below;
+			component.reverse = list_component->reverse;
+			component.component_scale = list_component->component_scale;
+			component.exaggeration = list_component->exaggeration;
+			component.min_value = list_component->min_value;
+			component.max_value = list_component->max_value;
+			component.colour_mapping_type = list_component->colour_mapping_type;
+			this->components.push_back(component);
+		}
+	}
+}
+
+/**
+ * Apply component to the colours of all values, as for
+ * cmzn_spectrumcomponent_activate.
+ */
+void Spectrum_colour_mapper::mapComponentValues(const Component& component,
+	int number_of_data_components, int number_of_values, const GLfloat *data,
+	GLfloat *rgba)
+{
+	const GLfloat *data_value = data + component.component_number;
+	GLfloat *colour = rgba;
+	for (int i = 0; i < number_of_values; ++i, data_value += number_of_data_components, colour += 4)
+	{
+		const ZnReal data_component = *data_value;
+		if (!(((data_component >= component.minimum) || component.extend_below) &&
+			((data_component <= component.maximum) || component.extend_above)))
+			continue;
+		/* first get value (normalised 0 to 1) from type */
+		GLfloat value = 0.0;
+		if (component.maximum != component.minimum)
+		{
+			switch (component.component_scale)
+			{
+			case CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LINEAR:
+				value = (data_component - component.minimum)/
+					(component.maximum - component.minimum);
+				break;
+			case CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LOG:
+				if (component.exaggeration < 0)
+				{
+					value = 1.0 - log(1 - component.exaggeration*
+						(component.maximum - data_component)/
+						(component.maximum - component.minimum))/
+						log(1 - component.exaggeration);
+				}
+				else
+				{
+					value = log(1 + component.exaggeration*
+						(data_component - component.minimum)/
+						(component.maximum - component.minimum))/
+						log(1 + component.exaggeration);
+				}
+				break;
+			default:
+				break;
+			}
+			/* ensure 0 - 1 */
+			if (value > 1.0)
+				value = 1.0;
+			if (value < 0.0)
+				value = 0.0;
+		}
+		else
+		{
+			value = (data_component <= component.minimum) ? 0.0 : 1.0;
+		}
+		/* reverse the direction if necessary */
+		if (component.reverse)
+			value = 1.0 - value;
+		/* apply the value minimums and maximums */
+		value = component.min_value + (component.max_value - component.min_value)*value;
+		switch (component.colour_mapping_type)
+		{
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_ALPHA:
+			colour[3] = value;
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RAINBOW:
+			if (value < 1.0/3.0)
+			{
+				colour[0] = 1.0;
+				colour[2] = 0.0;
+				if (value < 1.0/6.0)
+					colour[1] = value*4.5;
+				else
+					colour[1] = 0.75 + (value - 1.0/6.0)*1.5;
+			}
+			else if (value < 2.0/3.0)
+			{
+				colour[1] = 1.0;
+				if (value < 0.5)
+				{
+					colour[0] = 2.5 - 4.5*value;
+					colour[2] = 1.5*value - 0.5;
+				}
+				else
+				{
+					colour[0] = 1.0 - 1.5*value;
+					colour[2] = -2.0 + 4.5*value;
+				}
+			}
+			else
+			{
+				colour[0] = 0.0;
+				colour[2] = 1.0;
+				if (value < 5.0/6.0)
+					colour[1] = 1.0 - (value - 2.0/3.0)*1.5;
+				else
+					colour[1] = 0.75 - (value - 5.0/6.0)*4.5;
+			}
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RED:
+			colour[0] = value;
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_GREEN:
+			colour[1] = value;
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BLUE:
+			colour[2] = value;
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_MONOCHROME:
+			colour[0] = value;
+			colour[1] = value;
+			colour[2] = value;
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_BLUE:
+			colour[2] = 1.0;
+			colour[0] = (1 - value);
+			colour[1] = (1 - value);
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_RED:
+			colour[0] = 1.0;
+			colour[2] = (1 - value);
+			colour[1] = (1 - value);
+			break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_GREEN:
+			colour[1] = 1.0;
+			colour[0] = (1 - value);
+			colour[2] = (1 - value);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int Spectrum_colour_mapper::mapValues(int number_of_data_components,
+	int number_of_values, const GLfloat *data, const GLfloat *material_rgba,
+	GLfloat *rgba) const
+{
+	if (!((this->spectrum) && (0 < number_of_data_components) && (0 <= number_of_values) &&
+		data && material_rgba && rgba))
+	{
+		display_message(ERROR_MESSAGE, "Spectrum_colour_mapper::mapValues.  Invalid argument(s)");
+		return 0;
+	}
+	GLfloat initial_rgba[4];
+	for (int j = 0; j < 4; ++j)
+		initial_rgba[j] = (this->spectrum->overwrite_colour) ? ((j == 3) ? 1.0f : 0.0f) : material_rgba[j];
+	GLfloat *colour = rgba;
+	for (int i = 0; i < number_of_values; ++i, colour += 4)
+	{
+		for (int j = 0; j < 4; ++j)
+			colour[j] = initial_rgba[j];
+	}
+	if (this->field_lookup)
+	{
+		/* components must be applied in order with field lookups */
+		std::vector<FE_value> fe_data(number_of_data_components);
+		ZnReal colour_values[4];
+		const GLfloat *data_value = data;
+		colour = rgba;
+		for (int i = 0; i < number_of_values; ++i, data_value += number_of_data_components, colour += 4)
+		{
+			CAST_TO_FE_VALUE(fe_data, data_value, number_of_data_components);
+			CAST_TO_OTHER(colour_values, colour, ZnReal, 4);
+			if (!Spectrum_value_to_rgba(this->spectrum, number_of_data_components,
+				fe_data.data(), colour_values))
+				return 0;
+			CAST_TO_OTHER(colour, colour_values, GLfloat, 4);
+		}
+		return 1;
+	}
+	const size_t number_of_components = this->components.size();
+	for (size_t c = 0; c < number_of_components; ++c)
+	{
+		if (this->components[c].component_number < number_of_data_components)
+		{
+			mapComponentValues(this->components[c], number_of_data_components,
+				number_of_values, data, rgba);
+		}
+	}
+	return 1;
+}
+
 struct LIST(cmzn_spectrumcomponent) *get_cmzn_spectrumcomponent_list(
 	struct cmzn_spectrum *spectrum )
 /*******************************************************************************
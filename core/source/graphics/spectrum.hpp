@@ -9,8 +9,62 @@
 #if !defined(SPECTRUM_HPP)
 #define SPECTRUM_HPP
 
+#include "graphics/spectrum.h"
+#include <vector>
+
 class Render_graphics_opengl;
 
+/**
+ * Maps arrays of data values to RGBA colours with a spectrum. The active
+ * components are compiled into a flat array on construction and applied to
+ * all values in turn, so the component list is not walked and nothing is
+ * allocated per value. Construct just before mapping; it does not follow
+ * later changes to the spectrum.
+ * Spectrums with field lookup components are mapped one value at a time with
+ * Spectrum_value_to_rgba. Banded and step components only set texture
+ * coordinates so are ignored.
+ */
+class Spectrum_colour_mapper
+{
+	struct Component
+	{
+		int component_number;
+		ZnReal minimum, maximum;
+		bool extend_above, extend_below, reverse;
+		enum cmzn_spectrumcomponent_scale_type component_scale;
+		ZnReal exaggeration;
+		ZnReal min_value, max_value;
+		enum cmzn_spectrumcomponent_colour_mapping_type colour_mapping_type;
+	};
+
+	cmzn_spectrum *spectrum; // not accessed
+	std::vector<Component> components;
+	bool field_lookup;
+
+	static void mapComponentValues(const Component& component,
+		int number_of_data_components, int number_of_values, const GLfloat *data,
+		GLfloat *rgba);
+
+public:
+
+	Spectrum_colour_mapper(cmzn_spectrum *spectrumIn);
+
+	/**
+	 * Map data values to colours.
+	 * @param number_of_data_components  The number of data values per colour.
+	 * @param number_of_values  The number of colours to map.
+	 * @param data  Array of number_of_data_components*number_of_values.
+	 * @param material_rgba  Colour before applying spectrum components, usually
+	 * material diffuse colour and alpha. Ignored if spectrum overwrites
+	 * material, in which case opaque black is used.
+	 * @param rgba  Array of 4*number_of_values to receive colours.
+	 * @return  1 on success, 0 on failure.
+	 */
+	int mapValues(int number_of_data_components, int number_of_values,
+		const GLfloat *data, const GLfloat *material_rgba, GLfloat *rgba) const;
+
+};
+
 int Spectrum_compile_colour_lookup(struct cmzn_spectrum *spectrum,
 	Render_graphics_opengl *renderer);
 
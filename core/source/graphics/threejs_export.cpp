@@ -410,89 +410,56 @@ void Threejs_export::writeIndexBuffer(struct GT_object *object, int typeMask, in
 				GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 				&number_buffer, &number_per_vertex, &number_count);
 			unsigned int points_per_strip = 0;
+			unsigned int triangle[3];
+			bool firstFace = true;
 			for (unsigned i = 0; i < number_count; i ++)
 			{
 				points_per_strip = number_buffer[i];
 				for (unsigned int j =0; j< points_per_strip - 2; j++)
 				{
+					if (!Graphics_vertex_array_get_strip_triangle(indices + current_index, j, triangle))
+						continue;
+					if (!firstFace)
+					{
+						facesString += ",\n";
+					}
+					firstFace = false;
 					sprintf(temp,"\t\t%d", typeMask);
 					facesString += temp;
-					if (0 == (j % 2))
+					sprintf(temp," ,%d,%d,%d",
+						triangle[0]+offset, triangle[1]+offset, triangle[2]+offset);
+					facesString += temp;
+					if (typeMask & THREEJS_TYPE_VERTEX_TEX_COORD)
 					{
 						sprintf(temp," ,%d,%d,%d",
-							indices[current_index+j]+offset, indices[current_index+j+1]+offset,
-							indices[current_index+j+2]+offset);
+							triangle[0]+offset, triangle[1]+offset, triangle[2]+offset);
 						facesString += temp;
-						if (typeMask & THREEJS_TYPE_VERTEX_TEX_COORD)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j]+offset, indices[current_index+j+1]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
-						if (typeMask & THREEJS_TYPE_VERTEX_NORMAL)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j]+offset, indices[current_index+j+1]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
-						if (typeMask & THREEJS_TYPE_FACE_COLOR)
-						{
-							sprintf(temp," ,%d",	face_colour_index);
-							facesString += temp;
-							face_colour_index++;
-						}
-						if (typeMask & THREEJS_TYPE_VERTEX_COLOR)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j]+offset, indices[current_index+j+1]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
 					}
-					else
+					if (typeMask & THREEJS_TYPE_VERTEX_NORMAL)
 					{
 						sprintf(temp," ,%d,%d,%d",
-							indices[current_index+j+1]+offset, indices[current_index+j]+offset,
-							indices[current_index+j+2]+offset);
+							triangle[0]+offset, triangle[1]+offset, triangle[2]+offset);
 						facesString += temp;
-						if (typeMask & THREEJS_TYPE_VERTEX_TEX_COORD)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j+1]+offset, indices[current_index+j]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
-						if (typeMask & THREEJS_TYPE_VERTEX_NORMAL)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j+1]+offset, indices[current_index+j]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
-						if (typeMask & THREEJS_TYPE_FACE_COLOR)
-						{
-							sprintf(temp," ,%d",	face_colour_index);
-							facesString += temp;
-							face_colour_index++;
-						}
-						if (typeMask & THREEJS_TYPE_VERTEX_COLOR)
-						{
-							sprintf(temp," ,%d,%d,%d",
-								indices[current_index+j+1]+offset, indices[current_index+j]+offset,
-								indices[current_index+j+2]+offset);
-							facesString += temp;
-						}
 					}
-					if (!((i == number_count - 1) && (j == points_per_strip - 3)))
+					if (typeMask & THREEJS_TYPE_FACE_COLOR)
 					{
-						facesString += ",";
+						sprintf(temp," ,%d",	face_colour_index);
+						facesString += temp;
+						face_colour_index++;
+					}
+					if (typeMask & THREEJS_TYPE_VERTEX_COLOR)
+					{
+						sprintf(temp," ,%d,%d,%d",
+							triangle[0]+offset, triangle[1]+offset, triangle[2]+offset);
+						facesString += temp;
 					}
-					facesString += "\n";
 				}
 				current_index += points_per_strip;
 			}
+			if (!firstFace)
+			{
+				facesString += "\n";
+			}
 			facesString += "\t]\n\n";
 		}
 		else
@@ -546,37 +513,29 @@ void Threejs_export::writeSpecialDataBuffer(struct GT_object *object, GLfloat *v
 					&number_buffer, &number_per_vertex, &number_count);
 				unsigned int points_per_strip = 0;
 				unsigned int index[3];
+				bool firstValue = true;
 				for (unsigned i = 0; i < number_count; i ++)
 				{
 					outputString += "\n\t\t";
 					points_per_strip = number_buffer[i];
 					for (unsigned int j =0; j< points_per_strip - 2; j++)
 					{
-						if (0 == (j % 2))
-						{
-							index[0] = indices[current_index+j];
-							index[1] = indices[current_index+j+1];
-							index[2] = indices[current_index+j+2];
-						}
-						else
-						{
-							index[0] = indices[current_index+j+1];
-							index[1] = indices[current_index+j];
-							index[2] = indices[current_index+j+2];
-						}
+						// same faces as writeIndexBuffer
+						if (!Graphics_vertex_array_get_strip_triangle(indices + current_index, j, index))
+							continue;
 						GLfloat *currentVertex = vertex_buffer;
 						for (unsigned int k = 0; k < values_per_vertex; k++)
 						{
 							GLfloat average = (currentVertex[index[0] * values_per_vertex + k] +
 								currentVertex[index[1] * values_per_vertex + k] +
 								currentVertex[index[2] * values_per_vertex + k]) / 3;
-							sprintf(num_string, "%f", average);
-							outputString += num_string;
-							if (!((i == number_count - 1) && (k == values_per_vertex - 1) &&
-								 (j == points_per_strip - 3)))
+							if (!firstValue)
 							{
 								outputString += ",";
 							}
+							firstValue = false;
+							sprintf(num_string, "%f", average);
+							outputString += num_string;
 						}
 					}
 					current_index += points_per_strip;
@@ -10,11 +10,36 @@
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <cstdio>
+#include <cstring>
 #include "general/debug.h"
+#include "general/matrix_vector.h"
 #include "general/message.h"
 #include "graphics/auxiliary_graphics_types.h"
 #include "triangle_mesh.hpp"
 
+namespace {
+
+/** Store value in 4 bytes, least significant first */
+inline void set_uint32_little_endian(unsigned char *bytes, unsigned int value)
+{
+	bytes[0] = static_cast<unsigned char>(value & 0xff);
+	bytes[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+	bytes[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+	bytes[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+}
+
+/** Store IEEE single precision value in 4 bytes, least significant first */
+inline void set_float32_little_endian(unsigned char *bytes, double value)
+{
+	const float floatValue = static_cast<float>(value);
+	unsigned int intValue;
+	memcpy(&intValue, &floatValue, 4);
+	set_uint32_little_endian(bytes, intValue);
+}
+
+} // anonymous namespace
+
 void Triangle_vertex::list() const
 {
 	
@@ -37,40 +62,6 @@ void Mesh_triangle::list() const
 	trivertex3->list();
 }
 
-bool Triangle_vertex_compare::operator() (const Triangle_vertex *v1, const Triangle_vertex *v2)
-{
-	if (v1->coordinates[2] < (v2->coordinates[2] - tolerance))
-	{
-		return true;
-	}
-	else if (v1->coordinates[2] > (v2->coordinates[2] + tolerance))
-	{
-		return false;
-	}
-	else
-	{
-		if (v1->coordinates[1] < (v2->coordinates[1] - tolerance))
-		{
-			return true;
-		}
-		else if (v1->coordinates[1] > (v2->coordinates[1] + tolerance))
-		{
-			return false;
-		}
-		else
-		{
-			if (v1->coordinates[0] < (v2->coordinates[0] - tolerance))
-			{
-				return true;
-			}
-			else
-			{
-				return false;
-			}
-		}
-	}
-}
-
 Triangle_mesh::~Triangle_mesh()
 {
 	for (Mesh_triangle_list_iterator triangle_iter = triangle_list.begin(); triangle_iter != triangle_list.end(); triangle_iter++)
@@ -78,42 +69,34 @@ Triangle_mesh::~Triangle_mesh()
 		Mesh_triangle *triangle = (*triangle_iter);
 		delete triangle;
 	}
-	for (Triangle_vertex_set_iterator vertex_iter = vertex_set.begin(); vertex_iter != vertex_set.end(); vertex_iter++)
+	for (Triangle_vertex_list_iterator vertex_iter = vertex_list.begin(); vertex_iter != vertex_list.end(); vertex_iter++)
 	{
 		Triangle_vertex *vertex = (*vertex_iter);
 		delete vertex;
 	}
-	DESTROY(LIST(Octree_object))(&nearby_vertex);
-	DESTROY(Octree)(&octree);
 }
 
 const Triangle_vertex *Triangle_mesh::add_vertex(const Triple coordinates)
 {
-	Triangle_vertex *vertex_in_set = NULL;
-	FE_value coordinates_FEValue[3];
-	coordinates_FEValue[0] = (FE_value)coordinates[0];
-	coordinates_FEValue[1] = (FE_value)coordinates[1];
-	coordinates_FEValue[2] = (FE_value)coordinates[2];
-	Octree_add_objects_near_coordinate_to_list(octree,
-		/*dimension*/3, coordinates_FEValue, /*tolerance*/ 0.000001, nearby_vertex);
-	if (0 == NUMBER_IN_LIST(Octree_object)(nearby_vertex))
-	{
-		vertex_in_set = new Triangle_vertex(coordinates_FEValue);
-		vertex_in_set->set_identifier(static_cast<int>(vertex_set.size()) + 1);
-		Octree_object *octree_vertex = CREATE(Octree_object)(/*dimension*/3, coordinates_FEValue);
-		Octree_object_set_user_data(octree_vertex, (void *)vertex_in_set);
-		Octree_add_object(octree, octree_vertex);
-		vertex_set.insert(vertex_in_set);
-	}
-	else
+	double x[3];
+	x[0] = static_cast<double>(coordinates[0]);
+	x[1] = static_cast<double>(coordinates[1]);
+	x[2] = static_cast<double>(coordinates[2]);
+	Triangle_vertex *vertex = NULL;
+	double distance;
+	if (!vertex_grid.findNearest(x, tolerance, vertex, distance))
 	{
-		struct Octree_object *nearest_octree_object =
-			Octree_object_list_get_nearest(nearby_vertex, coordinates_FEValue);
-		REMOVE_ALL_OBJECTS_FROM_LIST(Octree_object)(nearby_vertex);
-		vertex_in_set = (Triangle_vertex *)Octree_object_get_user_data(nearest_octree_object);
+		ZnReal vertex_coordinates[3];
+		vertex_coordinates[0] = static_cast<ZnReal>(coordinates[0]);
+		vertex_coordinates[1] = static_cast<ZnReal>(coordinates[1]);
+		vertex_coordinates[2] = static_cast<ZnReal>(coordinates[2]);
+		vertex = new Triangle_vertex(vertex_coordinates);
+		vertex->index = static_cast<int>(vertex_list.size());
+		vertex->identifier = vertex->index + 1;
+		vertex_grid.add(x, vertex);
+		vertex_list.push_back(vertex);
 	}
-
-	return vertex_in_set;
+	return vertex;
 }
 
 const Mesh_triangle *Triangle_mesh::add_triangle(const Triangle_vertex *vertex1,
@@ -147,7 +130,7 @@ void Triangle_mesh::add_quadrilateral(const Triangle_vertex *v1, const Triangle_
 void Triangle_mesh::set_vertex_identifiers(int first_identifier)
 {
 	int i = first_identifier;
-	for (Triangle_vertex_set_iterator iter = vertex_set.begin(); iter != vertex_set.end(); iter++)
+	for (Triangle_vertex_list_iterator iter = vertex_list.begin(); iter != vertex_list.end(); iter++)
 	{
 		(*iter)->set_identifier(i);
 		i++;
@@ -165,3 +148,65 @@ void Triangle_mesh::list() const
 		i++;
 	}
 }
+
+void Triangle_mesh::write_binary_stl(std::string& output, const char *solid_name) const
+{
+	// header must not begin with "solid" which marks ASCII STL
+	unsigned char header[84];
+	memset(header, 0, 84);
+	snprintf(reinterpret_cast<char *>(header), 80, "Zinc binary STL %s",
+		solid_name ? solid_name : "default");
+	set_uint32_little_endian(header + 80, static_cast<unsigned int>(triangle_list.size()));
+	output.reserve(output.size() + 84 + 50*triangle_list.size());
+	output.append(reinterpret_cast<char *>(header), 84);
+	// normal, 3 vertices and 2 byte attribute count of zero
+	unsigned char facet[50];
+	memset(facet, 0, 50);
+	for (Mesh_triangle_list_const_iterator iter = triangle_list.begin(); iter != triangle_list.end(); iter++)
+	{
+		const Triangle_vertex *vertex[3];
+		(*iter)->get_vertexes(vertex, vertex + 1, vertex + 2);
+		double tangent1[3], tangent2[3], normal[3];
+		for (int c = 0; c < 3; ++c)
+		{
+			tangent1[c] = static_cast<double>(vertex[1]->coordinates[c] - vertex[0]->coordinates[c]);
+			tangent2[c] = static_cast<double>(vertex[2]->coordinates[c] - vertex[0]->coordinates[c]);
+		}
+		cross_product3(tangent1, tangent2, normal);
+		normalize3(normal);
+		unsigned char *value = facet;
+		for (int c = 0; c < 3; ++c, value += 4)
+			set_float32_little_endian(value, normal[c]);
+		for (int v = 0; v < 3; ++v)
+			for (int c = 0; c < 3; ++c, value += 4)
+				set_float32_little_endian(value, static_cast<double>(vertex[v]->coordinates[c]));
+		output.append(reinterpret_cast<char *>(facet), 50);
+	}
+}
+
+void Triangle_mesh::write_binary_ply(std::string& output) const
+{
+	char header[300];
+	snprintf(header, sizeof(header), "ply\nformat binary_little_endian 1.0\ncomment Zinc triangle mesh\n"
+		"element vertex %u\nproperty float x\nproperty float y\nproperty float z\n"
+		"element face %u\nproperty list uchar int vertex_indices\nend_header\n",
+		static_cast<unsigned int>(vertex_list.size()), static_cast<unsigned int>(triangle_list.size()));
+	output.reserve(output.size() + strlen(header) + 12*vertex_list.size() + 13*triangle_list.size());
+	output.append(header);
+	unsigned char record[13];
+	for (Triangle_vertex_list_const_iterator iter = vertex_list.begin(); iter != vertex_list.end(); iter++)
+	{
+		for (int c = 0; c < 3; ++c)
+			set_float32_little_endian(record + 4*c, static_cast<double>((*iter)->coordinates[c]));
+		output.append(reinterpret_cast<char *>(record), 12);
+	}
+	record[0] = 3;
+	for (Mesh_triangle_list_const_iterator iter = triangle_list.begin(); iter != triangle_list.end(); iter++)
+	{
+		const Triangle_vertex *vertex[3];
+		(*iter)->get_vertexes(vertex, vertex + 1, vertex + 2);
+		for (int v = 0; v < 3; ++v)
+			set_uint32_little_endian(record + 1 + 4*v, static_cast<unsigned int>(vertex[v]->index));
+		output.append(reinterpret_cast<char *>(record), 13);
+	}
+}
@@ -14,9 +14,10 @@
 #define TRIANGLE_MESH
 
 #include <list>
-#include <set>
+#include <string>
+#include <vector>
 
-#include "general/octree.h"
+#include "general/point_grid.hpp"
 #include "graphics/auxiliary_graphics_types.h"
 
 class Triangle_vertex
@@ -24,14 +25,15 @@ class Triangle_vertex
 private:
 	ZnReal coordinates[3];
 	int identifier;
+	int index; // position in mesh vertex list, from 0
 
-	friend class Triangle_vertex_compare;
 	friend class Mesh_triangle;
 	friend class Triangle_mesh;
 
 public:
 	Triangle_vertex(const ZnReal *in_coordinates) :
-		identifier(0)
+		identifier(0),
+		index(0)
 	{
 		coordinates[0] = in_coordinates[0];
 		coordinates[1] = in_coordinates[1];
@@ -69,27 +71,9 @@ public:
 	void list() const;
 };
 
-/***************************************************************************//**
- * Functor for comparing/sorting Triangle vertex based on coordinates but with
- * an allowed tolerance.
- */
-class Triangle_vertex_compare
-{
-private:
-	ZnReal tolerance;
-
-public:
-	Triangle_vertex_compare(ZnReal in_tolerance) :
-		tolerance(in_tolerance)
-	{	
-	}
-
-	bool operator() (const Triangle_vertex *v1, const Triangle_vertex *v2);
-};
-
-typedef std::set<Triangle_vertex*,Triangle_vertex_compare> Triangle_vertex_set;
-typedef std::set<Triangle_vertex*,Triangle_vertex_compare>::iterator Triangle_vertex_set_iterator;
-typedef std::set<Triangle_vertex*,Triangle_vertex_compare>::const_iterator Triangle_vertex_set_const_iterator;
+typedef std::vector<Triangle_vertex*> Triangle_vertex_list;
+typedef std::vector<Triangle_vertex*>::iterator Triangle_vertex_list_iterator;
+typedef std::vector<Triangle_vertex*>::const_iterator Triangle_vertex_list_const_iterator;
 
 class Mesh_triangle
 {
@@ -115,30 +99,35 @@ typedef std::list<Mesh_triangle*> Mesh_triangle_list;
 typedef std::list<Mesh_triangle*>::iterator Mesh_triangle_list_iterator;
 typedef std::list<Mesh_triangle*>::const_iterator Mesh_triangle_list_const_iterator;
 
+/***************************************************************************//**
+ * Triangle mesh welding vertices within a tolerance through a uniform hash
+ * grid. Vertices are kept in the order first added so identifiers and output
+ * are deterministic for the same input, and the mesh holds all its search
+ * state so separate meshes can be built independently.
+ */
 class Triangle_mesh
 {
 private:
-	Triangle_vertex_compare compare;
-	Triangle_vertex_set vertex_set;
+	ZnReal tolerance;
+	// cells twice the tolerance so only neighbouring cells are searched
+	PointGrid<Triangle_vertex*> vertex_grid;
+	Triangle_vertex_list vertex_list;
 	Mesh_triangle_list triangle_list;
-	struct Octree *octree;
-	struct LIST(Octree_object) *nearby_vertex;
 	
 public:
-	Triangle_mesh(ZnReal tolerance) :
-		compare(tolerance),
-		vertex_set(compare),
-		triangle_list(),
-		octree(CREATE(Octree)()),
-		nearby_vertex(CREATE(LIST(Octree_object))())
+	Triangle_mesh(ZnReal in_tolerance) :
+		tolerance((in_tolerance > 0.0) ? in_tolerance : 1.0E-6),
+		vertex_grid(/*dimension*/3, 2.0*tolerance),
+		vertex_list(),
+		triangle_list()
 	{
 	}
 
 	~Triangle_mesh();
 	
 	/***************************************************************************//**
-	 * Either finds an existing vertex within the tolerance of the supplied
-	 * coordinates, or creates one.
+	 * Either finds the nearest existing vertex within the tolerance of the
+	 * supplied coordinates, or creates one with the next identifier.
 	 *
 	 * @param coordinates  Pointer to 3 GLfloat values giving x, y, z coordinates. 
 	 * @return  Pointer to const vertex with supplied coordinates or within mesh
@@ -184,11 +173,13 @@ public:
 		add_quadrilateral(add_vertex(c1), add_vertex(c2), add_vertex(c3), add_vertex(c4));
 	}
 
+	/** Renumber vertices consecutively from first_identifier in the order added */
 	void set_vertex_identifiers(int first_identifier);
 	
-	const Triangle_vertex_set& get_vertex_set() const
+	/** @return  Vertices in the order added */
+	const Triangle_vertex_list& get_vertex_list() const
 	{
-		return vertex_set;
+		return vertex_list;
 	}
 
 	const Mesh_triangle_list& get_triangle_list() const
@@ -198,6 +189,23 @@ public:
 	
 	void list() const;
 
+	/***************************************************************************//**
+	 * Appends triangles in binary STL format to output, with facet normals from
+	 * their vertex winding. Values are written little endian on all hosts.
+	 *
+	 * @param output  String to append binary data to.
+	 * @param solid_name  Optional name written in the 80 byte header.
+	 */
+	void write_binary_stl(std::string& output, const char *solid_name) const;
+
+	/***************************************************************************//**
+	 * Appends the welded vertices and triangles indexing them to output in
+	 * binary little endian PLY format, in the order added.
+	 *
+	 * @param output  String to append binary data to.
+	 */
+	void write_binary_ply(std::string& output) const;
+
 private:
 	// declared but not defined so illegal:
 	Triangle_mesh(const Triangle_mesh& in_triangle_mesh);
@@ -21,6 +21,7 @@
 #include "computed_field/computed_field_finite_element.h"
 #include "general/mystring.h"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/enumerator_conversion.hpp"
 #include "minimise/cmiss_optimisation_private.hpp"
 #include "minimise/optimisation.hpp"
@@ -618,6 +619,9 @@ char *cmzn_optimisation_get_solution_report(cmzn_optimisation_id optimisation)
 int cmzn_optimisation_optimise(cmzn_optimisation_id optimisation)
 {
 	if (optimisation)
+	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_optimisation_optimise", "optimisation");
 		return optimisation->runOptimisation();
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
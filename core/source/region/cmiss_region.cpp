@@ -24,6 +24,7 @@
 #include "context/context.h"
 #include "general/callback_private.h"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/mystring.h"
 #include "graphics/scene.h"
 #include "region/cmiss_region.h"
@@ -86,6 +87,11 @@ struct cmzn_region
 	// list of notifiers which receive field module callbacks
 	cmzn_fieldmodulenotifier_list *notifier_list;
 
+	// owned loaders of content read on first access to fields, or NULL if none
+	std::vector<cmzn_region_loader *> *loaders;
+	// CMZN_OK, or error from first loader to fail
+	int loadResult;
+
 	/* number of objects using this region */
 	int access_count;
 };
@@ -115,9 +121,14 @@ static void cmzn_region_Computed_field_change(
 	if (message && region)
 	{
 		int change_summary = MANAGER_MESSAGE_GET_CHANGE_SUMMARY(Computed_field)(message);
+		const bool clearCaches = (0 != (change_summary & MANAGER_CHANGE_RESULT(Computed_field))) &&
+			(0 < region->field_caches->size());
+		// change logs are extracted from FE_region, so must only be created once
+		FE_region_changes *changes = 0;
+		if (clearCaches || (0 < region->notifier_list->size()))
+			changes = FE_region_changes::create(region->fe_region);
 		// clear active field caches for changed fields
-		if ((change_summary & MANAGER_CHANGE_RESULT(Computed_field)) &&
-			(0 < region->field_caches->size()))
+		if (clearCaches)
 		{
 			LIST(Computed_field) *changedFieldList =
 				MANAGER_MESSAGE_GET_CHANGE_LIST(Computed_field)(message, MANAGER_CHANGE_RESULT(Computed_field));
@@ -125,7 +136,12 @@ static void cmzn_region_Computed_field_change(
 			cmzn_field *field;
 			while (0 != (field = cmzn_fielditerator_next_non_access(iter)))
 			{
-				cmzn_region_clear_field_value_caches(region, field);
+				// partial result changes are only from node and element changes, for
+				// which value caches can keep information for unchanged elements
+				const int fieldChange = MANAGER_MESSAGE_GET_OBJECT_CHANGE(Computed_field)(message, field);
+				const bool partialChange = (MANAGER_CHANGE_PARTIAL_RESULT(Computed_field) ==
+					(fieldChange & MANAGER_CHANGE_RESULT(Computed_field)));
+				cmzn_region_clear_field_value_caches(region, field, partialChange ? changes : 0);
 			}
 			cmzn_fielditerator_destroy(&iter);
 			DESTROY(LIST(Computed_field))(&changedFieldList);
@@ -135,9 +151,7 @@ static void cmzn_region_Computed_field_change(
 			cmzn_fieldmoduleevent_id event = cmzn_fieldmoduleevent::create(region);
 			event->setChangeFlags(change_summary);
 			event->setManagerMessage(message);
-			FE_region_changes *changes = FE_region_changes::create(region->fe_region);
 			event->setFeRegionChanges(changes);
-			FE_region_changes::deaccess(changes);
 			for (cmzn_fieldmodulenotifier_list::iterator iter = region->notifier_list->begin();
 				iter != region->notifier_list->end(); ++iter)
 			{
@@ -155,6 +169,7 @@ static void cmzn_region_Computed_field_change(
 					parent->field_manager, message);
 			}
 		}
+		FE_region_changes::deaccess(changes);
 	}
 }
 
@@ -193,8 +208,14 @@ static int cmzn_region_fields_end_change(struct cmzn_region *region)
 	int return_code;
 	if (region)
 	{
-		FE_region_end_change(region->fe_region);
-		MANAGER_END_CACHE(Computed_field)(region->field_manager);
+		{
+			ZINC_INSTRUMENT_TRACE_SCOPE(feRegionSpan, "FE_region_end_change", "fields");
+			FE_region_end_change(region->fe_region);
+		}
+		{
+			ZINC_INSTRUMENT_TRACE_SCOPE(fieldManagerSpan, "MANAGER_END_CACHE(Computed_field)", "fields");
+			MANAGER_END_CACHE(Computed_field)(region->field_manager);
+		}
 		return_code = 1;
 	}
 	else
@@ -334,6 +355,8 @@ cmzn_region *cmzn_region_create_internal(cmzn_region *base_region)
 		region->change_callback_list =
 			CREATE(LIST(CMZN_CALLBACK_ITEM(cmzn_region_change)))();
 		region->notifier_list = new cmzn_fieldmodulenotifier_list();
+		region->loaders = 0;
+		region->loadResult = CMZN_OK;
 		region->field_manager = CREATE(MANAGER(Computed_field))();
 		Computed_field_manager_set_region(region->field_manager, region);
 		region->field_manager_callback_id = MANAGER_REGISTER(Computed_field)(
@@ -439,6 +462,17 @@ int DESTROY(cmzn_region)(struct cmzn_region **region_address)
 			delete region->field_caches;
 			DESTROY(LIST(Any_object))(&(region->any_object_list));
 
+			if (region->loaders)
+			{
+				for (std::vector<cmzn_region_loader *>::iterator iter = region->loaders->begin();
+					iter != region->loaders->end(); ++iter)
+				{
+					delete *iter;
+				}
+				delete region->loaders;
+				region->loaders = 0;
+			}
+
 			cmzn_region_detach_fields(region);
 
 			if (region->context)
@@ -466,6 +500,33 @@ int DESTROY(cmzn_region)(struct cmzn_region **region_address)
 	return (return_code);
 }
 
+/**
+ * Read content deferred by loaders into region, if any. Loaders are removed
+ * first so accessing the region while loading does not recurse.
+ */
+void cmzn_region_load_private(cmzn_region *region)
+{
+	std::vector<cmzn_region_loader *> *loaders = region->loaders;
+	region->loaders = 0;
+	cmzn_region_begin_hierarchical_change(region);
+	for (std::vector<cmzn_region_loader *>::iterator iter = loaders->begin();
+		iter != loaders->end(); ++iter)
+	{
+		const int result = (*iter)->load(region);
+		if (CMZN_OK != result)
+		{
+			if (CMZN_OK == region->loadResult)
+				region->loadResult = result;
+			char *path = cmzn_region_get_path(region);
+			display_message(ERROR_MESSAGE, "cmzn_region_load.  Failed to load region %s", path);
+			DEALLOCATE(path);
+		}
+		delete *iter;
+	}
+	delete loaders;
+	cmzn_region_end_hierarchical_change(region);
+}
+
 } // anonymous namespace
 
 /*
@@ -519,7 +580,8 @@ int cmzn_region_add_field_private(cmzn_region_id region, cmzn_field_id field)
 	return 0;
 }
 
-void cmzn_region_clear_field_value_caches(cmzn_region_id region, cmzn_field_id field)
+void cmzn_region_clear_field_value_caches(cmzn_region_id region, cmzn_field_id field,
+	FE_region_changes *changes)
 {
 	int cacheIndex = cmzn_field_get_cache_index_private(field);
 	for (std::list<cmzn_fieldcache_id>::iterator iter = region->field_caches->begin();
@@ -529,7 +591,10 @@ void cmzn_region_clear_field_value_caches(cmzn_region_id region, cmzn_field_id f
 		FieldValueCache *valueCache = cache->getValueCache(cacheIndex);
 		if (valueCache)
 		{
-			valueCache->clear();
+			if (changes)
+				valueCache->clearChanges(*changes);
+			else
+				valueCache->clear();
 		}
 	}
 }
@@ -615,7 +680,11 @@ int cmzn_region_clear_finite_elements(struct cmzn_region *region)
 struct FE_region *cmzn_region_get_FE_region(struct cmzn_region *region)
 {
 	if (region)
+	{
+		if (region->loaders)
+			cmzn_region_load_private(region);
 		return region->fe_region;
+	}
 	return 0;
 }
 
@@ -623,10 +692,33 @@ struct MANAGER(Computed_field) *cmzn_region_get_Computed_field_manager(
 	struct cmzn_region *region)
 {
 	if (region)
+	{
+		if (region->loaders)
+			cmzn_region_load_private(region);
 		return region->field_manager;
+	}
 	return 0;
 }
 
+int cmzn_region_add_loader(cmzn_region *region, cmzn_region_loader *loader)
+{
+	if (!(region && loader))
+		return CMZN_ERROR_ARGUMENT;
+	if (!region->loaders)
+		region->loaders = new std::vector<cmzn_region_loader *>();
+	region->loaders->push_back(loader);
+	return CMZN_OK;
+}
+
+int cmzn_region_load(cmzn_region_id region)
+{
+	if (!region)
+		return CMZN_ERROR_ARGUMENT;
+	if (region->loaders)
+		cmzn_region_load_private(region);
+	return region->loadResult;
+}
+
 int cmzn_region_get_field_cache_size(cmzn_region_id region)
 {
 	if (region)
@@ -679,6 +771,7 @@ int cmzn_region_end_change(struct cmzn_region *region)
 {
 	if (region)
 	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_region_end_change", "region");
 		if (0 < region->change_level)
 		{
 			cmzn_region_fields_end_change(region);
@@ -1471,6 +1564,8 @@ This function is only externally visible to context objects.
  */
 struct cmzn_fieldmodule *cmzn_region_get_fieldmodule(struct cmzn_region *region)
 {
+	if ((region) && (region->loaders))
+		cmzn_region_load_private(region);
 	return cmzn_fieldmodule_create(region);
 }
 
@@ -31,8 +31,12 @@ int cmzn_region_add_field_private(cmzn_region_id region, cmzn_field_id field);
 /***************************************************************************//**
  * Private function for clearing field value caches for field in all caches
  * listed in region.
+ * @param changes  Optional changes to nodes and elements which are the only
+ * cause of changes to the field's results. If supplied, value caches may keep
+ * information for unchanged elements.
  */
-void cmzn_region_clear_field_value_caches(cmzn_region_id region, cmzn_field_id field);
+void cmzn_region_clear_field_value_caches(cmzn_region_id region, cmzn_field_id field,
+	FE_region_changes *changes = 0);
 
 /***************************************************************************//**
  * Deaccesses fields from region and all child regions recursively.
@@ -108,4 +112,31 @@ void cmzn_region_set_context_private(cmzn_region *region, cmzn_context *context)
  */
 void cmzn_region_FE_region_change(cmzn_region *region);
 
+/**
+ * Reads content deferred from a region read, when the region's fields,
+ * nodes or elements are first accessed.
+ */
+class cmzn_region_loader
+{
+public:
+	virtual ~cmzn_region_loader()
+	{
+	}
+
+	/**
+	 * Read content into region.
+	 * @return  Status CMZN_OK on success, any other value on failure.
+	 */
+	virtual int load(cmzn_region *region) = 0;
+};
+
+/**
+ * Add loader to be called to read content into region on first access to its
+ * field module, field manager or FE_region. Loaders are called in the order
+ * added, then destroyed.
+ * @param loader  Loader to take ownership of.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+int cmzn_region_add_loader(cmzn_region *region, cmzn_region_loader *loader);
+
 #endif /* !defined (CMZN_REGION_PRIVATE_H) */
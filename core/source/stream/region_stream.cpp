@@ -18,9 +18,17 @@
 #include "finite_element/export_finite_element.h"
 #include "finite_element/import_finite_element.h"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/mystring.h"
 #include "region/cmiss_region.h"
+#include "region/cmiss_region_private.h"
 #include "stream/region_stream.hpp"
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -82,6 +90,271 @@ int cmzn_region_read_from_memory(struct cmzn_region *region, const void *memory_
 	return return_code;
 }
 
+/** Byte range of content following a 'Region:' line in an EX file */
+struct EXRegionBlock
+{
+	std::string path;
+	long long begin, end;
+};
+
+/** Region content found in an EX file, for adding loaders to read it */
+struct EXFileIndex
+{
+	std::string fileName;
+	// EX Version lines before the first region, prepended to each block
+	std::string header;
+	std::vector<EXRegionBlock> blocks;
+	bool timeEnabled;
+	FE_import_time_index timeIndex;
+	int useData;
+};
+
+/**
+ * @return  True if line from start begins with a top-level EX file keyword.
+ */
+bool isEXKeywordLine(const std::string& line, size_t start)
+{
+	static const char *keywords[] = { "EX Version", "Region", "Group name", "Shape",
+		"#", "Node", "Element", "Values", "!" };
+	for (size_t i = 0; i < sizeof(keywords)/sizeof(const char *); ++i)
+		if (0 == line.compare(start, strlen(keywords[i]), keywords[i]))
+			return true;
+	return false;
+}
+
+/**
+ * Index an EX file by region, finding the byte ranges of content following
+ * each 'Region:' line, without reading nodes or elements. Content before the
+ * first region line is given path "/" unless it has only EX Version lines,
+ * comments and blank lines.
+ * @param index  Index to fill; its fileName must be set.
+ * @return  True on success, false if file cannot be read, does not start
+ * with an EX keyword, has a region path without a leading separator or has
+ * no content.
+ */
+bool indexEXFileRegions(EXFileIndex& index)
+{
+	const char *fileName = index.fileName.c_str();
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file)
+	{
+		display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot open file %s", fileName);
+		return false;
+	}
+	std::string& header = index.header;
+	std::vector<EXRegionBlock>& blocks = index.blocks;
+	header.clear();
+	blocks.clear();
+	EXRegionBlock block;
+	block.path = "/";
+	block.begin = 0;
+	bool inPreamble = true;
+	bool preambleHasContent = false;
+	bool checkedFormat = false;
+	long long offset = 0;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		const long long lineBegin = offset;
+		offset += static_cast<long long>(line.size()) + 1;
+		const size_t start = line.find_first_not_of(" \t\r");
+		if (start == std::string::npos)
+			continue;
+		if (!checkedFormat)
+		{
+			if (!isEXKeywordLine(line, start))
+			{
+				display_message(ERROR_MESSAGE, "cmzn_region_read.  File %s is not in EX format", fileName);
+				return false;
+			}
+			checkedFormat = true;
+		}
+		if (0 == line.compare(start, 6, "Region"))
+		{
+			const size_t colon = line.find_first_not_of(" \t", start + 6);
+			if ((colon != std::string::npos) && (':' == line[colon]))
+			{
+				block.end = lineBegin;
+				if (((!inPreamble) || preambleHasContent) && (block.end > block.begin))
+					blocks.push_back(block);
+				const size_t pathBegin = line.find_first_not_of(" \t", colon + 1);
+				const size_t pathEnd = line.find_last_not_of(" \t\r");
+				if ((pathBegin == std::string::npos) || (pathEnd < pathBegin) ||
+					(CMZN_REGION_PATH_SEPARATOR_CHAR != line[pathBegin]))
+				{
+					display_message(ERROR_MESSAGE, "cmzn_region_read.  Invalid region path in file %s", fileName);
+					return false;
+				}
+				block.path = line.substr(pathBegin, pathEnd - pathBegin + 1);
+				block.begin = offset;
+				inPreamble = false;
+				continue;
+			}
+		}
+		if (inPreamble)
+		{
+			if (0 == line.compare(start, 2, "EX"))
+				header += line + "\n";
+			else if (!((line[start] == '!') && ((start + 1 == line.size()) || (line[start + 1] != '#'))))
+				preambleHasContent = true;
+		}
+	}
+	if (file.bad())
+	{
+		display_message(ERROR_MESSAGE, "cmzn_region_read.  Error reading file %s", fileName);
+		return false;
+	}
+	block.end = offset;
+	if (((!inPreamble) || preambleHasContent) && (block.end > block.begin))
+		blocks.push_back(block);
+	if (blocks.empty())
+	{
+		display_message(ERROR_MESSAGE, "cmzn_region_read.  File %s has no EX content", fileName);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Reads blocks of content for one region from an EX file when the region is
+ * first accessed. Reads into a temporary region and merges as for a normal
+ * read.
+ */
+class EXRegionLoader : public cmzn_region_loader
+{
+	std::string fileName;
+	std::string header;
+	std::vector<std::pair<long long, long long> > ranges;
+	bool timeEnabled;
+	FE_import_time_index timeIndex;
+	int useData;
+
+public:
+	EXRegionLoader(const char *fileNameIn, const std::string& headerIn,
+			const FE_import_time_index *timeIndexIn, int useDataIn) :
+		fileName(fileNameIn),
+		header(headerIn),
+		timeEnabled(0 != timeIndexIn),
+		useData(useDataIn)
+	{
+		this->timeIndex.time = (timeIndexIn) ? timeIndexIn->time : 0.0;
+	}
+
+	void addRange(long long begin, long long end)
+	{
+		this->ranges.push_back(std::make_pair(begin, end));
+	}
+
+	virtual int load(cmzn_region *region)
+	{
+		std::ifstream file(this->fileName.c_str(), std::ios::binary);
+		if (!file)
+		{
+			display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot open file %s to load region",
+				this->fileName.c_str());
+			return CMZN_ERROR_GENERAL;
+		}
+		std::string buffer(this->header);
+		for (size_t i = 0; i < this->ranges.size(); ++i)
+		{
+			const size_t oldSize = buffer.size();
+			buffer.resize(oldSize + static_cast<size_t>(this->ranges[i].second - this->ranges[i].first));
+			file.clear();
+			file.seekg(this->ranges[i].first);
+			file.read(&buffer[oldSize], static_cast<std::streamsize>(buffer.size() - oldSize));
+			buffer.resize(oldSize + static_cast<size_t>(file.gcount()));
+		}
+		if (buffer.empty())
+			return CMZN_OK;
+		cmzn_region *temp_region = cmzn_region_create_region(region);
+		int return_code = cmzn_region_read_from_memory(temp_region, buffer.data(),
+			static_cast<unsigned int>(buffer.size()), this->timeEnabled ? &this->timeIndex : 0,
+			this->useData, CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE,
+			CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX);
+		if (return_code == CMZN_OK)
+		{
+			if (!cmzn_region_can_merge(region, temp_region))
+				return_code = CMZN_ERROR_INCOMPATIBLE_DATA;
+			else if (!cmzn_region_merge(region, temp_region))
+				return_code = CMZN_ERROR_GENERAL;
+		}
+		cmzn_region_destroy(&temp_region);
+		return return_code;
+	}
+};
+
+/**
+ * Add loaders to read each region's content in indexed EX files on first
+ * access, creating subregions of region as needed. Either all subregions are
+ * found or created and all loaders added, or none are.
+ */
+int cmzn_region_add_EX_file_loaders(struct cmzn_region *region,
+	const std::vector<EXFileIndex>& indexes)
+{
+	// one loader per region per file, in order of first appearance
+	std::vector<std::pair<std::string, EXRegionLoader *> > loaders;
+	for (size_t f = 0; f < indexes.size(); ++f)
+	{
+		const EXFileIndex& index = indexes[f];
+		std::map<std::string, EXRegionLoader *> pathLoaders;
+		for (size_t i = 0; i < index.blocks.size(); ++i)
+		{
+			EXRegionLoader *&loader = pathLoaders[index.blocks[i].path];
+			if (!loader)
+			{
+				loader = new EXRegionLoader(index.fileName.c_str(), index.header,
+					index.timeEnabled ? &index.timeIndex : 0, index.useData);
+				loaders.push_back(std::make_pair(index.blocks[i].path, loader));
+			}
+			loader->addRange(index.blocks[i].begin, index.blocks[i].end);
+		}
+	}
+	int return_code = CMZN_OK;
+	std::vector<cmzn_region *> subregions(loaders.size(), static_cast<cmzn_region *>(0));
+	// top-most regions created here, to remove on failure
+	std::vector<cmzn_region *> createdRegions;
+	for (size_t i = 0; (i < loaders.size()) && (CMZN_OK == return_code); ++i)
+	{
+		const std::string& path = loaders[i].first;
+		subregions[i] = cmzn_region_find_subregion_at_path(region, path.c_str());
+		if (!subregions[i])
+		{
+			size_t end = 0;
+			while (std::string::npos != (end = path.find(CMZN_REGION_PATH_SEPARATOR_CHAR, end + 1)))
+			{
+				cmzn_region *ancestor = cmzn_region_find_subregion_at_path(region, path.substr(0, end).c_str());
+				if (!ancestor)
+					break;
+				cmzn_region_destroy(&ancestor);
+			}
+			subregions[i] = cmzn_region_create_subregion(region, path.c_str());
+			if (subregions[i])
+				createdRegions.push_back(cmzn_region_find_subregion_at_path(region, path.substr(0, end).c_str()));
+			else
+				return_code = CMZN_ERROR_GENERAL;
+		}
+	}
+	for (size_t i = 0; i < loaders.size(); ++i)
+	{
+		if (CMZN_OK == return_code)
+			cmzn_region_add_loader(subregions[i], loaders[i].second);
+		else
+			delete loaders[i].second;
+		cmzn_region_destroy(&subregions[i]);
+	}
+	for (size_t i = createdRegions.size(); 0 < i--;)
+	{
+		if (CMZN_OK != return_code)
+		{
+			cmzn_region *parent = cmzn_region_get_parent(createdRegions[i]);
+			cmzn_region_remove_child(parent, createdRegions[i]);
+			cmzn_region_destroy(&parent);
+		}
+		cmzn_region_destroy(&createdRegions[i]);
+	}
+	return return_code;
+}
+
 int cmzn_region_read_field_file_of_name(struct cmzn_region *region, const char *file_name,
 	struct IO_stream_package *io_stream_package,
 	struct FE_import_time_index *time_index, int useData,
@@ -127,6 +400,7 @@ int cmzn_region_read(cmzn_region_id region,
 	if (region && streaminformation_region &&
 		(cmzn_streaminformation_region_get_region_private(streaminformation_region) == region))
 	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_region_read", "io");
 		enum cmzn_streaminformation_data_compression_type data_compression_type =
 			CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE;
 		const cmzn_stream_properties_list streams_list = streaminformation_region->getResourcesList();
@@ -135,6 +409,11 @@ int cmzn_region_read(cmzn_region_id region,
 		struct cmzn_region *temp_region = cmzn_region_create_region(region);
 		if (!(streams_list.empty()) && io_stream_package && temp_region)
 		{
+			// only merge if anything read, otherwise region is loaded
+			bool mergeTempRegion = false;
+			// EX files indexed to load on demand; loaders are only added once
+			// all files are indexed and other resources are read and merged
+			std::vector<EXFileIndex> exFileIndexes;
 			cmzn_region_begin_hierarchical_change(temp_region);
 			cmzn_stream_properties_list_const_iterator iter;
 			cmzn_resource_properties *stream_properties = NULL;
@@ -151,6 +430,7 @@ int cmzn_region_read(cmzn_region_id region,
 				data_compression_type = CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE;
 				stream_properties = *iter;
 				stream = stream_properties->getResource();
+				ZINC_INSTRUMENT_TIME_SCOPE(readTimer, instrumentationCounters.streamReadTime);
 				if (cmzn_streaminformation_region_has_resource_attribute(
 					streaminformation_region, stream, CMZN_STREAMINFORMATION_REGION_ATTRIBUTE_TIME))
 				{
@@ -187,10 +467,34 @@ int cmzn_region_read(cmzn_region_id region,
 					char *file_name = file_resource->getFileName();
 					if (file_name)
 					{
-						return_code = cmzn_region_read_field_file_of_name(temp_region, file_name, io_stream_package, stream_time_index,
-							readData, data_compression_type, fileFormat);
-						if (return_code != CMZN_OK)
-							display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot read file %s", file_name);
+						if (streaminformation_region->isLoadOnDemand() &&
+							(data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE) &&
+							((fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX) ||
+								((fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC) &&
+									(!is_FieldML_file(file_name)))))
+						{
+							exFileIndexes.push_back(EXFileIndex());
+							EXFileIndex& index = exFileIndexes.back();
+							index.fileName = file_name;
+							index.timeEnabled = (0 != stream_time_index);
+							index.timeIndex.time = (stream_time_index) ? stream_time_index->time : 0.0;
+							index.useData = readData;
+							if (!indexEXFileRegions(index))
+							{
+								display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot index file %s", file_name);
+								return_code = CMZN_ERROR_GENERAL;
+							}
+						}
+						else
+						{
+							mergeTempRegion = true;
+							return_code = cmzn_region_read_field_file_of_name(temp_region, file_name, io_stream_package, stream_time_index,
+								readData, data_compression_type, fileFormat);
+							if (return_code != CMZN_OK)
+								display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot read file %s", file_name);
+							else
+								ZINC_INSTRUMENT_ADD(instrumentationCounters.streamReadBytes, Instrumentation_get_file_size(file_name));
+						}
 						DEALLOCATE(file_name);
 					}
 					cmzn_streamresource_file_destroy(&file_resource);
@@ -200,10 +504,13 @@ int cmzn_region_read(cmzn_region_id region,
 					memory_resource->getBuffer(&memory_block, &buffer_size);
 					if (memory_block)
 					{
+						mergeTempRegion = true;
 						return_code = cmzn_region_read_from_memory(temp_region, memory_block, buffer_size, stream_time_index,
 							readData, data_compression_type, fileFormat);
 						if (return_code != CMZN_OK)
 							display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot read memory resource");
+						else
+							ZINC_INSTRUMENT_ADD(instrumentationCounters.streamReadBytes, buffer_size);
 					}
 					cmzn_streamresource_memory_destroy(&memory_resource);
 				}
@@ -216,13 +523,15 @@ int cmzn_region_read(cmzn_region_id region,
 			// end change before merge otherwise there will be callbacks for changes
 			// to half-temporary, half-global objects, leading to errors
 			cmzn_region_end_hierarchical_change(temp_region);
-			if (return_code == CMZN_OK)
+			if ((return_code == CMZN_OK) && mergeTempRegion)
 			{
 				if (!cmzn_region_can_merge(region, temp_region))
 					return_code = CMZN_ERROR_INCOMPATIBLE_DATA;
 				else if (!cmzn_region_merge(region, temp_region))
 					return_code = CMZN_ERROR_GENERAL;
 			}
+			if ((return_code == CMZN_OK) && (!exFileIndexes.empty()))
+				return_code = cmzn_region_add_EX_file_loaders(region, exFileIndexes);
 		}
 		DEACCESS(cmzn_region)(&temp_region);
 		cmzn_region_end_hierarchical_change(region);
@@ -263,6 +572,7 @@ int cmzn_region_write(cmzn_region_id region,
 	if (region && streaminformation_region &&
 		(cmzn_streaminformation_region_get_region_private(streaminformation_region) == region))
 	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_region_write", "io");
 		const cmzn_stream_properties_list streams_list = streaminformation_region->getResourcesList();
 		if (streams_list.empty())
 			return_code = CMZN_ERROR_ARGUMENT;
@@ -288,6 +598,7 @@ int cmzn_region_write(cmzn_region_id region,
 			{
 				stream_properties = *iter;
 				stream = stream_properties->getResource();
+				ZINC_INSTRUMENT_TIME_SCOPE(writeTimer, instrumentationCounters.streamWriteTime);
 				if (cmzn_streaminformation_region_has_resource_attribute(
 					streaminformation_region, stream, CMZN_STREAMINFORMATION_REGION_ATTRIBUTE_TIME))
 				{
@@ -329,6 +640,14 @@ int cmzn_region_write(cmzn_region_id region,
 				if (local_recursion_mode == CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_INVALID)
 					local_recursion_mode = information_recursion_mode;
 				char *group_name = streaminformation_region->getResourceGroupName(stream);
+				cmzn_streaminformation_id streaminformation = cmzn_streaminformation_region_base_cast(
+					streaminformation_region);
+				enum cmzn_streaminformation_data_compression_type data_compression_type =
+					cmzn_streaminformation_get_resource_data_compression_type(streaminformation, stream);
+				if (data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_DEFAULT)
+					data_compression_type = cmzn_streaminformation_get_data_compression_type(streaminformation);
+				const bool compressed = (data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP) ||
+					(data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_BZIP2);
 
 				cmzn_streamresource_file_id file_resource = cmzn_streamresource_cast_file(stream);
 				cmzn_streamresource_memory_id memory_resource = NULL;
@@ -387,18 +706,31 @@ int cmzn_region_write(cmzn_region_id region,
 						switch (fileFormat)
 						{
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
-								if (!write_exregion_file_of_name(file_name, region, group_name,
+								if (data_compression_type == CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_BZIP2)
+								{
+									display_message(ERROR_MESSAGE, "cmzn_region_write.  Cannot write bzip2 compressed file %s", file_name);
+									return_code = CMZN_ERROR_ARGUMENT;
+								}
+								else if (!write_exregion_file_of_name(file_name, region, group_name,
 									cmzn_streaminformation_region_get_root_region(streaminformation_region),
 									writeElements,	writeNodes, writeData,
 									write_fields_mode, numberOfFieldNames, fieldNames,
-									stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode))
+									stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode,
+									data_compression_type, streaminformation_region->getCompressionLevel()))
 								{
 									return_code = CMZN_ERROR_GENERAL;
 									display_message(ERROR_MESSAGE, "cmzn_region_write.  Failed to write EX file %s", file_name);
 								}
 								break;
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
-								return_code = write_fieldml_file(region, file_name);
+								if (compressed)
+								{
+									display_message(ERROR_MESSAGE, "cmzn_region_write.  Cannot write compressed FieldML file %s", file_name);
+									return_code = CMZN_ERROR_ARGUMENT;
+								}
+								else
+									return_code = write_fieldml_file(region, file_name,
+										streaminformation_region->getFieldmlDataFormat());
 								break;
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC:
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_INVALID:
@@ -406,6 +738,8 @@ int cmzn_region_write(cmzn_region_id region,
 								return_code = CMZN_ERROR_ARGUMENT;
 								break;
 						}
+						if (return_code == CMZN_OK)
+							ZINC_INSTRUMENT_ADD(instrumentationCounters.streamWriteBytes, Instrumentation_get_file_size(file_name));
 						DEALLOCATE(file_name);
 					}
 					cmzn_streamresource_file_destroy(&file_resource);
@@ -418,7 +752,12 @@ int cmzn_region_write(cmzn_region_id region,
 					switch (fileFormat)
 					{
 						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
-							if (!write_exregion_file_to_memory_block(region, group_name,
+							if (compressed)
+							{
+								display_message(ERROR_MESSAGE, "cmzn_region_write.  Cannot write compressed EX format to memory block");
+								return_code = CMZN_ERROR_ARGUMENT;
+							}
+							else if (!write_exregion_file_to_memory_block(region, group_name,
 								cmzn_streaminformation_region_get_root_region(streaminformation_region),
 								writeElements,	writeNodes, writeData,
 								write_fields_mode, numberOfFieldNames, fieldNames,
@@ -430,6 +769,7 @@ int cmzn_region_write(cmzn_region_id region,
 							else
 							{
 								memory_resource->setBuffer(memory_block, buffer_size);
+								ZINC_INSTRUMENT_ADD(instrumentationCounters.streamWriteBytes, buffer_size);
 							}
 							break;
 						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
@@ -690,6 +1030,58 @@ int cmzn_streaminformation_region_set_file_format(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+enum cmzn_streaminformation_region_fieldml_data_format cmzn_streaminformation_region_get_fieldml_data_format(
+	cmzn_streaminformation_region_id streaminformation)
+{
+	if (streaminformation)
+		return streaminformation->getFieldmlDataFormat();
+	return CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INVALID;
+}
+
+int cmzn_streaminformation_region_set_fieldml_data_format(
+	cmzn_streaminformation_region_id streaminformation,
+	enum cmzn_streaminformation_region_fieldml_data_format fieldml_data_format)
+{
+	if (streaminformation)
+		return streaminformation->setFieldmlDataFormat(fieldml_data_format);
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_streaminformation_region_get_compression_level(
+	cmzn_streaminformation_region_id streaminformation)
+{
+	if (streaminformation)
+		return streaminformation->getCompressionLevel();
+	return -1;
+}
+
+int cmzn_streaminformation_region_set_compression_level(
+	cmzn_streaminformation_region_id streaminformation, int compression_level)
+{
+	if (streaminformation)
+		return streaminformation->setCompressionLevel(compression_level);
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_streaminformation_region_is_load_on_demand(
+	cmzn_streaminformation_region_id streaminformation)
+{
+	if (streaminformation)
+		return streaminformation->isLoadOnDemand();
+	return false;
+}
+
+int cmzn_streaminformation_region_set_load_on_demand(
+	cmzn_streaminformation_region_id streaminformation, bool value)
+{
+	if (streaminformation)
+	{
+		streaminformation->setLoadOnDemand(value);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 int cmzn_streaminformation_region_set_field_names(
 	cmzn_streaminformation_region_id streaminformation,
 	int number_of_names, const char **fieldNames)
@@ -161,6 +161,9 @@ public:
 		region(cmzn_region_access(region_in)),
 		root_region(cmzn_region_access(region_in)),
 		fileFormat(CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC),
+		fieldmlDataFormat(CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INLINE_TEXT),
+		loadOnDemand(false),
+		compressionLevel(-1),
 		recursion_mode(CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_ON),
 		write_no_field(0)
 	{
@@ -209,6 +212,42 @@ public:
 		return CMZN_OK;
 	}
 
+	cmzn_streaminformation_region_fieldml_data_format getFieldmlDataFormat() const
+	{
+		return this->fieldmlDataFormat;
+	}
+
+	int setFieldmlDataFormat(cmzn_streaminformation_region_fieldml_data_format fieldmlDataFormatIn)
+	{
+		if (fieldmlDataFormatIn == CMZN_STREAMINFORMATION_REGION_FIELDML_DATA_FORMAT_INVALID)
+			return CMZN_ERROR_ARGUMENT;
+		this->fieldmlDataFormat = fieldmlDataFormatIn;
+		return CMZN_OK;
+	}
+
+	bool isLoadOnDemand() const
+	{
+		return this->loadOnDemand;
+	}
+
+	void setLoadOnDemand(bool value)
+	{
+		this->loadOnDemand = value;
+	}
+
+	int getCompressionLevel() const
+	{
+		return this->compressionLevel;
+	}
+
+	int setCompressionLevel(int compressionLevelIn)
+	{
+		if ((compressionLevelIn < -1) || (compressionLevelIn > 9))
+			return CMZN_ERROR_ARGUMENT;
+		this->compressionLevel = compressionLevelIn;
+		return CMZN_OK;
+	}
+
 	double getTime()
 	{
 		return time;
@@ -480,6 +519,9 @@ private:
 	bool time_enabled;
 	struct cmzn_region *region, *root_region;
 	cmzn_streaminformation_region_file_format fileFormat;
+	cmzn_streaminformation_region_fieldml_data_format fieldmlDataFormat;
+	bool loadOnDemand;
+	int compressionLevel;
 	std::vector<std::string> strings_vectors;
 	cmzn_streaminformation_region_recursion_mode recursion_mode;
 	int write_no_field;
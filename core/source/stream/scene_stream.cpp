@@ -12,11 +12,13 @@
 
 #include "opencmiss/zinc/streamscene.h"
 #include "general/debug.h"
+#include "general/instrumentation.hpp"
 #include "general/mystring.h"
 #include "general/message.h"
 #include "general/enumerator_conversion.hpp"
 #include "description_io/scene_json_export.hpp"
 #include "description_io/scene_json_import.hpp"
+#include "graphics/render_triangularisation.hpp"
 #include "stream/scene_stream.hpp"
 
 
@@ -29,6 +31,7 @@ int cmzn_scene_write(cmzn_scene_id scene,
 	if (scene && streaminformation_scene &&
 		streaminformation_scene->getIOFormat() != CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_INVALID)
 	{
+		ZINC_INSTRUMENT_TRACE_SCOPE(span, "cmzn_scene_write", "io");
 		const cmzn_stream_properties_list streams_list = streaminformation_scene->getResourcesList();
 		if (!(streams_list.empty()))
 		{
@@ -88,11 +91,32 @@ int cmzn_scene_write(cmzn_scene_id scene,
 				output_string = new std::string[number_of_entries];
 				output_string[0] = jsonExport.getExportString();
 			}
+			else if ((streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY) ||
+				(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY))
+			{
+				number_of_entries = 1;
+				output_string = new std::string[number_of_entries];
+				cmzn_scenefilter_id scenefilter = streaminformation_scene->getScenefilter();
+				if (!export_scene_triangle_mesh(scene, scenefilter,
+					(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY) ?
+						TRIANGLE_MESH_FILE_FORMAT_BINARY_PLY : TRIANGLE_MESH_FILE_FORMAT_BINARY_STL,
+					output_string[0]))
+				{
+					return_code = CMZN_ERROR_GENERAL;
+				}
+				cmzn_scenefilter_destroy(&scenefilter);
+			}
 			cmzn_scene_destroy(&scene);
 
 			if (return_code != CMZN_OK)
+			{
+				delete[] output_string;
 				return CMZN_ERROR_GENERAL;
+			}
 
+			const bool binary =
+				(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY) ||
+				(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY);
 			cmzn_streamresource_id stream = NULL;
 			int i = 0;
 			for (iter = streams_list.begin(); iter != streams_list.end(); ++iter)
@@ -109,9 +133,18 @@ int cmzn_scene_write(cmzn_scene_id scene,
 						char *file_name = file_resource->getFileName();
 						if (file_name)
 						{
-							FILE *export_file = fopen(file_name,"w");
-							fprintf(export_file, "%s", output_string[i].c_str());
-							fclose(export_file);
+							// binary formats may contain zero bytes
+							FILE *export_file = fopen(file_name, binary ? "wb" : "w");
+							if (export_file)
+							{
+								fwrite(output_string[i].data(), 1, output_string[i].size(), export_file);
+								fclose(export_file);
+							}
+							else
+							{
+								display_message(ERROR_MESSAGE, "cmzn_scene_export.  Could not open file %s", file_name);
+								return_code = 0;
+							}
 							DEALLOCATE(file_name);
 							i++;
 						}
@@ -119,8 +152,11 @@ int cmzn_scene_write(cmzn_scene_id scene,
 					}
 					else if (NULL != (memory_resource = cmzn_streamresource_cast_memory(stream)))
 					{
-						char *buffer_out = duplicate_string(output_string[i].c_str());
-						unsigned int buffer_size = static_cast<unsigned int>(strlen(buffer_out));
+						const unsigned int buffer_size = static_cast<unsigned int>(output_string[i].size());
+						char *buffer_out;
+						ALLOCATE(buffer_out, char, buffer_size + 1);
+						memcpy(buffer_out, output_string[i].data(), buffer_size);
+						buffer_out[buffer_size] = '\0';
 						memory_resource->setBuffer(buffer_out, buffer_size);
 						cmzn_streamresource_memory_destroy(&memory_resource);
 						i++;
@@ -402,6 +438,12 @@ public:
 			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS:
 				enum_string = "THREEJS";
 				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY:
+				enum_string = "STL_BINARY";
+				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY:
+				enum_string = "PLY_BINARY";
+				break;
 			default:
 				break;
 		}
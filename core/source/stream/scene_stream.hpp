@@ -80,7 +80,9 @@ public:
 				numberOfResources += 1;
 			return numberOfResources;
 		}
-		else if (format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION)
+		else if ((format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION) ||
+			(format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_STL_BINARY) ||
+			(format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_PLY_BINARY))
 			return 1;
 		else
 			return 0;
@@ -0,0 +1,233 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmath>
+
+#include <opencmiss/zinc/elementbasis.hpp>
+#include <opencmiss/zinc/elementfieldtemplate.hpp>
+#include <opencmiss/zinc/elementtemplate.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/mesh.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/nodetemplate.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+namespace {
+
+const Node::ValueLabel hermiteDerivativeLabels[7] =
+{
+	Node::VALUE_LABEL_D_DS1,
+	Node::VALUE_LABEL_D_DS2,
+	Node::VALUE_LABEL_D2_DS1DS2,
+	Node::VALUE_LABEL_D_DS3,
+	Node::VALUE_LABEL_D2_DS1DS3,
+	Node::VALUE_LABEL_D2_DS2DS3,
+	Node::VALUE_LABEL_D3_DS1DS2DS3
+};
+
+// Kuhn subdivision of a cube into 6 tetrahedra, each following a path from
+// corner 0 to corner 7 along edges in the order of a permutation of the axes.
+// Corners are numbered with x in bit 0, y in bit 1, z in bit 2. Odd
+// permutations have their last 2 nodes swapped to give positive volume.
+const int tetCubeCorners[6][4] =
+{
+	{ 0, 1, 3, 7 },
+	{ 0, 2, 7, 3 },
+	{ 0, 2, 6, 7 },
+	{ 0, 4, 7, 6 },
+	{ 0, 4, 5, 7 },
+	{ 0, 1, 7, 5 }
+};
+
+} // anonymous namespace
+
+BenchmarkMesh::BenchmarkMesh(BenchmarkMeshType typeIn, int elementsCount) :
+	context("benchmark"),
+	region(context.getDefaultRegion()),
+	fm(region.getFieldmodule()),
+	type(typeIn),
+	elementsCountAxis(getElementsCountAxis(typeIn, elementsCount))
+{
+	createMesh(this->region, this->type, this->elementsCountAxis);
+	this->coordinates = this->fm.findFieldByName("coordinates");
+	this->mesh = this->fm.findMeshByDimension(3);
+	this->nodes = this->fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+}
+
+BenchmarkMesh::BenchmarkMesh(benchmark::State& state) :
+	context("benchmark"),
+	region(context.getDefaultRegion()),
+	fm(region.getFieldmodule()),
+	type(static_cast<BenchmarkMeshType>(state.range(0))),
+	elementsCountAxis(getElementsCountAxis(type, static_cast<int>(state.range(1))))
+{
+	createMesh(this->region, this->type, this->elementsCountAxis);
+	this->coordinates = this->fm.findFieldByName("coordinates");
+	this->mesh = this->fm.findMeshByDimension(3);
+	this->nodes = this->fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	state.SetLabel(getTypeName(this->type));
+	state.counters["elements"] = static_cast<double>(this->mesh.getSize());
+	state.counters["nodes"] = static_cast<double>(this->nodes.getSize());
+}
+
+void BenchmarkMesh::createMesh(Region& region, BenchmarkMeshType type, int elementsCountAxis)
+{
+	Fieldmodule fm = region.getFieldmodule();
+	fm.beginChange();
+	FieldFiniteElement coordinates = fm.createFieldFiniteElement(/*numberOfComponents*/3);
+	coordinates.setName("coordinates");
+	coordinates.setManaged(true);
+	coordinates.setTypeCoordinate(true);
+	coordinates.setComponentName(1, "x");
+	coordinates.setComponentName(2, "y");
+	coordinates.setComponentName(3, "z");
+
+	const bool hermite = (type == BENCHMARK_MESH_HEX_CUBIC_HERMITE);
+	const int n = elementsCountAxis;
+	const int nodesCountAxis = n + 1;
+	const double delta = 1.0/static_cast<double>(n);
+
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	nodetemplate.defineField(coordinates);
+	if (hermite)
+		for (int d = 0; d < 7; ++d)
+			nodetemplate.setValueNumberOfVersions(coordinates, -1, hermiteDerivativeLabels[d], 1);
+	Fieldcache cache = fm.createFieldcache();
+	const double zero[3] = { 0.0, 0.0, 0.0 };
+	int nodeIdentifier = 1;
+	for (int k = 0; k < nodesCountAxis; ++k)
+		for (int j = 0; j < nodesCountAxis; ++j)
+			for (int i = 0; i < nodesCountAxis; ++i)
+			{
+				Node node = nodes.createNode(nodeIdentifier++, nodetemplate);
+				cache.setNode(node);
+				const double x[3] = { i*delta, j*delta, k*delta };
+				coordinates.setNodeParameters(cache, -1, Node::VALUE_LABEL_VALUE, 1, 3, x);
+				if (hermite)
+				{
+					for (int d = 0; d < 7; ++d)
+						coordinates.setNodeParameters(cache, -1, hermiteDerivativeLabels[d], 1, 3, zero);
+					for (int c = 0; c < 3; ++c)
+					{
+						double derivative[3] = { 0.0, 0.0, 0.0 };
+						derivative[c] = delta;
+						// D_DS1, D_DS2, D_DS3 are at indexes 0, 1, 3
+						coordinates.setNodeParameters(cache, -1, hermiteDerivativeLabels[(c < 2) ? c : 3], 1, 3, derivative);
+					}
+				}
+			}
+
+	Mesh mesh = fm.findMeshByDimension(3);
+	const bool tet = (type == BENCHMARK_MESH_TET_LINEAR);
+	Elementbasis basis = fm.createElementbasis(3, tet ? Elementbasis::FUNCTION_TYPE_LINEAR_SIMPLEX :
+		(hermite ? Elementbasis::FUNCTION_TYPE_CUBIC_HERMITE : Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE));
+	Elementfieldtemplate eft = mesh.createElementfieldtemplate(basis);
+	Elementtemplate elementtemplate = mesh.createElementtemplate();
+	elementtemplate.setElementShapeType(tet ? Element::SHAPE_TYPE_TETRAHEDRON : Element::SHAPE_TYPE_CUBE);
+	elementtemplate.defineField(coordinates, -1, eft);
+	const int nodesCountLayer = nodesCountAxis*nodesCountAxis;
+	int elementIdentifier = 1;
+	for (int k = 0; k < n; ++k)
+		for (int j = 0; j < n; ++j)
+			for (int i = 0; i < n; ++i)
+			{
+				const int baseNodeIdentifier = 1 + i + j*nodesCountAxis + k*nodesCountLayer;
+				int cornerNodeIdentifiers[8];
+				for (int c = 0; c < 8; ++c)
+					cornerNodeIdentifiers[c] = baseNodeIdentifier + (c & 1) +
+						((c & 2) ? nodesCountAxis : 0) + ((c & 4) ? nodesCountLayer : 0);
+				if (tet)
+				{
+					for (int t = 0; t < 6; ++t)
+					{
+						int nodeIdentifiers[4];
+						for (int c = 0; c < 4; ++c)
+							nodeIdentifiers[c] = cornerNodeIdentifiers[tetCubeCorners[t][c]];
+						Element element = mesh.createElement(elementIdentifier++, elementtemplate);
+						element.setNodesByIdentifier(eft, 4, nodeIdentifiers);
+					}
+				}
+				else
+				{
+					Element element = mesh.createElement(elementIdentifier++, elementtemplate);
+					element.setNodesByIdentifier(eft, 8, cornerNodeIdentifiers);
+				}
+			}
+	fm.endChange();
+}
+
+int BenchmarkMesh::getElementsCountAxis(BenchmarkMeshType type, int elementsCount)
+{
+	const double hexCount = (type == BENCHMARK_MESH_TET_LINEAR) ? (elementsCount/6.0) : elementsCount;
+	const int n = static_cast<int>(floor(cbrt(hexCount) + 0.5));
+	return (n < 1) ? 1 : n;
+}
+
+const char *BenchmarkMesh::getTypeName(BenchmarkMeshType type)
+{
+	switch (type)
+	{
+	case BENCHMARK_MESH_HEX_LINEAR:
+		return "hex_linear";
+	case BENCHMARK_MESH_HEX_CUBIC_HERMITE:
+		return "hex_cubic_hermite";
+	case BENCHMARK_MESH_TET_LINEAR:
+		return "tet_linear";
+	}
+	return "unknown";
+}
+
+void BenchmarkMesh::allSizes(benchmark::internal::Benchmark *benchmark)
+{
+	sizesUpTo(benchmark, 10000000);
+}
+
+void BenchmarkMesh::smallSizes(benchmark::internal::Benchmark *benchmark)
+{
+	sizesUpTo(benchmark, 100000);
+}
+
+void BenchmarkMesh::sizesUpTo(benchmark::internal::Benchmark *benchmark, int maximumElementsCount)
+{
+	benchmark->ArgNames({ "type", "elements" });
+	const int types[3] = { BENCHMARK_MESH_HEX_LINEAR, BENCHMARK_MESH_HEX_CUBIC_HERMITE, BENCHMARK_MESH_TET_LINEAR };
+	for (int t = 0; t < 3; ++t)
+		for (int elementsCount = 1000; elementsCount <= maximumElementsCount; elementsCount *= 10)
+			benchmark->Args({ types[t], elementsCount });
+}
+
+const double *BenchmarkMesh::getElementPointsXi(BenchmarkMeshType type, int& pointsCount)
+{
+	// 2x2x2 Gauss points
+	static const double g1 = 0.5 - 0.5/sqrt(3.0);
+	static const double g2 = 0.5 + 0.5/sqrt(3.0);
+	static const double hexXi[8][3] =
+	{
+		{ g1, g1, g1 }, { g2, g1, g1 }, { g1, g2, g1 }, { g2, g2, g1 },
+		{ g1, g1, g2 }, { g2, g1, g2 }, { g1, g2, g2 }, { g2, g2, g2 }
+	};
+	// 4 point tetrahedron rule
+	static const double a = 0.1381966011250105;
+	static const double b = 0.5854101966249685;
+	static const double tetXi[4][3] =
+	{
+		{ a, a, a }, { b, a, a }, { a, b, a }, { a, a, b }
+	};
+	if (type == BENCHMARK_MESH_TET_LINEAR)
+	{
+		pointsCount = 4;
+		return &(tetXi[0][0]);
+	}
+	pointsCount = 8;
+	return &(hexXi[0][0]);
+}
@@ -0,0 +1,87 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef __ZINC_BENCHMARK_MESH_HPP__
+#define __ZINC_BENCHMARK_MESH_HPP__
+
+#include <benchmark/benchmark.h>
+
+#include <opencmiss/zinc/context.hpp>
+#include <opencmiss/zinc/element.hpp>
+#include <opencmiss/zinc/field.hpp>
+#include <opencmiss/zinc/fieldmodule.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/region.hpp>
+
+/** Element shape and interpolation of synthetic benchmark meshes */
+enum BenchmarkMeshType
+{
+	BENCHMARK_MESH_HEX_LINEAR = 0,
+	BENCHMARK_MESH_HEX_CUBIC_HERMITE = 1,
+	BENCHMARK_MESH_TET_LINEAR = 2
+};
+
+/**
+ * Synthetic 3-D mesh of a unit cube divided into an equal number of hexahedra
+ * along each axis, or into 6 tetrahedra per hexahedron, with a rectangular
+ * cartesian coordinates field. Element and node identifiers start at 1 and
+ * vary fastest along x.
+ * Benchmarks take the mesh type and approximate number of elements as their
+ * first two arguments, registered by the Apply functions below.
+ */
+class BenchmarkMesh
+{
+public:
+	OpenCMISS::Zinc::Context context;
+	OpenCMISS::Zinc::Region region;
+	OpenCMISS::Zinc::Fieldmodule fm;
+	OpenCMISS::Zinc::Field coordinates;
+	OpenCMISS::Zinc::Mesh mesh;
+	OpenCMISS::Zinc::Nodeset nodes;
+	BenchmarkMeshType type;
+	int elementsCountAxis;
+
+	/**
+	 * Create mesh in a new context.
+	 * @param elementsCount  Approximate number of elements to create.
+	 */
+	BenchmarkMesh(BenchmarkMeshType typeIn, int elementsCount);
+
+	/**
+	 * Create mesh in the root region of a new context from the mesh type and
+	 * element count arguments of the benchmark state, and label the
+	 * benchmark with the mesh type.
+	 */
+	explicit BenchmarkMesh(benchmark::State& state);
+
+	/** Create the mesh in region, which must be empty */
+	static void createMesh(OpenCMISS::Zinc::Region& region, BenchmarkMeshType type,
+		int elementsCountAxis);
+
+	/** @return  Number of elements along each axis giving about elementsCount elements */
+	static int getElementsCountAxis(BenchmarkMeshType type, int elementsCount);
+
+	static const char *getTypeName(BenchmarkMeshType type);
+
+	/** Register all mesh types with 1k to 10M elements */
+	static void allSizes(benchmark::internal::Benchmark *benchmark);
+
+	/** Register all mesh types with 1k to 100k elements, for slower operations */
+	static void smallSizes(benchmark::internal::Benchmark *benchmark);
+
+	/** Register all mesh types with 1k to maximumElementsCount elements */
+	static void sizesUpTo(benchmark::internal::Benchmark *benchmark, int maximumElementsCount);
+
+	/**
+	 * @return  Element xi at which to evaluate, inside both hexahedra and
+	 * tetrahedra. Fills pointsCount points of 3 xi.
+	 */
+	static const double *getElementPointsXi(BenchmarkMeshType type, int& pointsCount);
+};
+
+#endif // __ZINC_BENCHMARK_MESH_HPP__
@@ -0,0 +1,149 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <opencmiss/zinc/fieldarithmeticoperators.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldderivatives.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldmeshoperators.hpp>
+#include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/mesh.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+// evaluates an expression of coordinates at all nodes
+static void BM_EvaluateAtNodes(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Field magnitude = benchmarkMesh.fm.createFieldMagnitude(benchmarkMesh.coordinates);
+	Fieldcache cache = benchmarkMesh.fm.createFieldcache();
+	const int nodesCount = benchmarkMesh.nodes.getSize();
+	double value;
+	for (auto _ : state)
+	{
+		Nodeiterator iter = benchmarkMesh.nodes.createNodeiterator();
+		Node node;
+		while ((node = iter.next()).isValid())
+		{
+			cache.setNode(node);
+			magnitude.evaluateReal(cache, 1, &value);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*nodesCount);
+}
+BENCHMARK(BM_EvaluateAtNodes)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// evaluates coordinates at quadrature points in all elements
+static void BM_EvaluateAtElementPoints(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Fieldcache cache = benchmarkMesh.fm.createFieldcache();
+	int pointsCount;
+	const double *xi = BenchmarkMesh::getElementPointsXi(benchmarkMesh.type, pointsCount);
+	const int elementsCount = benchmarkMesh.mesh.getSize();
+	double values[3];
+	for (auto _ : state)
+	{
+		Elementiterator iter = benchmarkMesh.mesh.createElementiterator();
+		Element element;
+		while ((element = iter.next()).isValid())
+			for (int p = 0; p < pointsCount; ++p)
+			{
+				cache.setMeshLocation(element, 3, xi + 3*p);
+				benchmarkMesh.coordinates.evaluateReal(cache, 3, values);
+				benchmark::DoNotOptimize(values);
+			}
+	}
+	state.SetItemsProcessed(state.iterations()*elementsCount*pointsCount);
+}
+BENCHMARK(BM_EvaluateAtElementPoints)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// evaluates gradient of a scalar with respect to coordinates at quadrature
+// points in all elements, requiring the inverse of the element Jacobian
+static void BM_EvaluateGradientAtElementPoints(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Field magnitude = benchmarkMesh.fm.createFieldMagnitude(benchmarkMesh.coordinates);
+	Field gradient = benchmarkMesh.fm.createFieldGradient(magnitude, benchmarkMesh.coordinates);
+	Fieldcache cache = benchmarkMesh.fm.createFieldcache();
+	int pointsCount;
+	const double *xi = BenchmarkMesh::getElementPointsXi(benchmarkMesh.type, pointsCount);
+	const int elementsCount = benchmarkMesh.mesh.getSize();
+	double values[3];
+	for (auto _ : state)
+	{
+		Elementiterator iter = benchmarkMesh.mesh.createElementiterator();
+		Element element;
+		while ((element = iter.next()).isValid())
+			for (int p = 0; p < pointsCount; ++p)
+			{
+				cache.setMeshLocation(element, 3, xi + 3*p);
+				gradient.evaluateReal(cache, 3, values);
+				benchmark::DoNotOptimize(values);
+			}
+	}
+	state.SetItemsProcessed(state.iterations()*elementsCount*pointsCount);
+}
+BENCHMARK(BM_EvaluateGradientAtElementPoints)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// finds the mesh location of up to 1000 nodes in the mesh with offset
+// coordinates, so locations are mostly inside other elements
+static void BM_FindMeshLocation(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Fieldmodule& fm = benchmarkMesh.fm;
+	const double offsetValue = 0.25/benchmarkMesh.elementsCountAxis;
+	const double offsetValues[3] = { offsetValue, offsetValue, offsetValue };
+	Field offsetCoordinates = benchmarkMesh.coordinates + fm.createFieldConstant(3, offsetValues);
+	FieldFindMeshLocation findMeshLocation = fm.createFieldFindMeshLocation(
+		benchmarkMesh.coordinates, offsetCoordinates, benchmarkMesh.mesh);
+	findMeshLocation.setSearchMode(FieldFindMeshLocation::SEARCH_MODE_NEAREST);
+	Fieldcache cache = fm.createFieldcache();
+	const int nodesCount = benchmarkMesh.nodes.getSize();
+	const int queryCount = (nodesCount < 1000) ? nodesCount : 1000;
+	const int queryStride = nodesCount/queryCount;
+	double xi[3];
+	for (auto _ : state)
+	{
+		for (int q = 0; q < queryCount; ++q)
+		{
+			cache.setNode(benchmarkMesh.nodes.findNodeByIdentifier(1 + q*queryStride));
+			Element element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+			benchmark::DoNotOptimize(element.getId());
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*queryCount);
+}
+BENCHMARK(BM_FindMeshLocation)->Apply(BenchmarkMesh::smallSizes)->Unit(benchmark::kMillisecond);
+
+// integrates volume over the mesh
+static void BM_MeshIntegral(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Fieldmodule& fm = benchmarkMesh.fm;
+	const double one = 1.0;
+	FieldMeshIntegral volume = fm.createFieldMeshIntegral(
+		fm.createFieldConstant(1, &one), benchmarkMesh.coordinates, benchmarkMesh.mesh);
+	const int numberOfPoints = 2;
+	volume.setNumbersOfPoints(1, &numberOfPoints);
+	double value;
+	for (auto _ : state)
+	{
+		// new cache as integral is cached with the location
+		Fieldcache cache = fm.createFieldcache();
+		volume.evaluateReal(cache, 1, &value);
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.iterations()*benchmarkMesh.mesh.getSize());
+}
+BENCHMARK(BM_MeshIntegral)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,63 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <opencmiss/zinc/fieldcomposite.hpp>
+#include <opencmiss/zinc/graphics.hpp>
+#include <opencmiss/zinc/scene.hpp>
+#include <opencmiss/zinc/scenefilter.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+// builds exterior surfaces of the mesh; graphics are created on each
+// iteration and built by querying their range
+static void BM_GraphicsSurfaces(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	benchmarkMesh.fm.defineAllFaces();
+	Scene scene = benchmarkMesh.region.getScene();
+	Scenefilter noFilter;
+	double minimums[3], maximums[3];
+	for (auto _ : state)
+	{
+		GraphicsSurfaces surfaces = scene.createGraphicsSurfaces();
+		surfaces.setCoordinateField(benchmarkMesh.coordinates);
+		surfaces.setExterior(true);
+		scene.getCoordinatesRange(noFilter, minimums, maximums);
+		benchmark::DoNotOptimize(minimums);
+		state.PauseTiming();
+		scene.removeGraphics(surfaces);
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_GraphicsSurfaces)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// builds iso-surfaces of x through 3-D elements, alternating between two
+// iso-values so graphics are rebuilt on each iteration
+static void BM_GraphicsIsoSurfaces(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Scene scene = benchmarkMesh.region.getScene();
+	Scenefilter noFilter;
+	GraphicsContours contours = scene.createGraphicsContours();
+	contours.setCoordinateField(benchmarkMesh.coordinates);
+	contours.setFieldDomainType(Field::DOMAIN_TYPE_MESH3D);
+	contours.setIsoscalarField(benchmarkMesh.fm.createFieldComponent(benchmarkMesh.coordinates, 1));
+	const double isovalues[2] = { 0.3, 0.7 };
+	double minimums[3], maximums[3];
+	int index = 0;
+	for (auto _ : state)
+	{
+		contours.setListIsovalues(1, isovalues + index);
+		index = 1 - index;
+		scene.getCoordinatesRange(noFilter, minimums, maximums);
+		benchmark::DoNotOptimize(minimums);
+	}
+}
+BENCHMARK(BM_GraphicsIsoSurfaces)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <opencmiss/zinc/stream.hpp>
+#include <opencmiss/zinc/streamregion.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+// writes region in EX format to a memory buffer
+static void BM_WriteRegionEx(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	unsigned int bufferSize = 0;
+	for (auto _ : state)
+	{
+		StreaminformationRegion sir = benchmarkMesh.region.createStreaminformationRegion();
+		sir.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX);
+		StreamresourceMemory resource = sir.createStreamresourceMemory();
+		benchmarkMesh.region.write(sir);
+		void *buffer;
+		resource.getBuffer(&buffer, &bufferSize);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations()*static_cast<int64_t>(bufferSize));
+}
+BENCHMARK(BM_WriteRegionEx)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// reads region in EX format from a memory buffer into a new region
+static void BM_ReadRegionEx(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	StreaminformationRegion sir = benchmarkMesh.region.createStreaminformationRegion();
+	sir.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX);
+	StreamresourceMemory resource = sir.createStreamresourceMemory();
+	benchmarkMesh.region.write(sir);
+	void *buffer;
+	unsigned int bufferSize;
+	resource.getBuffer(&buffer, &bufferSize);
+	for (auto _ : state)
+	{
+		Region region = benchmarkMesh.region.createRegion();
+		StreaminformationRegion readSir = region.createStreaminformationRegion();
+		readSir.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX);
+		readSir.createStreamresourceMemoryBuffer(buffer, bufferSize);
+		region.read(readSir);
+		state.PauseTiming();
+		region = Region(); // exclude destruction from timing
+		state.ResumeTiming();
+	}
+	state.SetBytesProcessed(state.iterations()*static_cast<int64_t>(bufferSize));
+}
+BENCHMARK(BM_ReadRegionEx)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
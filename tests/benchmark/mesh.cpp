@@ -0,0 +1,57 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <opencmiss/zinc/mesh.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+// defines faces and lines of a mesh in a new region on each iteration
+static void BM_DefineAllFaces(benchmark::State& state)
+{
+	const BenchmarkMeshType type = static_cast<BenchmarkMeshType>(state.range(0));
+	const int elementsCountAxis = BenchmarkMesh::getElementsCountAxis(type, static_cast<int>(state.range(1)));
+	Context context("benchmark");
+	int facesCount = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Region region = context.getDefaultRegion().createRegion();
+		BenchmarkMesh::createMesh(region, type, elementsCountAxis);
+		Fieldmodule fm = region.getFieldmodule();
+		state.ResumeTiming();
+		fm.defineAllFaces();
+		state.PauseTiming();
+		facesCount = fm.findMeshByDimension(2).getSize();
+		region = Region();
+		fm = Fieldmodule();
+		state.ResumeTiming();
+	}
+	state.SetLabel(BenchmarkMesh::getTypeName(type));
+	state.counters["faces"] = static_cast<double>(facesCount);
+}
+BENCHMARK(BM_DefineAllFaces)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
+
+// creates the synthetic mesh, measuring node and element creation
+static void BM_CreateMesh(benchmark::State& state)
+{
+	const BenchmarkMeshType type = static_cast<BenchmarkMeshType>(state.range(0));
+	const int elementsCountAxis = BenchmarkMesh::getElementsCountAxis(type, static_cast<int>(state.range(1)));
+	Context context("benchmark");
+	for (auto _ : state)
+	{
+		Region region = context.getDefaultRegion().createRegion();
+		BenchmarkMesh::createMesh(region, type, elementsCountAxis);
+		state.PauseTiming();
+		region = Region();
+		state.ResumeTiming();
+	}
+	state.SetLabel(BenchmarkMesh::getTypeName(type));
+}
+BENCHMARK(BM_CreateMesh)->Apply(BenchmarkMesh::allSizes)->Unit(benchmark::kMillisecond);
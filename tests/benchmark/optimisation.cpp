@@ -0,0 +1,50 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <opencmiss/zinc/fieldarithmeticoperators.hpp>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldmeshoperators.hpp>
+#include <opencmiss/zinc/fieldsubobjectgroup.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/optimisation.hpp>
+
+#include "benchmark_mesh.hpp"
+
+using namespace OpenCMISS::Zinc;
+
+// runs one least squares iteration per benchmark iteration, fitting
+// coordinates over the whole mesh to a point by varying up to 64 nodes, so
+// the objective scales with the mesh while the number of parameters is fixed
+static void BM_OptimisationIteration(benchmark::State& state)
+{
+	BenchmarkMesh benchmarkMesh(state);
+	Fieldmodule& fm = benchmarkMesh.fm;
+	FieldNodeGroup nodeGroup = fm.createFieldNodeGroup(benchmarkMesh.nodes);
+	NodesetGroup nodesetGroup = nodeGroup.getNodesetGroup();
+	const int nodesCount = benchmarkMesh.nodes.getSize();
+	const int variableNodesCount = (nodesCount < 64) ? nodesCount : 64;
+	const int nodeStride = nodesCount/variableNodesCount;
+	for (int n = 0; n < variableNodesCount; ++n)
+		nodesetGroup.addNode(benchmarkMesh.nodes.findNodeByIdentifier(1 + n*nodeStride));
+	const double centreValues[3] = { 0.5, 0.5, 0.5 };
+	Field centre = fm.createFieldConstant(3, centreValues);
+	FieldMeshIntegralSquares objective = fm.createFieldMeshIntegralSquares(
+		benchmarkMesh.coordinates - centre, benchmarkMesh.coordinates, benchmarkMesh.mesh);
+	const int numberOfPoints = 2;
+	objective.setNumbersOfPoints(1, &numberOfPoints);
+	Optimisation optimisation = fm.createOptimisation();
+	optimisation.setMethod(Optimisation::METHOD_LEAST_SQUARES_QUASI_NEWTON);
+	optimisation.addObjectiveField(objective);
+	optimisation.addIndependentField(benchmarkMesh.coordinates);
+	optimisation.setConditionalField(benchmarkMesh.coordinates, nodeGroup);
+	optimisation.setAttributeInteger(Optimisation::ATTRIBUTE_MAXIMUM_ITERATIONS, 1);
+	for (auto _ : state)
+		optimisation.optimise();
+	state.counters["variable_nodes"] = static_cast<double>(variableNodesCount);
+}
+BENCHMARK(BM_OptimisationIteration)->Apply(BenchmarkMesh::smallSizes)->Unit(benchmark::kMillisecond);
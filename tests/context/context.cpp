@@ -6,15 +6,26 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include <opencmiss/zinc/core.h>
 #include <opencmiss/zinc/element.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
 #include <opencmiss/zinc/fieldmodule.hpp>
+#include <opencmiss/zinc/graphics.hpp>
+#include <opencmiss/zinc/logger.hpp>
 #include <opencmiss/zinc/region.hpp>
+#include <opencmiss/zinc/scene.hpp>
+#include <opencmiss/zinc/scenefilter.hpp>
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 
+#include "test_resources.h"
+
 TEST(cmzn_context, getVersion)
 {
 	ZincTestSetup zinc;
@@ -87,3 +98,110 @@ TEST(ZincContext, default_region)
 	Context otherContext = Context("other");
 	EXPECT_EQ(RESULT_ERROR_ARGUMENT_CONTEXT, otherContext.setDefaultRegion(r2));
 }
+
+TEST(ZincContext, statistics)
+{
+	ZincTestSetupCpp zinc;
+
+	double value = -1.0;
+	if (!zinc.context.isInstrumented())
+	{
+		EXPECT_EQ(RESULT_ERROR_NOT_IMPLEMENTED, zinc.context.getStatistic(Context::STATISTIC_TYPE_FIELD_EVALUATIONS, &value));
+		EXPECT_EQ(RESULT_ERROR_NOT_IMPLEMENTED, zinc.context.resetStatistics());
+		EXPECT_EQ((char *)0, zinc.context.getStatisticsDescription());
+		EXPECT_EQ(RESULT_ERROR_NOT_IMPLEMENTED, zinc.context.logStatistics());
+		return;
+	}
+	EXPECT_EQ(RESULT_OK, zinc.context.resetStatistics());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, zinc.context.getStatistic(Context::STATISTIC_TYPE_INVALID, &value));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, zinc.context.getStatistic(Context::STATISTIC_TYPE_FIELD_EVALUATIONS, 0));
+
+	Region region = zinc.context.getDefaultRegion();
+	Fieldmodule fm = region.getFieldmodule();
+	Scene scene = region.getScene();
+	EXPECT_EQ(RESULT_OK, region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_STREAM_READ_BYTES, &value));
+	EXPECT_LT(0.0, value);
+	EXPECT_EQ(RESULT_OK, zinc.context.resetStatistics());
+
+	Field coordinates = fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Fieldcache cache = fm.createFieldcache();
+	Element element = fm.findMeshByDimension(3).findElementByIdentifier(1);
+	const double xi[3] = { 0.25, 0.5, 0.75 };
+	double x[3];
+	EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, xi));
+	EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+	EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_FIELD_EVALUATIONS, &value));
+	EXPECT_EQ(2.0, value);
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_FIELD_EVALUATION_CACHE_HITS, &value));
+	EXPECT_EQ(1.0, value);
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_ELEMENT_FIELD_VALUES_CACHE_MISSES, &value));
+	EXPECT_EQ(1.0, value);
+
+	scene.beginChange();
+	GraphicsSurfaces surfaces = scene.createGraphicsSurfaces();
+	EXPECT_EQ(RESULT_OK, surfaces.setCoordinateField(coordinates));
+	scene.endChange();
+	double minimums[3], maximums[3];
+	EXPECT_EQ(RESULT_OK, scene.getCoordinatesRange(Scenefilter(), minimums, maximums));
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_GRAPHICS_BUILDS, &value));
+	EXPECT_EQ(1.0, value);
+
+	char *description = zinc.context.getStatisticsDescription();
+	EXPECT_NE((char *)0, description);
+	EXPECT_NE((char *)0, strstr(description, "\"FieldEvaluations\""));
+	EXPECT_NE((char *)0, strstr(description, "\"coordinates\""));
+	EXPECT_NE((char *)0, strstr(description, "\"SURFACES\""));
+	cmzn_deallocate(description);
+
+	Logger logger = zinc.context.getLogger();
+	const int oldMessagesCount = logger.getNumberOfMessages();
+	EXPECT_EQ(RESULT_OK, zinc.context.logStatistics());
+	EXPECT_EQ(oldMessagesCount + 1, logger.getNumberOfMessages());
+	EXPECT_EQ(Logger::MESSAGE_TYPE_INFORMATION, logger.getMessageTypeAtIndex(oldMessagesCount + 1));
+
+	EXPECT_EQ(RESULT_OK, zinc.context.resetStatistics());
+	EXPECT_EQ(RESULT_OK, zinc.context.getStatistic(Context::STATISTIC_TYPE_FIELD_EVALUATIONS, &value));
+	EXPECT_EQ(0.0, value);
+	description = zinc.context.getStatisticsDescription();
+	EXPECT_EQ((char *)0, strstr(description, "\"coordinates\""));
+	cmzn_deallocate(description);
+}
+
+TEST(ZincContext, trace)
+{
+	ZincTestSetupCpp zinc;
+	const char *traceFileName = "zinc_context_trace.json";
+
+	if (!zinc.context.isInstrumented())
+	{
+		EXPECT_EQ(RESULT_ERROR_NOT_IMPLEMENTED, zinc.context.beginTrace(traceFileName));
+		EXPECT_EQ(RESULT_ERROR_NOT_IMPLEMENTED, zinc.context.endTrace());
+		return;
+	}
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, zinc.context.beginTrace(0));
+	EXPECT_EQ(RESULT_ERROR_NOT_FOUND, zinc.context.endTrace());
+	EXPECT_EQ(RESULT_OK, zinc.context.beginTrace(traceFileName));
+	EXPECT_EQ(RESULT_ERROR_IN_USE, zinc.context.beginTrace(traceFileName));
+
+	Region region = zinc.context.getDefaultRegion();
+	EXPECT_EQ(RESULT_OK, region.beginChange());
+	EXPECT_EQ(RESULT_OK, region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	EXPECT_EQ(RESULT_OK, region.endChange());
+	EXPECT_EQ(RESULT_OK, zinc.context.endTrace());
+	EXPECT_EQ(RESULT_ERROR_NOT_FOUND, zinc.context.endTrace());
+
+	std::ifstream traceFile(traceFileName);
+	EXPECT_TRUE(traceFile.good());
+	std::stringstream buffer;
+	buffer << traceFile.rdbuf();
+	traceFile.close();
+	const std::string trace = buffer.str();
+	EXPECT_NE(std::string::npos, trace.find("\"traceEvents\""));
+	EXPECT_NE(std::string::npos, trace.find("\"name\":\"cmzn_region_read\""));
+	EXPECT_NE(std::string::npos, trace.find("\"name\":\"cmzn_region_end_change\""));
+	EXPECT_NE(std::string::npos, trace.find("\"name\":\"MANAGER_END_CACHE(Computed_field)\""));
+	std::remove(traceFileName);
+}
@@ -8,6 +8,9 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
 #include <opencmiss/zinc/core.h>
 #include <opencmiss/zinc/field.hpp>
@@ -19,6 +22,8 @@
 #include <opencmiss/zinc/fieldmeshoperators.hpp>
 #include <opencmiss/zinc/fieldmodule.hpp>
 #include <opencmiss/zinc/fieldsubobjectgroup.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
 #include <opencmiss/zinc/region.hpp>
 #include <opencmiss/zinc/result.hpp>
 #include <opencmiss/zinc/streamregion.hpp>
@@ -168,6 +173,72 @@ TEST(ZincStreaminformationRegion, fileFormat)
 	check_cube_model(zinc.fm);
 }
 
+// Test writing cube model with bulk array data in external HDF5 file
+TEST(ZincStreaminformationRegion, fieldmlDataFormat)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDIO_FIELDML_CUBE_RESOURCE)));
+	check_cube_model(zinc.fm);
+
+	StreaminformationRegion streamInfo = zinc.root_region.createStreaminformationRegion();
+	EXPECT_TRUE(streamInfo.isValid());
+	StreamresourceFile fileResource = streamInfo.createStreamresourceFile(FIELDML_OUTPUT_FOLDER "/cube_hdf5.fieldml");
+	EXPECT_TRUE(fileResource.isValid());
+	StreaminformationRegion::FieldmlDataFormat fieldmlDataFormat = streamInfo.getFieldmlDataFormat();
+	EXPECT_EQ(StreaminformationRegion::FIELDML_DATA_FORMAT_INLINE_TEXT, fieldmlDataFormat);
+	EXPECT_EQ(ERROR_ARGUMENT, result = streamInfo.setFieldmlDataFormat(StreaminformationRegion::FIELDML_DATA_FORMAT_INVALID));
+	EXPECT_EQ(OK, result = streamInfo.setFieldmlDataFormat(StreaminformationRegion::FIELDML_DATA_FORMAT_HDF5));
+	EXPECT_EQ(StreaminformationRegion::FIELDML_DATA_FORMAT_HDF5, fieldmlDataFormat = streamInfo.getFieldmlDataFormat());
+	// requires FieldML API built with HDF5 support
+	EXPECT_EQ(OK, result = zinc.root_region.write(streamInfo));
+
+	// arrays are in an external file referenced from the FieldML document
+	std::ifstream hdf5File(FIELDML_OUTPUT_FOLDER "/cube_hdf5.h5", std::ios::in | std::ios::binary);
+	EXPECT_TRUE(hdf5File.is_open());
+	char signature[8] = { 0 };
+	hdf5File.read(signature, 8);
+	EXPECT_EQ(0, memcmp(signature, "\x89HDF\r\n\x1a\n", 8));
+	hdf5File.close();
+	std::ifstream fieldmlFile(FIELDML_OUTPUT_FOLDER "/cube_hdf5.fieldml");
+	EXPECT_TRUE(fieldmlFile.is_open());
+	std::stringstream fieldmlText;
+	fieldmlText << fieldmlFile.rdbuf();
+	EXPECT_NE(std::string::npos, fieldmlText.str().find("cube_hdf5.h5"));
+
+	Region testRegion = zinc.root_region.createChild("test");
+	EXPECT_EQ(OK, result = testRegion.readFile(FIELDML_OUTPUT_FOLDER "/cube_hdf5.fieldml"));
+	Fieldmodule testFm = testRegion.getFieldmodule();
+	check_cube_model(testFm);
+
+	// compare node values with the original
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	Field pressure = zinc.fm.findFieldByName("pressure");
+	Field testCoordinates = testFm.findFieldByName("coordinates");
+	Field testPressure = testFm.findFieldByName("pressure");
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodeset testNodes = testFm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Fieldcache cache = zinc.fm.createFieldcache();
+	Fieldcache testCache = testFm.createFieldcache();
+	Nodeiterator iter = nodes.createNodeiterator();
+	Node node;
+	while ((node = iter.next()).isValid())
+	{
+		EXPECT_EQ(OK, result = cache.setNode(node));
+		EXPECT_EQ(OK, result = testCache.setNode(testNodes.findNodeByIdentifier(node.getIdentifier())));
+		double x[3], testX[3], p, testP;
+		EXPECT_EQ(OK, result = coordinates.evaluateReal(cache, 3, x));
+		EXPECT_EQ(OK, result = testCoordinates.evaluateReal(testCache, 3, testX));
+		for (int c = 0; c < 3; ++c)
+			EXPECT_DOUBLE_EQ(x[c], testX[c]);
+		EXPECT_EQ(OK, result = pressure.evaluateReal(cache, 1, &p));
+		EXPECT_EQ(OK, result = testPressure.evaluateReal(testCache, 1, &testP));
+		EXPECT_DOUBLE_EQ(p, testP);
+	}
+}
+
 namespace {
 
 void check_tetmesh_model(Fieldmodule& fm)
@@ -15,6 +15,17 @@
 #include <opencmiss/zinc/field.h>
 #include <opencmiss/zinc/fieldfibres.h>
 #include <opencmiss/zinc/fieldconstant.h>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfibres.hpp>
+#include <opencmiss/zinc/fieldmatrixoperators.hpp>
+#include <opencmiss/zinc/mesh.hpp>
+
+#include "zinctestsetupcpp.hpp"
+
+#include "test_resources.h"
+
+#include <cmath>
 
 TEST(cmzn_fieldmodule_create_field_fibre_axes, invalid_args)
 {
@@ -47,3 +58,103 @@ TEST(cmzn_fieldmodule_create_field_fibre_axes, invalid_args)
 	cmzn_context_destroy(&context);
 }
 
+
+// check kinematic quantities of a homogeneous deformation x = A.X in fibre axes
+TEST(ZincFieldFibreDeformationGradient, evaluate)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	// coordinates equal xi in the unit cube element
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double A[9] =
+	{
+		1.10, 0.20, -0.05,
+		0.05, 0.95,  0.10,
+		0.00, 0.15,  1.20
+	};
+	Field deformed = zinc.fm.createFieldMatrixMultiply(3, zinc.fm.createFieldConstant(9, A), coordinates);
+	EXPECT_TRUE(deformed.isValid());
+	const double fibreAngle = 0.5;
+	Field fibres = zinc.fm.createFieldConstant(1, &fibreAngle);
+	EXPECT_TRUE(fibres.isValid());
+
+	FieldFibreDeformationGradient F = zinc.fm.createFieldFibreDeformationGradient(deformed, coordinates, fibres);
+	EXPECT_TRUE(F.isValid());
+	EXPECT_EQ(9, F.getNumberOfComponents());
+	FieldFibreStrain C = zinc.fm.createFieldFibreRightCauchyGreenDeformation(F);
+	EXPECT_TRUE(C.isValid());
+	EXPECT_EQ(9, C.getNumberOfComponents());
+	FieldFibreStrain E = zinc.fm.createFieldFibreGreenLagrangeStrain(F);
+	EXPECT_TRUE(E.isValid());
+	EXPECT_EQ(9, E.getNumberOfComponents());
+	FieldFibreStrain principalStrains = zinc.fm.createFieldFibrePrincipalStrains(F);
+	EXPECT_TRUE(principalStrains.isValid());
+	EXPECT_EQ(3, principalStrains.getNumberOfComponents());
+	// quantities must be created from a fibre deformation gradient
+	EXPECT_FALSE(zinc.fm.createFieldFibreGreenLagrangeStrain(FieldFibreDeformationGradient()).isValid());
+
+	// fibre axes of the cube rotated about the xi3 axis by the fibre angle
+	const double c = cos(fibreAngle), s = sin(fibreAngle);
+	const double Q[9] =
+	{
+		  c,   s, 0.0,
+		 -s,   c, 0.0,
+		0.0, 0.0, 1.0
+	};
+	double expectedF[9], expectedC[9], expectedE[9], AQ[9];
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			AQ[i*3 + j] = A[i*3]*Q[j*3] + A[i*3 + 1]*Q[j*3 + 1] + A[i*3 + 2]*Q[j*3 + 2];
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			expectedF[i*3 + j] = Q[i*3]*AQ[j] + Q[i*3 + 1]*AQ[3 + j] + Q[i*3 + 2]*AQ[6 + j];
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+		{
+			expectedC[i*3 + j] = expectedF[i]*expectedF[j] + expectedF[3 + i]*expectedF[3 + j] + expectedF[6 + i]*expectedF[6 + j];
+			expectedE[i*3 + j] = 0.5*(expectedC[i*3 + j] - ((i == j) ? 1.0 : 0.0));
+		}
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double values[9];
+	// not defined away from elements
+	EXPECT_EQ(RESULT_OK, cache.setNode(zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES).findNodeByIdentifier(1)));
+	EXPECT_FALSE(F.isDefinedAtLocation(cache));
+	EXPECT_NE(RESULT_OK, E.evaluateReal(cache, 9, values));
+	// evaluate in the cube and on a face, using the top level element
+	for (int dimension = 3; dimension >= 2; --dimension)
+	{
+		Mesh mesh = zinc.fm.findMeshByDimension(dimension);
+		Element element = mesh.findElementByIdentifier(1);
+		EXPECT_TRUE(element.isValid());
+		const double xi[3] = { 0.2, 0.5, 0.7 };
+		EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, dimension, xi));
+		EXPECT_TRUE(F.isDefinedAtLocation(cache));
+		EXPECT_EQ(RESULT_OK, F.evaluateReal(cache, 9, values));
+		for (int i = 0; i < 9; ++i)
+			EXPECT_NEAR(expectedF[i], values[i], 1.0E-12);
+		EXPECT_EQ(RESULT_OK, C.evaluateReal(cache, 9, values));
+		for (int i = 0; i < 9; ++i)
+			EXPECT_NEAR(expectedC[i], values[i], 1.0E-12);
+		EXPECT_EQ(RESULT_OK, E.evaluateReal(cache, 9, values));
+		for (int i = 0; i < 9; ++i)
+			EXPECT_NEAR(expectedE[i], values[i], 1.0E-12);
+		// principal strains are in decreasing order and preserve invariants of E
+		EXPECT_EQ(RESULT_OK, principalStrains.evaluateReal(cache, 3, values));
+		EXPECT_GE(values[0], values[1]);
+		EXPECT_GE(values[1], values[2]);
+		EXPECT_NEAR(expectedE[0] + expectedE[4] + expectedE[8], values[0] + values[1] + values[2], 1.0E-12);
+		double sumSquares = 0.0;
+		for (int i = 0; i < 9; ++i)
+			sumSquares += expectedE[i]*expectedE[i];
+		EXPECT_NEAR(sumSquares, values[0]*values[0] + values[1]*values[1] + values[2]*values[2], 1.0E-12);
+		const double determinantE =
+			expectedE[0]*(expectedE[4]*expectedE[8] - expectedE[5]*expectedE[7]) -
+			expectedE[1]*(expectedE[3]*expectedE[8] - expectedE[5]*expectedE[6]) +
+			expectedE[2]*(expectedE[3]*expectedE[7] - expectedE[4]*expectedE[6]);
+		EXPECT_NEAR(determinantE, values[0]*values[1]*values[2], 1.0E-12);
+	}
+}
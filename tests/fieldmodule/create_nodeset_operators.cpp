@@ -7,21 +7,35 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
 
 #include <opencmiss/zinc/core.h>
+#include <opencmiss/zinc/fieldarithmeticoperators.h>
 #include <opencmiss/zinc/context.h>
 #include <opencmiss/zinc/field.h>
 #include <opencmiss/zinc/fieldcache.h>
 #include <opencmiss/zinc/fieldconstant.h>
 #include <opencmiss/zinc/fieldcomposite.h>
+#include <opencmiss/zinc/fieldfiniteelement.h>
 #include <opencmiss/zinc/fieldmodule.h>
 #include <opencmiss/zinc/fieldnodesetoperators.h>
+#include <opencmiss/zinc/fieldtrigonometry.h>
+#include <opencmiss/zinc/fieldvectoroperators.h>
+#include <opencmiss/zinc/node.h>
 #include <opencmiss/zinc/nodeset.h>
+#include <opencmiss/zinc/nodetemplate.h>
 #include <opencmiss/zinc/region.h>
 #include <opencmiss/zinc/status.h>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldnodesetoperators.hpp>
+#include <opencmiss/zinc/fieldsubobjectgroup.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/nodetemplate.hpp>
 
 #include "test_resources.h"
 #include "zinctestsetup.hpp"
+#include "zinctestsetupcpp.hpp"
 
 TEST(cmzn_fieldmodule_create_field_nodeset_minimum, invalid_args)
 {
@@ -226,3 +240,343 @@ TEST(cmzn_fieldmodule_create_field_nodeset_maximum, multiplecomponents)
 
 }
 
+
+// Nodeset operators on finite element fields and simple arithmetic expressions
+// of them evaluate directly from node parameters; compare with per-node results
+TEST(cmzn_fieldmodule_create_field_nodeset_operators, arithmetic_expression)
+{
+	ZincTestSetup zinc;
+	int result = 0;
+	EXPECT_EQ(CMZN_OK, result = cmzn_region_read_file(zinc.root_region, TestResources::getLocation(TestResources::FIELDMODULE_EXNODE_RESOURCE)));
+	cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(zinc.fm, "coordinates");
+	EXPECT_NE(static_cast<cmzn_field *>(0), coordinates);
+	const double offsetValues[3] = { 1.0, 2.0, 3.0 };
+	cmzn_field_id offset = cmzn_fieldmodule_create_field_constant(zinc.fm, 3, offsetValues);
+	EXPECT_NE(static_cast<cmzn_field *>(0), offset);
+	const double twoValues[3] = { 2.0, 2.0, 2.0 };
+	cmzn_field_id two = cmzn_fieldmodule_create_field_constant(zinc.fm, 3, twoValues);
+	EXPECT_NE(static_cast<cmzn_field *>(0), two);
+	// multiply and add can also evaluate directly from node parameters
+	cmzn_field_id square = cmzn_fieldmodule_create_field_multiply(zinc.fm, coordinates, coordinates);
+	EXPECT_NE(static_cast<cmzn_field *>(0), square);
+	cmzn_field_id fastExpression = cmzn_fieldmodule_create_field_add(zinc.fm, square, offset);
+	EXPECT_NE(static_cast<cmzn_field *>(0), fastExpression);
+	// power has no evaluation from node parameters of its own, but like
+	// multiply and add it compiles to a tape whose only input, coordinates,
+	// is evaluated from node parameters. Both expressions must give the
+	// expected results, and the same results as each other
+	cmzn_field_id power = cmzn_fieldmodule_create_field_power(zinc.fm, coordinates, two);
+	EXPECT_NE(static_cast<cmzn_field *>(0), power);
+	cmzn_field_id slowExpression = cmzn_fieldmodule_create_field_add(zinc.fm, power, offset);
+	EXPECT_NE(static_cast<cmzn_field *>(0), slowExpression);
+	cmzn_nodeset_id ns = cmzn_fieldmodule_find_nodeset_by_field_domain_type(zinc.fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	EXPECT_NE(static_cast<cmzn_nodeset *>(0), ns);
+	cmzn_fieldcache_id fc = cmzn_fieldmodule_create_fieldcache(zinc.fm);
+	EXPECT_NE(static_cast<cmzn_fieldcache *>(0), fc);
+
+	typedef cmzn_field_id (*CreateNodesetOperator)(cmzn_fieldmodule_id, cmzn_field_id, cmzn_nodeset_id);
+	const CreateNodesetOperator createFunctions[5] =
+	{
+		cmzn_fieldmodule_create_field_nodeset_sum,
+		cmzn_fieldmodule_create_field_nodeset_mean,
+		cmzn_fieldmodule_create_field_nodeset_sum_squares,
+		cmzn_fieldmodule_create_field_nodeset_minimum,
+		cmzn_fieldmodule_create_field_nodeset_maximum
+	};
+	const double expectedValues[5][3] =
+	{
+		{ 33.0, 47.0, 54.0 },
+		{ 33.0/16.0, 47.0/16.0, 54.0/16.0 },
+		{ 91.0, 163.0, 186.0 },
+		{ 1.0, 2.0, 3.0 },
+		{ 5.0, 6.0, 4.0 }
+	};
+	for (int i = 0; i < 5; ++i)
+	{
+		cmzn_field_id fastField = (createFunctions[i])(zinc.fm, fastExpression, ns);
+		EXPECT_NE(static_cast<cmzn_field *>(0), fastField);
+		cmzn_field_id slowField = (createFunctions[i])(zinc.fm, slowExpression, ns);
+		EXPECT_NE(static_cast<cmzn_field *>(0), slowField);
+		double fastValues[3], slowValues[3];
+		EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(fastField, fc, 3, fastValues));
+		EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(slowField, fc, 3, slowValues));
+		for (int c = 0; c < 3; ++c)
+		{
+			EXPECT_DOUBLE_EQ(expectedValues[i][c], fastValues[c]);
+			EXPECT_DOUBLE_EQ(slowValues[c], fastValues[c]);
+		}
+		cmzn_field_destroy(&fastField);
+		cmzn_field_destroy(&slowField);
+	}
+
+	cmzn_fieldcache_destroy(&fc);
+	cmzn_nodeset_destroy(&ns);
+	cmzn_field_destroy(&slowExpression);
+	cmzn_field_destroy(&power);
+	cmzn_field_destroy(&fastExpression);
+	cmzn_field_destroy(&square);
+	cmzn_field_destroy(&two);
+	cmzn_field_destroy(&offset);
+	cmzn_field_destroy(&coordinates);
+}
+
+namespace {
+
+/** Sum expression over nodes in nodeset evaluating node-by-node */
+void sumNodesetValues(cmzn_field_id expression, cmzn_nodeset_id nodeset,
+	cmzn_fieldcache_id fieldcache, double *sums)
+{
+	const int componentCount = cmzn_field_get_number_of_components(expression);
+	for (int c = 0; c < componentCount; ++c)
+		sums[c] = 0.0;
+	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
+	cmzn_node_id node;
+	while (0 != (node = cmzn_nodeiterator_next(iterator)))
+	{
+		double values[3];
+		EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_node(fieldcache, node));
+		EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(expression, fieldcache, componentCount, values));
+		for (int c = 0; c < componentCount; ++c)
+			sums[c] += values[c];
+		cmzn_node_destroy(&node);
+	}
+	cmzn_nodeiterator_destroy(&iterator);
+}
+
+}
+
+// test nodeset sum of expression with repeated subexpressions and constants
+// compiled to a tape, and recompiled when constants change
+TEST(cmzn_fieldmodule_create_field_nodeset_operators, compiled_expression)
+{
+	ZincTestSetup zinc;
+	int result = 0;
+	EXPECT_EQ(CMZN_OK, result = cmzn_region_read_file(zinc.root_region, TestResources::getLocation(TestResources::FIELDMODULE_EXNODE_RESOURCE)));
+	cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(zinc.fm, "coordinates");
+	EXPECT_NE(static_cast<cmzn_field *>(0), coordinates);
+	const double offsetValues[3] = { 1.0, 2.0, 3.0 };
+	cmzn_field_id offset = cmzn_fieldmodule_create_field_constant(zinc.fm, 3, offsetValues);
+	EXPECT_NE(static_cast<cmzn_field *>(0), offset);
+	// sin(x)*sin(x) + cos(x)*cos(x) + x/(offset + |x|)
+	cmzn_field_id sin1 = cmzn_fieldmodule_create_field_sin(zinc.fm, coordinates);
+	EXPECT_NE(static_cast<cmzn_field *>(0), sin1);
+	cmzn_field_id sin2 = cmzn_fieldmodule_create_field_sin(zinc.fm, coordinates);
+	EXPECT_NE(static_cast<cmzn_field *>(0), sin2);
+	cmzn_field_id cosine = cmzn_fieldmodule_create_field_cos(zinc.fm, coordinates);
+	EXPECT_NE(static_cast<cmzn_field *>(0), cosine);
+	cmzn_field_id sinSquared = cmzn_fieldmodule_create_field_multiply(zinc.fm, sin1, sin2);
+	EXPECT_NE(static_cast<cmzn_field *>(0), sinSquared);
+	cmzn_field_id cosSquared = cmzn_fieldmodule_create_field_multiply(zinc.fm, cosine, cosine);
+	EXPECT_NE(static_cast<cmzn_field *>(0), cosSquared);
+	cmzn_field_id one = cmzn_fieldmodule_create_field_add(zinc.fm, sinSquared, cosSquared);
+	EXPECT_NE(static_cast<cmzn_field *>(0), one);
+	cmzn_field_id magnitude = cmzn_fieldmodule_create_field_magnitude(zinc.fm, coordinates);
+	EXPECT_NE(static_cast<cmzn_field *>(0), magnitude);
+	cmzn_field_id denominator = cmzn_fieldmodule_create_field_add(zinc.fm, offset, magnitude);
+	EXPECT_NE(static_cast<cmzn_field *>(0), denominator);
+	cmzn_field_id quotient = cmzn_fieldmodule_create_field_divide(zinc.fm, coordinates, denominator);
+	EXPECT_NE(static_cast<cmzn_field *>(0), quotient);
+	cmzn_field_id expression = cmzn_fieldmodule_create_field_add(zinc.fm, one, quotient);
+	EXPECT_NE(static_cast<cmzn_field *>(0), expression);
+	cmzn_nodeset_id ns = cmzn_fieldmodule_find_nodeset_by_field_domain_type(zinc.fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	EXPECT_NE(static_cast<cmzn_nodeset *>(0), ns);
+	cmzn_field_id nodesetSum = cmzn_fieldmodule_create_field_nodeset_sum(zinc.fm, expression, ns);
+	EXPECT_NE(static_cast<cmzn_field *>(0), nodesetSum);
+	cmzn_fieldcache_id fc = cmzn_fieldmodule_create_fieldcache(zinc.fm);
+	EXPECT_NE(static_cast<cmzn_fieldcache *>(0), fc);
+
+	double expectedValues[3], values[3];
+	sumNodesetValues(expression, ns, fc, expectedValues);
+	EXPECT_EQ(CMZN_OK, result = cmzn_fieldcache_clear_location(fc));
+	EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(nodesetSum, fc, 3, values));
+	for (int c = 0; c < 3; ++c)
+		EXPECT_NEAR(expectedValues[c], values[c], 1.0E-12*fabs(expectedValues[c]));
+
+	// changing constant must discard the compiled tape
+	const double newOffsetValues[3] = { 0.5, -2.5, 7.25 };
+	EXPECT_EQ(CMZN_OK, result = cmzn_field_assign_real(offset, fc, 3, newOffsetValues));
+	double newExpectedValues[3];
+	sumNodesetValues(expression, ns, fc, newExpectedValues);
+	EXPECT_NE(expectedValues[0], newExpectedValues[0]);
+	EXPECT_EQ(CMZN_OK, result = cmzn_fieldcache_clear_location(fc));
+	EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(nodesetSum, fc, 3, values));
+	for (int c = 0; c < 3; ++c)
+		EXPECT_NEAR(newExpectedValues[c], values[c], 1.0E-12*fabs(newExpectedValues[c]));
+
+	cmzn_fieldcache_destroy(&fc);
+	cmzn_field_destroy(&nodesetSum);
+	cmzn_nodeset_destroy(&ns);
+	cmzn_field_destroy(&expression);
+	cmzn_field_destroy(&quotient);
+	cmzn_field_destroy(&denominator);
+	cmzn_field_destroy(&magnitude);
+	cmzn_field_destroy(&one);
+	cmzn_field_destroy(&cosSquared);
+	cmzn_field_destroy(&sinSquared);
+	cmzn_field_destroy(&cosine);
+	cmzn_field_destroy(&sin2);
+	cmzn_field_destroy(&sin1);
+	cmzn_field_destroy(&offset);
+	cmzn_field_destroy(&coordinates);
+}
+
+// test a compiled composite selecting components of one source is only defined
+// where its other sources are also defined, as for usual evaluation
+TEST(cmzn_fieldmodule_create_field_nodeset_operators, compiled_expression_partially_defined)
+{
+	ZincTestSetup zinc;
+	int result = 0;
+	EXPECT_EQ(CMZN_OK, result = cmzn_region_read_file(zinc.root_region, TestResources::getLocation(TestResources::FIELDMODULE_EXNODE_RESOURCE)));
+	cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(zinc.fm, "coordinates");
+	EXPECT_NE(static_cast<cmzn_field *>(0), coordinates);
+	cmzn_nodeset_id ns = cmzn_fieldmodule_find_nodeset_by_field_domain_type(zinc.fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	EXPECT_NE(static_cast<cmzn_nodeset *>(0), ns);
+	cmzn_fieldcache_id fc = cmzn_fieldmodule_create_fieldcache(zinc.fm);
+	EXPECT_NE(static_cast<cmzn_fieldcache *>(0), fc);
+
+	// define field only at odd numbered nodes
+	cmzn_field_id partial = cmzn_fieldmodule_create_field_finite_element(zinc.fm, 1);
+	EXPECT_NE(static_cast<cmzn_field *>(0), partial);
+	cmzn_nodetemplate_id nodetemplate = cmzn_nodeset_create_nodetemplate(ns);
+	EXPECT_EQ(CMZN_OK, result = cmzn_nodetemplate_define_field(nodetemplate, partial));
+	double expectedSum = 0.0;
+	for (int identifier = 1; identifier <= 16; identifier += 2)
+	{
+		cmzn_node_id node = cmzn_nodeset_find_node_by_identifier(ns, identifier);
+		EXPECT_NE(static_cast<cmzn_node *>(0), node);
+		EXPECT_EQ(CMZN_OK, result = cmzn_node_merge(node, nodetemplate));
+		EXPECT_EQ(CMZN_OK, result = cmzn_fieldcache_set_node(fc, node));
+		const double value = static_cast<double>(identifier);
+		EXPECT_EQ(CMZN_OK, result = cmzn_field_assign_real(partial, fc, 1, &value));
+		double x[3];
+		EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(coordinates, fc, 3, x));
+		expectedSum += x[0];
+		cmzn_node_destroy(&node);
+	}
+	cmzn_nodetemplate_destroy(&nodetemplate);
+
+	// only registers for the coordinates are used by the component field
+	cmzn_field_id sourceFields[2] = { coordinates, partial };
+	cmzn_field_id concatenate = cmzn_fieldmodule_create_field_concatenate(zinc.fm, 2, sourceFields);
+	EXPECT_NE(static_cast<cmzn_field *>(0), concatenate);
+	cmzn_field_id x = cmzn_fieldmodule_create_field_component(zinc.fm, concatenate, 1);
+	EXPECT_NE(static_cast<cmzn_field *>(0), x);
+
+	cmzn_node_id node = cmzn_nodeset_find_node_by_identifier(ns, 2);
+	EXPECT_EQ(CMZN_OK, result = cmzn_fieldcache_set_node(fc, node));
+	EXPECT_FALSE(cmzn_field_is_defined_at_location(x, fc));
+	double value;
+	EXPECT_NE(CMZN_OK, result = cmzn_field_evaluate_real(x, fc, 1, &value));
+	cmzn_node_destroy(&node);
+
+	cmzn_field_id nodesetSum = cmzn_fieldmodule_create_field_nodeset_sum(zinc.fm, x, ns);
+	EXPECT_NE(static_cast<cmzn_field *>(0), nodesetSum);
+	cmzn_field_id nodesetMean = cmzn_fieldmodule_create_field_nodeset_mean(zinc.fm, x, ns);
+	EXPECT_NE(static_cast<cmzn_field *>(0), nodesetMean);
+	EXPECT_EQ(CMZN_OK, result = cmzn_fieldcache_clear_location(fc));
+	EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(nodesetSum, fc, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+	EXPECT_EQ(CMZN_OK, result = cmzn_field_evaluate_real(nodesetMean, fc, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum/8.0, value);
+
+	cmzn_field_destroy(&nodesetMean);
+	cmzn_field_destroy(&nodesetSum);
+	cmzn_field_destroy(&x);
+	cmzn_field_destroy(&concatenate);
+	cmzn_field_destroy(&partial);
+	cmzn_fieldcache_destroy(&fc);
+	cmzn_nodeset_destroy(&ns);
+	cmzn_field_destroy(&coordinates);
+}
+
+TEST(ZincFieldFindNearestNode, evaluate)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(coordinates.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, result = nodetemplate.defineField(coordinates));
+	Fieldcache cache = zinc.fm.createFieldcache();
+	// 5x5x5 grid of nodes at integer coordinates, identifiers from 1
+	zinc.fm.beginChange();
+	for (int k = 0; k < 5; ++k)
+		for (int j = 0; j < 5; ++j)
+			for (int i = 0; i < 5; ++i)
+			{
+				Node node = nodes.createNode(1 + i + 5*j + 25*k, nodetemplate);
+				EXPECT_TRUE(node.isValid());
+				EXPECT_EQ(RESULT_OK, result = cache.setNode(node));
+				const double x[3] = { static_cast<double>(i), static_cast<double>(j), static_cast<double>(k) };
+				EXPECT_EQ(RESULT_OK, result = coordinates.assignReal(cache, 3, x));
+			}
+	zinc.fm.endChange();
+
+	const double pointValues[3] = { 1.2, 3.4, 2.45 };
+	FieldConstant point = zinc.fm.createFieldConstant(3, pointValues);
+	EXPECT_TRUE(point.isValid());
+	const double twoValues[2] = { 1.0, 2.0 };
+	FieldConstant two = zinc.fm.createFieldConstant(2, twoValues);
+	EXPECT_FALSE(zinc.fm.createFieldFindNearestNode(two, coordinates, nodes).isValid());
+	FieldFindNearestNode findNearestNode = zinc.fm.createFieldFindNearestNode(point, coordinates, nodes);
+	EXPECT_TRUE(findNearestNode.isValid());
+	EXPECT_EQ(nodes, findNearestNode.getNodeset());
+	FieldFindNearestNode castNearestNode = findNearestNode.castFindNearestNode();
+	EXPECT_TRUE(castNearestNode.isValid());
+	EXPECT_FALSE(point.castFindNearestNode().isValid());
+
+	double values[3];
+	EXPECT_EQ(RESULT_OK, result = findNearestNode.evaluateReal(cache, 3, values));
+	EXPECT_DOUBLE_EQ(1.0, values[0]);
+	EXPECT_DOUBLE_EQ(3.0, values[1]);
+	EXPECT_DOUBLE_EQ(2.0, values[2]);
+	Node node = findNearestNode.evaluateNode(cache);
+	EXPECT_EQ(1 + 1 + 5*3 + 25*2, node.getIdentifier());
+
+	// outside the grid of nodes
+	const double farValues[3] = { -10.0, 20.0, 2.8 };
+	EXPECT_EQ(RESULT_OK, result = point.assignReal(cache, 3, farValues));
+	node = findNearestNode.evaluateNode(cache);
+	EXPECT_EQ(1 + 0 + 5*4 + 25*3, node.getIdentifier());
+
+	// nodes within distance
+	const double centreValues[3] = { 2.0, 2.0, 2.0 };
+	EXPECT_EQ(RESULT_OK, result = point.assignReal(cache, 3, centreValues));
+	FieldNodeGroup nodeGroup = zinc.fm.createFieldNodeGroup(nodes);
+	NodesetGroup nodesetGroup = nodeGroup.getNodesetGroup();
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, result = findNearestNode.addNodesWithinDistance(cache, -1.0, nodesetGroup));
+	EXPECT_EQ(RESULT_OK, result = findNearestNode.addNodesWithinDistance(cache, 1.0, nodesetGroup));
+	EXPECT_EQ(7, nodesetGroup.getSize());
+	EXPECT_EQ(RESULT_OK, result = findNearestNode.addNodesWithinDistance(cache, 1.5, nodesetGroup));
+	EXPECT_EQ(19, nodesetGroup.getSize());
+
+	// index must be rebuilt after nodes move or are destroyed
+	node = nodes.findNodeByIdentifier(1 + 2 + 5*2 + 25*2);
+	EXPECT_EQ(RESULT_OK, result = cache.setNode(node));
+	const double movedValues[3] = { 10.0, 10.0, 10.0 };
+	EXPECT_EQ(RESULT_OK, result = coordinates.assignReal(cache, 3, movedValues));
+	const double nearMovedValues[3] = { 9.0, 9.0, 8.0 };
+	EXPECT_EQ(RESULT_OK, result = point.assignReal(cache, 3, nearMovedValues));
+	Node nearestNode = findNearestNode.evaluateNode(cache);
+	EXPECT_EQ(node, nearestNode);
+	EXPECT_EQ(RESULT_OK, result = nodes.destroyNode(node));
+	node = Node();
+	nearestNode = findNearestNode.evaluateNode(cache);
+	EXPECT_EQ(125, nearestNode.getIdentifier());
+	EXPECT_EQ(RESULT_OK, result = findNearestNode.evaluateReal(cache, 3, values));
+	EXPECT_DOUBLE_EQ(4.0, values[0]);
+	EXPECT_DOUBLE_EQ(4.0, values[1]);
+	EXPECT_DOUBLE_EQ(4.0, values[2]);
+
+	// search only nodes in group
+	Field findNearestGroupNode = zinc.fm.createFieldFindNearestNode(point, coordinates, nodesetGroup);
+	EXPECT_TRUE(findNearestGroupNode.isValid());
+	EXPECT_EQ(RESULT_OK, result = findNearestGroupNode.evaluateReal(cache, 3, values));
+	EXPECT_DOUBLE_EQ(3.0, values[0]);
+	EXPECT_DOUBLE_EQ(3.0, values[1]);
+	EXPECT_DOUBLE_EQ(2.0, values[2]);
+	EXPECT_EQ(RESULT_OK, result = nodesetGroup.removeAllNodes());
+	EXPECT_FALSE(findNearestGroupNode.isDefinedAtLocation(cache));
+}
@@ -8,21 +8,28 @@
 
 #include <gtest/gtest.h>
 
+#include <opencmiss/zinc/element.hpp>
 #include <opencmiss/zinc/field.hpp>
 #include <opencmiss/zinc/fieldarithmeticoperators.hpp>
 #include <opencmiss/zinc/fieldassignment.hpp>
 #include <opencmiss/zinc/fieldcache.hpp>
 #include <opencmiss/zinc/fieldcomposite.hpp>
+#include <opencmiss/zinc/fieldconditional.hpp>
 #include <opencmiss/zinc/fieldconstant.hpp>
 #include <opencmiss/zinc/fieldderivatives.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
 #include <opencmiss/zinc/fieldlogicaloperators.hpp>
 #include <opencmiss/zinc/fieldmatrixoperators.hpp>
+#include <opencmiss/zinc/fieldtrigonometry.hpp>
 #include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/nodetemplate.hpp>
 
 #include "zinctestsetupcpp.hpp"
 
 #include "test_resources.h"
 
+#include <cmath>
 #include <limits>
 #include <sstream>
 
@@ -600,6 +607,241 @@ TEST(ZincField, field_operator_derivatives_3d)
 	compare_double_array("expected_divide_deformed_temperature_derivatives1", expected_divide_deformed_temperature_derivatives1, divide_deformed_temperature_derivatives1, 12, 3, temperatureDerivatives1Tol);
 }
 
+// Derivatives of expressions compiled to a tape are evaluated by forward-mode
+// automatic differentiation; compare with analytic derivatives
+TEST(ZincField, compiled_expression_derivatives)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	// coordinates equal xi in the unit cube element
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	// e = sin(X).X + |X|
+	Field sinCoordinates = zinc.fm.createFieldSin(coordinates);
+	EXPECT_TRUE(sinCoordinates.isValid());
+	Field dotProduct = zinc.fm.createFieldDotProduct(sinCoordinates, coordinates);
+	EXPECT_TRUE(dotProduct.isValid());
+	Field magnitude = zinc.fm.createFieldMagnitude(coordinates);
+	EXPECT_TRUE(magnitude.isValid());
+	Field expression = zinc.fm.createFieldAdd(dotProduct, magnitude);
+	EXPECT_TRUE(expression.isValid());
+	// p = X^3 / (X + 1)
+	const double three = 3.0, one = 1.0;
+	Field power = zinc.fm.createFieldPower(coordinates, zinc.fm.createFieldConstant(1, &three));
+	EXPECT_TRUE(power.isValid());
+	Field quotient = zinc.fm.createFieldDivide(power,
+		zinc.fm.createFieldAdd(coordinates, zinc.fm.createFieldConstant(1, &one)));
+	EXPECT_TRUE(quotient.isValid());
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	Differentialoperator d_dxi[3];
+	for (int d = 0; d < 3; ++d)
+	{
+		d_dxi[d] = mesh3d.getChartDifferentialoperator(/*order*/1, d + 1);
+		EXPECT_TRUE(d_dxi[d].isValid());
+	}
+	Element element = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	const double xi[3] = { 0.2, 0.5, 0.9 };
+	EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, xi));
+	const double length = sqrt(xi[0]*xi[0] + xi[1]*xi[1] + xi[2]*xi[2]);
+	double value, values[3], derivatives[3];
+	EXPECT_EQ(RESULT_OK, expression.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(sin(xi[0])*xi[0] + sin(xi[1])*xi[1] + sin(xi[2])*xi[2] + length, value, 1.0E-12);
+	for (int d = 0; d < 3; ++d)
+	{
+		EXPECT_EQ(RESULT_OK, expression.evaluateDerivative(d_dxi[d], cache, 1, &value));
+		EXPECT_NEAR(cos(xi[d])*xi[d] + sin(xi[d]) + xi[d]/length, value, 1.0E-12);
+		EXPECT_EQ(RESULT_OK, quotient.evaluateDerivative(d_dxi[d], cache, 3, derivatives));
+		for (int c = 0; c < 3; ++c)
+		{
+			// d/dx (x^3/(x + 1)) = (2x^3 + 3x^2)/(x + 1)^2
+			const double expectedDerivative = (c == d) ?
+				(2.0*xi[c]*xi[c]*xi[c] + 3.0*xi[c]*xi[c])/((xi[c] + 1.0)*(xi[c] + 1.0)) : 0.0;
+			EXPECT_NEAR(expectedDerivative, derivatives[c], 1.0E-12);
+		}
+	}
+	EXPECT_EQ(RESULT_OK, quotient.evaluateReal(cache, 3, values));
+	for (int c = 0; c < 3; ++c)
+		EXPECT_NEAR(xi[c]*xi[c]*xi[c]/(xi[c] + 1.0), values[c], 1.0E-12);
+}
+
+// Derivatives of non-linear operators from a compiled tape must equal those
+// from the evaluate functions, here reached through an if field which is not
+// compiled, and the analytic derivatives
+TEST(ZincField, compiled_expression_derivatives_match_evaluate)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	// coordinates equal xi in the unit cube element
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double one = 1.0, three = 3.0;
+	Field constantOne = zinc.fm.createFieldConstant(1, &one);
+	EXPECT_TRUE(constantOne.isValid());
+
+	const int expressionCount = 4;
+	Field expressions[expressionCount];
+	// X/|X|
+	expressions[0] = zinc.fm.createFieldNormalise(coordinates);
+	// X/(X*X + 1)
+	expressions[1] = zinc.fm.createFieldDivide(coordinates, zinc.fm.createFieldAdd(
+		zinc.fm.createFieldMultiply(coordinates, coordinates), constantOne));
+	// X^(X + 1)
+	expressions[2] = zinc.fm.createFieldPower(coordinates,
+		zinc.fm.createFieldAdd(coordinates, constantOne));
+	// (X - 1)^3 has a negative base
+	expressions[3] = zinc.fm.createFieldPower(zinc.fm.createFieldSubtract(coordinates, constantOne),
+		zinc.fm.createFieldConstant(1, &three));
+	Field evaluateExpressions[expressionCount];
+	for (int e = 0; e < expressionCount; ++e)
+	{
+		EXPECT_TRUE(expressions[e].isValid());
+		evaluateExpressions[e] = zinc.fm.createFieldIf(constantOne, expressions[e], expressions[e]);
+		EXPECT_TRUE(evaluateExpressions[e].isValid());
+	}
+
+	// separate caches so neither path reuses values cached by the other
+	Fieldcache tapeCache = zinc.fm.createFieldcache();
+	Fieldcache evaluateCache = zinc.fm.createFieldcache();
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	Differentialoperator d_dxi[3];
+	for (int d = 0; d < 3; ++d)
+	{
+		d_dxi[d] = mesh3d.getChartDifferentialoperator(/*order*/1, d + 1);
+		EXPECT_TRUE(d_dxi[d].isValid());
+	}
+	Element element = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	const double xi[3] = { 0.2, 0.5, 0.9 };
+	EXPECT_EQ(RESULT_OK, tapeCache.setMeshLocation(element, 3, xi));
+	EXPECT_EQ(RESULT_OK, evaluateCache.setMeshLocation(element, 3, xi));
+	const double length = sqrt(xi[0]*xi[0] + xi[1]*xi[1] + xi[2]*xi[2]);
+	double tapeDerivatives[3], evaluateDerivatives[3];
+	for (int e = 0; e < expressionCount; ++e)
+	{
+		for (int d = 0; d < 3; ++d)
+		{
+			EXPECT_EQ(RESULT_OK, expressions[e].evaluateDerivative(d_dxi[d], tapeCache, 3, tapeDerivatives));
+			EXPECT_EQ(RESULT_OK, evaluateExpressions[e].evaluateDerivative(d_dxi[d], evaluateCache, 3, evaluateDerivatives));
+			for (int c = 0; c < 3; ++c)
+			{
+				const double x = xi[c];
+				double expectedDerivative = 0.0;
+				switch (e)
+				{
+				case 0:
+					expectedDerivative = (((c == d) ? 1.0 : 0.0) - x*xi[d]/(length*length))/length;
+					break;
+				case 1:
+					if (c == d)
+						expectedDerivative = (1.0 - x*x)/((x*x + 1.0)*(x*x + 1.0));
+					break;
+				case 2:
+					if (c == d)
+						expectedDerivative = pow(x, x + 1.0)*(log(x) + (x + 1.0)/x);
+					break;
+				case 3:
+					if (c == d)
+						expectedDerivative = 3.0*(x - 1.0)*(x - 1.0);
+					break;
+				}
+				EXPECT_NEAR(expectedDerivative, tapeDerivatives[c], 1.0E-12);
+				EXPECT_NEAR(tapeDerivatives[c], evaluateDerivatives[c], 1.0E-12);
+			}
+		}
+	}
+}
+
+// check derivatives of determinant, inverse and eigenvalues of 2x2, 3x3 and 4x4
+// matrices linear in xi against finite differences
+TEST(ZincField, matrix_operator_derivatives)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	// coordinates equal xi in the unit cube element
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	Differentialoperator d_dxi[3];
+	for (int d = 0; d < 3; ++d)
+	{
+		d_dxi[d] = mesh3d.getChartDifferentialoperator(/*order*/1, d + 1);
+		EXPECT_TRUE(d_dxi[d].isValid());
+	}
+	Element element = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	Fieldcache cache = zinc.fm.createFieldcache();
+
+	for (int n = 2; n <= 4; ++n)
+	{
+		// symmetric matrix = base + x*B1 + y*B2 + z*B3
+		const int size = n*n;
+		double baseValues[16], slopeValues[48];
+		for (int i = 0; i < n; ++i)
+			for (int j = i; j < n; ++j)
+			{
+				baseValues[i*n + j] = baseValues[j*n + i] = (i == j) ? 2.0*(i + 1) : 0.3/(i + j + 1);
+				for (int d = 0; d < 3; ++d)
+					slopeValues[d*size + i*n + j] = slopeValues[d*size + j*n + i] =
+						0.1*(d + 1)*((i + 2*j + d) % 3) - 0.15;
+			}
+		Field matrix = zinc.fm.createFieldAdd(zinc.fm.createFieldConstant(size, baseValues),
+			zinc.fm.createFieldMatrixMultiply(/*numberOfRows*/1, coordinates,
+				zinc.fm.createFieldConstant(3*size, slopeValues)));
+		EXPECT_TRUE(matrix.isValid());
+		Field determinant = zinc.fm.createFieldDeterminant(matrix);
+		EXPECT_TRUE(determinant.isValid());
+		Field inverse = zinc.fm.createFieldMatrixInvert(matrix);
+		EXPECT_TRUE(inverse.isValid());
+		Field eigenvalues = zinc.fm.createFieldEigenvalues(matrix);
+		EXPECT_TRUE(eigenvalues.isValid());
+		Field fields[3] = { determinant, inverse, eigenvalues };
+
+		const double xi[3] = { 0.2, 0.5, 0.9 };
+		const double h = 1.0E-6;
+		double matrixValues[16], inverseValues[16], product;
+		EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, xi));
+		EXPECT_EQ(RESULT_OK, matrix.evaluateReal(cache, size, matrixValues));
+		EXPECT_EQ(RESULT_OK, inverse.evaluateReal(cache, size, inverseValues));
+		for (int i = 0; i < n; ++i)
+			for (int j = 0; j < n; ++j)
+			{
+				product = 0.0;
+				for (int k = 0; k < n; ++k)
+					product += matrixValues[i*n + k]*inverseValues[k*n + j];
+				EXPECT_NEAR((i == j) ? 1.0 : 0.0, product, 1.0E-12);
+			}
+		for (int f = 0; f < 3; ++f)
+		{
+			const int componentsCount = fields[f].getNumberOfComponents();
+			double derivatives[16], plusValues[16], minusValues[16];
+			for (int d = 0; d < 3; ++d)
+			{
+				EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, xi));
+				EXPECT_EQ(RESULT_OK, fields[f].evaluateDerivative(d_dxi[d], cache, componentsCount, derivatives));
+				double offsetXi[3] = { xi[0], xi[1], xi[2] };
+				offsetXi[d] = xi[d] + h;
+				EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, offsetXi));
+				EXPECT_EQ(RESULT_OK, fields[f].evaluateReal(cache, componentsCount, plusValues));
+				offsetXi[d] = xi[d] - h;
+				EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element, 3, offsetXi));
+				EXPECT_EQ(RESULT_OK, fields[f].evaluateReal(cache, componentsCount, minusValues));
+				for (int c = 0; c < componentsCount; ++c)
+					EXPECT_NEAR((plusValues[c] - minusValues[c])/(2.0*h), derivatives[c], 1.0E-7);
+			}
+		}
+	}
+}
+
 /** Test evaluation of gradient at nodes which uses a finite different approximation */
 TEST(ZincFieldGradient, evaluateAtNodeFiniteDifference)
 {
@@ -654,3 +896,122 @@ TEST(ZincFieldGradient, evaluateAtNodeFiniteDifference)
 		}
 	}
 }
+
+TEST(ZincFieldGradient, evaluateAtNodeElementAverage)
+{
+	ZincTestSetupCpp zinc;
+
+	// two bilinear square elements along x with nodal field f = x*x at nodes,
+	// so df/dx is 1 in element 1 and 3 in element 2
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(2);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setTypeCoordinate(true));
+	FieldFiniteElement f = zinc.fm.createFieldFiniteElement(1);
+	EXPECT_TRUE(f.isValid());
+
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_TRUE(nodes.isValid());
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(f));
+	Fieldcache cache = zinc.fm.createFieldcache();
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 2; ++j)
+		{
+			// nodes 7 and 8 at x = 3 are not in any element initially
+			Node node = nodes.createNode((i < 3) ? (j*3 + i + 1) : (7 + j), nodetemplate);
+			EXPECT_TRUE(node.isValid());
+			EXPECT_EQ(RESULT_OK, cache.setNode(node));
+			const double x[2] = { static_cast<double>(i), static_cast<double>(j) };
+			EXPECT_EQ(RESULT_OK, coordinates.assignReal(cache, 2, x));
+			const double fValue = x[0]*x[0];
+			EXPECT_EQ(RESULT_OK, f.assignReal(cache, 1, &fValue));
+		}
+
+	Mesh mesh = zinc.fm.findMeshByDimension(2);
+	EXPECT_TRUE(mesh.isValid());
+	Elementbasis basis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	EXPECT_TRUE(basis.isValid());
+	Elementtemplate elementtemplate = mesh.createElementtemplate();
+	EXPECT_EQ(RESULT_OK, elementtemplate.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(RESULT_OK, elementtemplate.setNumberOfNodes(4));
+	const int localNodeIndexes[4] = { 1, 2, 3, 4 };
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineFieldSimpleNodal(coordinates, -1, basis, 4, localNodeIndexes));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineFieldSimpleNodal(f, -1, basis, 4, localNodeIndexes));
+	for (int e = 0; e < 2; ++e)
+	{
+		const int nodeIdentifiers[4] = { e + 1, e + 2, e + 4, e + 5 };
+		for (int n = 0; n < 4; ++n)
+			EXPECT_EQ(RESULT_OK, elementtemplate.setNode(n + 1, nodes.findNodeByIdentifier(nodeIdentifiers[n])));
+		EXPECT_EQ(RESULT_OK, mesh.defineElement(e + 1, elementtemplate));
+	}
+
+	FieldGradient df_dx = zinc.fm.createFieldGradient(f, coordinates);
+	EXPECT_TRUE(df_dx.isValid());
+	EXPECT_EQ(FieldGradient::NODE_MODE_FINITE_DIFFERENCE, df_dx.getNodeMode());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, df_dx.setNodeMode(FieldGradient::NODE_MODE_INVALID));
+	Field field = df_dx;
+	FieldGradient castGradient = field.castGradient();
+	EXPECT_TRUE(castGradient.isValid());
+	EXPECT_FALSE(f.castGradient().isValid());
+
+	const double tolerance = 1.0E-12;
+	double values[2];
+	// finite differences only perturb coordinates, on which nodal f does not depend
+	Node node2 = nodes.findNodeByIdentifier(2);
+	EXPECT_EQ(RESULT_OK, cache.setNode(node2));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(0.0, values[0], tolerance);
+	EXPECT_NEAR(0.0, values[1], tolerance);
+
+	EXPECT_EQ(RESULT_OK, df_dx.setNodeMode(FieldGradient::NODE_MODE_ELEMENT_AVERAGE));
+	EXPECT_EQ(FieldGradient::NODE_MODE_ELEMENT_AVERAGE, df_dx.getNodeMode());
+	EXPECT_EQ(FieldGradient::NODE_MODE_ELEMENT_AVERAGE, castGradient.getNodeMode());
+	const double expectedDfDx[6] = { 1.0, 2.0, 3.0, 1.0, 2.0, 3.0 };
+	for (int n = 0; n < 6; ++n)
+	{
+		EXPECT_EQ(RESULT_OK, cache.setNode(nodes.findNodeByIdentifier(n + 1)));
+		EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+		EXPECT_NEAR(expectedDfDx[n], values[0], tolerance);
+		EXPECT_NEAR(0.0, values[1], tolerance);
+	}
+
+	// changing only the source field keeps node locations but not values:
+	// df/dx in element 1 becomes 2
+	EXPECT_EQ(RESULT_OK, cache.setNode(nodes.findNodeByIdentifier(1)));
+	const double fValue1 = -1.0;
+	EXPECT_EQ(RESULT_OK, f.assignReal(cache, 1, &fValue1));
+	EXPECT_EQ(RESULT_OK, cache.setNode(node2));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(2.5, values[0], tolerance);
+	EXPECT_NEAR(0.0, values[1], tolerance);
+
+	// nodes not in any element fall back to finite differences
+	Node node7 = nodes.findNodeByIdentifier(7);
+	EXPECT_EQ(RESULT_OK, cache.setNode(node7));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(0.0, values[0], tolerance);
+
+	// node locations must be found again after the mesh changes:
+	// df/dx in new element 3 is 5
+	const int nodeIdentifiers3[4] = { 3, 7, 6, 8 };
+	for (int n = 0; n < 4; ++n)
+		EXPECT_EQ(RESULT_OK, elementtemplate.setNode(n + 1, nodes.findNodeByIdentifier(nodeIdentifiers3[n])));
+	EXPECT_EQ(RESULT_OK, mesh.defineElement(3, elementtemplate));
+	EXPECT_EQ(RESULT_OK, cache.setNode(nodes.findNodeByIdentifier(3)));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(4.0, values[0], tolerance);
+	EXPECT_EQ(RESULT_OK, cache.setNode(node7));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(5.0, values[0], tolerance);
+
+	// and after coordinates change: stretching x by 2 halves all gradients
+	const double scaleValues[2] = { 2.0, 1.0 };
+	Field scaleCoordinates = coordinates*zinc.fm.createFieldConstant(2, scaleValues);
+	Fieldassignment fieldassignment = coordinates.createFieldassignment(scaleCoordinates);
+	EXPECT_EQ(RESULT_OK, fieldassignment.assign());
+	EXPECT_EQ(RESULT_OK, cache.setNode(node2));
+	EXPECT_EQ(RESULT_OK, df_dx.evaluateReal(cache, 2, values));
+	EXPECT_NEAR(1.25, values[0], tolerance);
+	EXPECT_NEAR(0.0, values[1], tolerance);
+}
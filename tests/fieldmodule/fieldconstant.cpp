@@ -89,3 +89,51 @@ TEST(cmzn_field_constant, issue_3348_assign)
 	cmzn_field_destroy(&f2);
 	cmzn_field_destroy(&f3);
 }
+
+// Value storage for fields in a field cache is allocated from an arena and
+// reused when fields are destroyed; check values are not mixed up
+TEST(cmzn_field_constant, fieldcache_value_storage)
+{
+	ZincTestSetup zinc;
+
+	const int fieldCount = 200;
+	const int largeComponentCount = 1000;
+	double values[largeComponentCount], outValues[largeComponentCount];
+	cmzn_field_id fields[fieldCount];
+	cmzn_fieldcache_id cache = cmzn_fieldmodule_create_fieldcache(zinc.fm);
+	EXPECT_NE((cmzn_fieldcache_id)0, cache);
+	for (int f = 0; f < fieldCount; ++f)
+	{
+		values[0] = values[1] = values[2] = static_cast<double>(f);
+		fields[f] = cmzn_fieldmodule_create_field_constant(zinc.fm, 3, values);
+		EXPECT_NE((cmzn_field_id)0, fields[f]);
+		EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(fields[f], cache, 3, outValues));
+		EXPECT_EQ(static_cast<double>(f), outValues[2]);
+	}
+	// destroy every second field, freeing its value cache, then replace it
+	for (int f = 0; f < fieldCount; f += 2)
+	{
+		cmzn_field_destroy(&fields[f]);
+		values[0] = values[1] = values[2] = static_cast<double>(-f);
+		fields[f] = cmzn_fieldmodule_create_field_constant(zinc.fm, 3, values);
+		EXPECT_NE((cmzn_field_id)0, fields[f]);
+	}
+	for (int i = 0; i < largeComponentCount; ++i)
+		values[i] = static_cast<double>(i);
+	cmzn_field_id largeField = cmzn_fieldmodule_create_field_constant(zinc.fm, largeComponentCount, values);
+	EXPECT_NE((cmzn_field_id)0, largeField);
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(largeField, cache, largeComponentCount, outValues));
+	for (int i = 0; i < largeComponentCount; ++i)
+		EXPECT_EQ(values[i], outValues[i]);
+	for (int f = 0; f < fieldCount; ++f)
+	{
+		const double expectedValue = static_cast<double>((f % 2) ? f : -f);
+		EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(fields[f], cache, 3, outValues));
+		EXPECT_EQ(expectedValue, outValues[0]);
+		EXPECT_EQ(expectedValue, outValues[2]);
+	}
+	cmzn_field_destroy(&largeField);
+	for (int f = 0; f < fieldCount; ++f)
+		cmzn_field_destroy(&fields[f]);
+	cmzn_fieldcache_destroy(&cache);
+}
@@ -15,11 +15,15 @@
 #include <opencmiss/zinc/fieldcache.hpp>
 #include <opencmiss/zinc/fieldcomposite.hpp>
 #include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
 #include <opencmiss/zinc/fieldlogicaloperators.hpp>
 #include <opencmiss/zinc/fieldmeshoperators.hpp>
 #include <opencmiss/zinc/fieldsubobjectgroup.hpp>
 #include <opencmiss/zinc/fieldtrigonometry.hpp>
 #include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/nodetemplate.hpp>
 #include "zinctestsetupcpp.hpp"
 
 #include "test_resources.h"
@@ -355,3 +359,121 @@ TEST(ZincFieldMeshIntegralSquares, quadrature)
 			}
 	zinc.fm.endChange();
 }
+
+namespace {
+
+void setNodeCoordinates(Fieldcache& fieldcache, Field& coordinates, Node& node, double x, double y)
+{
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+	const double values[2] = { x, y };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 2, values));
+}
+
+void checkNodeValue(Fieldcache& fieldcache, Field& field, Node& node, double expectedValue)
+{
+	double value;
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+	EXPECT_EQ(RESULT_OK, field.evaluateReal(fieldcache, 1, &value));
+	EXPECT_NEAR(expectedValue, value, 1.0E-10);
+}
+
+}
+
+// integrates arc length along a chain of straight line elements from the
+// start of the seed element, with partial recalculation after node changes
+TEST(ZincFieldIntegration, lineArcLength)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(2);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setTypeCoordinate(true));
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	// element lengths 5, 6 and 10
+	const double x[5][2] = { { 0.0, 0.0 }, { 3.0, 4.0 }, { 3.0, 10.0 }, { 11.0, 16.0 }, { 11.0, 20.0 } };
+	Node node[5];
+	for (int n = 0; n < 5; ++n)
+	{
+		node[n] = nodes.createNode(n + 1, nodetemplate);
+		EXPECT_TRUE(node[n].isValid());
+		setNodeCoordinates(fieldcache, coordinates, node[n], x[n][0], x[n][1]);
+	}
+	Mesh mesh1d = zinc.fm.findMeshByDimension(1);
+	Elementbasis basis = zinc.fm.createElementbasis(1, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	Elementtemplate elementtemplate = mesh1d.createElementtemplate();
+	EXPECT_EQ(RESULT_OK, elementtemplate.setElementShapeType(Element::SHAPE_TYPE_LINE));
+	EXPECT_EQ(RESULT_OK, elementtemplate.setNumberOfNodes(2));
+	const int localNodeIndexes[2] = { 1, 2 };
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineFieldSimpleNodal(coordinates, -1, basis, 2, localNodeIndexes));
+	for (int e = 0; e < 3; ++e)
+	{
+		EXPECT_EQ(RESULT_OK, elementtemplate.setNode(1, node[e]));
+		EXPECT_EQ(RESULT_OK, elementtemplate.setNode(2, node[e + 1]));
+		EXPECT_EQ(RESULT_OK, mesh1d.defineElement(e + 1, elementtemplate));
+	}
+	Element element1 = mesh1d.findElementByIdentifier(1);
+	Element element2 = mesh1d.findElementByIdentifier(2);
+	Element element3 = mesh1d.findElementByIdentifier(3);
+
+	const double one = 1.0;
+	Field integrand = zinc.fm.createFieldConstant(1, &one);
+	FieldIntegration arcLength = zinc.fm.createFieldIntegration(integrand, coordinates, mesh1d, element1, true);
+	EXPECT_TRUE(arcLength.isValid());
+	EXPECT_EQ(1, arcLength.getNumberOfComponents());
+	FieldIntegration displacement = zinc.fm.createFieldIntegration(integrand, coordinates, mesh1d, element1, false);
+	EXPECT_TRUE(displacement.isValid());
+	EXPECT_EQ(2, displacement.getNumberOfComponents());
+	EXPECT_FALSE(zinc.fm.createFieldIntegration(coordinates, coordinates, mesh1d, element1, true).isValid());
+
+	checkNodeValue(fieldcache, arcLength, node[0], 0.0);
+	checkNodeValue(fieldcache, arcLength, node[1], 5.0);
+	checkNodeValue(fieldcache, arcLength, node[2], 11.0);
+	checkNodeValue(fieldcache, arcLength, node[3], 21.0);
+	double value, values[2];
+	const double xi = 0.5;
+	EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element2, 1, &xi));
+	EXPECT_EQ(RESULT_OK, arcLength.evaluateReal(fieldcache, 1, &value));
+	EXPECT_NEAR(8.0, value, 1.0E-10);
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node[3]));
+	EXPECT_EQ(RESULT_OK, displacement.evaluateReal(fieldcache, 2, values));
+	EXPECT_NEAR(11.0, values[0], 1.0E-10);
+	EXPECT_NEAR(16.0, values[1], 1.0E-10);
+	// node 5 is not in any element yet
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node[4]));
+	EXPECT_NE(RESULT_OK, arcLength.evaluateReal(fieldcache, 1, &value));
+
+	// moving nodes 3 and 4 changes lengths of elements 2 and 3 to 8 and 10
+	setNodeCoordinates(fieldcache, coordinates, node[2], 3.0, 12.0);
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node[3]));
+	const double x4[2] = { 9.0, 20.0 };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 2, x4));
+	checkNodeValue(fieldcache, arcLength, node[0], 0.0);
+	checkNodeValue(fieldcache, arcLength, node[1], 5.0);
+	checkNodeValue(fieldcache, arcLength, node[2], 13.0);
+	checkNodeValue(fieldcache, arcLength, node[3], 23.0);
+	EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element3, 1, &xi));
+	EXPECT_EQ(RESULT_OK, arcLength.evaluateReal(fieldcache, 1, &value));
+	EXPECT_NEAR(18.0, value, 1.0E-10);
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node[3]));
+	EXPECT_EQ(RESULT_OK, displacement.evaluateReal(fieldcache, 2, values));
+	EXPECT_NEAR(9.0, values[0], 1.0E-10);
+	EXPECT_NEAR(20.0, values[1], 1.0E-10);
+
+	// adding element 4 of length 5 reaches node 5
+	setNodeCoordinates(fieldcache, coordinates, node[4], 13.0, 23.0);
+	EXPECT_EQ(RESULT_OK, elementtemplate.setNode(1, node[3]));
+	EXPECT_EQ(RESULT_OK, elementtemplate.setNode(2, node[4]));
+	EXPECT_EQ(RESULT_OK, mesh1d.defineElement(4, elementtemplate));
+	checkNodeValue(fieldcache, arcLength, node[4], 28.0);
+
+	// removing element 2 disconnects elements 3 and 4 from the seed
+	EXPECT_EQ(RESULT_OK, mesh1d.destroyElement(element2));
+	checkNodeValue(fieldcache, arcLength, node[1], 5.0);
+	EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element3, 1, &xi));
+	EXPECT_NE(RESULT_OK, arcLength.evaluateReal(fieldcache, 1, &value));
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node[4]));
+	EXPECT_NE(RESULT_OK, arcLength.evaluateReal(fieldcache, 1, &value));
+}
@@ -6,6 +6,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <cmath>
 #include <gtest/gtest.h>
 
 #include <opencmiss/zinc/field.h>
@@ -16,9 +17,14 @@
 #include <opencmiss/zinc/status.h>
 
 #include <opencmiss/zinc/field.hpp>
+#include <opencmiss/zinc/fieldarithmeticoperators.hpp>
 #include <opencmiss/zinc/fieldcache.hpp>
 #include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldnodesetoperators.hpp>
+#include <opencmiss/zinc/fieldsubobjectgroup.hpp>
 #include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
 #include <opencmiss/zinc/status.hpp>
 
 #include "test_resources.h"
@@ -206,6 +212,66 @@ TEST(ZincFieldmodulenotifier, changeCallback)
 	EXPECT_EQ(CMZN_OK, result = notifier.clearCallback());
 }
 
+// changes must propagate through deep fields with shared sources in time
+// proportional to the number of fields downstream of the change
+TEST(ZincFieldmodulenotifier, sharedSourceChange)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	const int depth = 100;
+	const double one = 1.0;
+	FieldConstant base = zinc.fm.createFieldConstant(1, &one);
+	EXPECT_TRUE(base.isValid());
+	// each field adds the previous field to itself, doubling the value
+	Field top = base;
+	for (int i = 0; i < depth; ++i)
+	{
+		top = top + top;
+		EXPECT_TRUE(top.isValid());
+	}
+	FieldConstant other = zinc.fm.createFieldConstant(1, &one);
+	EXPECT_TRUE(other.isValid());
+	Field otherMagnitude = zinc.fm.createFieldMagnitude(other);
+	EXPECT_TRUE(otherMagnitude.isValid());
+	// unrelated fields with non-source dependencies, and fields using them
+	FieldFiniteElement feField = zinc.fm.createFieldFiniteElement(1);
+	EXPECT_TRUE(feField.isValid());
+	Field feMagnitude = zinc.fm.createFieldMagnitude(feField);
+	EXPECT_TRUE(feMagnitude.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	FieldNodeGroup nodeGroup = zinc.fm.createFieldNodeGroup(nodes);
+	EXPECT_TRUE(nodeGroup.isValid());
+	Field feSum = zinc.fm.createFieldNodesetSum(feField, nodeGroup.getNodesetGroup());
+	EXPECT_TRUE(feSum.isValid());
+	Field unrelatedFields[4] = { feField, feMagnitude, nodeGroup, feSum };
+
+	Fieldmodulenotifier notifier = zinc.fm.createFieldmodulenotifier();
+	EXPECT_TRUE(notifier.isValid());
+	FieldmodulecallbackRecordChange recordChange;
+	EXPECT_EQ(CMZN_OK, result = notifier.setCallback(recordChange));
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	const double two = 2.0;
+	EXPECT_EQ(CMZN_OK, result = other.assignReal(cache, 1, &two));
+	EXPECT_EQ(Field::CHANGE_FLAG_FULL_RESULT, result = recordChange.lastEvent.getFieldChangeFlags(otherMagnitude));
+	EXPECT_EQ(Field::CHANGE_FLAG_NONE, result = recordChange.lastEvent.getFieldChangeFlags(top));
+	EXPECT_EQ(Field::CHANGE_FLAG_NONE, result = recordChange.lastEvent.getFieldChangeFlags(base));
+	for (int i = 0; i < 4; ++i)
+		EXPECT_EQ(Field::CHANGE_FLAG_NONE, result = recordChange.lastEvent.getFieldChangeFlags(unrelatedFields[i]));
+
+	EXPECT_EQ(CMZN_OK, result = base.assignReal(cache, 1, &two));
+	EXPECT_EQ(Field::CHANGE_FLAG_FULL_RESULT, result = recordChange.lastEvent.getFieldChangeFlags(top));
+	EXPECT_EQ(Field::CHANGE_FLAG_NONE, result = recordChange.lastEvent.getFieldChangeFlags(otherMagnitude));
+	for (int i = 0; i < 4; ++i)
+		EXPECT_EQ(Field::CHANGE_FLAG_NONE, result = recordChange.lastEvent.getFieldChangeFlags(unrelatedFields[i]));
+	double value;
+	EXPECT_EQ(CMZN_OK, result = top.evaluateReal(cache, 1, &value));
+	EXPECT_DOUBLE_EQ(2.0*pow(2.0, depth), value);
+
+	EXPECT_EQ(CMZN_OK, result = notifier.clearCallback());
+}
+
 void createNodesWithCoordinates(cmzn_fieldmodule_id fm)
 {
 	int result;
@@ -2062,3 +2062,55 @@ TEST(ZincElementfieldtemplate, mergeExternalElementfieldtemplate)
 		EXPECT_DOUBLE_EQ(scaleFactors[s], scaleFactorsOut[s]);
 	}
 }
+
+// Changing node parameters only evicts cached element field values for
+// elements using those nodes; test values in changed and unchanged elements
+TEST(ZincFieldFiniteElement, partialChangeElementFieldValues)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	Element element1 = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element1.isValid());
+	Element element2 = mesh3d.findElementByIdentifier(2);
+	EXPECT_TRUE(element2.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	// node 3 is only used by element 2
+	Node node3 = nodes.findNodeByIdentifier(3);
+	EXPECT_TRUE(node3.isValid());
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	const double xi1[3] = { 0.5, 0.5, 0.5 };
+	const double xi2[3] = { 1.0, 0.0, 0.0 };
+	double x[3];
+	EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element1, 3, xi1));
+	EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+	EXPECT_DOUBLE_EQ(5.0, x[0]);
+	EXPECT_DOUBLE_EQ(5.0, x[1]);
+	EXPECT_DOUBLE_EQ(5.0, x[2]);
+	EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element2, 3, xi2));
+	EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+	EXPECT_DOUBLE_EQ(20.0, x[0]);
+
+	const double newX3[3] = { 30.0, 0.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, cache.setNode(node3));
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(cache, 3, newX3));
+
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element2, 3, xi2));
+		EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+		EXPECT_DOUBLE_EQ(30.0, x[0]);
+		EXPECT_DOUBLE_EQ(0.0, x[1]);
+		EXPECT_DOUBLE_EQ(0.0, x[2]);
+		EXPECT_EQ(RESULT_OK, cache.setMeshLocation(element1, 3, xi1));
+		EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+		EXPECT_DOUBLE_EQ(5.0, x[0]);
+		EXPECT_DOUBLE_EQ(5.0, x[1]);
+		EXPECT_DOUBLE_EQ(5.0, x[2]);
+	}
+}
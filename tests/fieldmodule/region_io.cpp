@@ -15,8 +15,10 @@
 #include <opencmiss/zinc/fieldcache.h>
 #include <opencmiss/zinc/fieldmodule.h>
 #include <opencmiss/zinc/fieldfiniteelement.h>
+#include <opencmiss/zinc/mesh.h>
 #include <opencmiss/zinc/node.h>
 #include <opencmiss/zinc/nodeset.h>
+#include <opencmiss/zinc/nodetemplate.h>
 #include <opencmiss/zinc/region.h>
 #include <opencmiss/zinc/status.h>
 #include <opencmiss/zinc/stream.h>
@@ -29,8 +31,16 @@
 #include <sstream>
 #include <fstream>
 
+#include "utilities/fileio.hpp"
+
 #include "test_resources.h"
 
+#define REGION_IO_OUTPUT_FOLDER "regioniotest"
+
+namespace {
+ManageOutputFolder manageOutputFolderRegionIO(REGION_IO_OUTPUT_FOLDER);
+}
+
 TEST(region_file_input, invalid_args)
 {
 	cmzn_context_id context = cmzn_context_create("test");
@@ -506,3 +516,373 @@ TEST(region_stream_gzip_input, invalid_args)
 	cmzn_region_destroy(&root_region);
 	cmzn_context_destroy(&context);
 }
+
+namespace {
+
+/** Get numbers of nodes and elements of each dimension in subregion at path */
+void getRegionObjectCounts(cmzn_region_id root_region, const char *path, int counts[4])
+{
+	cmzn_region_id region = cmzn_region_find_subregion_at_path(root_region, path);
+	EXPECT_NE(static_cast<cmzn_region *>(0), region);
+	cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(region);
+	cmzn_nodeset_id nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	counts[0] = cmzn_nodeset_get_size(nodes);
+	cmzn_nodeset_destroy(&nodes);
+	for (int dimension = 1; dimension <= 3; ++dimension)
+	{
+		cmzn_mesh_id mesh = cmzn_fieldmodule_find_mesh_by_dimension(fm, dimension);
+		counts[dimension] = cmzn_mesh_get_size(mesh);
+		cmzn_mesh_destroy(&mesh);
+	}
+	cmzn_fieldmodule_destroy(&fm);
+	cmzn_region_destroy(&region);
+}
+
+/** Create nodes 1..nodeCount with 3-component coordinates (0.125n, 1 - 0.25n, 0.5n) */
+void createLineOfNodes(cmzn_region_id region, int nodeCount)
+{
+	cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(region);
+	cmzn_fieldmodule_begin_change(fm);
+	cmzn_field_id coordinates = cmzn_fieldmodule_create_field_finite_element(fm, 3);
+	EXPECT_EQ(CMZN_OK, cmzn_field_set_name(coordinates, "coordinates"));
+	EXPECT_EQ(CMZN_OK, cmzn_field_set_type_coordinate(coordinates, true));
+	EXPECT_EQ(CMZN_OK, cmzn_field_set_managed(coordinates, true));
+	cmzn_nodeset_id nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	cmzn_nodetemplate_id nodetemplate = cmzn_nodeset_create_nodetemplate(nodes);
+	EXPECT_EQ(CMZN_OK, cmzn_nodetemplate_define_field(nodetemplate, coordinates));
+	cmzn_fieldcache_id cache = cmzn_fieldmodule_create_fieldcache(fm);
+	for (int n = 1; n <= nodeCount; ++n)
+	{
+		cmzn_node_id node = cmzn_nodeset_create_node(nodes, n, nodetemplate);
+		EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_node(cache, node));
+		const double x[3] = { 0.125*n, 1.0 - 0.25*n, 0.5*n };
+		EXPECT_EQ(CMZN_OK, cmzn_field_assign_real(coordinates, cache, 3, x));
+		cmzn_node_destroy(&node);
+	}
+	cmzn_fieldcache_destroy(&cache);
+	cmzn_nodetemplate_destroy(&nodetemplate);
+	cmzn_nodeset_destroy(&nodes);
+	cmzn_field_destroy(&coordinates);
+	cmzn_fieldmodule_end_change(fm);
+	cmzn_fieldmodule_destroy(&fm);
+}
+
+}
+
+TEST(region_file_input, load_on_demand)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+	cmzn_region_id lazy_region = cmzn_region_create_region(root_region);
+
+	EXPECT_EQ(CMZN_OK, cmzn_region_read_file(root_region,
+		TestResources::getLocation(TestResources::FIELDMODULE_REGION_INPUT_RESOURCE)));
+
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(lazy_region);
+	cmzn_streamresource_id sr = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::FIELDMODULE_REGION_INPUT_RESOURCE));
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_FALSE(cmzn_streaminformation_region_is_load_on_demand(si_region));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_region_set_load_on_demand(si_region, true));
+	EXPECT_TRUE(cmzn_streaminformation_region_is_load_on_demand(si_region));
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(lazy_region, si_region));
+	cmzn_streamresource_destroy(&sr);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	// subregions exist before their content is loaded
+	cmzn_region_id tetrahedron_region = cmzn_region_find_child_by_name(lazy_region, "tetrahedron");
+	EXPECT_NE(static_cast<cmzn_region *>(0), tetrahedron_region);
+	cmzn_region_id starburst_region = cmzn_region_find_child_by_name(tetrahedron_region, "starburst");
+	EXPECT_NE(static_cast<cmzn_region *>(0), starburst_region);
+	cmzn_region_destroy(&starburst_region);
+
+	// load a subregion before its parent
+	cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(tetrahedron_region);
+	cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(fm, "coordinates");
+	EXPECT_NE(static_cast<cmzn_field *>(0), coordinates);
+	cmzn_field_destroy(&coordinates);
+	cmzn_fieldmodule_destroy(&fm);
+	cmzn_region_destroy(&tetrahedron_region);
+
+	const char *paths[] = { "/", "/plate", "/tetrahedron", "/tetrahedron/starburst" };
+	for (int p = 0; p < 4; ++p)
+	{
+		int expectedCounts[4], counts[4];
+		getRegionObjectCounts(root_region, paths[p], expectedCounts);
+		getRegionObjectCounts(lazy_region, paths[p], counts);
+		for (int i = 0; i < 4; ++i)
+			EXPECT_EQ(expectedCounts[i], counts[i]);
+	}
+	int counts[4];
+	getRegionObjectCounts(lazy_region, "/", counts);
+	EXPECT_EQ(8, counts[0]);
+	EXPECT_EQ(CMZN_OK, cmzn_region_load(lazy_region));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_region_load(0));
+
+	cmzn_region_destroy(&lazy_region);
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
+
+TEST(region_file_input, load_on_demand_failure)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+	cmzn_region_id lazy_region = cmzn_region_create_region(root_region);
+
+	// a file not in EX format fails to index, and no subregions or loaders
+	// are added for other files in the same read
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(lazy_region);
+	cmzn_streamresource_id sr1 = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::FIELDMODULE_REGION_INPUT_RESOURCE));
+	cmzn_streamresource_id sr2 = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::FIELDIO_FIELDML_CUBE_RESOURCE));
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_region_set_file_format(si_region,
+		CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_region_set_load_on_demand(si_region, true));
+	EXPECT_NE(CMZN_OK, cmzn_region_read(lazy_region, si_region));
+	cmzn_streamresource_destroy(&sr1);
+	cmzn_streamresource_destroy(&sr2);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+	cmzn_region_id child_region = cmzn_region_get_first_child(lazy_region);
+	EXPECT_EQ(static_cast<cmzn_region *>(0), child_region);
+	EXPECT_EQ(CMZN_OK, cmzn_region_load(lazy_region));
+
+	// failure to load content after indexing is reported by cmzn_region_load
+	const char *fileName = REGION_IO_OUTPUT_FOLDER "/load_on_demand_failure.exregion";
+	EXPECT_EQ(CMZN_OK, cmzn_region_read_file(root_region,
+		TestResources::getLocation(TestResources::FIELDMODULE_REGION_INPUT_RESOURCE)));
+	EXPECT_EQ(CMZN_OK, cmzn_region_write_file(root_region, fileName));
+	si = cmzn_region_create_streaminformation_region(lazy_region);
+	sr1 = cmzn_streaminformation_create_streamresource_file(si, fileName);
+	si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_region_set_load_on_demand(si_region, true));
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(lazy_region, si_region));
+	cmzn_streamresource_destroy(&sr1);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+	std::streamoff fileSize = 0;
+	{
+		std::ifstream file(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+		fileSize = file.tellg();
+	}
+	EXPECT_GT(fileSize, 0);
+	{
+		std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+		file << std::string(static_cast<size_t>(fileSize), 'x');
+	}
+	EXPECT_NE(CMZN_OK, cmzn_region_load(lazy_region));
+	// failure is remembered
+	EXPECT_NE(CMZN_OK, cmzn_region_load(lazy_region));
+
+	cmzn_region_destroy(&lazy_region);
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
+
+TEST(region_file_output, gzip_compression_level)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+	// output spans several compressed blocks
+	const int nodeCount = 50000;
+	createLineOfNodes(root_region, nodeCount);
+
+	const char *fileName = REGION_IO_OUTPUT_FOLDER "/gzip_compression_level.exregion.gz";
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(root_region);
+	cmzn_streamresource_id sr = cmzn_streaminformation_create_streamresource_file(si, fileName);
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(-1, cmzn_streaminformation_region_get_compression_level(si_region));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_streaminformation_region_set_compression_level(si_region, 10));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_streaminformation_region_set_compression_level(si_region, -2));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_region_set_compression_level(si_region, 1));
+	EXPECT_EQ(1, cmzn_streaminformation_region_get_compression_level(si_region));
+	EXPECT_EQ(-1, cmzn_streaminformation_region_get_compression_level(0));
+	// bzip2 compression cannot be written
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_data_compression_type(si,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_BZIP2));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_region_write(root_region, si_region));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_data_compression_type(si,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+	EXPECT_EQ(CMZN_OK, cmzn_region_write(root_region, si_region));
+	cmzn_streamresource_destroy(&sr);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	// gzip compression cannot be written to FieldML
+	si = cmzn_region_create_streaminformation_region(root_region);
+	sr = cmzn_streaminformation_create_streamresource_file(si, REGION_IO_OUTPUT_FOLDER "/gzip_compression_level.fieldml");
+	si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_resource_data_compression_type(si, sr,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_region_write(root_region, si_region));
+	cmzn_streamresource_destroy(&sr);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	// gzip compression cannot be written to memory; uncompressed output spans
+	// more than two compressed blocks
+	si = cmzn_region_create_streaminformation_region(root_region);
+	sr = cmzn_streaminformation_create_streamresource_memory(si);
+	si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_resource_data_compression_type(si, sr,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_region_write(root_region, si_region));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_resource_data_compression_type(si, sr,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE));
+	EXPECT_EQ(CMZN_OK, cmzn_region_write(root_region, si_region));
+	cmzn_streamresource_memory_id sr_memory = cmzn_streamresource_cast_memory(sr);
+	void *memoryBuffer = 0;
+	unsigned int memoryBufferSize = 0;
+	EXPECT_EQ(CMZN_OK, cmzn_streamresource_memory_get_buffer(sr_memory, &memoryBuffer, &memoryBufferSize));
+	EXPECT_LT(2U*1024U*1024U, memoryBufferSize);
+	cmzn_streamresource_memory_destroy(&sr_memory);
+	cmzn_streamresource_destroy(&sr);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	// output starts with gzip magic number
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+	const std::string fileBuffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
+	EXPECT_LT(2U, fileBuffer.size());
+	EXPECT_GT(memoryBufferSize, fileBuffer.size());
+	EXPECT_EQ(0x1f, static_cast<unsigned char>(fileBuffer[0]));
+	EXPECT_EQ(0x8b, static_cast<unsigned char>(fileBuffer[1]));
+
+	// read back from file and as memory resource
+	for (int m = 0; m < 2; ++m)
+	{
+		cmzn_region_id input_region = cmzn_region_create_region(root_region);
+		si = cmzn_region_create_streaminformation_region(input_region);
+		sr = (0 == m) ? cmzn_streaminformation_create_streamresource_file(si, fileName) :
+			cmzn_streaminformation_create_streamresource_memory_buffer(si, fileBuffer.data(),
+				static_cast<unsigned int>(fileBuffer.size()));
+		EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_data_compression_type(si,
+			CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+		si_region = cmzn_streaminformation_cast_region(si);
+		EXPECT_EQ(CMZN_OK, cmzn_region_read(input_region, si_region));
+		cmzn_streamresource_destroy(&sr);
+		cmzn_streaminformation_region_destroy(&si_region);
+		cmzn_streaminformation_destroy(&si);
+
+		int counts[4];
+		getRegionObjectCounts(input_region, "/", counts);
+		EXPECT_EQ(nodeCount, counts[0]);
+		cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(input_region);
+		cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(fm, "coordinates");
+		cmzn_nodeset_id nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+		cmzn_node_id node = cmzn_nodeset_find_node_by_identifier(nodes, nodeCount);
+		cmzn_fieldcache_id cache = cmzn_fieldmodule_create_fieldcache(fm);
+		EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_node(cache, node));
+		double x[3];
+		EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(coordinates, cache, 3, x));
+		EXPECT_DOUBLE_EQ(0.5*nodeCount, x[2]);
+		cmzn_fieldcache_destroy(&cache);
+		cmzn_node_destroy(&node);
+		cmzn_nodeset_destroy(&nodes);
+		cmzn_field_destroy(&coordinates);
+		cmzn_fieldmodule_destroy(&fm);
+		cmzn_region_destroy(&input_region);
+	}
+
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
+
+TEST(region_stream_bzip2_input, multiple_chunks)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+	cmzn_region_id gzip_region = cmzn_region_create_child(root_region, "gzip");
+	EXPECT_EQ(CMZN_OK, cmzn_region_read_file(gzip_region,
+		TestResources::getLocation(TestResources::HEART_EXNODE_GZ)));
+	EXPECT_EQ(CMZN_OK, cmzn_region_read_file(gzip_region,
+		TestResources::getLocation(TestResources::HEART_EXELEM_GZ)));
+
+	// decompressed elements span several buffer chunks
+	std::ifstream exelemFile(TestResources::getLocation(TestResources::HEART_EXELEM_BZ2), std::ifstream::binary);
+	EXPECT_TRUE(exelemFile.is_open());
+	const std::string exelemBuffer((std::istreambuf_iterator<char>(exelemFile)), std::istreambuf_iterator<char>());
+	exelemFile.close();
+	EXPECT_LT(0U, exelemBuffer.size());
+
+	cmzn_region_id bzip2_region = cmzn_region_create_child(root_region, "bzip2");
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(bzip2_region);
+	cmzn_streamresource_id sr_exnode = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::HEART_EXNODE_GZ));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_resource_data_compression_type(si, sr_exnode,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+	cmzn_streamresource_id sr_exelem = cmzn_streaminformation_create_streamresource_memory_buffer(
+		si, exelemBuffer.data(), static_cast<unsigned int>(exelemBuffer.size()));
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_resource_data_compression_type(si, sr_exelem,
+		CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_BZIP2));
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(bzip2_region, si_region));
+	cmzn_streamresource_destroy(&sr_exnode);
+	cmzn_streamresource_destroy(&sr_exelem);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	int expectedCounts[4], counts[4];
+	getRegionObjectCounts(root_region, "/gzip", expectedCounts);
+	getRegionObjectCounts(root_region, "/bzip2", counts);
+	EXPECT_LT(0, expectedCounts[3]);
+	for (int i = 0; i < 4; ++i)
+		EXPECT_EQ(expectedCounts[i], counts[i]);
+
+	cmzn_region_destroy(&bzip2_region);
+	cmzn_region_destroy(&gzip_region);
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
+
+TEST(region_file_input, large_file)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+	cmzn_region_id output_region = cmzn_region_create_child(root_region, "output");
+	// enough nodes for the file to be memory mapped and its pages released
+	const int nodeCount = 100000;
+	createLineOfNodes(output_region, nodeCount);
+
+	const char *fileName = REGION_IO_OUTPUT_FOLDER "/large_file.exregion";
+	EXPECT_EQ(CMZN_OK, cmzn_region_write_file(output_region, fileName));
+	std::ifstream file(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+	EXPECT_LT(4*1024*1024, static_cast<int>(file.tellg()));
+	file.close();
+
+	cmzn_region_id input_region = cmzn_region_create_child(root_region, "input");
+	EXPECT_EQ(CMZN_OK, cmzn_region_read_file(input_region, fileName));
+	int counts[4];
+	getRegionObjectCounts(root_region, "/input", counts);
+	EXPECT_EQ(nodeCount, counts[0]);
+
+	// check values at last node, read after earlier pages are released
+	cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(input_region);
+	cmzn_field_id coordinates = cmzn_fieldmodule_find_field_by_name(fm, "coordinates");
+	EXPECT_NE(static_cast<cmzn_field *>(0), coordinates);
+	cmzn_nodeset_id nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	cmzn_node_id node = cmzn_nodeset_find_node_by_identifier(nodes, nodeCount);
+	EXPECT_NE(static_cast<cmzn_node *>(0), node);
+	cmzn_fieldcache_id cache = cmzn_fieldmodule_create_fieldcache(fm);
+	EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_node(cache, node));
+	double x[3];
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(coordinates, cache, 3, x));
+	EXPECT_DOUBLE_EQ(0.125*nodeCount, x[0]);
+	EXPECT_DOUBLE_EQ(1.0 - 0.25*nodeCount, x[1]);
+	EXPECT_DOUBLE_EQ(0.5*nodeCount, x[2]);
+	cmzn_fieldcache_destroy(&cache);
+	cmzn_node_destroy(&node);
+	cmzn_nodeset_destroy(&nodes);
+	cmzn_field_destroy(&coordinates);
+	cmzn_fieldmodule_destroy(&fm);
+
+	cmzn_region_destroy(&input_region);
+	cmzn_region_destroy(&output_region);
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
@@ -28,6 +28,7 @@ SET(${CURRENT_TEST}_SRC
 	${CURRENT_TEST}/finiteelement.cpp
 	${CURRENT_TEST}/nodesandelements.cpp
 	${CURRENT_TEST}/timesequence.cpp
+	utilities/fileio.cpp
 	)
 
 SET(FIELDMODULE_EXNODE_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/nodes.exnode")
@@ -40,6 +41,7 @@ SET(FIELDIMAGE_BLOCKCOLOURS_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/blockcolours.png
 SET(FIELDMODULE_TWO_CUBES_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/two_cubes.exformat")
 SET(HEART_EXNODE_GZ "${CMAKE_CURRENT_LIST_DIR}/heart.exnode.gz")
 SET(HEART_EXELEM_GZ "${CMAKE_CURRENT_LIST_DIR}/heart.exelem.gz")
+SET(HEART_EXELEM_BZ2 "${CMAKE_CURRENT_LIST_DIR}/heart.exelem.bz2")
 SET(FIELDMODULE_ALLSHAPES_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/allshapes.exformat")
 SET(FIELDMODULE_CUBE_XYZP_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/cube_xyzp.exformat")
 SET(FIELDMODULE_CUBESQUARELINE_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/cubesquareline.exformat")
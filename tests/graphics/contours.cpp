@@ -18,9 +18,20 @@
 #include <opencmiss/zinc/fieldconstant.h>
 #include <opencmiss/zinc/graphics.h>
 #include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldcomposite.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/nodeset.hpp>
+#include <opencmiss/zinc/scene.hpp>
+#include <opencmiss/zinc/scenefilter.hpp>
+#include <opencmiss/zinc/streamscene.hpp>
 
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
+#include "test_resources.h"
+
+#include <sstream>
+#include <string>
 
 TEST(cmzn_graphics_contours, create_cast)
 {
@@ -223,3 +234,179 @@ TEST(cmzn_graphics_contours, description_io)
 	cmzn_deallocate(return_string);
 }
 
+
+// Test contours are correct when only some elements are swept using scalar
+// ranges cached from previous builds
+TEST(ZincGraphicsContours, elementScalarRangeCulling)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	// element 1 spans x from 0 to 10, element 2 from 10 to 20
+	Field x = zinc.fm.createFieldComponent(coordinates, 1);
+	EXPECT_TRUE(x.isValid());
+
+	GraphicsContours contours = zinc.scene.createGraphicsContours();
+	EXPECT_TRUE(contours.isValid());
+	EXPECT_EQ(RESULT_OK, contours.setCoordinateField(coordinates));
+	EXPECT_EQ(RESULT_OK, contours.setIsoscalarField(x));
+
+	Scenefilter noFilter;
+	double minimums[3], maximums[3];
+	const double tol = 1.0E-5;
+	const double isovalues[] = { 5.0, 15.0 };
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(1, isovalues));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(5.0, minimums[0], tol);
+	EXPECT_NEAR(5.0, maximums[0], tol);
+
+	// change only isovalues so cached ranges are used
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(1, isovalues + 1));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(15.0, minimums[0], tol);
+	EXPECT_NEAR(15.0, maximums[0], tol);
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(2, isovalues));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(5.0, minimums[0], tol);
+	EXPECT_NEAR(15.0, maximums[0], tol);
+
+	// node 3 is only used by element 2: its range must be updated
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Node node3 = nodes.findNodeByIdentifier(3);
+	EXPECT_TRUE(node3.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const double newX3[3] = { 30.0, 0.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node3));
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, newX3));
+	const double isovalue = 25.0;
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(1, &isovalue));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(25.0, minimums[0], tol);
+	EXPECT_NEAR(25.0, maximums[0], tol);
+}
+
+namespace {
+
+/**
+ * Export scene surfaces in threejs format and get numbers of vertices and
+ * faces, and number of faces repeating a vertex.
+ */
+void getThreejsSurfaceCounts(Scene& scene, int& verticesCount, int& facesCount,
+	int& degenerateFacesCount)
+{
+	verticesCount = 0;
+	facesCount = 0;
+	degenerateFacesCount = 0;
+	StreaminformationScene si = scene.createStreaminformationScene();
+	EXPECT_EQ(RESULT_OK, si.setIOFormat(si.IO_FORMAT_THREEJS));
+	EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+	StreamresourceMemory sr = si.createStreamresourceMemory();
+	StreamresourceMemory sr2 = si.createStreamresourceMemory();
+	EXPECT_EQ(RESULT_OK, scene.write(si));
+	char *buffer = 0;
+	unsigned int size = 0;
+	EXPECT_EQ(RESULT_OK, sr2.getBuffer((void**)&buffer, &size));
+	std::string output(buffer, size);
+	size_t start = output.find("\"vertices\" : [");
+	EXPECT_NE(std::string::npos, start);
+	size_t end = output.find("]", start);
+	int valuesCount = 0;
+	for (size_t i = start; i < end; ++i)
+		if (output[i] == '.')
+			++valuesCount;
+	verticesCount = valuesCount/3;
+	start = output.find("\"faces\": [\n");
+	EXPECT_NE(std::string::npos, start);
+	end = output.find("]", start);
+	std::istringstream faces(output.substr(start + 11, end - start - 11));
+	std::string line;
+	while (std::getline(faces, line))
+	{
+		int typeMask, index[3];
+		char comma[3];
+		std::istringstream face(line);
+		if (face >> typeMask >> comma[0] >> index[0] >> comma[1] >> index[1] >> comma[2] >> index[2])
+		{
+			++facesCount;
+			if ((index[0] == index[1]) || (index[1] == index[2]) || (index[2] == index[0]))
+				++degenerateFacesCount;
+		}
+	}
+}
+
+}
+
+TEST(ZincGraphicsContours, welded)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	// element 1 spans x from 0 to 10, element 2 from 10 to 20
+	Field x = zinc.fm.createFieldComponent(coordinates, 1);
+	EXPECT_TRUE(x.isValid());
+	Field y = zinc.fm.createFieldComponent(coordinates, 2);
+	EXPECT_TRUE(y.isValid());
+
+	GraphicsContours contours = zinc.scene.createGraphicsContours();
+	EXPECT_TRUE(contours.isValid());
+	EXPECT_FALSE(contours.isWelded());
+	EXPECT_EQ(RESULT_OK, contours.setWelded(true));
+	EXPECT_TRUE(contours.isWelded());
+	EXPECT_EQ(RESULT_OK, contours.setCoordinateField(coordinates));
+	EXPECT_EQ(RESULT_OK, contours.setDataField(x));
+	EXPECT_EQ(RESULT_OK, contours.setIsoscalarField(y));
+
+	// iso-surface crosses the face shared by both elements
+	Scenefilter noFilter;
+	double minimums[3], maximums[3];
+	const double tol = 1.0E-5;
+	double isovalue = 5.0;
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(1, &isovalue));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(0.0, minimums[0], tol);
+	EXPECT_NEAR(20.0, maximums[0], tol);
+	EXPECT_NEAR(5.0, minimums[1], tol);
+	EXPECT_NEAR(5.0, maximums[1], tol);
+
+	// welded strips share vertices between triangles and elements; exported
+	// faces omit the degenerate triangles joining strips
+	int weldedVerticesCount, weldedFacesCount, degenerateFacesCount;
+	getThreejsSurfaceCounts(zinc.scene, weldedVerticesCount, weldedFacesCount, degenerateFacesCount);
+	EXPECT_LT(0, weldedFacesCount);
+	EXPECT_EQ(0, degenerateFacesCount);
+	EXPECT_EQ(RESULT_OK, contours.setWelded(false));
+	int verticesCount, facesCount;
+	getThreejsSurfaceCounts(zinc.scene, verticesCount, facesCount, degenerateFacesCount);
+	EXPECT_LT(0, facesCount);
+	EXPECT_EQ(3*facesCount, verticesCount);
+	EXPECT_EQ(0, degenerateFacesCount);
+	EXPECT_LT(weldedVerticesCount, verticesCount);
+	EXPECT_EQ(RESULT_OK, contours.setWelded(true));
+
+	// welded contours are fully rebuilt on node changes
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Node node3 = nodes.findNodeByIdentifier(3);
+	EXPECT_TRUE(node3.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const double newX3[3] = { 30.0, 0.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node3));
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, newX3));
+	isovalue = 2.0;
+	EXPECT_EQ(RESULT_OK, contours.setListIsovalues(1, &isovalue));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(0.0, minimums[0], tol);
+	EXPECT_NEAR(2.0, minimums[1], tol);
+	EXPECT_NEAR(2.0, maximums[1], tol);
+
+	EXPECT_EQ(RESULT_OK, contours.setWelded(false));
+	EXPECT_FALSE(contours.isWelded());
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(2.0, minimums[1], tol);
+	EXPECT_NEAR(2.0, maximums[1], tol);
+}
@@ -1538,6 +1538,7 @@ TEST(cmzn_graphics_api, sampling_attributes_description_io)
 	EXPECT_EQ(2.0, streamlines.getTrackLength());
 	EXPECT_EQ(GraphicsStreamlines::COLOUR_DATA_TYPE_MAGNITUDE, streamlines.getColourDataType());
 	EXPECT_EQ(GraphicsStreamlines::TRACK_DIRECTION_REVERSE, streamlines.getTrackDirection());
+	EXPECT_EQ(GraphicsStreamlines::INTEGRATION_METHOD_DORMAND_PRINCE, streamlines.getIntegrationMethod());
 
 	char *return_string = zinc.scene.writeDescription();
 	EXPECT_TRUE(return_string != 0);
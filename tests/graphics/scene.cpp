@@ -37,6 +37,7 @@
 #include <opencmiss/zinc/sceneviewer.hpp>
 #include <opencmiss/zinc/spectrum.hpp>
 #include <opencmiss/zinc/streamscene.hpp>
+#include <opencmiss/zinc/tessellation.hpp>
 
 #include "test_resources.h"
 #include "zinctestsetup.hpp"
@@ -664,6 +665,166 @@ TEST(cmzn_scene, threejs_export_cpp)
 	EXPECT_NE(static_cast<char *>(0), temp_char);
 }
 
+// test spectrum colours are mapped from the material colour at each vertex
+TEST(cmzn_scene, threejs_export_spectrum_colours_cpp)
+{
+	ZincTestSetupCpp zinc;
+
+	int result;
+
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+
+	Material material = zinc.context.getMaterialmodule().createMaterial();
+	EXPECT_TRUE(material.isValid());
+	const double blue[3] = { 0.0, 0.0, 1.0 };
+	EXPECT_EQ(CMZN_OK, result = material.setAttributeReal3(Material::ATTRIBUTE_DIFFUSE, blue));
+
+	// red component only applies to x in [0.5, 1.0], so only to vertices on x = 1
+	Spectrum spectrum = zinc.context.getSpectrummodule().createSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	EXPECT_EQ(CMZN_OK, result = spectrum.setMaterialOverwrite(false));
+	Spectrumcomponent component = spectrum.createSpectrumcomponent();
+	EXPECT_TRUE(component.isValid());
+	EXPECT_EQ(CMZN_OK, result = component.setColourMappingType(Spectrumcomponent::COLOUR_MAPPING_TYPE_RED));
+	EXPECT_EQ(CMZN_OK, result = component.setFieldComponent(1));
+	EXPECT_EQ(CMZN_OK, result = component.setRangeMaximum(1.0));
+	EXPECT_EQ(CMZN_OK, result = component.setRangeMinimum(0.5));
+	EXPECT_EQ(CMZN_OK, result = component.setExtendAbove(false));
+	EXPECT_EQ(CMZN_OK, result = component.setExtendBelow(false));
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinateField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setDataField(coordinateField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setMaterial(material));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSpectrum(spectrum));
+	// one division so vertices are only on x = 0 and x = 1
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int one = 1;
+	EXPECT_EQ(CMZN_OK, result = tessellation.setMinimumDivisions(1, &one));
+	EXPECT_EQ(CMZN_OK, result = tessellation.setRefinementFactors(1, &one));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setTessellation(tessellation));
+
+	StreaminformationScene si = zinc.scene.createStreaminformationScene();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(CMZN_OK, result = si.setIOFormat(si.IO_FORMAT_THREEJS));
+	EXPECT_EQ(CMZN_OK, result = si.setIODataType(si.IO_DATA_TYPE_COLOUR));
+	EXPECT_EQ(2, result = si.getNumberOfResourcesRequired());
+	StreamresourceMemory memory_sr = si.createStreamresourceMemory();
+	StreamresourceMemory memory_sr2 = si.createStreamresourceMemory();
+	EXPECT_EQ(CMZN_OK, result = zinc.scene.write(si));
+
+	char *memory_buffer;
+	unsigned int size = 0;
+	EXPECT_EQ(CMZN_OK, result = memory_sr2.getBuffer((void**)&memory_buffer, &size));
+	std::string buffer(memory_buffer, size);
+	const char *colours_key = "\"colors\" : [";
+	size_t position = buffer.find(colours_key);
+	EXPECT_NE(std::string::npos, position);
+	if (position == std::string::npos)
+		return;
+	const char *text = buffer.c_str() + position + strlen(colours_key);
+	int blueCount = 0, magentaCount = 0, otherCount = 0;
+	while (true)
+	{
+		char *end = 0;
+		const long colour = strtol(text, &end, 10);
+		if (end == text)
+			break;
+		if (colour == 0x0000ff)
+			++blueCount;
+		else if (colour == 0xff00ff)
+			++magentaCount;
+		else
+			++otherCount;
+		text = end;
+		while ((*text == ',') || isspace(*text))
+			++text;
+	}
+	EXPECT_LT(0, blueCount);
+	EXPECT_LT(0, magentaCount);
+	EXPECT_EQ(0, otherCount);
+}
+
+namespace {
+
+unsigned int getUint32LittleEndian(const unsigned char *bytes)
+{
+	return static_cast<unsigned int>(bytes[0]) | (static_cast<unsigned int>(bytes[1]) << 8) |
+		(static_cast<unsigned int>(bytes[2]) << 16) | (static_cast<unsigned int>(bytes[3]) << 24);
+}
+
+std::string writeSceneToMemory(Scene& scene, StreaminformationScene::IOFormat ioFormat)
+{
+	StreaminformationScene si = scene.createStreaminformationScene();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(CMZN_OK, si.setIOFormat(ioFormat));
+	EXPECT_EQ(1, si.getNumberOfResourcesRequired());
+	StreamresourceMemory memory_sr = si.createStreamresourceMemory();
+	EXPECT_EQ(CMZN_OK, scene.write(si));
+	char *memory_buffer = 0;
+	unsigned int size = 0;
+	EXPECT_EQ(CMZN_OK, memory_sr.getBuffer((void**)&memory_buffer, &size));
+	return std::string(memory_buffer ? memory_buffer : "", size);
+}
+
+}
+
+// surfaces of a cube with 2x2 divisions per face: 6*8 triangles sharing
+// 26 distinct vertices once duplicates along face edges are welded
+TEST(cmzn_scene, triangle_mesh_export_cpp)
+{
+	ZincTestSetupCpp zinc;
+
+	int result;
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinateField));
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int two = 2;
+	EXPECT_EQ(CMZN_OK, result = tessellation.setMinimumDivisions(1, &two));
+	EXPECT_EQ(CMZN_OK, result = tessellation.setRefinementFactors(1, &two));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setTessellation(tessellation));
+
+	const unsigned int expectedTriangleCount = 48;
+	const unsigned int expectedVertexCount = 26;
+
+	const std::string stl = writeSceneToMemory(zinc.scene, StreaminformationScene::IO_FORMAT_STL_BINARY);
+	EXPECT_EQ(84 + 50*expectedTriangleCount, stl.size());
+	if (stl.size() < 84)
+		return;
+	EXPECT_NE(0, strncmp(stl.c_str(), "solid", 5));
+	EXPECT_EQ(expectedTriangleCount, getUint32LittleEndian(reinterpret_cast<const unsigned char *>(stl.data()) + 80));
+
+	const std::string ply = writeSceneToMemory(zinc.scene, StreaminformationScene::IO_FORMAT_PLY_BINARY);
+	const char *end_header = "end_header\n";
+	const size_t header_size = ply.find(end_header) + strlen(end_header);
+	EXPECT_NE(std::string::npos, ply.find(end_header));
+	EXPECT_NE(std::string::npos, ply.find("element vertex 26\n"));
+	EXPECT_NE(std::string::npos, ply.find("element face 48\n"));
+	EXPECT_EQ(header_size + 12*expectedVertexCount + 13*expectedTriangleCount, ply.size());
+	if (ply.size() != header_size + 12*expectedVertexCount + 13*expectedTriangleCount)
+		return;
+	// every face is a triangle referencing welded vertices
+	const unsigned char *face = reinterpret_cast<const unsigned char *>(ply.data()) + header_size + 12*expectedVertexCount;
+	for (unsigned int f = 0; f < expectedTriangleCount; ++f, face += 13)
+	{
+		EXPECT_EQ(3, face[0]);
+		for (int v = 0; v < 3; ++v)
+			EXPECT_GT(expectedVertexCount, getUint32LittleEndian(face + 1 + 4*v));
+	}
+
+	// output is byte-exact across repeated exports
+	EXPECT_EQ(stl, writeSceneToMemory(zinc.scene, StreaminformationScene::IO_FORMAT_STL_BINARY));
+	EXPECT_EQ(ply, writeSceneToMemory(zinc.scene, StreaminformationScene::IO_FORMAT_PLY_BINARY));
+}
+
 TEST(cmzn_scene, threejs_export)
 {
 	ZincTestSetup zinc;
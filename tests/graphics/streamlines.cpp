@@ -20,8 +20,14 @@
 
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
+#include "opencmiss/zinc/element.hpp"
+#include "opencmiss/zinc/fieldarithmeticoperators.hpp"
 #include "opencmiss/zinc/fieldconstant.hpp"
+#include "opencmiss/zinc/fieldmatrixoperators.hpp"
 #include "opencmiss/zinc/graphics.hpp"
+#include "opencmiss/zinc/scene.hpp"
+#include "opencmiss/zinc/scenefilter.hpp"
+#include "test_resources.h"
 
 TEST(cmzn_graphics_streamlines, create_cast)
 {
@@ -181,6 +187,19 @@ TEST(cmzn_graphics_streamlines, track_direction_cpp)
 	EXPECT_EQ(GraphicsStreamlines::TRACK_DIRECTION_REVERSE, st.getTrackDirection());
 }
 
+TEST(cmzn_graphics_streamlines, integration_method_cpp)
+{
+	ZincTestSetupCpp zinc;
+
+	GraphicsStreamlines st = zinc.scene.createGraphicsStreamlines();
+	EXPECT_TRUE(st.isValid());
+
+	EXPECT_EQ(GraphicsStreamlines::INTEGRATION_METHOD_IMPROVED_EULER, st.getIntegrationMethod());
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, st.setIntegrationMethod(GraphicsStreamlines::INTEGRATION_METHOD_INVALID));
+	EXPECT_EQ(CMZN_OK, st.setIntegrationMethod(GraphicsStreamlines::INTEGRATION_METHOD_DORMAND_PRINCE));
+	EXPECT_EQ(GraphicsStreamlines::INTEGRATION_METHOD_DORMAND_PRINCE, st.getIntegrationMethod());
+}
+
 TEST(cmzn_graphics_streamlines, track_length)
 {
 	ZincTestSetup zinc;
@@ -210,3 +229,102 @@ TEST(cmzn_graphics_streamlines, track_length_cpp)
 	EXPECT_EQ(CMZN_OK, st.setTrackLength(trackLength));
 	EXPECT_DOUBLE_EQ(trackLength, st.getTrackLength());
 }
+
+TEST(ZincGraphicsStreamlines, trackAcrossElements)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double values[] = { 1.0, 0.0, 0.0 };
+	Field streamVectorField = zinc.fm.createFieldConstant(3, values);
+	EXPECT_TRUE(streamVectorField.isValid());
+
+	GraphicsStreamlines st = zinc.scene.createGraphicsStreamlines();
+	EXPECT_TRUE(st.isValid());
+	EXPECT_EQ(CMZN_OK, st.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, st.setStreamVectorField(streamVectorField));
+	EXPECT_EQ(CMZN_OK, st.setTrackLength(100.0));
+	// seed at centre of each element: element 1 spans x from 0 to 10, element 2 from 10 to 20
+	Graphicssamplingattributes sampling = st.getGraphicssamplingattributes();
+	EXPECT_EQ(CMZN_OK, sampling.setElementPointSamplingMode(Element::POINT_SAMPLING_MODE_SET_LOCATION));
+	const double location[3] = { 0.5, 0.5, 0.5 };
+	EXPECT_EQ(CMZN_OK, sampling.setLocation(3, location));
+
+	// both streamlines are traced through the same reused buffers
+	Scenefilter noFilter;
+	double minimums[3], maximums[3];
+	const double tol = 1.0E-5;
+	EXPECT_EQ(CMZN_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(5.0, minimums[0], tol);
+	EXPECT_NEAR(20.0, maximums[0], tol);
+	EXPECT_NEAR(5.0, minimums[1], tol);
+	EXPECT_NEAR(5.0, maximums[1], tol);
+
+	EXPECT_EQ(CMZN_OK, st.setTrackDirection(GraphicsStreamlines::TRACK_DIRECTION_REVERSE));
+	EXPECT_EQ(CMZN_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(0.0, minimums[0], tol);
+	EXPECT_NEAR(15.0, maximums[0], tol);
+
+	// ribbons are traced through the same buffers
+	Graphicslineattributes lineAttributes = st.getGraphicslineattributes();
+	EXPECT_EQ(CMZN_OK, lineAttributes.setShapeType(Graphicslineattributes::SHAPE_TYPE_RIBBON));
+	EXPECT_EQ(CMZN_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+	EXPECT_NEAR(0.0, minimums[0], tol);
+	EXPECT_NEAR(15.0, maximums[0], tol);
+}
+
+// helix about axis parallel to x through y = z = 5, crossing between elements
+TEST(ZincGraphicsStreamlines, integrationMethods)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double axisValues[] = { 0.0, 5.0, 5.0 };
+	Field axis = zinc.fm.createFieldConstant(3, axisValues);
+	const double rotationValues[] = { 0.0, 0.0, 0.0, 0.0, 0.0, -1.0, 0.0, 1.0, 0.0 };
+	Field rotation = zinc.fm.createFieldConstant(9, rotationValues);
+	const double driftValues[] = { 1.0, 0.0, 0.0 };
+	Field drift = zinc.fm.createFieldConstant(3, driftValues);
+	Field streamVectorField = drift + zinc.fm.createFieldMatrixMultiply(3, rotation, coordinates - axis);
+	EXPECT_TRUE(streamVectorField.isValid());
+
+	GraphicsStreamlines st = zinc.scene.createGraphicsStreamlines();
+	EXPECT_TRUE(st.isValid());
+	EXPECT_EQ(CMZN_OK, st.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, st.setStreamVectorField(streamVectorField));
+	EXPECT_EQ(CMZN_OK, st.setTrackLength(6.0));
+	// seeds at (5, 8, 5) and (15, 8, 5) circle the axis with radius 3;
+	// the first crosses into element 2 at x = 10, the second leaves the mesh at x = 20
+	Graphicssamplingattributes sampling = st.getGraphicssamplingattributes();
+	EXPECT_EQ(CMZN_OK, sampling.setElementPointSamplingMode(Element::POINT_SAMPLING_MODE_SET_LOCATION));
+	const double location[3] = { 0.5, 0.8, 0.5 };
+	EXPECT_EQ(CMZN_OK, sampling.setLocation(3, location));
+
+	const GraphicsStreamlines::IntegrationMethod integrationMethods[2] =
+	{
+		GraphicsStreamlines::INTEGRATION_METHOD_IMPROVED_EULER,
+		GraphicsStreamlines::INTEGRATION_METHOD_DORMAND_PRINCE
+	};
+	Scenefilter noFilter;
+	double minimums[3], maximums[3];
+	const double tol = 1.0E-3;
+	// extremes of circle are only reached at points output along streamline
+	const double circleTol = 0.05;
+	for (int m = 0; m < 2; ++m)
+	{
+		EXPECT_EQ(CMZN_OK, st.setIntegrationMethod(integrationMethods[m]));
+		EXPECT_EQ(CMZN_OK, zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+		EXPECT_NEAR(5.0, minimums[0], tol);
+		EXPECT_NEAR(20.0, maximums[0], tol);
+		EXPECT_NEAR(2.0, minimums[1], circleTol);
+		EXPECT_NEAR(8.0, maximums[1], tol);
+		EXPECT_NEAR(2.0, minimums[2], circleTol);
+		EXPECT_NEAR(8.0, maximums[2], circleTol);
+	}
+}
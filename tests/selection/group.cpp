@@ -484,6 +484,123 @@ TEST(ZincFieldNodeGroup, add_remove_conditional)
 	EXPECT_EQ(OK, nodesetGroup.removeNodesConditional(otherNodesGroup));
 }
 
+// test conditionals which are groups combined with logical operators, which
+// are handled by bitset operations on groups without evaluating per object
+TEST(ZincFieldNodeGroup, add_remove_conditional_logical_groups)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Nodeset nodeset = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_EQ(12, result = nodeset.getSize());
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double fifteen = 15.0;
+	const double five = 5.0;
+	FieldGreaterThan x_gt_15 = zinc.fm.createFieldComponent(coordinates, 1) > zinc.fm.createFieldConstant(1, &fifteen);
+	EXPECT_TRUE(x_gt_15.isValid());
+	FieldGreaterThan z_gt_5 = zinc.fm.createFieldComponent(coordinates, 3) > zinc.fm.createFieldConstant(1, &five);
+	EXPECT_TRUE(z_gt_5.isValid());
+
+	// nodes 3, 6, 9, 12
+	FieldNodeGroup groupA = zinc.fm.createFieldNodeGroup(nodeset);
+	NodesetGroup nodesetGroupA = groupA.getNodesetGroup();
+	EXPECT_EQ(OK, nodesetGroupA.addNodesConditional(x_gt_15));
+	EXPECT_EQ(4, result = nodesetGroupA.getSize());
+	// nodes 7-12
+	FieldNodeGroup groupB = zinc.fm.createFieldNodeGroup(nodeset);
+	NodesetGroup nodesetGroupB = groupB.getNodesetGroup();
+	EXPECT_EQ(OK, nodesetGroupB.addNodesConditional(z_gt_5));
+	EXPECT_EQ(6, result = nodesetGroupB.getSize());
+
+	FieldNodeGroup nodesGroup = zinc.fm.createFieldNodeGroup(nodeset);
+	NodesetGroup nodesetGroup = nodesGroup.getNodesetGroup();
+	EXPECT_TRUE(nodesetGroup.isValid());
+
+	EXPECT_EQ(OK, nodesetGroup.addNodesConditional(groupA && groupB));
+	EXPECT_EQ(2, result = nodesetGroup.getSize());
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(9)));
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(12)));
+
+	EXPECT_EQ(OK, nodesetGroup.addNodesConditional(groupA || groupB));
+	EXPECT_EQ(8, result = nodesetGroup.getSize());
+	EXPECT_FALSE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(1)));
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(3)));
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(7)));
+
+	EXPECT_EQ(OK, nodesetGroup.removeNodesConditional(!groupA));
+	EXPECT_EQ(4, result = nodesetGroup.getSize());
+	for (int i = 3; i <= 12; i += 3)
+		EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(i)));
+
+	EXPECT_EQ(OK, nodesetGroup.addNodesConditional(!(groupA || groupB)));
+	EXPECT_EQ(8, result = nodesetGroup.getSize());
+	for (int i = 1; i <= 5; ++i)
+		EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(i)));
+
+	EXPECT_EQ(OK, nodesetGroup.removeNodesConditional((!groupB) && (!groupA)));
+	EXPECT_EQ(4, result = nodesetGroup.getSize());
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(9)));
+	EXPECT_FALSE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(1)));
+
+	// logical operator on a non-group is evaluated at each node
+	EXPECT_EQ(OK, nodesetGroup.removeNodesConditional(groupA && z_gt_5));
+	EXPECT_EQ(2, result = nodesetGroup.getSize());
+	EXPECT_FALSE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(9)));
+	EXPECT_TRUE(nodesetGroup.containsNode(nodeset.findNodeByIdentifier(6)));
+
+	// group containing the local region is true for all nodes
+	FieldGroup allGroup = zinc.fm.createFieldGroup();
+	EXPECT_EQ(OK, allGroup.addLocalRegion());
+	EXPECT_EQ(OK, nodesetGroup.removeAllNodes());
+	EXPECT_EQ(OK, nodesetGroup.addNodesConditional(allGroup && !groupB));
+	EXPECT_EQ(6, result = nodesetGroup.getSize());
+	EXPECT_EQ(OK, nodesetGroup.addNodesConditional(allGroup));
+	EXPECT_EQ(12, result = nodesetGroup.getSize());
+}
+
+TEST(ZincFieldElementGroup, add_remove_conditional_logical_groups)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	EXPECT_EQ(2, result = mesh3d.getSize());
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	EXPECT_EQ(11, result = mesh2d.getSize());
+
+	FieldElementGroup group1 = zinc.fm.createFieldElementGroup(mesh3d);
+	MeshGroup meshGroup1 = group1.getMeshGroup();
+	EXPECT_EQ(OK, meshGroup1.addElement(mesh3d.findElementByIdentifier(1)));
+
+	FieldElementGroup elementsGroup = zinc.fm.createFieldElementGroup(mesh3d);
+	MeshGroup elementsMeshGroup = elementsGroup.getMeshGroup();
+	EXPECT_TRUE(elementsMeshGroup.isValid());
+
+	EXPECT_EQ(OK, elementsMeshGroup.addElementsConditional(!group1));
+	EXPECT_EQ(1, result = elementsMeshGroup.getSize());
+	EXPECT_TRUE(elementsMeshGroup.containsElement(mesh3d.findElementByIdentifier(2)));
+	EXPECT_EQ(OK, elementsMeshGroup.addElementsConditional(group1 || elementsGroup));
+	EXPECT_EQ(2, result = elementsMeshGroup.getSize());
+	EXPECT_EQ(OK, elementsMeshGroup.removeElementsConditional(group1 && elementsGroup));
+	EXPECT_EQ(1, result = elementsMeshGroup.getSize());
+	EXPECT_TRUE(elementsMeshGroup.containsElement(mesh3d.findElementByIdentifier(2)));
+
+	// a face group is false for all 3-D elements
+	FieldElementGroup facesGroup = zinc.fm.createFieldElementGroup(mesh2d);
+	MeshGroup facesMeshGroup = facesGroup.getMeshGroup();
+	EXPECT_EQ(OK, facesMeshGroup.addElement(mesh2d.findElementByIdentifier(1)));
+	EXPECT_EQ(OK, elementsMeshGroup.removeElementsConditional(!facesGroup));
+	EXPECT_EQ(0, result = elementsMeshGroup.getSize());
+	EXPECT_EQ(OK, elementsMeshGroup.addElementsConditional(facesGroup || group1));
+	EXPECT_EQ(1, result = elementsMeshGroup.getSize());
+	EXPECT_TRUE(elementsMeshGroup.containsElement(mesh3d.findElementByIdentifier(1)));
+}
+
 TEST(ZincFieldGroup, subelementHandlingMode)
 {
 	ZincTestSetupCpp zinc;
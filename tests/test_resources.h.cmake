@@ -64,7 +64,8 @@ public:
 		FIELDIO_EX2_ALLSHAPES_ELEMENT_CONSTANT_RESOURCE = 53,
 		FIELDMODULE_EX2_PART_SURFACES_RESOURCE = 54,
 		FIELDMODULE_EX2_TWO_CUBES_HERMITE_NOCROSS_RESOURCE = 55,
-		FIELDMODULE_EX2_CYLINDER_TEXTURE_RESOURCE = 56
+		FIELDMODULE_EX2_CYLINDER_TEXTURE_RESOURCE = 56,
+		HEART_EXELEM_BZ2 = 57
 	};
 
 	TestResources()
@@ -299,6 +300,10 @@ public:
 		{
 			return "@FIELDMODULE_EX2_CYLINDER_TEXTURE_RESOURCE@";
 		}
+		if (resourceName == TestResources::HEART_EXELEM_BZ2)
+		{
+			return "@HEART_EXELEM_BZ2@";
+		}
 		return 0;
 	}
 };